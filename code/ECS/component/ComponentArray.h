@@ -13,6 +13,7 @@
 #include "entity/EntityHandle.h"
 // component
 #include "ComponentHandle.h"
+#include "ComponentStorage.h"
 #include "ECS/HandleAssignMode.h"
 #include "IComponent.h"
 #include "IComponentArray.h"
@@ -27,6 +28,10 @@ namespace OriGine {
 /// <summary>
 /// コンポーネント配列
 /// </summary>
+/// <remarks>
+/// ComponentStorageTraits で単一インスタンス指定された型は, Entityごとの std::vector を持たず
+/// 所有Entityと同じ密配列のスロットに直接格納される (1Entityにつき1つまで).
+/// </remarks>
 /// <typeparam name="ComponentType"></typeparam>
 template <IsComponent ComponentType>
 class ComponentArray final
@@ -35,6 +40,11 @@ public:
     ComponentArray()           = default;
     ~ComponentArray() override = default;
 
+    /// Entityごとに保持するComponentリストの型
+    using ComponentListType = ComponentList<ComponentType>;
+    /// 単一インスタンス格納方式か
+    static constexpr bool kSingleInstance = ComponentStorageTraits<ComponentType>::kSingleInstance;
+
     // ────────────────────────────────
     //  lifecycle
     // ────────────────────────────────
@@ -182,10 +192,11 @@ public:
 
     /// <summary>
     /// Entityが所有するComponent全ての取得
+    /// (単一インスタンス型では要素数 0 or 1 の SingleComponentList)
     /// </summary>
     /// <param name="_handle"></param>
     /// <returns></returns>
-    std::vector<ComponentType>& GetComponents(const EntityHandle& _handle);
+    ComponentListType& GetComponents(const EntityHandle& _handle);
 
     /// <summary>
     /// Componentの取得 (IComponent版)
@@ -227,14 +238,38 @@ public:
     /// </summary>
     struct EntitySlot {
         EntityHandle owner{}; // このスロットを所有するEntity
-        std::vector<ComponentType> components; // 所有するComponent本体の配列
+        ComponentListType components; // 所有するComponent本体 (単一インスタンス型はスロット内に直接保持)
     };
 
+private:
+    /// <summary>
+    /// Entityに対応する EntitySlot の安定IDを探す.
+    /// 実行時インデックスを持つHandleは配列参照と uuid の比較で解決し, 持たない場合や一致しない場合は uuid で検索する.
+    /// </summary>
+    /// <returns>見つからなければ DenseSlotMap::kInvalidId</returns>
+    uint32_t FindSlotId(const EntityHandle& _entity) const;
+    /// <summary>
+    /// Componentの位置を探す.
+    /// Handleの位置ヒントが正しければ uuid の比較のみで解決し, 古ければ uuid で検索する.
+    /// </summary>
+    /// <returns>見つかれば true</returns>
+    bool FindComponentLocation(const ComponentHandle& _handle, ComponentLocation& _outLocation) const;
+    /// <summary>
+    /// Componentの位置情報を登録し, Component自身のHandleにも位置ヒントを書き戻す
+    /// </summary>
+    void UpdateComponentLocation(uint32_t _slotId, uint32_t _compIndex);
+    /// <summary>
+    /// スロットにComponentを追加できるか (単一インスタンス型で既に所有している場合は警告して false)
+    /// </summary>
+    bool CanAddComponent(const EntitySlot& _slot) const;
+
 private:
     DenseSlotMap<EntitySlot> slots_; // Entity単位でComponent群を保持する実データ本体
 
     // entity uuid -> DenseSlotMap stable ID
     std::unordered_map<uuids::uuid, uint32_t> entitySlotMap_;
+    // entity runtime index -> DenseSlotMap stable ID (EntityHandle::index で直接引く)
+    std::vector<uint32_t> entityIndexToSlot_;
     // component uuid -> (stable ID, component index)
     std::unordered_map<uuids::uuid, ComponentLocation> componentLocationMap_;
 
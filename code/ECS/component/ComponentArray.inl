@@ -8,6 +8,7 @@ template <IsComponent ComponentType>
 inline void ComponentArray<ComponentType>::Initialize(uint32_t _reserveSize) {
     slots_.Reserve(_reserveSize);
     entitySlotMap_.clear();
+    entityIndexToSlot_.clear();
     componentLocationMap_.clear();
 }
 
@@ -17,15 +18,19 @@ inline void ComponentArray<ComponentType>::Finalize() {
         for (auto& comp : slot.components) {
             comp.Finalize();
         }
+        // 削除時と同じく, 所有していたEntityのシグネチャからこの型を外す
+        RecordEntityUnregistered(slot.owner);
+        RecordComponentPresence(slot.owner, false);
     }
     slots_.Clear();
     entitySlotMap_.clear();
+    entityIndexToSlot_.clear();
     componentLocationMap_.clear();
 }
 
 template <IsComponent ComponentType>
 inline void ComponentArray<ComponentType>::RegisterEntity(const EntityHandle& _entity) {
-    if (entitySlotMap_.contains(_entity.uuid)) {
+    if (FindSlotId(_entity) != DenseSlotMap<EntitySlot>::kInvalidId) {
         return;
     }
 
@@ -33,59 +38,74 @@ inline void ComponentArray<ComponentType>::RegisterEntity(const EntityHandle& _e
     EntitySlot& slot = slots_[slotId];
     slot.owner       = _entity;
     slot.components.clear();
+    // 空のスロットから始めるので, 以前の登録で残ったシグネチャのビットを外しておく
+    RecordComponentPresence(_entity, false);
 
     entitySlotMap_[_entity.uuid] = slotId;
+    if (_entity.HasRuntimeIndex()) {
+        if (_entity.index >= entityIndexToSlot_.size()) {
+            entityIndexToSlot_.resize(static_cast<size_t>(_entity.index) + 1, DenseSlotMap<EntitySlot>::kInvalidId);
+        }
+        entityIndexToSlot_[_entity.index] = slotId;
+    }
+    RecordEntityRegistered(_entity);
 }
 
 template <IsComponent ComponentType>
 inline void ComponentArray<ComponentType>::UnregisterEntity(const EntityHandle& _entity) {
-    auto itr = entitySlotMap_.find(_entity.uuid);
-    if (itr == entitySlotMap_.end()) {
+    uint32_t slotId = FindSlotId(_entity);
+    if (slotId == DenseSlotMap<EntitySlot>::kInvalidId) {
         return;
     }
 
-    uint32_t slotId = itr->second;
-
     // 所有する全Componentを終了処理し、位置情報も合わせて削除する
-    for (auto& comp : slots_[slotId].components) {
+    EntitySlot& slot = slots_[slotId];
+    for (auto& comp : slot.components) {
         comp.Finalize();
         componentLocationMap_.erase(comp.GetHandle().uuid);
     }
 
-    entitySlotMap_.erase(itr);
+    if (slot.owner.HasRuntimeIndex() && slot.owner.index < entityIndexToSlot_.size()) {
+        entityIndexToSlot_[slot.owner.index] = DenseSlotMap<EntitySlot>::kInvalidId;
+    }
+    entitySlotMap_.erase(slot.owner.uuid);
+    RecordEntityUnregistered(slot.owner);
+    RecordComponentPresence(slot.owner, false);
     slots_.Erase(slotId);
 }
 
 template <IsComponent ComponentType>
 inline bool ComponentArray<ComponentType>::HasEntity(const EntityHandle& _entity) const {
-    auto itr = entitySlotMap_.find(_entity.uuid);
-    if (itr == entitySlotMap_.end()) {
+    uint32_t slotId = FindSlotId(_entity);
+    if (slotId == DenseSlotMap<EntitySlot>::kInvalidId) {
         return false;
     }
 
-    return !slots_[itr->second].components.empty();
+    return !slots_[slotId].components.empty();
 }
 
 template <IsComponent ComponentType>
 inline ComponentHandle ComponentArray<ComponentType>::AddComponent(Scene* _scene, const EntityHandle& _entity) {
-    auto entIt = entitySlotMap_.find(_entity.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_entity);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         RegisterEntity(_entity);
-        entIt = entitySlotMap_.find(_entity.uuid);
+        slotIndex = FindSlotId(_entity);
     }
 
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
+    if (!CanAddComponent(slot)) {
+        return ComponentHandle();
+    }
 
     ComponentType comp{};
-    comp.SetHandle(ComponentHandle(UuidGenerator::RandomGenerate())); // 新規Handleを発行
+    comp.SetHandle(ComponentHandle(UuidGenerator::Generate())); // 新規Handleを発行
 
     slot.components.emplace_back(std::move(comp));
     uint32_t compIndex = static_cast<uint32_t>(slot.components.size() - 1);
 
     // 追加位置を検索用マップに登録
-    componentLocationMap_[slot.components.back().GetHandle().uuid] =
-        {slotIndex, compIndex};
+    UpdateComponentLocation(slotIndex, compIndex);
+    RecordComponentPresence(_entity, true);
 
     slot.components.back().Initialize(_scene, _entity); // マップ登録後に初期化
 
@@ -94,17 +114,19 @@ inline ComponentHandle ComponentArray<ComponentType>::AddComponent(Scene* _scene
 
 template <IsComponent ComponentType>
 inline ComponentHandle ComponentArray<ComponentType>::InsertComponent(Scene* _scene, const EntityHandle& _entity, uint32_t _compIndex) {
-    auto entIt = entitySlotMap_.find(_entity.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_entity);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         RegisterEntity(_entity);
-        entIt = entitySlotMap_.find(_entity.uuid);
+        slotIndex = FindSlotId(_entity);
     }
 
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
+    if (!CanAddComponent(slot)) {
+        return ComponentHandle();
+    }
 
     ComponentType comp{};
-    ComponentHandle compHandle = ComponentHandle(UuidGenerator::RandomGenerate());
+    ComponentHandle compHandle = ComponentHandle(UuidGenerator::Generate());
     comp.SetHandle(compHandle);
     comp.Initialize(_scene, _entity);
 
@@ -115,43 +137,42 @@ inline ComponentHandle ComponentArray<ComponentType>::InsertComponent(Scene* _sc
 
     // handleの再配置
     for (uint32_t i = static_cast<uint32_t>(_compIndex); i < static_cast<uint32_t>(slot.components.size()); ++i) {
-        componentLocationMap_[slot.components[i].GetHandle().uuid] =
-            {slotIndex, i};
+        UpdateComponentLocation(slotIndex, i);
     }
+    RecordComponentPresence(_entity, true);
 
-    return compHandle;
+    return slot.components[_compIndex].GetHandle();
 }
 
 template <IsComponent ComponentType>
 inline void ComponentArray<ComponentType>::RemoveComponent(ComponentHandle _handle) {
-    auto itr = componentLocationMap_.find(_handle.uuid);
-    if (itr == componentLocationMap_.end()) {
+    ComponentLocation location{};
+    if (!FindComponentLocation(_handle, location)) {
         return;
     }
 
-    auto [slotIndex, compIndex] = itr->second;
+    auto [slotIndex, compIndex] = location;
     EntitySlot& slot            = slots_[slotIndex];
 
     slot.components[compIndex].Finalize();
     slot.components.erase(slot.components.begin() + compIndex);
-    componentLocationMap_.erase(itr);
+    componentLocationMap_.erase(_handle.uuid);
 
     // index 再割当（同一 entity 内のみ）
     for (uint32_t i = compIndex; i < slot.components.size(); ++i) {
-        componentLocationMap_[slot.components[i].GetHandle().uuid] =
-            {slotIndex, i};
+        UpdateComponentLocation(slotIndex, i);
     }
+    RecordComponentPresence(slot.owner, !slot.components.empty());
 }
 
 template <IsComponent ComponentType>
 inline void ComponentArray<ComponentType>::RemoveComponent(const EntityHandle& _handle, uint32_t _compIndex) {
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         return;
     }
 
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
     if (_compIndex < 0 || static_cast<size_t>(_compIndex) >= slot.components.size()) {
         return;
     }
@@ -162,35 +183,35 @@ inline void ComponentArray<ComponentType>::RemoveComponent(const EntityHandle& _
     slot.components.erase(slot.components.begin() + _compIndex);
     // index 再割当（同一 entity 内のみ）
     for (uint32_t i = _compIndex; i < slot.components.size(); ++i) {
-        componentLocationMap_[slot.components[i].GetHandle().uuid] =
-            {slotIndex, i};
+        UpdateComponentLocation(slotIndex, i);
     }
+    RecordComponentPresence(slot.owner, !slot.components.empty());
 }
 
 template <IsComponent ComponentType>
 inline void ComponentArray<ComponentType>::RemoveAllComponents(const EntityHandle& _handle) {
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         return;
     }
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
     for (auto& comp : slot.components) {
         comp.Finalize();
         componentLocationMap_.erase(comp.GetHandle().uuid);
     }
     slot.components.clear();
+    RecordComponentPresence(slot.owner, false);
 }
 
 template <IsComponent ComponentType>
 inline bool ComponentArray<ComponentType>::SaveComponent(ComponentHandle _compHandle, nlohmann::json& _outJson) {
     // エンティティが存在しない場合は失敗
-    auto itr = componentLocationMap_.find(_compHandle.uuid);
-    if (itr == componentLocationMap_.end()) {
+    ComponentLocation location{};
+    if (!FindComponentLocation(_compHandle, location)) {
         return false;
     }
 
-    auto [slotIndex, compIndex] = itr->second;
+    auto [slotIndex, compIndex] = location;
     EntitySlot& slot            = slots_[slotIndex];
 
     _outJson[nameof<ComponentType>()]           = slot.components[compIndex];
@@ -202,13 +223,12 @@ inline bool ComponentArray<ComponentType>::SaveComponent(ComponentHandle _compHa
 template <IsComponent ComponentType>
 inline bool ComponentArray<ComponentType>::SaveComponent(const EntityHandle& _handle, uint32_t _compIndex, nlohmann::json& _outJson) {
     // エンティティが存在しない場合は失敗
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         return false;
     }
 
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
     // indexが無効なら 失敗
     if (_compIndex < 0 || static_cast<size_t>(_compIndex) >= slot.components.size()) {
         return false;
@@ -223,14 +243,13 @@ inline bool ComponentArray<ComponentType>::SaveComponent(const EntityHandle& _ha
 template <IsComponent ComponentType>
 inline bool ComponentArray<ComponentType>::SaveComponents(const EntityHandle& _handle, nlohmann::json& _outJson) {
     // エンティティが存在しない場合は何もしない
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         return false;
     }
 
     // slotの取得
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
 
     // コンポーネントを保存
     nlohmann::json compVecJson = nlohmann::json::array();
@@ -249,29 +268,33 @@ inline ComponentHandle ComponentArray<ComponentType>::LoadComponent(
     const EntityHandle& _handle,
     const nlohmann::json& _inJson,
     HandleAssignMode _handleMode) {
-    auto itr = entitySlotMap_.find(_handle.uuid);
-    if (itr == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         // エンティティが存在しない場合は何もしない
         LOG_ERROR("Entity not found for ID: {}", uuids::to_string(_handle.uuid));
         return ComponentHandle();
     }
 
     // slotの取得
-    uint32_t slotIndex = itr->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
+    if (!CanAddComponent(slot)) {
+        return ComponentHandle();
+    }
 
     // コンポーネントを読み込み
     ComponentType comp         = _inJson.get<ComponentType>();
     ComponentHandle compHandle = ComponentHandle();
     if (_handleMode == HandleAssignMode::UseSaved && _inJson.contains("Handle")) {
         _inJson["Handle"].get_to<ComponentHandle>(compHandle);
+        UuidGenerator::NotifyLoaded(compHandle.uuid);
     } else {
         // 新規Handle生成
-        compHandle = ComponentHandle(UuidGenerator::RandomGenerate());
+        compHandle = ComponentHandle(UuidGenerator::Generate());
     }
     comp.SetHandle(compHandle);
 
     slot.components.push_back(comp);
+    RecordComponentPresence(_handle, true);
 
     return compHandle;
 }
@@ -282,23 +305,26 @@ inline ComponentHandle ComponentArray<ComponentType>::LoadComponent(
     uint32_t _compIndex,
     const nlohmann::json& _inJson,
     HandleAssignMode _handleMode) {
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         // エンティティが見つからなかった 場合
         // 新たに登録する
         RegisterEntity(_handle);
-        entIt = entitySlotMap_.find(_handle.uuid);
+        slotIndex = FindSlotId(_handle);
     }
     // slotの取得
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
+    if (!CanAddComponent(slot)) {
+        return ComponentHandle();
+    }
     // コンポーネントを読み込み
     ComponentType comp         = _inJson.get<ComponentType>();
     ComponentHandle compHandle = ComponentHandle();
     if (_handleMode == HandleAssignMode::UseSaved && _inJson.contains("Handle")) {
         _inJson["Handle"].get_to<ComponentHandle>(compHandle);
+        UuidGenerator::NotifyLoaded(compHandle.uuid);
     } else {
-        compHandle = ComponentHandle(UuidGenerator::RandomGenerate());
+        compHandle = ComponentHandle(UuidGenerator::Generate());
     }
     comp.SetHandle(compHandle);
 
@@ -309,11 +335,11 @@ inline ComponentHandle ComponentArray<ComponentType>::LoadComponent(
 
     // handleの再配置
     for (uint32_t i = _compIndex; i < static_cast<uint32_t>(slot.components.size()); ++i) {
-        componentLocationMap_[slot.components[i].GetHandle().uuid] =
-            {slotIndex, i};
+        UpdateComponentLocation(slotIndex, i);
     }
+    RecordComponentPresence(_handle, true);
 
-    return compHandle;
+    return slot.components[_compIndex].GetHandle();
 }
 
 template <IsComponent ComponentType>
@@ -321,59 +347,60 @@ inline void ComponentArray<ComponentType>::LoadComponents(
     const EntityHandle& _handle,
     const nlohmann::json& _inJson,
     HandleAssignMode _handleMode) {
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         // エンティティが見つからなかった 場合
         // 新たに登録する
         RegisterEntity(_handle);
-        entIt = entitySlotMap_.find(_handle.uuid);
+        slotIndex = FindSlotId(_handle);
     }
 
     // slotの取得
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
     if (!slot.components.empty()) {
         slot.components.clear();
     }
 
     // コンポーネントを読み込み
     for (const auto& compJson : _inJson) {
+        if (!CanAddComponent(slot)) {
+            break;
+        }
         ComponentType comp         = compJson.get<ComponentType>();
         ComponentHandle compHandle = ComponentHandle();
         if (_handleMode == HandleAssignMode::UseSaved && compJson.contains("Handle")) {
             compJson["Handle"].get_to<ComponentHandle>(compHandle);
+            UuidGenerator::NotifyLoaded(compHandle.uuid);
         } else {
-            compHandle = ComponentHandle(UuidGenerator::RandomGenerate());
+            compHandle = ComponentHandle(UuidGenerator::Generate());
         }
         comp.SetHandle(compHandle);
 
         slot.components.emplace_back(comp);
 
-        componentLocationMap_[comp.GetHandle().uuid] =
-            {slotIndex, static_cast<uint32_t>(slot.components.size() - 1)};
+        UpdateComponentLocation(slotIndex, static_cast<uint32_t>(slot.components.size() - 1));
     }
+    RecordComponentPresence(_handle, !slot.components.empty());
 }
 
 template <IsComponent ComponentType>
 inline ComponentType* ComponentArray<ComponentType>::GetComponent(ComponentHandle _handle) {
-    auto itr = componentLocationMap_.find(_handle.uuid);
-    if (itr == componentLocationMap_.end()) {
+    ComponentLocation location{};
+    if (!FindComponentLocation(_handle, location)) {
         return nullptr;
     }
 
-    auto [slotIndex, compIndex] = itr->second;
-    return &slots_[slotIndex].components[compIndex];
+    return &slots_[location.entitySlot].components[location.componentIndex];
 }
 
 template <IsComponent ComponentType>
 inline ComponentType* ComponentArray<ComponentType>::GetComponent(const EntityHandle& _handle, uint32_t _compIndex) {
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         return nullptr;
     }
 
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
     if (_compIndex < 0 || static_cast<size_t>(_compIndex) >= slot.components.size()) {
         return nullptr;
     }
@@ -382,15 +409,14 @@ inline ComponentType* ComponentArray<ComponentType>::GetComponent(const EntityHa
 }
 
 template <IsComponent ComponentType>
-inline std::vector<ComponentType>& ComponentArray<ComponentType>::GetComponents(const EntityHandle& _handle) {
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
-        static std::vector<ComponentType> emptyComponents;
+inline typename ComponentArray<ComponentType>::ComponentListType& ComponentArray<ComponentType>::GetComponents(const EntityHandle& _handle) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
+        static ComponentListType emptyComponents;
         return emptyComponents;
     }
 
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
 
     return slot.components;
 }
@@ -407,14 +433,13 @@ inline IComponent* ComponentArray<ComponentType>::GetIComponent(const EntityHand
 
 template <IsComponent ComponentType>
 inline std::vector<IComponent*> ComponentArray<ComponentType>::GetIComponents(const EntityHandle& _handle) {
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         static std::vector<IComponent*> emptyIComponents;
         return emptyIComponents;
     }
 
-    uint32_t slotIndex = entIt->second;
-    EntitySlot& slot   = slots_[slotIndex];
+    EntitySlot& slot = slots_[slotIndex];
 
     // 戻り値はstatic配列を使い回すため、次の呼び出しまでの間のみ有効
     static std::vector<IComponent*> iComponents;
@@ -427,14 +452,72 @@ inline std::vector<IComponent*> ComponentArray<ComponentType>::GetIComponents(co
 
 template <IsComponent ComponentType>
 inline uint32_t ComponentArray<ComponentType>::GetComponentCount(const EntityHandle& _handle) const {
-    auto entIt = entitySlotMap_.find(_handle.uuid);
-    if (entIt == entitySlotMap_.end()) {
+    uint32_t slotIndex = FindSlotId(_handle);
+    if (slotIndex == DenseSlotMap<EntitySlot>::kInvalidId) {
         return 0;
     }
 
-    uint32_t slotIndex     = entIt->second;
     const EntitySlot& slot = slots_[slotIndex];
     return static_cast<uint32_t>(slot.components.size());
 }
 
+template <IsComponent ComponentType>
+inline uint32_t ComponentArray<ComponentType>::FindSlotId(const EntityHandle& _entity) const {
+    if (_entity.HasRuntimeIndex() && _entity.index < entityIndexToSlot_.size()) {
+        uint32_t slotId = entityIndexToSlot_[_entity.index];
+        // index が別Entityに再利用されていないかを世代番号で確認し,
+        // index / generation だけ一致する別Entityの Handle を取り違えないよう uuid も比較する
+        if (slots_.IsValid(slotId)) {
+            const EntityHandle& owner = slots_[slotId].owner;
+            if (owner.generation == _entity.generation && owner.uuid == _entity.uuid) {
+                return slotId;
+            }
+        }
+    }
+
+    auto itr = entitySlotMap_.find(_entity.uuid);
+    if (itr == entitySlotMap_.end()) {
+        return DenseSlotMap<EntitySlot>::kInvalidId;
+    }
+    return itr->second;
+}
+
+template <IsComponent ComponentType>
+inline bool ComponentArray<ComponentType>::FindComponentLocation(const ComponentHandle& _handle, ComponentLocation& _outLocation) const {
+    if (_handle.HasLocationHint() && slots_.IsValid(_handle.entitySlot)) {
+        const auto& components = slots_[_handle.entitySlot].components;
+        // 挿入/削除でずれている可能性があるため, 指している先のuuidが一致する場合のみ採用する
+        if (_handle.componentIndex < components.size() && components[_handle.componentIndex].GetHandle().uuid == _handle.uuid) {
+            _outLocation = {_handle.entitySlot, _handle.componentIndex};
+            return true;
+        }
+    }
+
+    auto itr = componentLocationMap_.find(_handle.uuid);
+    if (itr == componentLocationMap_.end()) {
+        return false;
+    }
+    _outLocation = itr->second;
+    return true;
+}
+
+template <IsComponent ComponentType>
+inline void ComponentArray<ComponentType>::UpdateComponentLocation(uint32_t _slotId, uint32_t _compIndex) {
+    ComponentType& comp = slots_[_slotId].components[_compIndex];
+    ComponentHandle handle(comp.GetHandle().uuid, _slotId, _compIndex);
+    comp.SetHandle(handle);
+    componentLocationMap_[handle.uuid] = {_slotId, _compIndex};
+}
+
+template <IsComponent ComponentType>
+inline bool ComponentArray<ComponentType>::CanAddComponent(const EntitySlot& _slot) const {
+    if constexpr (kSingleInstance) {
+        if (!_slot.components.empty()) {
+            LOG_WARN("{} is single instance. Entity {} already has one.", nameof<ComponentType>(), uuids::to_string(_slot.owner.uuid));
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace OriGine
@@ -1,5 +1,8 @@
 #pragma once
 
+/// stl
+#include <cstdint>
+
 /// externals
 #include "nlohmann/json.hpp"
 #include "uuid/uuid.h"
@@ -9,15 +12,22 @@ namespace OriGine {
 /// <summary>
 /// Componentを一意に識別するためのハンドル。
 /// 内部的にはuuidをラップし、Component検索・保存/復元のキーとして使用する。
+/// entitySlot / componentIndex は実行時の位置ヒントで、一致しなければ uuid で検索し直す。
 /// </summary>
 struct ComponentHandle {
     friend void to_json(nlohmann::json& _j, const ComponentHandle& _c);
     friend void from_json(const nlohmann::json& _j, ComponentHandle& _c);
 
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFF; // 位置ヒント未設定を表す値
+
     ComponentHandle() : uuid() {}
     ComponentHandle(const uuids::uuid& _uuid) : uuid(_uuid) {}
+    ComponentHandle(const uuids::uuid& _uuid, uint32_t _entitySlot, uint32_t _componentIndex)
+        : uuid(_uuid), entitySlot(_entitySlot), componentIndex(_componentIndex) {}
 
     uuids::uuid uuid; // このHandleが指すComponentの一意なID
+    uint32_t entitySlot     = kInvalidIndex; // 所属するEntitySlotの安定ID (実行時のみ, 保存しない)
+    uint32_t componentIndex = kInvalidIndex; // EntitySlot内でのインデックス (実行時のみ, 保存しない)
     bool operator==(const ComponentHandle& _other) const {
         return uuid == _other.uuid;
     }
@@ -31,6 +41,13 @@ struct ComponentHandle {
     bool IsValid() const {
         return !uuid.is_nil();
     }
+
+    /// <summary>
+    /// 実行時の位置ヒントを持っているか
+    /// </summary>
+    bool HasLocationHint() const {
+        return entitySlot != kInvalidIndex;
+    }
 };
 
 } // namespace OriGine
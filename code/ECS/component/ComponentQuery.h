@@ -0,0 +1,176 @@
+#pragma once
+
+/// stl
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// ECS
+// entity
+#include "entity/EntityHandle.h"
+// component
+#include "ComponentArray.h"
+
+namespace OriGine {
+
+/// <summary>
+/// 複数のComponent型をすべて持つEntityを列挙するクエリ.
+/// 参加するComponentArrayのうち最も小さいものの DenseSlotMap を走査し,
+/// 残りの型は EntityHandle の実行時インデックスで引く (uuid のハッシュ検索を行わない).
+/// </summary>
+/// <remarks>
+/// 走査中に対象のComponentArrayへComponentを追加/削除してはならない (格納先の再確保で参照が無効になる).
+/// </remarks>
+/// <typeparam name="ComponentTypes">対象のComponent型</typeparam>
+template <IsComponent... ComponentTypes>
+class ComponentQuery {
+    static_assert(sizeof...(ComponentTypes) > 0, "ComponentQuery requires at least one component type");
+
+public:
+    ComponentQuery(ComponentArray<ComponentTypes>*... _arrays)
+        : arrays_(_arrays...) {}
+
+    /// <summary>
+    /// 全ての型を持つEntityごとに, 各型の先頭のComponentを渡して呼び出す
+    /// </summary>
+    /// <param name="_func">void(const EntityHandle&, ComponentTypes&...)</param>
+    template <typename Func>
+    void ForEach(Func&& _func) {
+        ForEach(0, UINT32_MAX, std::forward<Func>(_func));
+    }
+    /// <summary>
+    /// 走査元の [_begin, _end) 番目のスロットだけを対象に ForEach を行う.
+    /// 範囲ごとに別スレッドから呼び出せる (JobSystem::ParallelFor 等で GetDriveSize() を分割する).
+    /// </summary>
+    /// <param name="_begin">開始位置</param>
+    /// <param name="_end">終了位置 (GetDriveSize() を超える分は無視する)</param>
+    /// <param name="_func">void(const EntityHandle&, ComponentTypes&...)</param>
+    template <typename Func>
+    void ForEach(uint32_t _begin, uint32_t _end, Func&& _func) {
+        DispatchByDriver([&]<size_t DriverIndex>() {
+            DriveSingle<DriverIndex>(_begin, _end, _func, std::index_sequence_for<ComponentTypes...>{});
+        });
+    }
+
+    /// <summary>
+    /// 全ての型を持つEntityごとに, 各型のComponent配列を渡して呼び出す (同種のComponentを複数持つ型向け)
+    /// </summary>
+    /// <param name="_func">void(const EntityHandle&, ComponentList<ComponentTypes>&...)</param>
+    template <typename Func>
+    void ForEachAll(Func&& _func) {
+        ForEachAll(0, UINT32_MAX, std::forward<Func>(_func));
+    }
+    /// <summary>
+    /// 走査元の [_begin, _end) 番目のスロットだけを対象に ForEachAll を行う
+    /// </summary>
+    /// <param name="_begin">開始位置</param>
+    /// <param name="_end">終了位置 (GetDriveSize() を超える分は無視する)</param>
+    /// <param name="_func">void(const EntityHandle&, ComponentList<ComponentTypes>&...)</param>
+    template <typename Func>
+    void ForEachAll(uint32_t _begin, uint32_t _end, Func&& _func) {
+        DispatchByDriver([&]<size_t DriverIndex>() {
+            DriveAll<DriverIndex>(_begin, _end, _func, std::index_sequence_for<ComponentTypes...>{});
+        });
+    }
+
+    /// <summary>
+    /// 走査元のスロット数 (範囲指定版 ForEach / ForEachAll の上限)
+    /// </summary>
+    uint32_t GetDriveSize() const {
+        if (!IsValid()) {
+            return 0;
+        }
+        size_t driveSize = SIZE_MAX;
+        std::apply([&](auto*... _arrays) { ((driveSize = (std::min)(driveSize, _arrays->GetSlots().Size())), ...); }, arrays_);
+        return static_cast<uint32_t>(driveSize);
+    }
+
+    /// <summary>
+    /// 参加するComponentArrayが全て有効か (一つでも未登録なら列挙結果は常に空)
+    /// </summary>
+    bool IsValid() const {
+        return std::apply([](auto*... _arrays) { return ((_arrays != nullptr) && ...); }, arrays_);
+    }
+
+private:
+    /// <summary>
+    /// 最もEntity数の少ないComponentArrayを走査元として _drive<Index>() を呼び出す
+    /// </summary>
+    template <typename DriveFunc>
+    void DispatchByDriver(DriveFunc&& _drive) {
+        if (!IsValid()) {
+            return;
+        }
+
+        size_t driverIndex = 0;
+        size_t driverSize  = SIZE_MAX;
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+            ((std::get<Is>(arrays_)->GetSlots().Size() < driverSize
+                     ? (driverIndex = Is, driverSize = std::get<Is>(arrays_)->GetSlots().Size())
+                     : 0),
+                ...);
+        }(std::index_sequence_for<ComponentTypes...>{});
+
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+            ((driverIndex == Is ? (_drive.template operator()<Is>(), true) : false) || ...);
+        }(std::index_sequence_for<ComponentTypes...>{});
+    }
+
+    /// <summary>
+    /// 走査元のSlotから I 番目の型のComponent配列を取得する
+    /// </summary>
+    template <size_t I, size_t DriverIndex, typename DriverSlot>
+    auto* ResolveComponents(DriverSlot& _driverSlot) {
+        if constexpr (I == DriverIndex) {
+            return &_driverSlot.components;
+        } else {
+            using ComponentType = std::tuple_element_t<I, std::tuple<ComponentTypes...>>;
+            ComponentList<ComponentType>& components = std::get<I>(arrays_)->GetComponents(_driverSlot.owner);
+            return components.empty() ? nullptr : &components;
+        }
+    }
+
+    template <size_t DriverIndex, typename Func, size_t... Is>
+    void DriveSingle(uint32_t _begin, uint32_t _end, Func& _func, std::index_sequence<Is...>) {
+        auto& slots        = std::get<DriverIndex>(arrays_)->GetSlotsRef();
+        const size_t first = (std::min)(static_cast<size_t>(_begin), slots.Size());
+        const size_t last  = (std::min)(static_cast<size_t>(_end), slots.Size());
+        for (auto itr = slots.begin() + first; itr != slots.begin() + last; ++itr) {
+            auto& slot = *itr;
+            if (slot.components.empty()) {
+                continue;
+            }
+            auto components = std::make_tuple(ResolveComponents<Is, DriverIndex>(slot)...);
+            if (!((std::get<Is>(components) != nullptr) && ...)) {
+                continue;
+            }
+            _func(static_cast<const EntityHandle&>(slot.owner), std::get<Is>(components)->front()...);
+        }
+    }
+
+    template <size_t DriverIndex, typename Func, size_t... Is>
+    void DriveAll(uint32_t _begin, uint32_t _end, Func& _func, std::index_sequence<Is...>) {
+        auto& slots        = std::get<DriverIndex>(arrays_)->GetSlotsRef();
+        const size_t first = (std::min)(static_cast<size_t>(_begin), slots.Size());
+        const size_t last  = (std::min)(static_cast<size_t>(_end), slots.Size());
+        for (auto itr = slots.begin() + first; itr != slots.begin() + last; ++itr) {
+            auto& slot = *itr;
+            if (slot.components.empty()) {
+                continue;
+            }
+            auto components = std::make_tuple(ResolveComponents<Is, DriverIndex>(slot)...);
+            if (!((std::get<Is>(components) != nullptr) && ...)) {
+                continue;
+            }
+            _func(static_cast<const EntityHandle&>(slot.owner), *std::get<Is>(components)...);
+        }
+    }
+
+private:
+    std::tuple<ComponentArray<ComponentTypes>*...> arrays_; // 参加するComponentArray
+};
+
+} // namespace OriGine
@@ -1,5 +1,6 @@
 #pragma once
 #include "ComponentArray.h"
+#include "ComponentTypeId.h"
 
 namespace OriGine {
 
@@ -79,6 +80,8 @@ void ComponentRegistry::RegisterComponent(
         LOG_WARN("ComponentRegistry: ComponentArray already registered for type: {}", typeName);
     }
     cloneMaker_[typeName] = _makeCloneFunc;
+    // 登録順にComponentTypeIdを発行しておく
+    GetComponentTypeId<ComponentType>();
 
 #ifdef _DEBUG
     componentTypeNames_.push_back(typeName);
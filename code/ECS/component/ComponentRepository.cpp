@@ -17,6 +17,17 @@ void ComponentRepository::Clear() {
         componentArray->Finalize();
     }
     componentArrays_.clear();
+    componentArraysById_.clear();
+    entityTypeIndex_.Clear();
+}
+
+void ComponentRepository::BindEntityRepository(EntityRepository* _entityRepository) {
+    entityRepository_ = _entityRepository;
+    for (IComponentArray* componentArray : componentArraysById_) {
+        if (componentArray) {
+            componentArray->BindEntityRepository(entityRepository_);
+        }
+    }
 }
 
 bool ComponentRepository::RegisterComponentArray(const std::string& _compTypeName) {
@@ -29,6 +40,7 @@ bool ComponentRepository::RegisterComponentArray(const std::string& _compTypeNam
         // ComponentRegistryに登録済みのファクトリからComponentArrayの実体を複製生成する
         componentArrays_[_compTypeName] = std::move(ComponentRegistry::GetInstance()->CloneComponentArray(_compTypeName));
         componentArrays_[_compTypeName]->Initialize(1000);
+        BindComponentArrayId(ComponentTypeIdAllocator::Acquire(_compTypeName), componentArrays_[_compTypeName].get());
     } else {
         LOG_ERROR("ComponentRepository: ComponentArray not found for type: {}", _compTypeName);
         return false;
@@ -36,12 +48,21 @@ bool ComponentRepository::RegisterComponentArray(const std::string& _compTypeNam
     return true;
 }
 
+void ComponentRepository::PrepareComponentArrays(const std::vector<ComponentTypeId>& _typeIds) {
+    for (ComponentTypeId typeId : _typeIds) {
+        if (!GetComponentArray(typeId)) {
+            RegisterComponentArray(ComponentTypeIdAllocator::GetTypeName(typeId));
+        }
+    }
+}
+
 void ComponentRepository::UnregisterComponentArray(const std::string& _typeName, bool _isFinalize) {
     auto itr = componentArrays_.find(_typeName);
     if (itr != componentArrays_.end()) {
         if (_isFinalize) {
             itr->second->Finalize();
         }
+        BindComponentArrayId(ComponentTypeIdAllocator::Find(_typeName), nullptr);
         componentArrays_.erase(itr);
     }
 }
@@ -85,14 +106,74 @@ void ComponentRepository::RemoveComponent(const std::string& _compTypeName, cons
 }
 
 void ComponentRepository::RemoveEntity(const EntityHandle& _handle) {
+    // 逆引きできれば, 所有している型の配列だけを処理する
+    // (記録が空の場合は, 実行時インデックスを持たないHandleで登録された可能性があるため全走査する)
+    if (entityTypeIndex_.Take(_handle, removingTypeIds_) && !removingTypeIds_.empty()) {
+        for (ComponentTypeId typeId : removingTypeIds_) {
+            if (IComponentArray* componentArray = GetComponentArray(typeId)) {
+                componentArray->UnregisterEntity(_handle);
+            }
+        }
+        return;
+    }
+
     for (auto& [typeName, componentArray] : componentArrays_) {
-        componentArray->RemoveAllComponents(_handle);
+        componentArray->UnregisterEntity(_handle);
+    }
+}
+
+bool ComponentRepository::HasComponent(ComponentTypeId _typeId, const EntityHandle& _handle) const {
+    // 配列が登録解除されていれば, シグネチャに関わらず持っていない
+    IComponentArray* componentArray = GetComponentArray(_typeId);
+    if (!componentArray) {
+        return false;
+    }
+    if (entityRepository_) {
+        return entityRepository_->HasComponentType(_handle, _typeId);
+    }
+    return componentArray->HasEntity(_handle);
+}
+
+void ComponentRepository::GetComponentTypes(const EntityHandle& _handle, std::vector<ComponentTypeId>& _outTypeIds) const {
+    _outTypeIds.clear();
+
+    const Entity* entity = nullptr;
+    if (entityRepository_ && entityRepository_->IsAlive(_handle)) {
+        entity = entityRepository_->GetEntity(_handle);
+    }
+    if (entity) {
+        entity->ForEachComponentType([&](ComponentTypeId _typeId) {
+            if (GetComponentArray(_typeId)) {
+                _outTypeIds.push_back(_typeId);
+            }
+        });
+        return;
+    }
+
+    // シグネチャを引けない場合は全ての配列に問い合わせる
+    for (ComponentTypeId typeId = 0; typeId < static_cast<ComponentTypeId>(componentArraysById_.size()); ++typeId) {
+        if (componentArraysById_[typeId] && componentArraysById_[typeId]->HasEntity(_handle)) {
+            _outTypeIds.push_back(typeId);
+        }
     }
 }
 
 std::unordered_map<std::string, std::vector<IComponent*>> OriGine::ComponentRepository::GetAllComponentsOfEntity(const EntityHandle& _handle) {
     std::unordered_map<std::string, std::vector<IComponent*>> result;
 
+    // シグネチャを引ければ, 所有している型の配列だけを処理する
+    if (entityRepository_ && entityRepository_->IsAlive(_handle)) {
+        std::vector<ComponentTypeId> typeIds;
+        GetComponentTypes(_handle, typeIds);
+        for (ComponentTypeId typeId : typeIds) {
+            auto comps = GetComponentArray(typeId)->GetIComponents(_handle);
+            if (!comps.empty()) {
+                result[ComponentTypeIdAllocator::GetTypeName(typeId)] = comps;
+            }
+        }
+        return result;
+    }
+
     for (const auto& [typeName, componentArray] : componentArrays_) {
         if (componentArray->HasEntity(_handle)) {
             auto comps = componentArray->GetIComponents(_handle);
@@ -107,6 +188,20 @@ std::unordered_map<std::string, std::vector<IComponent*>> OriGine::ComponentRepo
     return result;
 }
 
+void ComponentRepository::BindComponentArrayId(ComponentTypeId _typeId, IComponentArray* _componentArray) {
+    if (_typeId == kInvalidComponentTypeId) {
+        return;
+    }
+    if (_typeId >= componentArraysById_.size()) {
+        componentArraysById_.resize(static_cast<size_t>(_typeId) + 1, nullptr);
+    }
+    componentArraysById_[_typeId] = _componentArray;
+    if (_componentArray) {
+        _componentArray->BindEntityTypeIndex(&entityTypeIndex_, _typeId);
+        _componentArray->BindEntityRepository(entityRepository_);
+    }
+}
+
 uint32_t ComponentRepository::GetComponentCount() const {
     return static_cast<uint32_t>(componentArrays_.size());
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "ComponentArray.h"
+#include "ComponentQuery.h"
 #include "ComponentRegistry.h"
+#include "ComponentTypeId.h"
 
 /// stl
 #include <vector>
@@ -25,6 +27,13 @@ public:
     /// </summary>
     void Clear();
 
+    /// <summary>
+    /// Componentの所有状態 (Entity のシグネチャ) を記録する EntityRepository を設定する.
+    /// 設定されていれば HasComponent / GetComponentTypes がコンポーネント配列を走査せずに答えられる.
+    /// </summary>
+    /// <param name="_entityRepository">同じシーンの EntityRepository (nullptr で解除)</param>
+    void BindEntityRepository(EntityRepository* _entityRepository);
+
     /// <summary>
     /// 指定した型のコンポーネント配列を登録する
     /// </summary>
@@ -40,6 +49,12 @@ public:
     /// <returns>登録ができた ＝ true ,できなかった = false</returns>
     bool RegisterComponentArray(const std::string& _compTypeName);
     /// <summary>
+    /// 指定した型IDのうち未登録のコンポーネント配列をまとめて登録する.
+    /// 並列に実行する処理が GetComponentArray の遅延登録でリポジトリを書き換えないよう, 事前に呼んでおく.
+    /// </summary>
+    /// <param name="_typeIds">用意するコンポーネントの型ID</param>
+    void PrepareComponentArrays(const std::vector<ComponentTypeId>& _typeIds);
+    /// <summary>
     /// 指定した型名のコンポーネント配列を登録解除する
     /// </summary>
     /// <param name="_typeName">コンポーネントの型名</param>
@@ -58,6 +73,49 @@ public:
     /// </summary>
     /// <param name="_typeName">コンポーネントの型名</param>
     IComponentArray* GetComponentArray(const std::string& _typeName);
+    /// <summary>
+    /// 指定したComponentTypeIdのコンポーネント配列を取得する (未登録なら nullptr)
+    /// </summary>
+    /// <param name="_typeId">コンポーネントの型ID</param>
+    IComponentArray* GetComponentArray(ComponentTypeId _typeId) const {
+        return _typeId < componentArraysById_.size() ? componentArraysById_[_typeId] : nullptr;
+    }
+
+    /// <summary>
+    /// 指定した型を全て持つエンティティを列挙するクエリを作成する
+    /// </summary>
+    /// <typeparam name="ComponentTypes">コンポーネントの型</typeparam>
+    /// <returns>クエリ</returns>
+    template <IsComponent... ComponentTypes>
+    ComponentQuery<ComponentTypes...> Query() {
+        return ComponentQuery<ComponentTypes...>(GetComponentArray<ComponentTypes>()...);
+    }
+
+    /// <summary>
+    /// 指定したエンティティが指定した型のコンポーネントを持っているか
+    /// </summary>
+    /// <typeparam name="ComponentType">コンポーネントの型</typeparam>
+    /// <param name="_handle">対象のエンティティ</param>
+    /// <returns>1つ以上持っていればtrue</returns>
+    template <IsComponent ComponentType>
+    bool HasComponent(const EntityHandle& _handle) const {
+        return HasComponent(GetComponentTypeId<ComponentType>(), _handle);
+    }
+    /// <summary>
+    /// 指定したエンティティが指定した型IDのコンポーネントを持っているか.
+    /// EntityRepository が設定されていれば Entity のシグネチャで O(1) に判定する.
+    /// </summary>
+    /// <param name="_typeId">コンポーネントの型ID</param>
+    /// <param name="_handle">対象のエンティティ</param>
+    /// <returns>1つ以上持っていればtrue</returns>
+    bool HasComponent(ComponentTypeId _typeId, const EntityHandle& _handle) const;
+
+    /// <summary>
+    /// 指定したエンティティが持つコンポーネントの型IDを列挙する (所有していない型の配列には触れない)
+    /// </summary>
+    /// <param name="_handle">対象のエンティティ</param>
+    /// <param name="_outTypeIds">型IDの出力先 (ComponentTypeId の昇順)</param>
+    void GetComponentTypes(const EntityHandle& _handle, std::vector<ComponentTypeId>& _outTypeIds) const;
 
     /// <summary>
     /// 指定したエンティティが持つ指定した型のコンポーネント群を取得する
@@ -66,7 +124,7 @@ public:
     /// <param name="_handle">コンポーネントを持つエンティティ</param>
     /// <returns> _handleが持つコンポーネント郡 </returns>
     template <IsComponent ComponentType>
-    std::vector<ComponentType>& GetComponents(const EntityHandle& _handle);
+    ComponentList<ComponentType>& GetComponents(const EntityHandle& _handle);
 
     /// <summary>
     /// 指定したエンティティが持つ指定した型のコンポーネントを取得する
@@ -129,7 +187,8 @@ public:
     void RemoveComponent(const EntityHandle& _handle, bool _doFinalize = true);
 
     /// <summary>
-    /// 指定したエンティティから全てのコンポーネントを削除する
+    /// 指定したエンティティから全てのコンポーネントを削除し, 各配列から登録を解除する.
+    /// 実行時インデックスを持つエンティティは, 実際に所有している型の配列だけを処理する.
     /// </summary>
     /// <param name="_handle">コンポーネントを削除されるエンティティ</param>
     void RemoveEntity(const EntityHandle& _handle);
@@ -141,11 +200,30 @@ public:
     /// <returns>first = typename, second = typeComponents </returns>
     std::unordered_map<std::string, std::vector<IComponent*>> GetAllComponentsOfEntity(const EntityHandle& _handle);
 
+private:
+    /// <summary>
+    /// ComponentTypeId の位置にコンポーネント配列を登録する
+    /// </summary>
+    void BindComponentArrayId(ComponentTypeId _typeId, IComponentArray* _componentArray);
+
 private:
     /// <summary>
     /// コンポーネントの型名をキーに持つコンポーネント配列のマップ
     /// </summary>
     std::unordered_map<std::string, std::unique_ptr<IComponentArray>> componentArrays_;
+    /// <summary>
+    /// ComponentTypeId で直接引けるコンポーネント配列 (componentArrays_ の実体を参照する)
+    /// </summary>
+    std::vector<IComponentArray*> componentArraysById_;
+    /// <summary>
+    /// Entity -> 登録されているコンポーネント配列の型ID (RemoveEntity で全配列を走査しないための逆引き)
+    /// </summary>
+    EntityReverseIndex<ComponentTypeId> entityTypeIndex_;
+    std::vector<ComponentTypeId> removingTypeIds_; // RemoveEntity の作業領域
+    /// <summary>
+    /// Entity のシグネチャの記録先 (Scene が所有する)
+    /// </summary>
+    EntityRepository* entityRepository_ = nullptr;
 
 public:
     uint32_t GetComponentCount() const;
@@ -165,6 +243,7 @@ inline bool ComponentRepository::RegisterComponentArray() {
         // ComponentRegistryに登録済みのファクトリからComponentArrayの実体を複製生成する
         componentArrays_[typeName] = std::move(ComponentRegistry::GetInstance()->CloneComponentArray<ComponentType>());
         componentArrays_[typeName]->Initialize(1000);
+        BindComponentArrayId(GetComponentTypeId<ComponentType>(), componentArrays_[typeName].get());
     } else {
         LOG_ERROR("ComponentRepository: ComponentArray not found for type: {}", typeName);
         return false;
@@ -174,25 +253,25 @@ inline bool ComponentRepository::RegisterComponentArray() {
 
 template <IsComponent ComponentType>
 inline ComponentArray<ComponentType>* ComponentRepository::GetComponentArray() {
-    std::string typeName = nameof<ComponentType>();
-    auto itr             = componentArrays_.find(typeName);
-    if (itr == componentArrays_.end()) {
-        // 未登録の場合はここで遅延登録する
-        if (RegisterComponentArray<ComponentType>()) {
-            itr = componentArrays_.find(typeName);
-        } else {
-            LOG_ERROR("ComponentRepository: ComponentArray not found for type: {}", typeName);
-            return nullptr;
-        }
+    // 型IDで直接引く (文字列の生成/ハッシュを行わない)
+    ComponentTypeId typeId = GetComponentTypeId<ComponentType>();
+    if (typeId < componentArraysById_.size() && componentArraysById_[typeId]) {
+        return static_cast<ComponentArray<ComponentType>*>(componentArraysById_[typeId]);
+    }
+
+    // 未登録の場合はここで遅延登録する
+    if (!RegisterComponentArray<ComponentType>()) {
+        LOG_ERROR("ComponentRepository: ComponentArray not found for type: {}", nameof<ComponentType>());
+        return nullptr;
     }
-    return reinterpret_cast<ComponentArray<ComponentType>*>(itr->second.get());
+    return static_cast<ComponentArray<ComponentType>*>(componentArraysById_[typeId]);
 }
 
 template <IsComponent ComponentType>
-inline std::vector<ComponentType>& ComponentRepository::GetComponents(const EntityHandle& _handle) {
+inline ComponentList<ComponentType>& ComponentRepository::GetComponents(const EntityHandle& _handle) {
     auto componentArray = GetComponentArray<ComponentType>();
     if (componentArray == nullptr) {
-        static std::vector<ComponentType> emptyVector;
+        static ComponentList<ComponentType> emptyVector;
         return emptyVector;
     }
     return componentArray->GetComponents(_handle);
@@ -0,0 +1,117 @@
+#pragma once
+
+/// stl
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OriGine {
+
+/// <summary>
+/// Component型ごとの格納方式を指定するトレイト.
+/// 1Entityにつき高々1つしか持たない型は特殊化して kSingleInstance = true にすると,
+/// ComponentArray が Entity ごとの std::vector を使わず, 所有Entityと同じ密配列のスロットに直接格納する.
+/// </summary>
+/// <example>
+/// template &lt;&gt;
+/// struct ComponentStorageTraits&lt;Rigidbody&gt; {
+///     static constexpr bool kSingleInstance = true;
+/// };
+/// </example>
+/// <typeparam name="ComponentType">対象のComponent型</typeparam>
+template <typename ComponentType>
+struct ComponentStorageTraits {
+    static constexpr bool kSingleInstance = false;
+};
+
+/// <summary>
+/// 単一インスタンス格納方式が選択されているか
+/// </summary>
+template <typename ComponentType>
+concept IsSingleInstanceComponent = ComponentStorageTraits<ComponentType>::kSingleInstance;
+
+/// <summary>
+/// 容量1のComponentリスト. ヒープ確保を行わず, 所有するスロット内に値を直接保持する.
+/// std::vector と同じ名前の操作を持つため, ComponentArray の処理や
+/// slot.components を走査する既存コードはそのまま動作する.
+/// </summary>
+/// <typeparam name="ComponentType">格納するComponent型</typeparam>
+template <typename ComponentType>
+class SingleComponentList {
+public:
+    using value_type     = ComponentType;
+    using iterator       = ComponentType*;
+    using const_iterator = const ComponentType*;
+
+    static constexpr uint32_t kCapacity = 1;
+
+    // ────────────────────────────────
+    //  access
+    // ────────────────────────────────
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+
+    ComponentType* data() { return value_ ? &*value_ : nullptr; }
+    const ComponentType* data() const { return value_ ? &*value_ : nullptr; }
+
+    ComponentType& operator[]([[maybe_unused]] size_t _index) {
+        assert(_index == 0 && value_);
+        return *value_;
+    }
+    const ComponentType& operator[]([[maybe_unused]] size_t _index) const {
+        assert(_index == 0 && value_);
+        return *value_;
+    }
+
+    ComponentType& front() { return *value_; }
+    const ComponentType& front() const { return *value_; }
+    ComponentType& back() { return *value_; }
+    const ComponentType& back() const { return *value_; }
+
+    size_t size() const { return value_ ? 1 : 0; }
+    bool empty() const { return !value_.has_value(); }
+    static constexpr size_t capacity() { return kCapacity; }
+
+    // ────────────────────────────────
+    //  modify (空の時のみ追加できる)
+    // ────────────────────────────────
+    template <typename... Args>
+    ComponentType& emplace_back(Args&&... _args) {
+        assert(!value_ && "SingleComponentList can hold only one component.");
+        return value_.emplace(std::forward<Args>(_args)...);
+    }
+    void push_back(const ComponentType& _comp) { emplace_back(_comp); }
+    void push_back(ComponentType&& _comp) { emplace_back(std::move(_comp)); }
+
+    iterator insert([[maybe_unused]] const_iterator _pos, ComponentType&& _comp) {
+        emplace_back(std::move(_comp));
+        return data();
+    }
+    iterator erase([[maybe_unused]] const_iterator _pos) {
+        assert(_pos == data());
+        value_.reset();
+        return end();
+    }
+
+    void clear() { value_.reset(); }
+
+private:
+    std::optional<ComponentType> value_;
+};
+
+/// <summary>
+/// Component型に応じたEntityごとのComponentリストの型.
+/// 単一インスタンス型は SingleComponentList, それ以外は std::vector.
+/// </summary>
+template <typename ComponentType>
+using ComponentList = std::conditional_t<
+    ComponentStorageTraits<ComponentType>::kSingleInstance,
+    SingleComponentList<ComponentType>,
+    std::vector<ComponentType>>;
+
+} // namespace OriGine
@@ -0,0 +1,69 @@
+#include "ComponentTypeId.h"
+
+/// stl
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace OriGine;
+
+namespace {
+
+/// <summary>
+/// 発行済みIDの保持先.
+/// 静的初期化順に依存しないよう関数内staticで生成する.
+/// </summary>
+struct ComponentTypeIdStorage {
+    std::mutex mutex;
+    std::unordered_map<std::string, ComponentTypeId> nameToId; // 型名 -> ID
+    std::vector<std::string> idToName; // ID -> 型名
+};
+
+ComponentTypeIdStorage& GetStorage() {
+    static ComponentTypeIdStorage storage;
+    return storage;
+}
+
+} // namespace
+
+ComponentTypeId ComponentTypeIdAllocator::Acquire(const std::string& _typeName) {
+    auto& storage = GetStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+
+    auto itr = storage.nameToId.find(_typeName);
+    if (itr != storage.nameToId.end()) {
+        return itr->second;
+    }
+
+    ComponentTypeId typeId = static_cast<ComponentTypeId>(storage.idToName.size());
+    storage.idToName.push_back(_typeName);
+    storage.nameToId[_typeName] = typeId;
+    return typeId;
+}
+
+ComponentTypeId ComponentTypeIdAllocator::Find(const std::string& _typeName) {
+    auto& storage = GetStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+
+    auto itr = storage.nameToId.find(_typeName);
+    if (itr == storage.nameToId.end()) {
+        return kInvalidComponentTypeId;
+    }
+    return itr->second;
+}
+
+std::string ComponentTypeIdAllocator::GetTypeName(ComponentTypeId _typeId) {
+    auto& storage = GetStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+
+    if (_typeId >= storage.idToName.size()) {
+        return {};
+    }
+    return storage.idToName[_typeId];
+}
+
+uint32_t ComponentTypeIdAllocator::GetTypeCount() {
+    auto& storage = GetStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    return static_cast<uint32_t>(storage.idToName.size());
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+/// stl
+#include <cstdint>
+#include <string>
+
+/// util
+#include <util/nameof.h>
+
+namespace OriGine {
+
+/// <summary>
+/// Component型ごとに発行される連番ID (0 から詰めて発行される)
+/// </summary>
+using ComponentTypeId = uint32_t;
+
+static constexpr ComponentTypeId kInvalidComponentTypeId = 0xFFFFFFFF; // 無効なComponentTypeIdを表す値
+
+/// <summary>
+/// ComponentTypeId の発行/検索を行うクラス.
+/// IDは型名と1対1に対応するため, 型経由のアクセスと文字列経由のアクセス(エディタ/Json)で同じIDを共有する.
+/// </summary>
+class ComponentTypeIdAllocator final {
+public:
+    /// <summary>
+    /// 型名に対応するIDを取得する. 未発行なら新規に発行する.
+    /// </summary>
+    /// <param name="_typeName">Componentの型名</param>
+    /// <returns>型名に対応するID</returns>
+    static ComponentTypeId Acquire(const ::std::string& _typeName);
+
+    /// <summary>
+    /// 型名に対応するIDを検索する (発行はしない)
+    /// </summary>
+    /// <param name="_typeName">Componentの型名</param>
+    /// <returns>見つからなければ kInvalidComponentTypeId</returns>
+    static ComponentTypeId Find(const ::std::string& _typeName);
+
+    /// <summary>
+    /// IDに対応する型名を取得する
+    /// </summary>
+    /// <param name="_typeId">ComponentTypeId</param>
+    /// <returns>型名 (未発行のIDなら空文字列)</returns>
+    static ::std::string GetTypeName(ComponentTypeId _typeId);
+
+    /// <summary>
+    /// 発行済みのID数を取得する
+    /// </summary>
+    static uint32_t GetTypeCount();
+};
+
+/// <summary>
+/// Component型の ComponentTypeId を取得する.
+/// 型ごとに一度だけ型名から解決し, 以降は関数内staticの値を返す.
+/// </summary>
+/// <typeparam name="ComponentType">Componentの型</typeparam>
+/// <returns>ComponentTypeId</returns>
+template <typename ComponentType>
+inline ComponentTypeId GetComponentTypeId() {
+    static const ComponentTypeId typeId = ComponentTypeIdAllocator::Acquire(nameof<ComponentType>());
+    return typeId;
+}
+
+} // namespace OriGine
@@ -6,8 +6,11 @@
 /// ECS
 // entity
 #include "entity/EntityHandle.h"
+#include "entity/EntityRepository.h"
+#include "entity/EntityReverseIndex.h"
 // component
 #include "ComponentHandle.h"
+#include "ComponentTypeId.h"
 #include "ECS/HandleAssignMode.h"
 
 /// externals
@@ -175,6 +178,51 @@ public:
     /// <param name="_handle"></param>
     /// <returns></returns>
     virtual uint32_t GetComponentCount(const EntityHandle& _handle) const = 0;
+
+    /// <summary>
+    /// Entity登録/登録解除を記録する逆引き表を設定する (ComponentRepository が登録時に呼ぶ)
+    /// </summary>
+    /// <param name="_entityTypeIndex">Entity -> 所属する配列の型ID の逆引き表</param>
+    /// <param name="_typeId">この配列の型ID</param>
+    void BindEntityTypeIndex(EntityReverseIndex<ComponentTypeId>* _entityTypeIndex, ComponentTypeId _typeId) {
+        entityTypeIndex_ = _entityTypeIndex;
+        typeId_          = _typeId;
+    }
+    /// <summary>
+    /// Componentの所有状態 (Entity のシグネチャ) を記録する EntityRepository を設定する (ComponentRepository が呼ぶ)
+    /// </summary>
+    /// <param name="_entityRepository">記録先 (nullptr で記録しない)</param>
+    void BindEntityRepository(EntityRepository* _entityRepository) {
+        entityRepository_ = _entityRepository;
+    }
+
+protected:
+    /// <summary>
+    /// Entityのスロットが作られた/破棄されたことを逆引き表へ記録する
+    /// </summary>
+    void RecordEntityRegistered(const EntityHandle& _entity) {
+        if (entityTypeIndex_) {
+            entityTypeIndex_->Add(_entity, typeId_);
+        }
+    }
+    void RecordEntityUnregistered(const EntityHandle& _entity) {
+        if (entityTypeIndex_) {
+            entityTypeIndex_->Remove(_entity, typeId_);
+        }
+    }
+    /// <summary>
+    /// Entityがこの型のComponentを1つ以上持っているかを Entity のシグネチャへ記録する
+    /// </summary>
+    void RecordComponentPresence(const EntityHandle& _entity, bool _hasComponent) {
+        if (entityRepository_ && typeId_ != kInvalidComponentTypeId) {
+            entityRepository_->SetComponentType(_entity, typeId_, _hasComponent);
+        }
+    }
+
+private:
+    EntityReverseIndex<ComponentTypeId>* entityTypeIndex_ = nullptr;
+    ComponentTypeId typeId_                               = kInvalidComponentTypeId;
+    EntityRepository* entityRepository_                   = nullptr;
 };
 
 } // namespace OriGine
@@ -0,0 +1,91 @@
+#include "AnimationClipBinding.h"
+
+/// engine
+#include "model/Model.h"
+
+/// externals
+#include "logger/Logger.h"
+
+using namespace OriGine;
+
+void AnimationClipBinding::Bind(const Skeleton& _skeleton, const std::shared_ptr<AnimationData>& _animationData, const std::string& _clipName) {
+    Reset();
+    // 読み込めていなくても関節の数だけ並べておき, 全関節をトラック無しとして扱う
+    animationData_ = _animationData;
+    jointTracks_.resize(_skeleton.joints.size());
+    if (!_animationData) {
+        LOG_WARN("Animation '{}' is not loaded", _clipName);
+        return;
+    }
+    trackRevision_ = _animationData->trackRevision;
+
+    // 圧縮後にトラックが増減していたら圧縮したものは使わない
+    const CompressedAnimationData* compressed = _animationData->compressed.get();
+    useCompressed_                            = compressed && compressed->GetTrackRevision() == _animationData->trackRevision;
+
+    std::string missingJoints;
+    size_t missingJointCount = 0;
+    size_t boundTrackCount   = 0;
+    for (size_t i = 0; i < _skeleton.joints.size(); ++i) {
+        const Joint& joint = _skeleton.joints[i];
+
+        auto itr = _animationData->animationNodes_.find(joint.name);
+        if (itr == _animationData->animationNodes_.end()) {
+            missingJoints += (missingJointCount == 0 ? "" : ", ") + joint.name;
+            ++missingJointCount;
+            continue;
+        }
+        jointTracks_[i].node = &itr->second;
+        if (useCompressed_) {
+            jointTracks_[i].compressedTrack = compressed->GetTrackIndex(joint.name);
+        }
+        ++boundTrackCount;
+    }
+
+    if (missingJointCount > 0) {
+        LOG_WARN("Animation '{}' has no track for {} of {} joints: {}", _clipName, missingJointCount, _skeleton.joints.size(), missingJoints);
+    }
+    // ボーン以外のノード (メッシュ, ルート等) のトラックも含まれるので, 情報としてだけ出す
+    if (_animationData->animationNodes_.size() > boundTrackCount) {
+        LOG_INFO("Animation '{}' has {} tracks without a matching joint", _clipName, _animationData->animationNodes_.size() - boundTrackCount);
+    }
+}
+
+void AnimationClipBinding::Reset() {
+    animationData_ = nullptr;
+    trackRevision_ = 0;
+    useCompressed_ = false;
+    jointTracks_.clear();
+}
+
+bool AnimationClipBinding::IsBoundTo(const Skeleton& _skeleton, const std::shared_ptr<AnimationData>& _animationData) const {
+    if (animationData_ != _animationData || jointTracks_.size() != _skeleton.joints.size()) {
+        return false;
+    }
+    return !_animationData || trackRevision_ == _animationData->trackRevision;
+}
+
+void AnimationClipBinding::Prepare(float _time) {
+    if (useCompressed_) {
+        animationData_->compressed->SamplePose(_time, compressedPose_);
+    }
+}
+
+bool AnimationClipBinding::SampleJoint(size_t _jointIndex, float _time, Vec3f& _scale, Quaternion& _rotate, Vec3f& _translate) {
+    JointTrack& track = jointTracks_[_jointIndex];
+    if (!track.node) {
+        return false;
+    }
+
+    if (useCompressed_) {
+        _scale     = compressedPose_.scales[track.compressedTrack];
+        _rotate    = compressedPose_.rotates[track.compressedTrack];
+        _translate = compressedPose_.translates[track.compressedTrack];
+        return true;
+    }
+
+    _scale     = CalculateValue::Linear(track.node->scale, _time, track.scaleCursor);
+    _rotate    = CalculateValue::Linear(track.node->rotate, _time, track.rotateCursor);
+    _translate = CalculateValue::Linear(track.node->translate, _time, track.translateCursor);
+    return true;
+}
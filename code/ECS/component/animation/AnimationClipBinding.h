@@ -0,0 +1,83 @@
+#pragma once
+
+/// stl
+#include <memory>
+#include <string>
+#include <vector>
+
+/// engine
+#include "AnimationData.h"
+#include "CompressedAnimationData.h"
+
+namespace OriGine {
+/// 前方宣言
+struct Skeleton;
+
+/// <summary>
+/// AnimationData のトラックを Skeleton の関節の順に並べたもの.
+/// 関節名でのトラックの検索は Bind で1度だけ行い, 毎フレームのサンプリングは関節の添字で引く.
+/// AnimationData が圧縮されていれば, 圧縮したトラックからサンプリングする.
+/// </summary>
+class AnimationClipBinding {
+public:
+    /// <summary>
+    /// 1つの関節に対応するトラックと, そのサンプリング位置
+    /// </summary>
+    struct JointTrack {
+        const ModelAnimationNode* node = nullptr; // 対応するトラック. 無ければ nullptr
+        int32_t compressedTrack        = -1; // CompressedAnimationData のトラック番号 (圧縮したものを使うときだけ)
+
+        KeyframeCursor scaleCursor;
+        KeyframeCursor rotateCursor;
+        KeyframeCursor translateCursor;
+    };
+
+public:
+    AnimationClipBinding()  = default;
+    ~AnimationClipBinding() = default;
+
+    /// <summary>
+    /// _animationData のトラックを _skeleton の関節に対応付ける.
+    /// トラックの無い関節, 関節の無いトラックはここで1度だけ報告する.
+    /// </summary>
+    /// <param name="_skeleton">対応付ける Skeleton</param>
+    /// <param name="_animationData">対応付けるアニメーション</param>
+    /// <param name="_clipName">ログに出すアニメーション名</param>
+    void Bind(const Skeleton& _skeleton, const std::shared_ptr<AnimationData>& _animationData, const std::string& _clipName);
+
+    /// <summary>
+    /// 対応付けを破棄する (Skeleton を差し替えたときに呼ぶ)
+    /// </summary>
+    void Reset();
+
+    /// <summary>
+    /// _skeleton と _animationData の組に対応付け済みか
+    /// </summary>
+    bool IsBoundTo(const Skeleton& _skeleton, const std::shared_ptr<AnimationData>& _animationData) const;
+
+    /// <summary>
+    /// _time の姿勢のサンプリングを始める. 圧縮したものを使うときはここで全トラックをまとめて展開する
+    /// </summary>
+    void Prepare(float _time);
+
+    /// <summary>
+    /// 関節 _jointIndex の値をサンプリングする. トラックが無ければ何もせず false を返す.
+    /// 圧縮したものを使うときは, 直前の Prepare の時刻の値になる.
+    /// </summary>
+    bool SampleJoint(size_t _jointIndex, float _time, Vec3f& _scale, Quaternion& _rotate, Vec3f& _translate);
+
+private:
+    std::shared_ptr<AnimationData> animationData_ = nullptr; // 対応付けたアニメーション (node のポインタを有効に保つため所有する)
+    uint32_t trackRevision_                       = 0; // 対応付けたときの AnimationData::trackRevision
+    bool useCompressed_                           = false; // animationData_->compressed からサンプリングするか
+
+    std::vector<JointTrack> jointTracks_; // size = skeleton.joints.size()
+    AnimationPose compressedPose_; // Prepare で展開した全トラックの値
+
+public:
+    bool IsUsingCompressed() const { return useCompressed_; }
+    const std::vector<JointTrack>& GetJointTracks() const { return jointTracks_; }
+    std::vector<JointTrack>& GetJointTracksRef() { return jointTracks_; }
+};
+
+} // namespace OriGine
@@ -1,8 +1,11 @@
 #pragma once
 
 /// stl
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 /// math
 #include <Quaternion.h>
@@ -11,6 +14,8 @@
 #include <Vector4.h>
 
 namespace OriGine {
+/// 前方宣言
+class CompressedAnimationData;
 
 /// <summary>
 /// 時間と紐づけられた値を表すクラス
@@ -35,6 +40,16 @@ using KeyframeQuaternion = Keyframe<Quaternion>;
 template <typename T>
 using AnimationCurve = std::vector<Keyframe<T>>;
 
+/// <summary>
+/// 直前に使ったキーフレームの区間を覚えておくカーソル (トラックごとに1つ持つ).
+/// 時刻が前に進む再生では次の検索をその区間から始めるので, ほとんどのサンプルが O(1) になる.
+/// </summary>
+struct KeyframeCursor {
+    size_t segment = 0; // 直前に使った区間の先頭キーフレームの添字
+
+    void Reset() { segment = 0; }
+};
+
 /// <summary>
 /// 各軸ごとに分離されたアニメーション曲線データ
 /// </summary>
@@ -117,6 +132,13 @@ struct AnimationData {
 
     float duration = 0.0f;
     std::unordered_map<std::string, ModelAnimationNode> animationNodes_;
+
+    // animationNodes_ にトラックを追加, 削除したり, キーフレームを編集したら増やす.
+    // 関節への対応付け (AnimationClipBinding) の作り直しと, 圧縮データ (compressed) が古くなったことの判定に使う
+    uint32_t trackRevision = 0;
+
+    // animationNodes_ を圧縮したもの (AnimationManager::SetCompressOnLoad で読み込み時に作る). 無ければ nullptr
+    std::shared_ptr<const CompressedAnimationData> compressed = nullptr;
 };
 
 namespace CalculateValue {
@@ -165,7 +187,53 @@ struct DefaultValueTraits<float> {
 };
 
 /// <summary>
-/// 線形補間でキーフレーム値を計算
+/// カーソルの区間から前へ線形に探す区間数 (これで見つからなければ二分探索する)
+/// </summary>
+static constexpr size_t kCursorForwardSearchCount = 4;
+
+/// <summary>
+/// _time を含む区間の先頭キーフレームの添字を二分探索で求める.
+/// _keyframes[index].time < _time <= _keyframes[index + 1].time となる最初の index を返す.
+/// </summary>
+/// <param name="_keyframes">時刻の昇順に並んだ2つ以上のキーフレーム</param>
+/// <param name="_time">_keyframes.front().time < _time <= _keyframes.back().time の時刻</param>
+template <typename T>
+size_t FindSegment(const std::vector<Keyframe<T>>& _keyframes, float _time) {
+    auto itr = std::lower_bound(_keyframes.begin() + 1, _keyframes.end(), _time, [](const Keyframe<T>& _keyframe, float _t) {
+        return _keyframe.time < _t;
+    });
+    if (itr == _keyframes.end()) {
+        return _keyframes.size() - 2;
+    }
+    return static_cast<size_t>(itr - _keyframes.begin()) - 1;
+}
+
+/// <summary>
+/// _time を含む区間の先頭キーフレームの添字をカーソルの区間から求め, カーソルを更新する.
+/// 結果は FindSegment(_keyframes, _time) と同じ.
+/// </summary>
+template <typename T>
+size_t FindSegment(const std::vector<Keyframe<T>>& _keyframes, float _time, KeyframeCursor& _cursor) {
+    const size_t lastSegment = _keyframes.size() - 2;
+
+    // 時刻が前に進んでいれば, 直前の区間かその少し先にある
+    size_t segment = _cursor.segment;
+    for (size_t i = 0; i < kCursorForwardSearchCount && segment <= lastSegment; ++i, ++segment) {
+        if (_time <= _keyframes[segment].time) {
+            break; // 直前の区間より前 (ループや巻き戻し)
+        }
+        if (_time <= _keyframes[segment + 1].time) {
+            _cursor.segment = segment;
+            return segment;
+        }
+    }
+
+    _cursor.segment = FindSegment(_keyframes, _time);
+    return _cursor.segment;
+}
+
+/// <summary>
+/// 線形補間でキーフレーム値を計算 (区間は二分探索で求める)
 /// </summary>
 template <typename T>
 T Linear(const std::vector<Keyframe<T>>& _keyframes, float _time) {
@@ -176,22 +244,43 @@ T Linear(const std::vector<Keyframe<T>>& _keyframes, float _time) {
     if (_keyframes.size() == 1 || _time <= _keyframes[0].time) {
         return _keyframes[0].value;
     }
+    // 登録されている時間より 後ろ (NaN を含む) -> 最後の値を返す
+    if (!(_time <= _keyframes.back().time)) {
+        return _keyframes.back().value;
+    }
 
-    for (size_t index = 0; index < _keyframes.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        // index と nextIndex の 2つを取得して 現時刻が 範囲内か
-        if (_keyframes[index].time <= _time && _time <= _keyframes[nextIndex].time) {
-            // 範囲内 で 補間
-            float t = (_time - _keyframes[index].time) / (_keyframes[nextIndex].time - _keyframes[index].time);
-            return InterpolationTraits<T>::Interpolate(_keyframes[index].value, _keyframes[nextIndex].value, t);
-        }
+    size_t index     = FindSegment(_keyframes, _time);
+    size_t nextIndex = index + 1;
+    float t          = (_time - _keyframes[index].time) / (_keyframes[nextIndex].time - _keyframes[index].time);
+    return InterpolationTraits<T>::Interpolate(_keyframes[index].value, _keyframes[nextIndex].value, t);
+}
+
+/// <summary>
+/// 線形補間でキーフレーム値を計算 (区間はカーソルから求める. 結果はカーソル無しと同じ)
+/// </summary>
+template <typename T>
+T Linear(const std::vector<Keyframe<T>>& _keyframes, float _time, KeyframeCursor& _cursor) {
+    // 例外処理
+    if (_keyframes.empty()) {
+        return DefaultValueTraits<T>::Default();
     }
-    // 登録されている時間より 後ろ -> 最後の値を返す
-    return _keyframes.back().value;
+    if (_keyframes.size() == 1 || _time <= _keyframes[0].time) {
+        _cursor.segment = 0;
+        return _keyframes[0].value;
+    }
+    // 登録されている時間より 後ろ (NaN を含む) -> 最後の値を返す
+    if (!(_time <= _keyframes.back().time)) {
+        return _keyframes.back().value;
+    }
+
+    size_t index     = FindSegment(_keyframes, _time, _cursor);
+    size_t nextIndex = index + 1;
+    float t          = (_time - _keyframes[index].time) / (_keyframes[nextIndex].time - _keyframes[index].time);
+    return InterpolationTraits<T>::Interpolate(_keyframes[index].value, _keyframes[nextIndex].value, t);
 }
 
 /// <summary>
-/// ステップ補間でキーフレーム値を計算（補間なし）
+/// ステップ補間でキーフレーム値を計算（補間なし. 区間は二分探索で求める）
 /// </summary>
 template <typename T>
 T Step(const std::vector<Keyframe<T>>& _keyframes, float _time) {
@@ -202,16 +291,33 @@ T Step(const std::vector<Keyframe<T>>& _keyframes, float _time) {
     if (_keyframes.size() == 1 || _time <= _keyframes[0].time) {
         return _keyframes[0].value;
     }
+    // 登録されている時間より 後ろ (NaN を含む) -> 最後の値を返す
+    if (!(_time <= _keyframes.back().time)) {
+        return _keyframes.back().value;
+    }
 
-    for (size_t index = 0; index < _keyframes.size() - 1; ++index) {
-        size_t nextIndex = index + 1;
-        // index と nextIndex の 2つを取得して 現時刻が 範囲内か
-        if (_keyframes[index].time <= _time && _time <= _keyframes[nextIndex].time) {
-            return _keyframes[index].value;
-        }
+    return _keyframes[FindSegment(_keyframes, _time)].value;
+}
+
+/// <summary>
+/// ステップ補間でキーフレーム値を計算（補間なし. 区間はカーソルから求める. 結果はカーソル無しと同じ）
+/// </summary>
+template <typename T>
+T Step(const std::vector<Keyframe<T>>& _keyframes, float _time, KeyframeCursor& _cursor) {
+    // 例外処理
+    if (_keyframes.empty()) {
+        return DefaultValueTraits<T>::Default();
+    }
+    if (_keyframes.size() == 1 || _time <= _keyframes[0].time) {
+        _cursor.segment = 0;
+        return _keyframes[0].value;
+    }
+    // 登録されている時間より 後ろ (NaN を含む) -> 最後の値を返す
+    if (!(_time <= _keyframes.back().time)) {
+        return _keyframes.back().value;
     }
-    // 登録されている時間より 後ろ -> 最後の値を返す
-    return _keyframes.back().value;
+
+    return _keyframes[FindSegment(_keyframes, _time, _cursor)].value;
 }
 
 } // namespace CalculateValue
@@ -6,6 +6,7 @@
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include "logger/Logger.h"
 
 using namespace OriGine;
 
@@ -207,6 +208,11 @@ void AnimationManager::SaveAnimation(const std::string& _directory, const std::s
     }
 }
 
+void AnimationManager::SetCompressOnLoad(bool _enable, const AnimationCompressionSettings& _settings) {
+    compressOnLoad_      = _enable;
+    compressionSettings_ = _settings;
+}
+
 int AnimationManager::addAnimationData(const std::string& _name, std::unique_ptr<AnimationData> _animationData) {
     auto animationIndex = animationDataLibrary_.find(_name);
     if (animationIndex != animationDataLibrary_.end()) {
@@ -226,5 +232,22 @@ const AnimationData* AnimationManager::GetAnimationData(const std::string& _name
 }
 
 void AnimationManager::AnimationLoadTask::Update() const {
-    *animationData = AnimationManager::GetInstance()->LoadAnimationData(directory, filename);
+    AnimationManager* manager = AnimationManager::GetInstance();
+    *animationData            = manager->LoadAnimationData(directory, filename);
+
+    // Assimp から読み込んだものだけ圧縮する (.anm はエディタで編集するため)
+    if (!manager->compressOnLoad_ || filename.find(".gltf") == std::string::npos) {
+        return;
+    }
+    auto compressed = std::make_shared<CompressedAnimationData>(CompressedAnimationData::Compress(*animationData, manager->compressionSettings_));
+
+    AnimationCompressionReport report = compressed->Measure(*animationData);
+    LOG_INFO(
+        "Compressed animation {}/{}: {} tracks, {} frames, animated S/R/T {}/{}/{}, {} -> {} bytes, max error S {} R {} rad T {}",
+        directory, filename, report.trackCount, report.frameCount,
+        report.animatedScaleCount, report.animatedRotateCount, report.animatedTranslateCount,
+        report.sourceBytes, report.compressedBytes,
+        report.maxScaleError, report.maxRotateError, report.maxTranslateError);
+
+    animationData->compressed = std::move(compressed);
 }
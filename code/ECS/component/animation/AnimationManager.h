@@ -7,6 +7,7 @@
 #include <vector>
 
 /// engine
+#include "CompressedAnimationData.h"
 #include "model/Model.h"
 #include "ModelNodeAnimation.h"
 
@@ -44,6 +45,14 @@ public:
 
     int addAnimationData(const std::string& _name, std::unique_ptr<AnimationData> _animationData);
 
+    /// <summary>
+    /// gltf (Assimp) から読み込んだアニメーションを読み込み時に圧縮するか.
+    /// 圧縮したものは AnimationData::compressed に持たせ, 元のキーフレームも残す. 既に読み込んだものには影響しない
+    /// </summary>
+    /// <param name="_enable">圧縮するか</param>
+    /// <param name="_settings">圧縮の設定</param>
+    void SetCompressOnLoad(bool _enable, const AnimationCompressionSettings& _settings = {});
+
 private:
     /// <summary>
     /// アニメーションデータの読み込み
@@ -84,6 +93,9 @@ private:
     std::unordered_map<std::string, int> animationDataLibrary_;
     std::vector<std::shared_ptr<AnimationData>> animationData_;
 
+    bool compressOnLoad_ = false;
+    AnimationCompressionSettings compressionSettings_;
+
 public:
     const AnimationData* GetAnimationData(const std::string& _name) const;
     const AnimationData* GetAnimationData(int _index) const { return animationData_[_index].get(); }
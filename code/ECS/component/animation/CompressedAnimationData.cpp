@@ -0,0 +1,372 @@
+#include "CompressedAnimationData.h"
+
+/// stl
+#include <algorithm>
+#include <cmath>
+
+using namespace OriGine;
+
+namespace {
+
+constexpr float kSmallestThreeRange       = 0.70710678f; // 最大成分以外の成分の絶対値の上限 (1/√2)
+constexpr uint16_t kQuaternionComponentMax = (1u << 15) - 1;
+constexpr uint16_t kQuaternionIndexBit     = 1u << 15;
+constexpr float kVec3ComponentMax          = 65535.f;
+
+PackedQuaternion PackQuaternion(const Quaternion& _q) {
+    int32_t largest = 0;
+    for (int32_t i = 1; i < 4; ++i) {
+        if (std::abs(_q[i]) > std::abs(_q[largest])) {
+            largest = i;
+        }
+    }
+    // q と -q は同じ回転なので, 最大成分が正になる方を残す
+    float sign = _q[largest] < 0.f ? -1.f : 1.f;
+
+    PackedQuaternion packed;
+    int32_t component = 0;
+    for (int32_t i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        float normalized      = std::clamp(_q[i] * sign / kSmallestThreeRange * 0.5f + 0.5f, 0.f, 1.f);
+        packed.v[component++] = static_cast<uint16_t>(std::lround(normalized * kQuaternionComponentMax));
+    }
+    packed.v[0] |= (largest & 2) ? kQuaternionIndexBit : 0;
+    packed.v[1] |= (largest & 1) ? kQuaternionIndexBit : 0;
+    return packed;
+}
+
+Quaternion UnpackQuaternion(const PackedQuaternion& _packed) {
+    int32_t largest = ((_packed.v[0] & kQuaternionIndexBit) ? 2 : 0) | ((_packed.v[1] & kQuaternionIndexBit) ? 1 : 0);
+
+    Quaternion q;
+    float sumSq       = 0.f;
+    int32_t component = 0;
+    for (int32_t i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        float normalized = static_cast<float>(_packed.v[component++] & kQuaternionComponentMax) / kQuaternionComponentMax;
+        q[i]             = (normalized * 2.f - 1.f) * kSmallestThreeRange;
+        sumSq += q[i] * q[i];
+    }
+    q[largest] = std::sqrt((std::max)(1.f - sumSq, 0.f));
+    return q;
+}
+
+uint16_t QuantizeComponent(float _value, float _min, float _extent) {
+    if (_extent <= 0.f) {
+        return 0;
+    }
+    float normalized = std::clamp((_value - _min) / _extent, 0.f, 1.f);
+    return static_cast<uint16_t>(std::lround(normalized * kVec3ComponentMax));
+}
+
+Vec3f DequantizeVec3(const uint16_t* _quantized, const Vec3f& _min, const Vec3f& _extent) {
+    return Vec3f(
+        _min[X] + _extent[X] * (static_cast<float>(_quantized[X]) / kVec3ComponentMax),
+        _min[Y] + _extent[Y] * (static_cast<float>(_quantized[Y]) / kVec3ComponentMax),
+        _min[Z] + _extent[Z] * (static_cast<float>(_quantized[Z]) / kVec3ComponentMax));
+}
+
+/// <summary>
+/// 曲線を _frameTimes の時刻で再サンプリングする.
+/// 圧縮データの代わりになるスキニングの経路 (AnimationClipBinding) と同じく, interpolationType に関わらず Linear で求める
+/// (interpolationType は Assimp の mPreState から読み込まれ, STEP になっているトラックもある)
+/// </summary>
+template <typename T>
+void ResampleCurve(const AnimationCurve<T>& _curve, const std::vector<float>& _frameTimes, std::vector<T>& _out) {
+    KeyframeCursor cursor;
+    _out.resize(_frameTimes.size());
+    for (size_t i = 0; i < _frameTimes.size(); ++i) {
+        _out[i] = CalculateValue::Linear(_curve, _frameTimes[i], cursor);
+    }
+}
+
+/// <summary>
+/// 再サンプリングした scale / translate のトラック群を量子化する
+/// </summary>
+void BuildVec3Channel(const std::vector<std::vector<Vec3f>>& _tracks, const std::vector<size_t>& _keyCounts, float _tolerance, uint32_t _frameCount, CompressedVec3Channel& _out) {
+    _out.constantValues.resize(_tracks.size());
+    for (uint32_t track = 0; track < _tracks.size(); ++track) {
+        const std::vector<Vec3f>& samples = _tracks[track];
+        _out.constantValues[track]        = samples[0];
+
+        // キーが1つ以下なら元の値そのもの
+        bool isConstant = _keyCounts[track] <= 1;
+        if (!isConstant) {
+            isConstant = std::all_of(samples.begin(), samples.end(), [&](const Vec3f& _sample) {
+                return std::abs(_sample[X] - samples[0][X]) <= _tolerance
+                       && std::abs(_sample[Y] - samples[0][Y]) <= _tolerance
+                       && std::abs(_sample[Z] - samples[0][Z]) <= _tolerance;
+            });
+        }
+        if (isConstant) {
+            continue;
+        }
+
+        Vec3f min = samples[0];
+        Vec3f max = samples[0];
+        for (const Vec3f& sample : samples) {
+            for (int32_t axis = 0; axis < 3; ++axis) {
+                min[axis] = (std::min)(min[axis], sample[axis]);
+                max[axis] = (std::max)(max[axis], sample[axis]);
+            }
+        }
+        _out.animatedTracks.push_back(track);
+        _out.rangeMin.push_back(min);
+        _out.rangeExtent.push_back(max - min);
+    }
+
+    const size_t animatedCount = _out.animatedTracks.size();
+    _out.samples.resize(static_cast<size_t>(_frameCount) * animatedCount * 3);
+    for (size_t animated = 0; animated < animatedCount; ++animated) {
+        const std::vector<Vec3f>& samples = _tracks[_out.animatedTracks[animated]];
+        const Vec3f& min                  = _out.rangeMin[animated];
+        const Vec3f& extent               = _out.rangeExtent[animated];
+        for (uint32_t frame = 0; frame < _frameCount; ++frame) {
+            uint16_t* quantized = _out.samples.data() + (static_cast<size_t>(frame) * animatedCount + animated) * 3;
+            for (int32_t axis = 0; axis < 3; ++axis) {
+                quantized[axis] = QuantizeComponent(samples[frame][axis], min[axis], extent[axis]);
+            }
+        }
+    }
+}
+
+/// <summary>
+/// 再サンプリングした rotate のトラック群を量子化する
+/// </summary>
+void BuildQuaternionChannel(const std::vector<std::vector<Quaternion>>& _tracks, const std::vector<size_t>& _keyCounts, float _tolerance, uint32_t _frameCount, CompressedQuaternionChannel& _out) {
+    _out.constantValues.resize(_tracks.size());
+    for (uint32_t track = 0; track < _tracks.size(); ++track) {
+        const std::vector<Quaternion>& samples = _tracks[track];
+        _out.constantValues[track]             = samples[0];
+
+        // キーが1つ以下なら元の値そのもの
+        bool isConstant = _keyCounts[track] <= 1;
+        if (!isConstant) {
+            Quaternion first = Quaternion::Normalize(samples[0]);
+            isConstant       = std::all_of(samples.begin(), samples.end(), [&](const Quaternion& _sample) {
+                return 1.f - std::abs(Quaternion::Dot(first, Quaternion::Normalize(_sample))) <= _tolerance;
+            });
+        }
+        if (!isConstant) {
+            _out.animatedTracks.push_back(track);
+        }
+    }
+
+    const size_t animatedCount = _out.animatedTracks.size();
+    _out.samples.resize(static_cast<size_t>(_frameCount) * animatedCount);
+    for (size_t animated = 0; animated < animatedCount; ++animated) {
+        const std::vector<Quaternion>& samples = _tracks[_out.animatedTracks[animated]];
+        for (uint32_t frame = 0; frame < _frameCount; ++frame) {
+            _out.samples[static_cast<size_t>(frame) * animatedCount + animated] = PackQuaternion(Quaternion::Normalize(samples[frame]));
+        }
+    }
+}
+
+void SampleVec3Channel(const CompressedVec3Channel& _channel, uint32_t _frame0, uint32_t _frame1, float _t, std::vector<Vec3f>& _out) {
+    _out.assign(_channel.constantValues.begin(), _channel.constantValues.end());
+
+    const size_t animatedCount = _channel.animatedTracks.size();
+    const uint16_t* row0       = _channel.samples.data() + static_cast<size_t>(_frame0) * animatedCount * 3;
+    const uint16_t* row1       = _channel.samples.data() + static_cast<size_t>(_frame1) * animatedCount * 3;
+    for (size_t animated = 0; animated < animatedCount; ++animated) {
+        Vec3f value0 = DequantizeVec3(row0 + animated * 3, _channel.rangeMin[animated], _channel.rangeExtent[animated]);
+        Vec3f value1 = DequantizeVec3(row1 + animated * 3, _channel.rangeMin[animated], _channel.rangeExtent[animated]);
+
+        _out[_channel.animatedTracks[animated]] = Lerp(value0, value1, _t);
+    }
+}
+
+void SampleQuaternionChannel(const CompressedQuaternionChannel& _channel, uint32_t _frame0, uint32_t _frame1, float _t, std::vector<Quaternion>& _out) {
+    _out.assign(_channel.constantValues.begin(), _channel.constantValues.end());
+
+    const size_t animatedCount   = _channel.animatedTracks.size();
+    const PackedQuaternion* row0 = _channel.samples.data() + static_cast<size_t>(_frame0) * animatedCount;
+    const PackedQuaternion* row1 = _channel.samples.data() + static_cast<size_t>(_frame1) * animatedCount;
+    for (size_t animated = 0; animated < animatedCount; ++animated) {
+        Quaternion value0 = UnpackQuaternion(row0[animated]);
+        Quaternion value1 = UnpackQuaternion(row1[animated]);
+        // 符号を捨てているので, 近い側へ補間する
+        if (Quaternion::Dot(value0, value1) < 0.f) {
+            value1 = value1 * -1.f;
+        }
+        // 隣り合うフレームの間は角度が小さいので, Slerp の代わりに正規化した線形補間を使う
+        _out[_channel.animatedTracks[animated]] = Quaternion::Normalize(value0 * (1.f - _t) + value1 * _t);
+    }
+}
+
+template <typename T>
+size_t CurveBytes(const AnimationCurve<T>& _curve) {
+    return _curve.size() * sizeof(Keyframe<T>);
+}
+
+template <typename T>
+size_t VectorBytes(const std::vector<T>& _vector) {
+    return _vector.size() * sizeof(T);
+}
+
+size_t ChannelBytes(const CompressedVec3Channel& _channel) {
+    return VectorBytes(_channel.constantValues) + VectorBytes(_channel.animatedTracks)
+           + VectorBytes(_channel.rangeMin) + VectorBytes(_channel.rangeExtent) + VectorBytes(_channel.samples);
+}
+
+size_t ChannelBytes(const CompressedQuaternionChannel& _channel) {
+    return VectorBytes(_channel.constantValues) + VectorBytes(_channel.animatedTracks) + VectorBytes(_channel.samples);
+}
+
+} // namespace
+
+CompressedAnimationData CompressedAnimationData::Compress(const AnimationData& _source, const AnimationCompressionSettings& _settings) {
+    CompressedAnimationData result;
+    result.duration_      = (std::max)(_source.duration, 0.f);
+    result.sampleRate_    = _settings.sampleRate > 0.f ? _settings.sampleRate : 30.f;
+    result.trackRevision_ = _source.trackRevision;
+    // 終端 (duration) のフレームも持つ. 端数は最後の区間が短くなる
+    result.frameCount_ = static_cast<uint32_t>(std::ceil(result.duration_ * result.sampleRate_ - 1e-3f)) + 1;
+    result.frameCount_ = (std::max)(result.frameCount_, 1u);
+
+    // トラック番号はノード名の順 (unordered_map の順に依存させない)
+    result.trackNames_.reserve(_source.animationNodes_.size());
+    for (const auto& [nodeName, node] : _source.animationNodes_) {
+        result.trackNames_.push_back(nodeName);
+    }
+    std::sort(result.trackNames_.begin(), result.trackNames_.end());
+    for (uint32_t track = 0; track < result.trackNames_.size(); ++track) {
+        result.trackIndexBinder_[result.trackNames_[track]] = track;
+    }
+
+    std::vector<float> frameTimes(result.frameCount_);
+    for (uint32_t frame = 0; frame < result.frameCount_; ++frame) {
+        frameTimes[frame] = result.GetFrameTime(frame);
+    }
+
+    const size_t trackCount = result.trackNames_.size();
+    std::vector<std::vector<Vec3f>> scales(trackCount);
+    std::vector<std::vector<Quaternion>> rotates(trackCount);
+    std::vector<std::vector<Vec3f>> translates(trackCount);
+    std::vector<size_t> scaleKeyCounts(trackCount);
+    std::vector<size_t> rotateKeyCounts(trackCount);
+    std::vector<size_t> translateKeyCounts(trackCount);
+    for (size_t track = 0; track < trackCount; ++track) {
+        const ModelAnimationNode& node = _source.animationNodes_.at(result.trackNames_[track]);
+        ResampleCurve(node.scale, frameTimes, scales[track]);
+        ResampleCurve(node.rotate, frameTimes, rotates[track]);
+        ResampleCurve(node.translate, frameTimes, translates[track]);
+        scaleKeyCounts[track]     = node.scale.size();
+        rotateKeyCounts[track]    = node.rotate.size();
+        translateKeyCounts[track] = node.translate.size();
+    }
+
+    BuildVec3Channel(scales, scaleKeyCounts, _settings.constantScaleTolerance, result.frameCount_, result.scale_);
+    BuildQuaternionChannel(rotates, rotateKeyCounts, _settings.constantRotateTolerance, result.frameCount_, result.rotate_);
+    BuildVec3Channel(translates, translateKeyCounts, _settings.constantTranslateTolerance, result.frameCount_, result.translate_);
+
+    return result;
+}
+
+void CompressedAnimationData::SamplePose(float _time, AnimationPose& _out) const {
+    uint32_t frame0 = 0;
+    uint32_t frame1 = 0;
+    float t         = 0.f;
+    if (frameCount_ <= 1 || !(_time < duration_)) {
+        // 終端より後ろ (NaN を含む) -> 最後のフレーム
+        frame0 = frameCount_ > 0 ? frameCount_ - 1 : 0;
+        frame1 = frame0;
+    } else if (_time > 0.f) {
+        frame0 = (std::min)(static_cast<uint32_t>(_time * sampleRate_), frameCount_ - 2);
+        frame1 = frame0 + 1;
+
+        float time0 = GetFrameTime(frame0);
+        float time1 = GetFrameTime(frame1);
+        t           = std::clamp((_time - time0) / (time1 - time0), 0.f, 1.f);
+    }
+
+    SampleVec3Channel(scale_, frame0, frame1, t, _out.scales);
+    SampleQuaternionChannel(rotate_, frame0, frame1, t, _out.rotates);
+    SampleVec3Channel(translate_, frame0, frame1, t, _out.translates);
+}
+
+AnimationCompressionReport CompressedAnimationData::Measure(const AnimationData& _source) const {
+    AnimationCompressionReport report;
+    report.trackCount             = GetTrackCount();
+    report.frameCount             = frameCount_;
+    report.animatedScaleCount     = static_cast<uint32_t>(scale_.animatedTracks.size());
+    report.animatedRotateCount    = static_cast<uint32_t>(rotate_.animatedTracks.size());
+    report.animatedTranslateCount = static_cast<uint32_t>(translate_.animatedTracks.size());
+    report.compressedBytes        = GetMemoryBytes();
+
+    std::vector<const ModelAnimationNode*> nodes(trackNames_.size(), nullptr);
+    for (size_t track = 0; track < trackNames_.size(); ++track) {
+        auto itr = _source.animationNodes_.find(trackNames_[track]);
+        if (itr == _source.animationNodes_.end()) {
+            continue;
+        }
+        nodes[track] = &itr->second;
+        report.sourceBytes += CurveBytes(itr->second.scale) + CurveBytes(itr->second.rotate) + CurveBytes(itr->second.translate);
+    }
+
+    // フレームの間も比べるため, 再サンプリングのレートの 4 倍の時刻で比べる
+    const uint32_t compareCount = (frameCount_ - 1) * 4 + 1;
+    std::vector<KeyframeCursor> cursors(trackNames_.size() * 3);
+    AnimationPose pose;
+    double rotateErrorSum    = 0.0;
+    double translateErrorSum = 0.0;
+    size_t errorCount        = 0;
+    for (uint32_t i = 0; i < compareCount; ++i) {
+        float time = compareCount > 1 ? duration_ * static_cast<float>(i) / static_cast<float>(compareCount - 1) : 0.f;
+        SamplePose(time, pose);
+
+        for (size_t track = 0; track < nodes.size(); ++track) {
+            const ModelAnimationNode* node = nodes[track];
+            if (!node) {
+                continue;
+            }
+            // 比べる相手もスキニングと同じ Linear
+            Vec3f scale          = CalculateValue::Linear(node->scale, time, cursors[track * 3 + 0]);
+            Quaternion rotate    = CalculateValue::Linear(node->rotate, time, cursors[track * 3 + 1]);
+            Vec3f translate      = CalculateValue::Linear(node->translate, time, cursors[track * 3 + 2]);
+            float scaleError     = Vec3f(scale - pose.scales[track]).length();
+            float translateError = Vec3f(translate - pose.translates[track]).length();
+            float rotateError    = 0.f;
+            if (!node->rotate.empty()) {
+                // acos(dot) は 1 付近で精度が出ないので, 差の回転の角度を atan2 で求める
+                Quaternion diff = Quaternion::Normalize(rotate).Conjugation() * Quaternion::Normalize(pose.rotates[track]);
+                rotateError     = 2.f * std::atan2(Vec3f(diff[X], diff[Y], diff[Z]).length(), std::abs(diff[W]));
+            }
+
+            report.maxScaleError     = (std::max)(report.maxScaleError, scaleError);
+            report.maxRotateError    = (std::max)(report.maxRotateError, rotateError);
+            report.maxTranslateError = (std::max)(report.maxTranslateError, translateError);
+            rotateErrorSum += rotateError;
+            translateErrorSum += translateError;
+            ++errorCount;
+        }
+    }
+    if (errorCount > 0) {
+        report.meanRotateError    = static_cast<float>(rotateErrorSum / static_cast<double>(errorCount));
+        report.meanTranslateError = static_cast<float>(translateErrorSum / static_cast<double>(errorCount));
+    }
+    return report;
+}
+
+size_t CompressedAnimationData::GetMemoryBytes() const {
+    return ChannelBytes(scale_) + ChannelBytes(rotate_) + ChannelBytes(translate_);
+}
+
+int32_t CompressedAnimationData::GetTrackIndex(const std::string& _nodeName) const {
+    auto itr = trackIndexBinder_.find(_nodeName);
+    if (itr == trackIndexBinder_.end()) {
+        return -1;
+    }
+    return static_cast<int32_t>(itr->second);
+}
+
+float CompressedAnimationData::GetFrameTime(uint32_t _frame) const {
+    if (_frame + 1 >= frameCount_) {
+        return duration_;
+    }
+    return static_cast<float>(_frame) / sampleRate_;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+/// stl
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// engine
+#include "AnimationData.h"
+
+/// math
+#include <Quaternion.h>
+#include <Vector3.h>
+
+namespace OriGine {
+
+/// <summary>
+/// AnimationData を圧縮するときの設定
+/// </summary>
+struct AnimationCompressionSettings {
+    float sampleRate = 30.f; // 再サンプリングのレート (Hz)
+
+    // 全サンプルが最初のサンプルからこの範囲に収まるトラックは, 定数として値を1つだけ持つ
+    float constantScaleTolerance     = 1e-4f;
+    float constantRotateTolerance    = 1e-6f; // 1 - |dot| で比較する
+    float constantTranslateTolerance = 1e-4f;
+};
+
+/// <summary>
+/// 絶対値が最大の成分を除いた3成分を 15bit ずつに量子化した四元数 (smallest-three).
+/// 除いた成分の番号は v[0], v[1] の最上位ビットに入れる.
+/// </summary>
+struct PackedQuaternion {
+    uint16_t v[3] = {0, 0, 0};
+};
+
+/// <summary>
+/// scale / translate の全トラック. 動くトラックのサンプルは関節をまたいで時刻ごとに並べる (SoA)
+/// </summary>
+struct CompressedVec3Channel {
+    std::vector<Vec3f> constantValues; // トラックごとの定数値 (動くトラックではサンプリングで上書きされる)
+    std::vector<uint32_t> animatedTracks; // 動くトラックのトラック番号
+    std::vector<Vec3f> rangeMin; // 動くトラックごとの量子化範囲の最小値
+    std::vector<Vec3f> rangeExtent; // 動くトラックごとの量子化範囲の幅
+    std::vector<uint16_t> samples; // [frame][animatedTrack][xyz]
+};
+
+/// <summary>
+/// rotate の全トラック. 動くトラックのサンプルは関節をまたいで時刻ごとに並べる (SoA)
+/// </summary>
+struct CompressedQuaternionChannel {
+    std::vector<Quaternion> constantValues; // トラックごとの定数値 (動くトラックではサンプリングで上書きされる)
+    std::vector<uint32_t> animatedTracks; // 動くトラックのトラック番号
+    std::vector<PackedQuaternion> samples; // [frame][animatedTrack]
+};
+
+/// <summary>
+/// 1つの時刻の全トラックの値. CompressedAnimationData のトラック番号で引く
+/// </summary>
+struct AnimationPose {
+    std::vector<Vec3f> scales;
+    std::vector<Quaternion> rotates;
+    std::vector<Vec3f> translates;
+};
+
+/// <summary>
+/// 圧縮前後のメモリ使用量と誤差
+/// </summary>
+struct AnimationCompressionReport {
+    uint32_t trackCount = 0;
+    uint32_t frameCount = 0;
+
+    // 定数にならなかったトラック数
+    uint32_t animatedScaleCount     = 0;
+    uint32_t animatedRotateCount    = 0;
+    uint32_t animatedTranslateCount = 0;
+
+    // キーフレームの値と時刻のバイト数 (ノード名は両方に同じだけあるので含めない)
+    size_t sourceBytes     = 0;
+    size_t compressedBytes = 0;
+
+    // 元の曲線 (スキニングと同じ CalculateValue::Linear) との誤差. 再サンプリングのレートの 4 倍の時刻で比べる
+    float maxScaleError      = 0.f; // 差の長さ
+    float maxRotateError     = 0.f; // 角度 (rad)
+    float maxTranslateError  = 0.f; // 差の長さ
+    float meanRotateError    = 0.f;
+    float meanTranslateError = 0.f;
+};
+
+/// <summary>
+/// 一定レートで再サンプリングし, 量子化したアニメーション.
+/// rotate は smallest-three, scale / translate はトラックごとの範囲で 16bit に量子化し, 動かないトラックは値を1つだけ持つ.
+/// トラック番号は元の animationNodes_ のノードごとに振る.
+/// </summary>
+class CompressedAnimationData {
+public:
+    CompressedAnimationData()  = default;
+    ~CompressedAnimationData() = default;
+
+    /// <summary>
+    /// _source を圧縮する
+    /// </summary>
+    static CompressedAnimationData Compress(const AnimationData& _source, const AnimationCompressionSettings& _settings = {});
+
+    /// <summary>
+    /// _time の全トラックの値を _out に書き込む (_out の領域は使い回す)
+    /// </summary>
+    void SamplePose(float _time, AnimationPose& _out) const;
+
+    /// <summary>
+    /// 圧縮元と比べたメモリ使用量と誤差を求める
+    /// </summary>
+    AnimationCompressionReport Measure(const AnimationData& _source) const;
+
+    /// <summary>
+    /// 量子化したデータのバイト数
+    /// </summary>
+    size_t GetMemoryBytes() const;
+
+    /// <summary>
+    /// ノード名のトラック番号. 無ければ -1
+    /// </summary>
+    int32_t GetTrackIndex(const std::string& _nodeName) const;
+
+private:
+    /// <summary>
+    /// フレーム _frame の時刻
+    /// </summary>
+    float GetFrameTime(uint32_t _frame) const;
+
+private:
+    float duration_         = 0.f;
+    float sampleRate_       = 30.f;
+    uint32_t frameCount_    = 0;
+    uint32_t trackRevision_ = 0; // 圧縮したときの AnimationData::trackRevision
+
+    std::vector<std::string> trackNames_;
+    std::unordered_map<std::string, uint32_t> trackIndexBinder_;
+
+    CompressedVec3Channel scale_;
+    CompressedQuaternionChannel rotate_;
+    CompressedVec3Channel translate_;
+
+public:
+    float GetDuration() const { return duration_; }
+    float GetSampleRate() const { return sampleRate_; }
+    uint32_t GetFrameCount() const { return frameCount_; }
+    uint32_t GetTrackCount() const { return static_cast<uint32_t>(trackNames_.size()); }
+    uint32_t GetTrackRevision() const { return trackRevision_; }
+    const std::vector<std::string>& GetTrackNames() const { return trackNames_; }
+};
+
+} // namespace OriGine
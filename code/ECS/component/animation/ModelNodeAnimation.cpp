@@ -143,12 +143,14 @@ void ModelNodeAnimation::Edit(Scene* _scene, const EntityHandle& _entity, [[mayb
                         ImGui::SameLine();
                         if (ImGui::SmallButton(("+##Add" + node.name + _parentLabel).c_str())) {
                             data_->animationNodes_[node.name] = ModelAnimationNode();
+                            ++data_->trackRevision;
                         }
                     } else {
                         // 削除ボタン
                         ImGui::SameLine();
                         if (ImGui::SmallButton(("-##Remove" + node.name + _parentLabel).c_str())) {
                             data_->animationNodes_.erase(node.name);
+                            ++data_->trackRevision;
                         }
                     }
 
@@ -178,7 +180,8 @@ void ModelNodeAnimation::Edit(Scene* _scene, const EntityHandle& _entity, [[mayb
                     std::string name(newNodeName);
                     if (data_->animationNodes_.find(name) == data_->animationNodes_.end()) {
                         data_->animationNodes_[name] = ModelAnimationNode();
-                        newNodeName[0]               = '\0';
+                        ++data_->trackRevision;
+                        newNodeName[0] = '\0';
                     }
                 }
             }
@@ -208,24 +211,27 @@ void ModelNodeAnimation::Edit(Scene* _scene, const EntityHandle& _entity, [[mayb
 
             constexpr float kKeyFrameSliderWidth = 400.0f;
 
+            // キーフレームを編集するコマンドの Execute / Undo で, 関節への対応付けを作り直させ, 古い圧縮データを使わせない
+            std::function<void()> onKeyFrameEdited = [data = data_]() { ++data->trackRevision; };
+
             // Scale
             ImGui::TextUnformatted("Scale");
             ImGui::SetNextItemWidth(kKeyFrameSliderWidth);
-            ImGui::EditKeyFrame("##Scale" + nodeName + _parentLabel, nodeAnim.scale, duration_);
+            ImGui::EditKeyFrame("##Scale" + nodeName + _parentLabel, nodeAnim.scale, duration_, Vec3f(0.0f, 0.0f, 0.0f), nullptr, onKeyFrameEdited);
 
             ImGui::Separator();
 
             // Rotate
             ImGui::TextUnformatted("Rotate");
             ImGui::SetNextItemWidth(kKeyFrameSliderWidth);
-            ImGui::EditKeyFrame("##Rotate" + nodeName + _parentLabel, nodeAnim.rotate, duration_);
+            ImGui::EditKeyFrame("##Rotate" + nodeName + _parentLabel, nodeAnim.rotate, duration_, Quaternion(0.0f, 0.0f, 0.0f, 1.0f), nullptr, onKeyFrameEdited);
 
             ImGui::Separator();
 
             // Translate
             ImGui::TextUnformatted("Translate");
             ImGui::SetNextItemWidth(kKeyFrameSliderWidth);
-            ImGui::EditKeyFrame("##Translate" + nodeName + _parentLabel, nodeAnim.translate, duration_);
+            ImGui::EditKeyFrame("##Translate" + nodeName + _parentLabel, nodeAnim.translate, duration_, Vec3f(0.0f, 0.0f, 0.0f), nullptr, onKeyFrameEdited);
 
             ImGui::TreePop();
         }
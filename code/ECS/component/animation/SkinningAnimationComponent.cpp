@@ -264,6 +264,14 @@ void SkinningAnimationComponent::Stop() {
     animation.currentTime            = 0.0f;
 }
 
+AnimationClipBinding& SkinningAnimationComponent::BindAnimation(int32_t _animationIndex) {
+    auto& animation = animationTable_[_animationIndex];
+    if (!animation.binding.IsBoundTo(skeleton_, animation.animationData)) {
+        animation.binding.Bind(skeleton_, animation.animationData, animation.fileName);
+    }
+    return animation.binding;
+}
+
 void SkinningAnimationComponent::CreateSkinnedVertex(Scene* _scene) {
     DxDescriptorHeap<DxDescriptorHeapType::CBV_SRV_UAV>* uavHeap = Engine::GetInstance()->GetSrvHeap(); // cbv_srv_uav heap
     auto& device                                                 = Engine::GetInstance()->GetDxDevice()->device_;
@@ -347,6 +355,11 @@ void SkinningAnimationComponent::CreateSkinnedVertex(Scene* _scene) {
         }
         skeleton_ = modelMeshData->skeleton.value();
     }
+
+    // Skeleton を差し替えたので, 関節との対応付けは次の BindAnimation で作り直す
+    for (auto& animation : animationTable_) {
+        animation.binding.Reset();
+    }
 }
 void SkinningAnimationComponent::DeleteSkinnedVertex() {
     // UAVディスクリプタを解放
@@ -6,6 +6,7 @@
 #include <string>
 
 /// engine
+#include "AnimationClipBinding.h"
 #include "AnimationData.h"
 #include "model/Model.h"
 
@@ -67,6 +68,13 @@ public:
     /// </summary>
     void Stop();
 
+    /// <summary>
+    /// 指定したアニメーションを skeleton_ の関節の順に対応付けたものを返す.
+    /// 未対応付け, またはアニメーションか Skeleton が変わっていればここで対応付け直す.
+    /// </summary>
+    /// <param name="_animationIndex">animationのIndexを指定する</param>
+    AnimationClipBinding& BindAnimation(int32_t _animationIndex);
+
     /// <summary>
     /// スキニングされた頂点バッファを作成する
     /// </summary>
@@ -94,6 +102,8 @@ private:
         float duration                = 0.0f;
         float currentTime             = 0.0f;
         float playbackSpeed           = 1.0f; // 再生速度
+
+        AnimationClipBinding binding; // skeleton_ の関節との対応付け (BindAnimation で作る)
     };
     struct AnimationBlendData {
         int32_t targetAnimationIndex = -1; // 対象のアニメーションインデックス
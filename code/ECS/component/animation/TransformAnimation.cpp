@@ -249,25 +249,25 @@ void TransformAnimation::UpdateTransform(Transform* _transform) {
     switch (interpolationType_) {
     case InterpolationType::LINEAR:
         if (!scaleCurve_.empty()) {
-            _transform->scale = ApplyFlip(CalculateValue::Linear(scaleCurve_, currentTime_), scaleFlip_);
+            _transform->scale = ApplyFlip(CalculateValue::Linear(scaleCurve_, currentTime_, scaleCursor_), scaleFlip_);
         }
         if (!rotateCurve_.empty()) {
-            _transform->rotate = ApplyFlipQ(CalculateValue::Linear(rotateCurve_, currentTime_), rotateFlip_);
+            _transform->rotate = ApplyFlipQ(CalculateValue::Linear(rotateCurve_, currentTime_, rotateCursor_), rotateFlip_);
         }
         if (!translateCurve_.empty()) {
-            _transform->translate = ApplyFlip(CalculateValue::Linear(translateCurve_, currentTime_), translateFlip_);
+            _transform->translate = ApplyFlip(CalculateValue::Linear(translateCurve_, currentTime_, translateCursor_), translateFlip_);
         }
         break;
 
     case InterpolationType::STEP:
         if (!scaleCurve_.empty()) {
-            _transform->scale = ApplyFlip(CalculateValue::Step(scaleCurve_, currentTime_), scaleFlip_);
+            _transform->scale = ApplyFlip(CalculateValue::Step(scaleCurve_, currentTime_, scaleCursor_), scaleFlip_);
         }
         if (!rotateCurve_.empty()) {
-            _transform->rotate = ApplyFlipQ(CalculateValue::Step(rotateCurve_, currentTime_), rotateFlip_);
+            _transform->rotate = ApplyFlipQ(CalculateValue::Step(rotateCurve_, currentTime_, rotateCursor_), rotateFlip_);
         }
         if (!translateCurve_.empty()) {
-            _transform->translate = ApplyFlip(CalculateValue::Step(translateCurve_, currentTime_), translateFlip_);
+            _transform->translate = ApplyFlip(CalculateValue::Step(translateCurve_, currentTime_, translateCursor_), translateFlip_);
         }
         break;
     default:
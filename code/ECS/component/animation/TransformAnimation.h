@@ -69,6 +69,11 @@ private:
     AnimationCurve<Quaternion> rotateCurve_;
     AnimationCurve<Vec3f> translateCurve_;
 
+    /// 曲線ごとのキーフレーム検索のカーソル
+    KeyframeCursor scaleCursor_;
+    KeyframeCursor rotateCursor_;
+    KeyframeCursor translateCursor_;
+
     /// flip masks (軸ごとの反転)
     FlipMask scaleFlip_;
     FlipMask rotateFlip_;
@@ -3,6 +3,7 @@
 #include "component/IComponent.h"
 /// stl
 #include <unordered_map>
+#include <vector>
 /// math
 #include <math/Vector3.h>
 
@@ -55,10 +56,34 @@ public:
         Vec3f collPoint; // 衝突点
     };
 
+    /// <summary>
+    /// 並列の衝突判定中に記録し, 後でまとめて target に追加する衝突情報。
+    /// </summary>
+    struct DeferredInfo {
+        CollisionPushBackInfo* target; // 追加先
+        EntityHandle other; // 衝突相手
+        Info info;
+    };
+
+    /// <summary>
+    /// このインスタンスを _target の代理にする。
+    /// 押し戻し種別は _target と同じになり, AddCollisionInfo は自身のマップではなく _records に追記する。
+    /// </summary>
+    /// <param name="_target">本来の追加先</param>
+    /// <param name="_records">記録先 (nullptr で代理を解除)</param>
+    void DeferTo(CollisionPushBackInfo* _target, std::vector<DeferredInfo>* _records) {
+        pushBackType_ = _target ? _target->pushBackType_ : CollisionPushBackType::None;
+        deferTarget_  = _target;
+        deferRecords_ = _records;
+    }
+
 private:
     CollisionPushBackType pushBackType_ = CollisionPushBackType::None; // 衝突時の挙動
     std::unordered_map<EntityHandle, Info> collisionInfoMap_; // 衝突相手エンティティごとの衝突情報
 
+    CollisionPushBackInfo* deferTarget_      = nullptr; // DeferTo の追加先
+    std::vector<DeferredInfo>* deferRecords_ = nullptr; // DeferTo の記録先
+
 public:
     CollisionPushBackType GetPushBackType() const { return pushBackType_; }
     void SetPushBackType(CollisionPushBackType _type) { pushBackType_ = _type; }
@@ -66,6 +91,10 @@ public:
     const std::unordered_map<EntityHandle, Info>& GetCollisionInfoMap() const { return collisionInfoMap_; }
     void SetCollisionInfoMap(const std::unordered_map<EntityHandle, Info>& _map) { collisionInfoMap_ = _map; }
     void AddCollisionInfo(const EntityHandle& _handle, const Info& _info) {
+        if (deferRecords_) {
+            deferRecords_->push_back(DeferredInfo{deferTarget_, _handle, _info});
+            return;
+        }
         collisionInfoMap_[_handle] = _info;
     }
 };
@@ -8,12 +8,22 @@
 
 using namespace OriGine;
 
+std::atomic<uint32_t> ICollider::staticRevision_ = 0;
+
 void ICollider::Initialize(Scene* /*_scene*/, const EntityHandle& /*_entity*/) {}
 
 void OriGine::ICollider::Edit(Scene* /*_scene*/, const EntityHandle& /*_handle*/, [[maybe_unused]] const std::string& _parentLabel) {
 #ifdef _DEBUG
 
     CheckBoxCommand("IsActive##" + _parentLabel, isActive_);
+    CheckBoxCommand("IsStatic##" + _parentLabel, isStatic_);
+
+    // IsStatic の切り替え (コマンド経由で遅れて反映される, Undoも含む) や
+    // 静的コライダーを編集している間は静的BVHを作り直させる
+    if (isStatic_ != editedIsStatic_ || (isStatic_ && ImGui::IsAnyItemActive())) {
+        editedIsStatic_ = isStatic_;
+        MarkStaticDirty();
+    }
 
     // カテゴリ選択Combo
     auto* manager                          = CollisionCategoryManager::GetInstance();
@@ -25,7 +35,7 @@ void OriGine::ICollider::Edit(Scene* /*_scene*/, const EntityHandle& /*_handle*/
         for (const auto& [name, category] : categories) {
             bool isSelected = (currentCategoryName == name);
             if (ImGui::Selectable(name.c_str(), isSelected)) {
-                collisionCategory_ = category;
+                SetCollisionCategory(category);
             }
             if (isSelected) {
                 ImGui::SetItemDefaultFocus();
@@ -38,25 +48,37 @@ void OriGine::ICollider::Edit(Scene* /*_scene*/, const EntityHandle& /*_handle*/
 }
 
 void ICollider::StartCollision() {
-    // 前フレームの状態を退避してから今フレーム分をクリアし、最新のワールド形状を計算する
-    this->preCollisionStateMap_ = this->collisionStateMap_;
-    this->collisionStateMap_.clear();
-
     CalculateWorldShape();
 }
 
-void ICollider::EndCollision() {
-    // 前フレーム衝突していた相手のうち、今フレームで更新されなかったものをExit状態にする
-    for (auto& [entity, state] : this->preCollisionStateMap_) {
-        if (state == CollisionState::Exit)
-            return;
-        if (this->collisionStateMap_[entity] == CollisionState::None)
-            this->collisionStateMap_[entity] = CollisionState::Exit;
+void ICollider::EndCollision(std::span<const EntityHandle> _others) {
+    // 前フレームの状態を退避し、どちらもエンティティ順に並んでいるので先頭から突き合わせる
+    // (両方にいる相手はStay、今フレームだけの相手はEnter、前フレームだけの相手はExit。Exit済みの相手は捨てる)
+    std::swap(this->collisionContacts_, this->preCollisionContacts_);
+    this->collisionContacts_.clear();
+
+    size_t otherIndex = 0;
+    for (const auto& pre : this->preCollisionContacts_) {
+        if (pre.state == CollisionState::Exit) {
+            continue;
+        }
+        while (otherIndex < _others.size() && _others[otherIndex] < pre.other) {
+            this->collisionContacts_.push_back(CollisionContact{_others[otherIndex++], CollisionState::Enter});
+        }
+        if (otherIndex < _others.size() && _others[otherIndex] == pre.other) {
+            this->collisionContacts_.push_back(CollisionContact{_others[otherIndex++], CollisionState::Stay});
+        } else {
+            this->collisionContacts_.push_back(CollisionContact{pre.other, CollisionState::Exit});
+        }
+    }
+    while (otherIndex < _others.size()) {
+        this->collisionContacts_.push_back(CollisionContact{_others[otherIndex++], CollisionState::Enter});
     }
 }
 
 void OriGine::to_json(nlohmann::json& _j, const ICollider& _c) {
     _j["isActive"]          = _c.isActive_;
+    _j["isStatic"]          = _c.isStatic_;
     _j["collisionCategory"] = _c.collisionCategory_.GetName();
 }
 
@@ -64,6 +86,12 @@ void OriGine::from_json(const nlohmann::json& _j, ICollider& _c) {
     if (_j.contains("isActive")) {
         _c.isActive_ = _j["isActive"].get<bool>();
     }
+    if (_j.contains("isStatic")) {
+        _c.isStatic_ = _j["isStatic"].get<bool>();
+        if (_c.isStatic_) {
+            ICollider::MarkStaticDirty();
+        }
+    }
 
     if (_j.contains("collisionCategory")) {
         std::string categoryName          = _j["collisionCategory"].get<std::string>();
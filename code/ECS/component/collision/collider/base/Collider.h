@@ -3,8 +3,10 @@
 /// parent
 #include "component/IComponent.h"
 /// stl
+#include <atomic>
 #include <concepts>
-#include <unordered_map>
+#include <span>
+#include <vector>
 
 /// engine
 /// ECS
@@ -34,6 +36,14 @@ enum class CollisionState {
     Exit // 衝突終了時
 };
 
+/// <summary>
+/// 衝突相手とその衝突状態
+/// </summary>
+struct CollisionContact {
+    EntityHandle other; // 衝突相手のエンティティ
+    CollisionState state = CollisionState::None;
+};
+
 /// <summary>
 /// コライダーのインターフェース
 /// </summary>
@@ -66,13 +76,14 @@ public:
     virtual void CalculateWorldShape() = 0;
 
     /// <summary>
-    /// 衝突判定開始時の状態更新（前フレームの状態を保存し、ワールド形状を更新する）
+    /// 衝突判定開始時の状態更新（ワールド形状を更新する）
     /// </summary>
     virtual void StartCollision();
     /// <summary>
-    /// 衝突判定終了時の状態更新（このフレームで衝突が無くなった相手をExit状態にする）
+    /// 衝突判定終了時の状態更新（このフレームの衝突相手と前フレームの衝突相手を突き合わせ、Enter/Stay/Exitを求める）
     /// </summary>
-    virtual void EndCollision();
+    /// <param name="_others">このフレームの衝突相手 (エンティティ順, 重複なし)</param>
+    virtual void EndCollision(std::span<const EntityHandle> _others);
 
     /// <summary>
     /// 衝突可能か判定（Manager経由でマトリクス参照）
@@ -85,38 +96,74 @@ public:
     /// </summary>
     virtual Bounds::AABB ToWorldAABB() const = 0;
 
+    /// <summary>
+    /// 静的コライダーの配置が変わったことを通知する (CollisionCheckSystem が静的BVHを作り直す).
+    /// 静的コライダーを持つエンティティの Transform や形状を実行時に書き換えた場合に呼ぶ.
+    /// </summary>
+    static void MarkStaticDirty() { staticRevision_.fetch_add(1, std::memory_order_relaxed); }
+
+    /// <summary>
+    /// 静的コライダーの配置の更新番号を取得 (MarkStaticDirty のたびに進む)
+    /// </summary>
+    static uint32_t GetStaticRevision() { return staticRevision_.load(std::memory_order_relaxed); }
+
 protected:
-    bool isActive_ = true; // このコライダーが衝突判定の対象かどうか
+    bool isActive_       = true; // このコライダーが衝突判定の対象かどうか
+    bool isStatic_       = false; // 動かないコライダーか (静的BVHに焼き込まれ, 静的コライダー同士は判定しない)
+    bool editedIsStatic_ = false; // Edit で最後に確認した isStatic_ (切り替えの検出用)
 
     CollisionCategory collisionCategory_ = CollisionCategory(); // 所属する衝突カテゴリ
 
     Transform transform_;
-    std::unordered_map<EntityHandle, CollisionState> collisionStateMap_; // 現フレームの相手ごとの衝突状態
-    std::unordered_map<EntityHandle, CollisionState> preCollisionStateMap_; // 前フレームの相手ごとの衝突状態
+    std::vector<CollisionContact> collisionContacts_; // 現フレームの衝突相手と状態 (相手のエンティティ順)
+    std::vector<CollisionContact> preCollisionContacts_; // 前フレームの衝突相手と状態 (collisionContacts_ と入れ替えて容量を使い回す)
+    uint32_t contactSlot_ = 0xFFFFFFFF; // 今フレームの CollisionContactCache のスロット
+
+private:
+    static std::atomic<uint32_t> staticRevision_;
 
 public: // accessor
     bool IsActive() const { return isActive_; }
-    void SetActive(bool _isActive) { isActive_ = _isActive; }
+    void SetActive(bool _isActive) {
+        if (isStatic_ && isActive_ != _isActive) {
+            MarkStaticDirty();
+        }
+        isActive_ = _isActive;
+    }
+
+    /// <summary>
+    /// 静的コライダーか. 静的コライダーだけを持つエンティティは毎フレームの更新を行わず,
+    /// 衝突状態は動的コライダーと衝突している間 (と離れた次のフレーム) だけ更新される.
+    /// 配置は静的BVHに焼き込まれるため, 実行時に Transform (親の付け替えを含む) を書き換えたら MarkStaticDirty を呼ぶこと.
+    /// 呼ばずに動かすと古い位置で判定され続ける (Debug ビルドでは CollisionCheckSystem がエラーを出して止める).
+    /// </summary>
+    bool IsStatic() const { return isStatic_; }
+    void SetStatic(bool _isStatic) {
+        if (isStatic_ != _isStatic) {
+            MarkStaticDirty();
+        }
+        isStatic_ = _isStatic;
+    }
 
     const Transform& GetTransform() const { return transform_; }
     void SetParent(Transform* _parent) { transform_.parent = _parent; }
 
     const CollisionCategory& GetCollisionCategory() const { return collisionCategory_; }
-    void SetCollisionCategory(const CollisionCategory& _category) { collisionCategory_ = _category; }
+    void SetCollisionCategory(const CollisionCategory& _category) {
+        // 静的BVHは衝突レイヤーも焼き込んでいるため作り直させる
+        if (isStatic_) {
+            MarkStaticDirty();
+        }
+        collisionCategory_ = _category;
+    }
 
-    // 衝突状態の操作
     /// <summary>
-    /// 相手エンティティとの衝突状態を更新する（前フレーム未衝突ならEnter、それ以外はStayにする）
+    /// 現フレームの衝突相手と状態を取得 (前フレームから衝突が無くなった相手は Exit として1フレームだけ含まれる)
     /// </summary>
-    /// <param name="_otherHandle">相手エンティティのハンドル</param>
-    void SetCollisionState(const EntityHandle& _otherHandle) {
-        if (this->preCollisionStateMap_[_otherHandle] == CollisionState::None) {
-            this->collisionStateMap_[_otherHandle] = CollisionState::Enter;
-        } else {
-            this->collisionStateMap_[_otherHandle] = CollisionState::Stay;
-        }
-    }
-    const std::unordered_map<EntityHandle, CollisionState>& GetCollisionStateMap() const { return collisionStateMap_; }
+    const std::vector<CollisionContact>& GetCollisionContacts() const { return collisionContacts_; }
+
+    uint32_t GetContactSlot() const { return contactSlot_; }
+    void SetContactSlot(uint32_t _slot) { contactSlot_ = _slot; }
 };
 
 /// <summary>
@@ -129,8 +176,8 @@ public:
     Collider() {}
     void Initialize(Scene* /*_scene*/, const EntityHandle& /*_entity*/) override {}
     void Finalize() override {
-        this->collisionStateMap_.clear();
-        this->preCollisionStateMap_.clear();
+        this->collisionContacts_.clear();
+        this->preCollisionContacts_.clear();
     }
 
     virtual void Edit(Scene* _scene, const EntityHandle& _handle, const std::string& _parentLabel) = 0;
@@ -107,11 +107,11 @@ void Particle::SetKeyFrames(int32_t updateSettings, ParticleKeyFrames* _keyFrame
     if (updateSettings & static_cast<int32_t>(ParticleUpdateType::ColorPerLifeTime)) {
         if (colorInterpolationType_ == InterpolationType::LINEAR) {
             updateByCurves_.push_back([this]() {
-                transform_.color = CalculateValue::Linear(keyFrames_->colorCurve, currentTime_);
+                transform_.color = CalculateValue::Linear(keyFrames_->colorCurve, currentTime_, colorCursor_);
             });
         } else {
             updateByCurves_.push_back([this]() {
-                transform_.color = CalculateValue::Step(keyFrames_->colorCurve, currentTime_);
+                transform_.color = CalculateValue::Step(keyFrames_->colorCurve, currentTime_, colorCursor_);
             });
         }
     }
@@ -120,11 +120,11 @@ void Particle::SetKeyFrames(int32_t updateSettings, ParticleKeyFrames* _keyFrame
     if (updateSettings & static_cast<int32_t>(ParticleUpdateType::ScalePerLifeTime)) {
         if (transformInterpolationType_ == InterpolationType::LINEAR) {
             updateByCurves_.push_back([this]() {
-                transform_.scale = CalculateValue::Linear(keyFrames_->scaleCurve, currentTime_);
+                transform_.scale = CalculateValue::Linear(keyFrames_->scaleCurve, currentTime_, scaleCursor_);
             });
         } else {
             updateByCurves_.push_back([this]() {
-                transform_.scale = CalculateValue::Step(keyFrames_->scaleCurve, currentTime_);
+                transform_.scale = CalculateValue::Step(keyFrames_->scaleCurve, currentTime_, scaleCursor_);
             });
         }
     } else if (updateSettings & static_cast<int32_t>(ParticleUpdateType::ScaleRandom)) {
@@ -137,11 +137,11 @@ void Particle::SetKeyFrames(int32_t updateSettings, ParticleKeyFrames* _keyFrame
     if (updateSettings & static_cast<int32_t>(ParticleUpdateType::RotatePerLifeTime)) {
         if (transformInterpolationType_ == InterpolationType::LINEAR) {
             updateByCurves_.push_back([this]() {
-                transform_.rotate = CalculateValue::Linear(keyFrames_->rotateCurve, currentTime_);
+                transform_.rotate = CalculateValue::Linear(keyFrames_->rotateCurve, currentTime_, rotateCursor_);
             });
         } else {
             updateByCurves_.push_back([this]() {
-                transform_.rotate = CalculateValue::Step(keyFrames_->rotateCurve, currentTime_);
+                transform_.rotate = CalculateValue::Step(keyFrames_->rotateCurve, currentTime_, rotateCursor_);
             });
         }
     } else if (updateSettings & static_cast<int32_t>(ParticleUpdateType::RotateRandom)) {
@@ -156,11 +156,11 @@ void Particle::SetKeyFrames(int32_t updateSettings, ParticleKeyFrames* _keyFrame
     if (updateSettings & static_cast<int32_t>(ParticleUpdateType::VelocityPerLifeTime)) {
         if (transformInterpolationType_ == InterpolationType::LINEAR) {
             updateByCurves_.push_back([this]() {
-                velocity_ = CalculateValue::Linear(keyFrames_->velocityCurve, currentTime_);
+                velocity_ = CalculateValue::Linear(keyFrames_->velocityCurve, currentTime_, velocityCursor_);
             });
         } else {
             updateByCurves_.push_back([this]() {
-                velocity_ = CalculateValue::Step(keyFrames_->velocityCurve, currentTime_);
+                velocity_ = CalculateValue::Step(keyFrames_->velocityCurve, currentTime_, velocityCursor_);
             });
         }
     } else if (updateSettings & static_cast<int32_t>(ParticleUpdateType::VelocityRandom)) {
@@ -181,11 +181,11 @@ void Particle::SetKeyFrames(int32_t updateSettings, ParticleKeyFrames* _keyFrame
     if (updateSettings & static_cast<int32_t>(ParticleUpdateType::UvScalePerLifeTime)) {
         if (uvInterpolationType_ == InterpolationType::LINEAR) {
             updateByCurves_.push_back([this]() {
-                transform_.uvScale = CalculateValue::Linear(keyFrames_->uvScaleCurve, currentTime_);
+                transform_.uvScale = CalculateValue::Linear(keyFrames_->uvScaleCurve, currentTime_, uvScaleCursor_);
             });
         } else {
             updateByCurves_.push_back([this]() {
-                transform_.uvScale = CalculateValue::Step(keyFrames_->uvScaleCurve, currentTime_);
+                transform_.uvScale = CalculateValue::Step(keyFrames_->uvScaleCurve, currentTime_, uvScaleCursor_);
             });
         }
     }
@@ -193,11 +193,11 @@ void Particle::SetKeyFrames(int32_t updateSettings, ParticleKeyFrames* _keyFrame
     if (updateSettings & static_cast<int32_t>(ParticleUpdateType::UvRotatePerLifeTime)) {
         if (uvInterpolationType_ == InterpolationType::LINEAR) {
             updateByCurves_.push_back([this]() {
-                transform_.uvRotate = CalculateValue::Linear(keyFrames_->uvRotateCurve, currentTime_);
+                transform_.uvRotate = CalculateValue::Linear(keyFrames_->uvRotateCurve, currentTime_, uvRotateCursor_);
             });
         } else {
             updateByCurves_.push_back([this]() {
-                transform_.uvRotate = CalculateValue::Step(keyFrames_->uvRotateCurve, currentTime_);
+                transform_.uvRotate = CalculateValue::Step(keyFrames_->uvRotateCurve, currentTime_, uvRotateCursor_);
             });
         }
     }
@@ -205,11 +205,11 @@ void Particle::SetKeyFrames(int32_t updateSettings, ParticleKeyFrames* _keyFrame
     if (updateSettings & static_cast<int32_t>(ParticleUpdateType::UvTranslatePerLifeTime)) {
         if (uvInterpolationType_ == InterpolationType::LINEAR) {
             updateByCurves_.push_back([this]() {
-                transform_.uvTranslate = CalculateValue::Linear(keyFrames_->uvTranslateCurve, currentTime_);
+                transform_.uvTranslate = CalculateValue::Linear(keyFrames_->uvTranslateCurve, currentTime_, uvTranslateCursor_);
             });
         } else {
             updateByCurves_.push_back([this]() {
-                transform_.uvTranslate = CalculateValue::Step(keyFrames_->uvTranslateCurve, currentTime_);
+                transform_.uvTranslate = CalculateValue::Step(keyFrames_->uvTranslateCurve, currentTime_, uvTranslateCursor_);
             });
         }
     }
@@ -87,6 +87,15 @@ protected:
 
     ParticleKeyFrames* keyFrames_ = nullptr;
     std::vector<std::function<void()>> updateByCurves_;
+
+    // 曲線ごとのキーフレーム検索のカーソル (粒子ごとに寿命の中を前へ進むだけなので, ほぼ直前の区間で見つかる)
+    KeyframeCursor colorCursor_;
+    KeyframeCursor scaleCursor_;
+    KeyframeCursor rotateCursor_;
+    KeyframeCursor velocityCursor_;
+    KeyframeCursor uvScaleCursor_;
+    KeyframeCursor uvRotateCursor_;
+    KeyframeCursor uvTranslateCursor_;
     Vec3f scaleRatio_;
     Vec3f rotateRatio_;
     Vec3f velocityRatio_;
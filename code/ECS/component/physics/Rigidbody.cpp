@@ -32,6 +32,12 @@ void Rigidbody::Edit(Scene* /*_scene*/, const EntityHandle& /*_entity*/, [[maybe
     ImGui::Separator();
 
     DragGuiCommand("restitution##" + _parentLabel, restitution_, 0.01f);
+    DragGuiCommand("ccdThreshold##" + _parentLabel, ccdThreshold_, 0.01f, 0.f, 1000.f, "%.3f");
+
+    ImGui::Separator();
+
+    CheckBoxCommand("canSleep##" + _parentLabel, canSleep_);
+    ImGui::Text("isSleeping : %s", isSleeping_ ? "true" : "false");
 
     ImGui::Separator();
 
@@ -55,6 +61,8 @@ void Rigidbody::Debug() {
     ImGui::Separator();
     ImGui::Checkbox("Use Gravity", &useGravity_);
     ImGui::DragFloat("Mass", &mass_, 0.1f, 0.f, 0.f, "%.3f", ImGuiSliderFlags_ReadOnly);
+    ImGui::Separator();
+    ImGui::Text("Sleeping : %s (rest frames : %d, island : %u)", isSleeping_ ? "true" : "false", restFrameCount_, islandId_);
 #endif // _DEBUG
 }
 
@@ -69,6 +77,8 @@ void OriGine::to_json(nlohmann::json& _j, const Rigidbody& _comp) {
     _j["useGravity"]   = _comp.useGravity_;
     _j["maxFallSpeed"] = _comp.maxFallSpeed_;
     _j["restitution"]  = _comp.restitution_;
+    _j["ccdThreshold"] = _comp.ccdThreshold_;
+    _j["canSleep"]     = _comp.canSleep_;
 
     _j["isUsingLocalDeltaTime"] = _comp.isUsingLocalDeltaTime_;
     _j["localDeltaTimeName"]    = _comp.localDeltaTimeName_;
@@ -89,7 +99,9 @@ void OriGine::from_json(const nlohmann::json& _j, Rigidbody& _comp) {
         _j.at("maxFallSpeed").get_to(_comp.maxFallSpeed_);
     }
 
-    _comp.restitution_ = _j.value("restitution", 0.0f); // デフォルト値を 0.0f に設定
+    _comp.restitution_  = _j.value("restitution", 0.0f); // デフォルト値を 0.0f に設定
+    _comp.ccdThreshold_ = _j.value("ccdThreshold", 0.0f);
+    _comp.canSleep_     = _j.value("canSleep", true);
 
     if (_j.contains("isUsingLocalDeltaTime")) {
         _j.at("isUsingLocalDeltaTime").get_to(_comp.isUsingLocalDeltaTime_);
@@ -2,6 +2,7 @@
 
 /// parent
 #include "component/IComponent.h"
+#include "component/ComponentStorage.h"
 
 /// math
 #include "Vector3.h"
@@ -17,6 +18,8 @@ class Rigidbody
     friend void from_json(const nlohmann::json& _j, Rigidbody& _comp);
 
 public:
+    static constexpr uint32_t kNoIsland = 0; // 眠っている島に属していない
+
     Rigidbody();
     virtual ~Rigidbody() = default;
 
@@ -42,9 +45,18 @@ private:
 
     float restitution_ = 0.0f; // 反発係数 (0.0f = 非反発, 1.0f = 完全反発)
 
+    float ccdThreshold_ = 0.0f; // 1回の更新の移動量がこれを超えたら prePos_ からの掃引判定ですり抜けを防ぐ (0以下なら行わない)
+
     bool isUsingLocalDeltaTime_     = false;
     std::string localDeltaTimeName_ = "";
 
+    bool canSleep_          = true; // 静止が続いたら眠らせてよいか
+    bool isSleeping_        = false; // 眠っているか (積分・押し戻し・衝突判定の更新を行わない)
+    int32_t restFrameCount_ = 0; // 静止が続いているフレーム数
+    uint32_t islandId_      = kNoIsland; // 一緒に眠った島の番号 (MoveSystemByRigidBody が割り当てる)
+
+    Vec3f renderOffset_ = Vec3f(0.0f, 0.0f, 0.0f); // 描画中だけ translate に足している補間のずれ (Scene が設定し, 描画後に戻す)
+
 public: // accsessor
     bool IsActive() const { return isActive_; }
     void SetIsActive(const bool _isActive) { isActive_ = _isActive; }
@@ -61,21 +73,37 @@ public: // accsessor
 
     const Vec3f& GetAcceleration() const { return acceleration_; }
     float GetAcceleration(int32_t _index) const { return acceleration_[_index]; }
-    void SetAcceleration(const Vec3f& _acceleration) { acceleration_ = _acceleration; }
+    void SetAcceleration(const Vec3f& _acceleration) {
+        if (isSleeping_ && acceleration_ != _acceleration) {
+            WakeUp();
+        }
+        acceleration_ = _acceleration;
+    }
     void SetAcceleration(int32_t _index, float _accel) {
         if (_index < 0 || _index >= 3) {
             throw std::out_of_range("Index must be between 0 and 2.");
         }
+        if (isSleeping_ && acceleration_[_index] != _accel) {
+            WakeUp();
+        }
         acceleration_[_index] = _accel;
     }
 
     const Vec3f& GetVelocity() const { return velocity_; }
     float GetVelocity(int32_t _index) const { return velocity_[_index]; }
-    void SetVelocity(const Vec3f& _velocity) { velocity_ = _velocity; }
+    void SetVelocity(const Vec3f& _velocity) {
+        if (isSleeping_ && velocity_ != _velocity) {
+            WakeUp();
+        }
+        velocity_ = _velocity;
+    }
     void SetVelocity(int32_t _index, float _velo) {
         if (_index < 0 || _index >= 3) {
             throw std::out_of_range("Index must be between 0 and 2.");
         }
+        if (isSleeping_ && velocity_[_index] != _velo) {
+            WakeUp();
+        }
         velocity_[_index] = _velo;
     }
 
@@ -106,8 +134,64 @@ public: // accsessor
     float GetRestitution() const { return restitution_; }
     void SetRestitution(float _restitution) { restitution_ = _restitution; }
 
+    /// <summary>
+    /// 連続衝突判定を行う移動量のしきい値 (0以下なら行わない).
+    /// CollisionCheckSystem は prePos_ から現在位置までを掃引するため, Transform を直接動かして瞬間移動させる時は SetPrePos も合わせる.
+    /// </summary>
+    float GetCcdThreshold() const { return ccdThreshold_; }
+    void SetCcdThreshold(float _threshold) { ccdThreshold_ = _threshold; }
+
     bool IsUsingLocalDeltaTime() const { return isUsingLocalDeltaTime_; }
     const std::string& GetLocalDeltaTimeName() const { return localDeltaTimeName_; }
+
+    bool CanSleep() const { return canSleep_; }
+    void SetCanSleep(bool _canSleep) {
+        if (!_canSleep) {
+            WakeUp();
+        }
+        canSleep_ = _canSleep;
+    }
+
+    /// <summary>
+    /// 眠っているか. 眠っている間に Transform を直接動かしても衝突判定に反映されないため, 動かす前に WakeUp を呼ぶ.
+    /// 速度/加速度を変更すると自動で起きる. 同じ島の他の物体は次の MoveSystemByRigidBody の更新で一緒に起きる.
+    /// </summary>
+    bool IsSleeping() const { return isSleeping_; }
+
+    /// <summary>
+    /// 眠らせる (速度と加速度を0にする)
+    /// </summary>
+    void Sleep() {
+        isSleeping_   = true;
+        acceleration_ = Vec3f(0.0f, 0.0f, 0.0f);
+        velocity_     = Vec3f(0.0f, 0.0f, 0.0f);
+        realVelocity_ = Vec3f(0.0f, 0.0f, 0.0f);
+    }
+
+    /// <summary>
+    /// 起こす (静止フレーム数も数え直す)
+    /// </summary>
+    void WakeUp() {
+        isSleeping_     = false;
+        restFrameCount_ = 0;
+    }
+
+    int32_t GetRestFrameCount() const { return restFrameCount_; }
+    void SetRestFrameCount(int32_t _count) { restFrameCount_ = _count; }
+
+    uint32_t GetIslandId() const { return islandId_; }
+    void SetIslandId(uint32_t _islandId) { islandId_ = _islandId; }
+
+    const Vec3f& GetRenderOffset() const { return renderOffset_; }
+    void SetRenderOffset(const Vec3f& _offset) { renderOffset_ = _offset; }
+};
+
+/// <summary>
+/// Rigidbody は1Entityにつき1つなので, スロット内に直接格納する
+/// </summary>
+template <>
+struct ComponentStorageTraits<Rigidbody> {
+    static constexpr bool kSingleInstance = true;
 };
 
 } // namespace OriGine
@@ -1,11 +1,17 @@
 #pragma once
 
 /// stl
+#include <bit>
 #include <string>
 
 /// ECS
 // entity
 #include "entity/EntityHandle.h"
+// component
+#include "component/ComponentTypeId.h"
+
+/// util
+#include "util/BitArray.h"
 
 /// externals
 #include <uuid/uuid.h>
@@ -21,6 +27,28 @@ class EntityRepository;
 
 static constexpr int32_t kInvalidEntityID = -1; // 無効なEntity IDを表す値
 
+/// <summary>
+/// Entityが持つComponentの型の集合 (ComponentTypeId 番目のビットが立っていれば, その型を1つ以上持つ)
+/// </summary>
+using ComponentSignature = BitArray<uint64_t>;
+
+/// <summary>
+/// 指定した型を全て含むシグネチャを作成する (Entity::HasComponentTypes での絞り込みに使う)
+/// </summary>
+/// <typeparam name="ComponentTypes">Componentの型</typeparam>
+template <typename... ComponentTypes>
+ComponentSignature MakeComponentSignature() {
+    ComponentSignature signature;
+    auto addType = [&signature](ComponentTypeId _typeId) {
+        if (_typeId >= signature.size()) {
+            signature.resize(static_cast<size_t>(_typeId) + 1);
+        }
+        signature.Set(_typeId, true);
+    };
+    (addType(GetComponentTypeId<ComponentTypes>()), ...);
+    return signature;
+}
+
 /// <summary>
 /// 実体を表すクラス (実際にはIDでしか無い)
 /// </summary>
@@ -43,6 +71,21 @@ private:
     bool isUnique_       = false; // シーン内で唯一の存在かどうか
     bool shouldSave_     = true; // シーン保存時に書き出す対象かどうか
 
+    ComponentSignature componentSignature_; // 持っているComponentの型 (ComponentArray が更新する)
+
+    /// <summary>
+    /// 指定した型のComponentを持っているかを記録する
+    /// </summary>
+    void SetComponentType(ComponentTypeId _typeId, bool _hasComponent) {
+        if (_typeId >= componentSignature_.size()) {
+            if (!_hasComponent) {
+                return;
+            }
+            componentSignature_.resize(static_cast<size_t>(_typeId) + 1);
+        }
+        componentSignature_.Set(_typeId, _hasComponent);
+    }
+
 public:
     /// <summary>
     /// エンティティハンドルを取得
@@ -84,6 +127,56 @@ public:
         shouldSave_ = _ShouldSave;
     }
 
+    /// <summary>
+    /// 指定した型のComponentを持っているか
+    /// </summary>
+    /// <param name="_typeId">ComponentTypeId</param>
+    /// <returns>1つ以上持っていればtrue</returns>
+    bool HasComponentType(ComponentTypeId _typeId) const {
+        return _typeId < componentSignature_.size() && componentSignature_.Get(_typeId);
+    }
+
+    /// <summary>
+    /// 指定したシグネチャの型を全て持っているか
+    /// </summary>
+    /// <param name="_required">必要な型の集合</param>
+    /// <returns>全て持っていればtrue</returns>
+    bool HasComponentTypes(const ComponentSignature& _required) const {
+        const auto& required = _required.GetData();
+        const auto& owned    = componentSignature_.GetData();
+        for (size_t i = 0; i < required.size(); ++i) {
+            uint64_t ownedBlock = i < owned.size() ? owned[i] : 0;
+            if ((required[i] & ownedBlock) != required[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// 持っているComponentの型を ComponentTypeId の昇順に列挙する
+    /// </summary>
+    /// <param name="_func">void(ComponentTypeId)</param>
+    template <typename Func>
+    void ForEachComponentType(Func&& _func) const {
+        const auto& blocks = componentSignature_.GetData();
+        for (size_t blockIndex = 0; blockIndex < blocks.size(); ++blockIndex) {
+            uint64_t block = blocks[blockIndex];
+            while (block) {
+                uint32_t bit = static_cast<uint32_t>(::std::countr_zero(block));
+                _func(static_cast<ComponentTypeId>(blockIndex * ComponentSignature::BlockBitCount + bit));
+                block &= block - 1;
+            }
+        }
+    }
+
+    /// <summary>
+    /// 持っているComponentの型の集合を取得する
+    /// </summary>
+    const ComponentSignature& GetComponentSignature() const {
+        return componentSignature_;
+    }
+
     /// <summary>
     /// エンティティのデータタイプを取得する
     /// </summary>
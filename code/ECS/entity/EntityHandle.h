@@ -1,18 +1,28 @@
 #pragma once
 
+/// stl
+#include <cstdint>
+
 /// external
 #include <nlohmann/json.hpp>
 #include <uuid/uuid.h>
 
 namespace OriGine {
 /// <summary>
-/// エンティティのハンドル構造体
+/// エンティティのハンドル構造体.
+/// uuid は保存/読込用の永続ID, index + generation は実行時の O(1) 参照用.
 /// </summary>
 struct EntityHandle {
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFF; // 実行時インデックス未割当を表す値
+
     EntityHandle() = default;
     EntityHandle(const uuids::uuid& _uuid) : uuid(_uuid) {}
+    EntityHandle(const uuids::uuid& _uuid, uint32_t _index, uint32_t _generation)
+        : uuid(_uuid), index(_index), generation(_generation) {}
 
-    uuids::uuid uuid{}; // このHandleが指すEntityの一意なID
+    uuids::uuid uuid{}; // このHandleが指すEntityの一意なID (永続)
+    uint32_t index      = kInvalidIndex; // EntityRepository内のインデックス (実行時のみ, 保存しない)
+    uint32_t generation = 0; // index の再利用を検出するための世代番号 (実行時のみ, 保存しない)
 
     bool operator==(const EntityHandle& _rhs) const {
         return uuid == _rhs.uuid;
@@ -35,6 +45,15 @@ struct EntityHandle {
     bool IsValid() const {
         return !uuid.is_nil();
     }
+
+    /// <summary>
+    /// 実行時インデックスを持っているかどうか
+    /// (Jsonから復元しただけのHandleは持っていない)
+    /// </summary>
+    /// <returns>true = 持っている / false = uuidのみ</returns>
+    bool HasRuntimeIndex() const {
+        return index != kInvalidIndex;
+    }
 };
 
 /// <summary>
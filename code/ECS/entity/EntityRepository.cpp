@@ -23,8 +23,9 @@ EntityRepository::~EntityRepository() {}
 /// 初期化
 /// </summary>
 void EntityRepository::Initialize() {
-    entities_.resize(size_);
-    entityActiveBits_.resize(size_);
+    while (GetCapacity() < kInitialCapacity) {
+        AddChunk();
+    }
 }
 
 /// <summary>
@@ -38,13 +39,34 @@ void EntityRepository::Finalize() {
 /// EntityIndex の 確保
 /// </summary>
 int32_t EntityRepository::AllocateIndex() {
-    // 生存数が容量上限に達したらプールを倍のサイズに拡張する
-    if (entityActiveBits_.GetTrueCount() >= size_) {
-        size_ *= 2;
-        entities_.resize(size_);
-        entityActiveBits_.resize(size_);
+    // 空きが無ければチャンクを足す (既存のEntityは移動しない)
+    if (freeIndices_.empty()) {
+        AddChunk();
+    }
+
+    uint32_t index = freeIndices_.back();
+    freeIndices_.pop_back();
+
+    ++liveCount_;
+    if (index >= highWaterMark_) {
+        highWaterMark_ = index + 1;
+    }
+    return static_cast<int32_t>(index);
+}
+
+/// <summary>
+/// チャンクを1つ追加する
+/// </summary>
+void EntityRepository::AddChunk() {
+    uint32_t first = GetCapacity();
+    chunks_.push_back(std::make_unique<Entity[]>(kChunkSize));
+    generations_.resize(GetCapacity(), 0);
+
+    // 若いインデックスから取り出されるように逆順で積む
+    freeIndices_.reserve(freeIndices_.size() + kChunkSize);
+    for (uint32_t i = kChunkSize; i > 0; --i) {
+        freeIndices_.push_back(first + i - 1);
     }
-    return static_cast<int32_t>(entityActiveBits_.allocateBit());
 }
 
 /// <summary>
@@ -59,20 +81,38 @@ int32_t OriGine::EntityRepository::FindIndex(const uuids::uuid& _uuid) const {
     return it->second;
 }
 
+/// <summary>
+/// EntityHandle から EntityIndex を解決する
+/// </summary>
+int32_t EntityRepository::ResolveIndex(const EntityHandle& _handle) const {
+    if (_handle.HasRuntimeIndex() && _handle.index < generations_.size()) {
+        // index が再利用されていなければ (世代番号が一致すれば) ハッシュ検索を行わずに確定する
+        const Entity& e = EntityAt(_handle.index);
+        if (e.isAlive_ && generations_[_handle.index] == _handle.generation && e.handle_.uuid == _handle.uuid) {
+            return static_cast<int32_t>(_handle.index);
+        }
+    }
+
+    auto it = uuidToIndex_.find(_handle.uuid);
+    if (it == uuidToIndex_.end()) {
+        return -1;
+    }
+    return it->second;
+}
+
 /// <summary>
 /// Entity 作成
 /// </summary>
 EntityHandle EntityRepository::CreateEntity(const std::string& _type, bool _unique) {
     int32_t index = AllocateIndex();
 
-    Entity& e   = entities_[index];
+    Entity& e   = EntityAt(index);
     e.id_       = index;
     e.dataType_ = _type;
     e.isAlive_  = true;
     e.isUnique_ = false;
-    e.handle_   = EntityHandle(UuidGenerator::RandomGenerate());
+    e.handle_   = EntityHandle(UuidGenerator::Generate(), static_cast<uint32_t>(index), generations_[index]);
 
-    entityActiveBits_.Set(index, true);
     uuidToIndex_[e.handle_.uuid] = index;
 
     if (_unique) {
@@ -92,18 +132,20 @@ EntityHandle OriGine::EntityRepository::CreateEntity(EntityHandle _handle, const
     if (itr != uuidToIndex_.end() || !_handle.IsValid()) {
         LOG_WARN("EntityHandle already exists. Generating a new one. \n name : {} \n uuid : {}\n", _dataType, uuids::to_string(_handle.uuid));
         _handle = EntityHandle(UuidGenerator::RandomGenerate());
+    } else {
+        // 連番で発行している場合に, 読み込んだUUIDを後から発行し直さないよう知らせる
+        UuidGenerator::NotifyLoaded(_handle.uuid);
     }
 
     int32_t index = AllocateIndex();
 
-    Entity& e   = entities_[index];
+    Entity& e   = EntityAt(index);
     e.id_       = index;
     e.dataType_ = _dataType;
     e.isAlive_  = true;
     e.isUnique_ = false;
-    e.handle_   = _handle;
+    e.handle_   = EntityHandle(_handle.uuid, static_cast<uint32_t>(index), generations_[index]);
 
-    entityActiveBits_.Set(index, true);
     uuidToIndex_[e.handle_.uuid] = index;
 
     if (_unique) {
@@ -114,6 +156,21 @@ EntityHandle OriGine::EntityRepository::CreateEntity(EntityHandle _handle, const
     return e.handle_;
 }
 
+/// <summary>
+/// Entity をまとめて作成する
+/// </summary>
+void EntityRepository::CreateEntities(const std::string& _dataType, size_t _count, std::vector<EntityHandle>& _outHandles) {
+    // UUID は1回でまとめて発行する (Sequential なら連番の範囲を予約するだけで済む)
+    reservedUuids_.clear();
+    UuidGenerator::GenerateRange(_count, reservedUuids_);
+
+    uuidToIndex_.reserve(uuidToIndex_.size() + _count);
+    _outHandles.reserve(_outHandles.size() + _count);
+    for (const uuids::uuid& uuid : reservedUuids_) {
+        _outHandles.push_back(CreateEntity(EntityHandle(uuid), _dataType, false));
+    }
+}
+
 /// <summary>
 /// Unique Entity 登録
 /// </summary>
@@ -137,7 +194,7 @@ bool OriGine::EntityRepository::RegisterUniqueEntity(Entity* _entity) {
     }
 
     uniqueEntities_[_entity->dataType_] = _entity->handle_.uuid;
-    entities_[itr->second].isUnique_    = true;
+    EntityAt(itr->second).isUnique_     = true;
 
     return true;
 }
@@ -165,7 +222,7 @@ bool OriGine::EntityRepository::UnregisterUniqueEntity(Entity* _entity) {
     }
 
     uniqueEntities_.erase(uniqueItr);
-    entities_[itr->second].isUnique_ = false;
+    EntityAt(itr->second).isUnique_ = false;
 
     return true;
 }
@@ -174,22 +231,24 @@ bool OriGine::EntityRepository::UnregisterUniqueEntity(Entity* _entity) {
 /// Entity 削除
 /// </summary>
 bool EntityRepository::RemoveEntity(const EntityHandle& _handle) {
-    auto it = uuidToIndex_.find(_handle.uuid);
-    if (it == uuidToIndex_.end()) {
+    int32_t index = ResolveIndex(_handle);
+    if (index < 0) {
         return false;
     }
 
-    int32_t index = it->second;
-    Entity& e     = entities_[index];
+    Entity& e = EntityAt(index);
 
     if (e.isUnique_) {
         uniqueEntities_.erase(e.dataType_);
     }
 
-    uuidToIndex_.erase(it);
-    entityActiveBits_.Set(index, false);
+    uuidToIndex_.erase(e.handle_.uuid);
+    ++generations_[index]; // 古いHandleからの参照を無効化する
+    ++removeCount_;
 
     e = Entity(); // スロットをデフォルト状態に戻し、再利用可能にする
+    freeIndices_.push_back(static_cast<uint32_t>(index));
+    --liveCount_;
     return true;
 }
 
@@ -197,29 +256,67 @@ bool EntityRepository::RemoveEntity(const EntityHandle& _handle) {
 /// 全エンティティを削除する
 /// </summary>
 void OriGine::EntityRepository::Clear() {
-    entities_.clear();
-    entityActiveBits_.resize(0);
+    chunks_.clear();
+    freeIndices_.clear();
+    generations_.clear();
+    liveCount_     = 0;
+    highWaterMark_ = 0;
     uuidToIndex_.clear();
     uniqueEntities_.clear();
+    ++removeCount_;
 }
 
 /// <summary>
 /// Entity 取得
 /// </summary>
 Entity* EntityRepository::GetEntity(const EntityHandle& _handle) {
-    auto itr = uuidToIndex_.find(_handle.uuid);
-    if (itr == uuidToIndex_.end()) {
+    int32_t index = ResolveIndex(_handle);
+    if (index < 0) {
         LOG_ERROR("Entity not fount. \n uuid : {}", uuids::to_string(_handle.uuid));
         return nullptr;
     }
-    return &entities_[itr->second];
+    return &EntityAt(index);
+}
+
+/// <summary>
+/// Entity 取得 (const)
+/// </summary>
+const Entity* EntityRepository::GetEntity(const EntityHandle& _handle) const {
+    int32_t index = ResolveIndex(_handle);
+    if (index < 0) {
+        LOG_ERROR("Entity not fount. \n uuid : {}", uuids::to_string(_handle.uuid));
+        return nullptr;
+    }
+    return &EntityAt(index);
 }
 
 /// <summary>
 /// 生存チェック
 /// </summary>
 bool EntityRepository::IsAlive(const EntityHandle& _handle) const {
-    return uuidToIndex_.contains(_handle.uuid);
+    return ResolveIndex(_handle) >= 0;
+}
+
+/// <summary>
+/// Entityが指定した型のComponentを持っているかを記録する
+/// </summary>
+void EntityRepository::SetComponentType(const EntityHandle& _handle, ComponentTypeId _typeId, bool _hasComponent) {
+    int32_t index = ResolveIndex(_handle);
+    if (index < 0) {
+        return;
+    }
+    EntityAt(index).SetComponentType(_typeId, _hasComponent);
+}
+
+/// <summary>
+/// Entityが指定した型のComponentを持っているか
+/// </summary>
+bool EntityRepository::HasComponentType(const EntityHandle& _handle, ComponentTypeId _typeId) const {
+    int32_t index = ResolveIndex(_handle);
+    if (index < 0) {
+        return false;
+    }
+    return EntityAt(index).HasComponentType(_typeId);
 }
 
 /// <summary>
@@ -233,3 +330,23 @@ EntityHandle EntityRepository::GetUniqueEntity(const std::string& _type) {
     }
     return EntityHandle{itr->second};
 }
+
+/// <summary>
+/// メモリ使用状況を取得
+/// </summary>
+EntityRepositoryMemoryStats EntityRepository::GetMemoryStats() const {
+    EntityRepositoryMemoryStats stats;
+    stats.capacity      = GetCapacity();
+    stats.liveCount     = liveCount_;
+    stats.highWaterMark = highWaterMark_;
+    stats.freeCount     = static_cast<uint32_t>(freeIndices_.size());
+    stats.chunkCount    = static_cast<uint32_t>(chunks_.size());
+    stats.reservedBytes = chunks_.size() * kChunkSize * sizeof(Entity)
+                          + chunks_.capacity() * sizeof(std::unique_ptr<Entity[]>)
+                          + freeIndices_.capacity() * sizeof(uint32_t)
+                          + generations_.capacity() * sizeof(uint32_t);
+    if (highWaterMark_ > 0) {
+        stats.fragmentation = static_cast<float>(highWaterMark_ - liveCount_) / static_cast<float>(highWaterMark_);
+    }
+    return stats;
+}
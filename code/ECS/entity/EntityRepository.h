@@ -1,7 +1,9 @@
 #pragma once
 
 /// stl
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -10,9 +12,6 @@
 #include "Entity.h"
 #include "EntityHandle.h"
 
-/// util
-#include "util/BitArray.h"
-
 /// external
 #include <uuid/uuid.h>
 
@@ -20,11 +19,70 @@
 #include <stdint.h>
 
 namespace OriGine {
+
+/// <summary>
+/// EntityRepository のメモリ使用状況
+/// </summary>
+struct EntityRepositoryMemoryStats {
+    uint32_t capacity      = 0; // 確保済みスロット数 (チャンク数 * チャンクサイズ)
+    uint32_t liveCount     = 0; // 生存エンティティ数
+    uint32_t highWaterMark = 0; // これまでに使用された最大インデックス + 1
+    uint32_t freeCount     = 0; // フリーリストに積まれている空きスロット数
+    uint32_t chunkCount    = 0; // 確保済みチャンク数
+    size_t reservedBytes   = 0; // チャンク + 管理配列が確保しているバイト数
+    float fragmentation    = 0.f; // highWaterMark 以下の空きスロットの割合 (0 ~ 1)
+};
+
 /// <summary>
-/// Entity Repository(登録, 削除, 取得などを行う)
+/// Entity Repository(登録, 削除, 取得などを行う).
+/// Entity実体は固定サイズのチャンク単位で確保し, 拡張時も既存チャンクを再配置しないため Entity* は削除されるまで有効.
 /// </summary>
 class EntityRepository final {
 public:
+    static constexpr uint32_t kChunkSize       = 1024; // 1チャンクあたりのEntity数
+    static constexpr uint32_t kInitialCapacity = 10000; // Initialize時に確保しておくEntity数
+
+    /// <summary>
+    /// 全スロット (0 ~ highWaterMark) を走査する範囲. 未使用スロットも含むため IsAlive() で判定すること.
+    /// </summary>
+    template <bool IsConst>
+    class EntityRange {
+    public:
+        using RepositoryType = std::conditional_t<IsConst, const EntityRepository, EntityRepository>;
+        using EntityType     = std::conditional_t<IsConst, const Entity, Entity>;
+
+        class Iterator {
+        public:
+            Iterator(RepositoryType* _repository, uint32_t _index) : repository_(_repository), index_(_index) {}
+
+            EntityType& operator*() const { return repository_->EntityAt(index_); }
+            EntityType* operator->() const { return &repository_->EntityAt(index_); }
+            Iterator& operator++() {
+                ++index_;
+                return *this;
+            }
+            bool operator==(const Iterator& _other) const { return index_ == _other.index_; }
+            bool operator!=(const Iterator& _other) const { return index_ != _other.index_; }
+
+        private:
+            RepositoryType* repository_ = nullptr;
+            uint32_t index_             = 0;
+        };
+
+        explicit EntityRange(RepositoryType* _repository) : repository_(_repository) {}
+
+        Iterator begin() const { return Iterator(repository_, 0); }
+        Iterator end() const { return Iterator(repository_, repository_->highWaterMark_); }
+
+        /// <summary>
+        /// 生存エンティティが1つも無ければtrue
+        /// </summary>
+        bool empty() const { return repository_->liveCount_ == 0; }
+
+    private:
+        RepositoryType* repository_ = nullptr;
+    };
+
     /// <summary>
     /// コンストラクタ
     /// </summary>
@@ -63,6 +121,14 @@ public:
     /// <returns>作成されたエンティティのハンドル</returns>
     EntityHandle CreateEntity(EntityHandle _handle, const std::string& _dataType, bool _unique = false);
 
+    /// <summary>
+    /// Entity をまとめて作成する (大量スポーン向け). UUIDは UuidGenerator::GenerateRange でまとめて発行する.
+    /// </summary>
+    /// <param name="_dataType">エンティティのデータタイプ</param>
+    /// <param name="_count">作成する数</param>
+    /// <param name="_outHandles">作成されたエンティティのハンドルの追加先</param>
+    void CreateEntities(const std::string& _dataType, size_t _count, std::vector<EntityHandle>& _outHandles);
+
     /// <summary>
     /// Unique Entity 取得
     /// </summary>
@@ -112,6 +178,23 @@ public:
     /// <returns>生存していればtrue</returns>
     bool IsAlive(const EntityHandle& _handle) const;
 
+    /// <summary>
+    /// Entityが指定した型のComponentを持っているかを記録する (ComponentArray から呼ばれる).
+    /// 存在しないEntityは無視する.
+    /// </summary>
+    /// <param name="_handle">対象のエンティティのハンドル</param>
+    /// <param name="_typeId">ComponentTypeId</param>
+    /// <param name="_hasComponent">1つ以上持っているか</param>
+    void SetComponentType(const EntityHandle& _handle, ComponentTypeId _typeId, bool _hasComponent);
+
+    /// <summary>
+    /// Entityが指定した型のComponentを持っているか (O(1))
+    /// </summary>
+    /// <param name="_handle">対象のエンティティのハンドル</param>
+    /// <param name="_typeId">ComponentTypeId</param>
+    /// <returns>1つ以上持っていればtrue. Entityが存在しなければfalse</returns>
+    bool HasComponentType(const EntityHandle& _handle, ComponentTypeId _typeId) const;
+
     /// <summary>
     /// 全エンティティを削除する
     /// </summary>
@@ -121,11 +204,22 @@ private:
     // --- 内部 ---
 
     /// <summary>
-    /// EntityIndex の 確保
+    /// EntityIndex の 確保 (フリーリストから取り出す. 空ならチャンクを追加する)
     /// </summary>
     /// <returns>確保されたEntityIndex</returns>
     int32_t AllocateIndex();
 
+    /// <summary>
+    /// チャンクを1つ追加し, そのスロットをフリーリストに積む. 既存チャンクは移動しない.
+    /// </summary>
+    void AddChunk();
+
+    /// <summary>
+    /// インデックスから Entity 実体を取得する (範囲チェックなし)
+    /// </summary>
+    Entity& EntityAt(uint32_t _index) { return chunks_[_index / kChunkSize][_index % kChunkSize]; }
+    const Entity& EntityAt(uint32_t _index) const { return chunks_[_index / kChunkSize][_index % kChunkSize]; }
+
     /// <summary>
     /// UUID から EntityIndex を探す
     /// </summary>
@@ -133,39 +227,61 @@ private:
     /// <returns>見つかったEntityIndex。見つからなければ-1</returns>
     int32_t FindIndex(const uuids::uuid& _uuid) const;
 
-private:
-    uint32_t size_ = 10000; // entities_の初期確保サイズ(最大収容数)
+    /// <summary>
+    /// EntityHandle から EntityIndex を解決する.
+    /// 実行時インデックスを持つHandleは世代番号の照合のみで解決し, 持たない場合は uuid で検索する.
+    /// </summary>
+    /// <param name="_handle">解決するハンドル</param>
+    /// <returns>見つかったEntityIndex。見つからなければ-1</returns>
+    int32_t ResolveIndex(const EntityHandle& _handle) const;
 
-    std::vector<Entity> entities_; // Entity実体のプール(インデックスで管理)
-    BitArray<uint64_t> entityActiveBits_; // 各インデックスが生存中かどうかのビット集合
+private:
+    std::vector<std::unique_ptr<Entity[]>> chunks_; // Entity実体のチャンク (インデックス / kChunkSize で引く)
+    std::vector<uint32_t> freeIndices_; // 空きスロットのスタック (末尾から取り出す)
+    std::vector<uint32_t> generations_; // 各インデックスの世代番号 (削除のたびに進む)
+    uint32_t liveCount_     = 0; // 生存エンティティ数
+    uint32_t highWaterMark_ = 0; // これまでに使用された最大インデックス + 1
+    uint64_t removeCount_ = 0; // これまでに削除したエンティティ数 (Clear も1回と数える)
 
-    std::unordered_map<uuids::uuid, int32_t> uuidToIndex_; // uuid -> entities_内インデックス
+    std::unordered_map<uuids::uuid, int32_t> uuidToIndex_; // uuid -> Entityインデックス
     std::unordered_map<std::string, uuids::uuid> uniqueEntities_; // dataType名 -> UniqueEntityのuuid
+    std::vector<uuids::uuid> reservedUuids_; // CreateEntities の作業領域
 
 public:
     /// <summary>
     /// 生存しているエンティティ数を取得
     /// </summary>
     /// <returns>生存エンティティ数</returns>
-    size_t GetEntityCount() const { return entityActiveBits_.GetTrueCount(); }
+    size_t GetEntityCount() const { return liveCount_; }
+
+    /// <summary>
+    /// これまでに削除したエンティティ数を取得 (値が変わっていなければ, 前回確認時から削除は起きていない)
+    /// </summary>
+    /// <returns>削除の累計回数</returns>
+    uint64_t GetRemoveCount() const { return removeCount_; }
 
     /// <summary>
     /// 収容可能なエンティティの最大数を取得
     /// </summary>
     /// <returns>最大エンティティ数</returns>
-    uint32_t GetCapacity() const { return static_cast<uint32_t>(entities_.size()); }
+    uint32_t GetCapacity() const { return static_cast<uint32_t>(chunks_.size()) * kChunkSize; }
+
+    /// <summary>
+    /// メモリ使用状況を取得
+    /// </summary>
+    EntityRepositoryMemoryStats GetMemoryStats() const;
 
     /// <summary>
-    /// 全エンティティ配列を取得
+    /// 全エンティティを走査する範囲を取得
     /// </summary>
-    /// <returns>エンティティ配列</returns>
-    const std::vector<Entity>& GetEntities() const { return entities_; }
+    /// <returns>エンティティの範囲</returns>
+    EntityRange<true> GetEntities() const { return EntityRange<true>(this); }
 
     /// <summary>
-    /// 全エンティティ配列をリファレンスで取得
+    /// 全エンティティを走査する範囲を取得 (書き換え可能)
     /// </summary>
-    /// <returns>エンティティ配列のリファレンス</returns>
-    std::vector<Entity>& GetEntitiesRef() { return entities_; }
+    /// <returns>エンティティの範囲</returns>
+    EntityRange<false> GetEntitiesRef() { return EntityRange<false>(this); }
 };
 
 } // namespace OriGine
@@ -0,0 +1,113 @@
+#pragma once
+
+/// stl
+#include <algorithm>
+#include <vector>
+
+/// ECS
+// entity
+#include "EntityHandle.h"
+
+namespace OriGine {
+
+/// <summary>
+/// Entityの実行時インデックスから, そのEntityが属する先 (ComponentArray の型, System など) を引く逆引き表.
+/// 値の追加/削除は O(1) (削除は末尾と入れ替えて取り除く) で, 値の順序は保持しない.
+/// 実行時インデックスを持たないHandleは記録されないため, 呼び出し側で全走査にフォールバックする.
+/// </summary>
+/// <typeparam name="ValueType">記録する値の型 (比較可能であること)</typeparam>
+template <typename ValueType>
+class EntityReverseIndex {
+public:
+    /// <summary>
+    /// Entityに値を記録する (記録済みなら何もしない)
+    /// </summary>
+    void Add(const EntityHandle& _entity, const ValueType& _value) {
+        std::vector<ValueType>* values = AcquireValues(_entity);
+        if (!values) {
+            return;
+        }
+        if (std::find(values->begin(), values->end(), _value) == values->end()) {
+            values->push_back(_value);
+        }
+    }
+
+    /// <summary>
+    /// Entityから値を取り除く
+    /// </summary>
+    void Remove(const EntityHandle& _entity, const ValueType& _value) {
+        std::vector<ValueType>* values = FindValues(_entity);
+        if (!values) {
+            return;
+        }
+        auto itr = std::find(values->begin(), values->end(), _value);
+        if (itr != values->end()) {
+            *itr = values->back();
+            values->pop_back();
+        }
+    }
+
+    /// <summary>
+    /// Entityに記録されている値を取得する
+    /// </summary>
+    /// <returns>記録されている値 (実行時インデックスを持たない, または世代が古いHandleなら nullptr)</returns>
+    const std::vector<ValueType>* Find(const EntityHandle& _entity) const {
+        if (!_entity.HasRuntimeIndex() || _entity.index >= entries_.size()) {
+            return nullptr;
+        }
+        const Entry& entry = entries_[_entity.index];
+        return entry.generation == _entity.generation ? &entry.values : nullptr;
+    }
+
+    /// <summary>
+    /// Entityに記録されている値を _outValues へ移し, 記録を空にする
+    /// </summary>
+    /// <returns>実行時インデックスで引けたら true (false の場合 _outValues は空)</returns>
+    bool Take(const EntityHandle& _entity, std::vector<ValueType>& _outValues) {
+        _outValues.clear();
+        std::vector<ValueType>* values = FindValues(_entity);
+        if (!values) {
+            return false;
+        }
+        _outValues.swap(*values);
+        return true;
+    }
+
+    /// <summary>
+    /// 全ての記録を破棄する
+    /// </summary>
+    void Clear() { entries_.clear(); }
+
+private:
+    struct Entry {
+        uint32_t generation = 0;
+        std::vector<ValueType> values;
+    };
+
+    std::vector<ValueType>* FindValues(const EntityHandle& _entity) {
+        return const_cast<std::vector<ValueType>*>(static_cast<const EntityReverseIndex*>(this)->Find(_entity));
+    }
+
+    /// <summary>
+    /// 記録先を取得する. index が別世代のEntityに再利用されていたら記録を作り直す.
+    /// </summary>
+    std::vector<ValueType>* AcquireValues(const EntityHandle& _entity) {
+        if (!_entity.HasRuntimeIndex()) {
+            return nullptr;
+        }
+        if (_entity.index >= entries_.size()) {
+            entries_.resize(static_cast<size_t>(_entity.index) + 1);
+        }
+        Entry& entry = entries_[_entity.index];
+        if (entry.generation != _entity.generation) {
+            entry.generation = _entity.generation;
+            entry.values.clear();
+        }
+        return &entry.values;
+    }
+
+private:
+    std::vector<Entry> entries_; // EntityHandle::index -> 記録
+};
+
+} // namespace OriGine
@@ -0,0 +1,133 @@
+#include "EntityCommandBuffer.h"
+
+/// engine
+#include "scene/Scene.h"
+
+/// externals
+#include "logger/Logger.h"
+
+using namespace OriGine;
+
+namespace {
+// ScopedRecord による記録先の切り替え (スレッドごと)
+thread_local const EntityCommandBuffer* tlsRecordBuffer      = nullptr;
+thread_local EntityCommandBuffer::CommandList* tlsRecordList = nullptr;
+} // namespace
+
+EntityCommandBuffer::ScopedRecord::ScopedRecord(EntityCommandBuffer* _buffer, CommandList* _list)
+    : prevBuffer_(tlsRecordBuffer), prevList_(tlsRecordList) {
+    tlsRecordBuffer = _buffer;
+    tlsRecordList   = _list;
+}
+
+EntityCommandBuffer::ScopedRecord::~ScopedRecord() {
+    tlsRecordBuffer = prevBuffer_;
+    tlsRecordList   = prevList_;
+}
+
+/// <summary>
+/// エンティティの生成を予約する
+/// </summary>
+void EntityCommandBuffer::CreateEntity(const std::string& _dataType, bool _isUnique, CreatedCallback _onCreated) {
+    Command command;
+    command.type      = Command::Type::CreateEntity;
+    command.name      = _dataType;
+    command.isUnique  = _isUnique;
+    command.onCreated = std::move(_onCreated);
+    Record(std::move(command));
+}
+
+/// <summary>
+/// コンポーネントの追加を予約する
+/// </summary>
+void EntityCommandBuffer::AddComponent(const EntityHandle& _entity, const std::string& _typeName) {
+    Command command;
+    command.type   = Command::Type::AddComponent;
+    command.entity = _entity;
+    command.name   = _typeName;
+    Record(std::move(command));
+}
+
+/// <summary>
+/// エンティティの削除予約を予約する
+/// </summary>
+void EntityCommandBuffer::AddDeleteEntity(const EntityHandle& _entity) {
+    Command command;
+    command.type   = Command::Type::AddDeleteEntity;
+    command.entity = _entity;
+    Record(std::move(command));
+}
+
+/// <summary>
+/// 別に記録したコマンド列を末尾へ移す
+/// </summary>
+void EntityCommandBuffer::Append(CommandList& _commands) {
+    if (_commands.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    commands_.insert(commands_.end(), std::make_move_iterator(_commands.begin()), std::make_move_iterator(_commands.end()));
+    _commands.clear();
+}
+
+/// <summary>
+/// 記録されたコマンドを記録順に Scene へ反映する
+/// </summary>
+void EntityCommandBuffer::Execute(Scene* _scene) {
+    if (!_scene) {
+        LOG_ERROR("EntityCommandBuffer: Scene is null.");
+        return;
+    }
+
+    CommandList executing;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (commands_.empty()) {
+                break;
+            }
+            executing.swap(commands_);
+        }
+
+        for (Command& command : executing) {
+            switch (command.type) {
+            case Command::Type::CreateEntity: {
+                EntityHandle entity = _scene->CreateEntity(command.name, command.isUnique);
+                if (command.onCreated) {
+                    command.onCreated(_scene, entity);
+                }
+                break;
+            }
+            case Command::Type::AddComponent:
+                _scene->AddComponent(command.name, command.entity);
+                break;
+            case Command::Type::AddDeleteEntity:
+                _scene->AddDeleteEntity(command.entity);
+                break;
+            }
+        }
+        executing.clear();
+    }
+}
+
+/// <summary>
+/// 記録されたコマンドを反映せずに破棄する
+/// </summary>
+void EntityCommandBuffer::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    commands_.clear();
+}
+
+void EntityCommandBuffer::Record(Command&& _command) {
+    if (tlsRecordBuffer == this && tlsRecordList) {
+        tlsRecordList->emplace_back(std::move(_command));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    commands_.emplace_back(std::move(_command));
+}
+
+size_t EntityCommandBuffer::GetCommandCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return commands_.size();
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+/// stl
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// ECS
+// entity
+#include "entity/EntityHandle.h"
+// component
+#include "component/IComponent.h"
+
+namespace OriGine {
+
+/// 前方宣言
+class Scene;
+
+/// <summary>
+/// Entity/Component の構造変更 (生成, 追加, 削除予約) を記録し, 同期点でまとめて反映するバッファ.
+/// 並列実行中のシステムは EntityRepository / ComponentArray を直接変更できないため, ここに積んでおく.
+/// 記録はスレッドセーフ. 反映 (Execute) は呼び出し元スレッドで記録順に行う.
+/// </summary>
+class EntityCommandBuffer final {
+public:
+    /// <summary>
+    /// 生成したエンティティを受け取るコールバック (反映時に呼ばれる)
+    /// </summary>
+    using CreatedCallback = std::function<void(Scene* _scene, const EntityHandle& _entity)>;
+
+    /// <summary>
+    /// 記録されたコマンド
+    /// </summary>
+    struct Command {
+        enum class Type {
+            CreateEntity,
+            AddComponent,
+            AddDeleteEntity,
+        };
+
+        Type type = Type::CreateEntity;
+        EntityHandle entity;
+        std::string name; // CreateEntity = データタイプ, AddComponent = コンポーネントの型名
+        bool isUnique = false;
+        CreatedCallback onCreated;
+    };
+    using CommandList = std::vector<Command>;
+
+    /// <summary>
+    /// 記録先をこのスレッドだけ一時的に別のリストへ切り替える.
+    /// ParallelFor のチャンクごとに記録し, 終了後にチャンク順で Append すると
+    /// スレッドの割り当てに関わらず逐次実行と同じ順序で反映される.
+    /// </summary>
+    class ScopedRecord {
+    public:
+        ScopedRecord(EntityCommandBuffer* _buffer, CommandList* _list);
+        ~ScopedRecord();
+        ScopedRecord(const ScopedRecord&)            = delete;
+        ScopedRecord& operator=(const ScopedRecord&) = delete;
+
+    private:
+        const EntityCommandBuffer* prevBuffer_ = nullptr;
+        CommandList* prevList_                 = nullptr;
+    };
+
+public:
+    EntityCommandBuffer()  = default;
+    ~EntityCommandBuffer() = default;
+
+    /// <summary>
+    /// エンティティの生成を予約する
+    /// </summary>
+    /// <param name="_dataType">エンティティのデータタイプ</param>
+    /// <param name="_isUnique">ユニークなエンティティとして登録するか</param>
+    /// <param name="_onCreated">生成後に呼ばれる処理 (コンポーネントの追加など)</param>
+    void CreateEntity(const std::string& _dataType, bool _isUnique = false, CreatedCallback _onCreated = nullptr);
+
+    /// <summary>
+    /// コンポーネントの追加を予約する
+    /// </summary>
+    /// <param name="_entity">対象のエンティティハンドル</param>
+    /// <param name="_typeName">コンポーネントの型名</param>
+    void AddComponent(const EntityHandle& _entity, const std::string& _typeName);
+    /// <summary>
+    /// コンポーネントの追加を予約する
+    /// </summary>
+    /// <typeparam name="ComponentType">コンポーネントの型</typeparam>
+    /// <param name="_entity">対象のエンティティハンドル</param>
+    template <IsComponent ComponentType>
+    void AddComponent(const EntityHandle& _entity) {
+        AddComponent(_entity, nameof<ComponentType>());
+    }
+
+    /// <summary>
+    /// エンティティの削除予約 (Scene::AddDeleteEntity) を予約する
+    /// </summary>
+    /// <param name="_entity">削除するエンティティハンドル</param>
+    void AddDeleteEntity(const EntityHandle& _entity);
+
+    /// <summary>
+    /// 別に記録したコマンド列を末尾へ移す
+    /// </summary>
+    /// <param name="_commands">移すコマンド列 (空になる)</param>
+    void Append(CommandList& _commands);
+
+    /// <summary>
+    /// 記録されたコマンドを記録順に Scene へ反映する.
+    /// 反映中に追加で記録されたコマンド (onCreated 内など) も続けて反映する.
+    /// </summary>
+    /// <param name="_scene">反映先のシーン</param>
+    void Execute(Scene* _scene);
+
+    /// <summary>
+    /// 記録されたコマンドを反映せずに破棄する
+    /// </summary>
+    void Clear();
+
+private:
+    void Record(Command&& _command);
+
+private:
+    mutable std::mutex mutex_;
+    CommandList commands_;
+
+public:
+    /// <summary>
+    /// 未反映のコマンド数
+    /// </summary>
+    size_t GetCommandCount() const;
+    bool IsEmpty() const { return GetCommandCount() == 0; }
+};
+
+} // namespace OriGine
@@ -6,6 +6,8 @@
 /// ECS
 // entity
 #include "entity/Entity.h"
+// system
+#include "system/SystemRunner.h"
 
 /// external
 #include "logger/Logger.h"
@@ -21,10 +23,140 @@ namespace OriGine {
 /// 無効なエンティティの除外
 /// </summary>
 void ISystem::EraseDeadEntity() {
-    ::std::erase_if(entities_, [&entityRepository = this->entityRepository_](const EntityHandle& _handle) {
-        Entity* entity = entityRepository->GetEntity(_handle);
-        return !_handle.IsValid() || !entity || !entity->IsAlive();
-    });
+    // 前回の確認以降に削除も登録も無ければ, 無効なエンティティは存在しない
+    const uint64_t removeCount = entityRepository_->GetRemoveCount();
+    if (!hasUncheckedEntity_ && checkedRemoveCount_ == removeCount) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(entities_.size());) {
+        const EntityHandle& handle = entities_[i];
+        Entity* entity             = entityRepository_->GetEntity(handle);
+        if (!handle.IsValid() || !entity || !entity->IsAlive()) {
+            // 削除済みのエンティティは世代番号で逆引き表から外れるため, 逆引き表は更新しない
+            // (他のシステムと並列に実行されている可能性があるため, 共有の表には触れない)
+            RemoveEntityAt(i, false);
+            continue;
+        }
+        ++i;
+    }
+
+    checkedRemoveCount_ = removeCount;
+    hasUncheckedEntity_ = false;
+}
+
+/// <summary>
+/// entities_ 内の位置を検索する
+/// </summary>
+uint32_t ISystem::FindEntityPosition(const EntityHandle& _entity) const {
+    if (_entity.HasRuntimeIndex()) {
+        if (_entity.index < entityMembership_.size()) {
+            const EntityMembership& membership = entityMembership_[_entity.index];
+            if (membership.generation == _entity.generation && membership.position != kNotMember) {
+                return membership.position;
+            }
+        }
+        // uuid だけのHandleで登録されたEntityは逆引き表に載っていないので, uuid で探す
+        if (unindexedEntityCount_ == 0) {
+            return kNotMember;
+        }
+    }
+
+    auto itr = ::std::find_if(
+        entities_.begin(),
+        entities_.end(),
+        [&](const EntityHandle& e) { return e.uuid == _entity.uuid; });
+    return itr != entities_.end() ? static_cast<uint32_t>(itr - entities_.begin()) : kNotMember;
+}
+
+/// <summary>
+/// entities_ の指定位置のEntityを末尾と入れ替えて取り除く
+/// </summary>
+void ISystem::RemoveEntityAt(uint32_t _position, bool _updateSystemIndex) {
+    EntityHandle removed = entities_[_position];
+
+    const uint32_t lastPosition = static_cast<uint32_t>(entities_.size()) - 1;
+    if (_position != lastPosition) {
+        entities_[_position] = entities_[lastPosition];
+        SetMembership(entities_[_position], _position);
+    }
+    entities_.pop_back();
+
+    SetMembership(removed, kNotMember);
+    if (!removed.HasRuntimeIndex()) {
+        --unindexedEntityCount_;
+    }
+    if (_updateSystemIndex && systemIndex_) {
+        systemIndex_->Remove(removed, this);
+    }
+}
+
+/// <summary>
+/// Entityをシステムに登録する
+/// </summary>
+void ISystem::AddEntity(const EntityHandle& _entity) {
+    // uuid だけのHandleは, 逆引きできるよう実行時インデックスを持つHandleに解決してから登録する
+    EntityHandle entity = _entity;
+    if (!entity.HasRuntimeIndex() && entityRepository_ && entityRepository_->IsAlive(entity)) {
+        entity = entityRepository_->GetEntity(entity)->GetHandle();
+    }
+
+    if (HasEntity(entity)) {
+        return;
+    }
+    entities_.push_back(entity);
+    SetMembership(entity, static_cast<uint32_t>(entities_.size()) - 1);
+    if (!entity.HasRuntimeIndex()) {
+        ++unindexedEntityCount_;
+    }
+    hasUncheckedEntity_ = true;
+
+    if (systemIndex_) {
+        systemIndex_->Add(entity, this);
+    }
+}
+
+/// <summary>
+/// Entityをシステムから除外する
+/// </summary>
+void ISystem::RemoveEntity(const EntityHandle& _entity) {
+    uint32_t position = FindEntityPosition(_entity);
+    if (position == kNotMember) {
+        return;
+    }
+    RemoveEntityAt(position, true);
+}
+
+/// <summary>
+/// 全てのEntityをシステムから除外する
+/// </summary>
+void ISystem::ClearEntities() {
+    if (systemIndex_) {
+        for (const EntityHandle& entity : entities_) {
+            systemIndex_->Remove(entity, this);
+        }
+    }
+    entities_.clear();
+    entityMembership_.clear();
+    unindexedEntityCount_ = 0;
+    hasUncheckedEntity_   = false;
+}
+
+/// <summary>
+/// Entity -> 登録されているシステム の逆引き表を設定する
+/// </summary>
+void ISystem::SetSystemIndex(EntityReverseIndex<ISystem*>* _systemIndex) {
+    if (systemIndex_) {
+        for (const EntityHandle& entity : entities_) {
+            systemIndex_->Remove(entity, this);
+        }
+    }
+    systemIndex_ = _systemIndex;
+    if (systemIndex_) {
+        for (const EntityHandle& entity : entities_) {
+            systemIndex_->Add(entity, this);
+        }
+    }
 }
 
 /// <summary>
@@ -94,6 +226,18 @@ ComponentHandle ISystem::AddComponent(const EntityHandle& _entity, const ::std::
     return scene_->GetComponentRepositoryRef()->GetComponentArray(_typeName)->AddComponent(scene_, _entity);
 }
 
+/// <summary>
+/// 構造変更を遅延させるためのコマンドバッファを取得する
+/// </summary>
+/// <returns>コマンドバッファ (Scene未設定時はnullptr)</returns>
+EntityCommandBuffer* ISystem::GetCommandBuffer() {
+    if (scene_ == nullptr || scene_->GetSystemRunnerRef() == nullptr) {
+        LOG_ERROR("Scene is not Set.");
+        return nullptr;
+    }
+    return scene_->GetSystemRunnerRef()->GetCommandBufferRef();
+}
+
 /// <summary>
 /// 所属シーンの設定
 /// </summary>
@@ -132,6 +276,44 @@ void ISystem::Run() {
 #endif
 }
 
+/// <summary>
+/// 他のシステムと同時に実行できないか
+/// </summary>
+/// <param name="_other">比較するシステム</param>
+/// <returns>競合するなら true</returns>
+bool ISystem::IsConflictWith(const ISystem& _other) const {
+    if (!hasAccessDeclaration_ || !_other.hasAccessDeclaration_) {
+        return true;
+    }
+
+    // 昇順リスト同士に共通要素があるか
+    auto intersects = [](const std::vector<ComponentTypeId>& _a, const std::vector<ComponentTypeId>& _b) {
+        auto itrA = _a.begin();
+        auto itrB = _b.begin();
+        while (itrA != _a.end() && itrB != _b.end()) {
+            if (*itrA == *itrB) {
+                return true;
+            }
+            (*itrA < *itrB) ? ++itrA : ++itrB;
+        }
+        return false;
+    };
+
+    return intersects(writeComponentTypes_, _other.writeComponentTypes_)
+           || intersects(writeComponentTypes_, _other.readComponentTypes_)
+           || intersects(readComponentTypes_, _other.writeComponentTypes_);
+}
+
+/// <summary>
+/// 宣言リストへ型IDを昇順を保って追加する
+/// </summary>
+void ISystem::InsertComponentTypeId(std::vector<ComponentTypeId>& _list, ComponentTypeId _typeId) {
+    auto itr = std::lower_bound(_list.begin(), _list.end(), _typeId);
+    if (itr == _list.end() || *itr != _typeId) {
+        _list.insert(itr, _typeId);
+    }
+}
+
 /// <summary>
 /// システムの基本更新処理
 /// </summary>
@@ -142,6 +324,15 @@ void ISystem::Update() {
 
     EraseDeadEntity();
 
+    if (isParallelUpdate_) {
+        ParallelFor(static_cast<uint32_t>(entities_.size()), [this](uint32_t _begin, uint32_t _end) {
+            for (uint32_t i = _begin; i < _end; ++i) {
+                UpdateEntity(entities_[i]);
+            }
+        });
+        return;
+    }
+
     for (auto& entityID : entities_) {
         UpdateEntity(entityID);
     }
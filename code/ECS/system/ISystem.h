@@ -8,15 +8,19 @@
 // entity
 #include "entity/Entity.h"
 #include "entity/EntityHandle.h"
+#include "entity/EntityReverseIndex.h"
 // component
 #include "component/ComponentArray.h"
 #include "component/ComponentHandle.h"
 #include "component/ComponentRepository.h"
+#include "component/ComponentTypeId.h"
 // system
+#include "system/EntityCommandBuffer.h"
 #include "system/SystemCategory.h"
 
 /// util
 #include "deltaTime/DeltaTimer.h"
+#include "jobSystem/JobSystem.h"
 
 namespace OriGine {
 
@@ -28,6 +32,11 @@ namespace OriGine {
 	/// </summary>
 	class ISystem{
 	public:
+		/// <summary>
+		/// 並列更新時に1ジョブへまとめるEntity数の既定値
+		/// </summary>
+		static constexpr uint32_t kDefaultParallelGrainSize = 256;
+
 		/// <summary>
 		/// コンストラクタ
 		/// </summary>
@@ -60,7 +69,8 @@ namespace OriGine {
 		virtual void Edit();
 
 		/// <summary>
-		/// 無効Entityの削除処理
+		/// 無効Entityの削除処理.
+		/// 前回の確認以降にEntityの削除も登録も無ければ走査を省略する.
 		/// </summary>
 		void EraseDeadEntity();
 
@@ -70,7 +80,8 @@ namespace OriGine {
 		/// </summary>
 		virtual void Update();
 		/// <summary>
-		/// 更新処理 (Entity単位)
+		/// 更新処理 (Entity単位).
+		/// 並列更新が有効な場合は複数のスレッドから同時に呼ばれるため, 対象Entityのコンポーネント以外を書き換えてはならない.
 		/// </summary>
 		/// <param name="_handle">対象のエンティティハンドル</param>
 		virtual void UpdateEntity([[maybe_unused]] const EntityHandle& _handle){}
@@ -133,7 +144,16 @@ namespace OriGine {
 		/// <param name="_entity">対象のエンティティハンドル</param>
 		/// <returns>コンポーネントのリストへの参照</returns>
 		template <IsComponent ComponentType>
-		std::vector<ComponentType>& GetComponents(const EntityHandle& _entity);
+		ComponentList<ComponentType>& GetComponents(const EntityHandle& _entity);
+
+		/// <summary>
+		/// エンティティが特定の型のコンポーネントを持っているか (Entity のシグネチャで O(1) に判定する)
+		/// </summary>
+		/// <typeparam name="ComponentType">コンポーネントの型</typeparam>
+		/// <param name="_entity">対象のエンティティハンドル</param>
+		/// <returns>1つ以上持っていればtrue</returns>
+		template <IsComponent ComponentType>
+		bool HasComponent(const EntityHandle& _entity) const;
 
 		/// <summary>
 		/// コンポーネント配列を取得する
@@ -143,6 +163,15 @@ namespace OriGine {
 		template <IsComponent ComponentType>
 		ComponentArray<ComponentType>* GetComponentArray();
 
+		/// <summary>
+		/// 指定した型のコンポーネントを全て持つエンティティを列挙するクエリを作成する
+		/// (システムへの登録有無は問わないため, 必要なら HasEntity で絞り込む)
+		/// </summary>
+		/// <typeparam name="ComponentTypes">コンポーネントの型</typeparam>
+		/// <returns>クエリ</returns>
+		template <IsComponent... ComponentTypes>
+		ComponentQuery<ComponentTypes...> Query();
+
 		/// <summary>
 		/// コンポーネントを追加する
 		/// </summary>
@@ -160,9 +189,105 @@ namespace OriGine {
 		/// <returns>追加されたコンポーネントのハンドル</returns>
 		ComponentHandle AddComponent(const EntityHandle& _entity,const ::std::string& _typeName);
 
+		/// <summary>
+		/// 構造変更 (Entityの生成, Componentの追加, Entityの削除予約) を遅延させるためのコマンドバッファを取得する.
+		/// 記録したコマンドはカテゴリの実行後に SystemRunner が反映する.
+		/// 並列に実行される Update 中は CreateEntity / AddComponent / Scene::AddDeleteEntity の代わりにこちらを使う.
+		/// </summary>
+		/// <returns>コマンドバッファ (Scene未設定時はnullptr)</returns>
+		EntityCommandBuffer* GetCommandBuffer();
+
+	protected:
+		/// <summary>
+		/// Entity単位の並列更新を有効にする (コンストラクタで呼ぶ).
+		/// 既定の Update は entities_ を _grainSize ごとに分割し, JobSystem 上で UpdateEntity を並列に呼び出す.
+		/// </summary>
+		/// <param name="_grainSize">1ジョブあたりのEntity数</param>
+		void EnableParallelUpdate(uint32_t _grainSize = kDefaultParallelGrainSize){
+			isParallelUpdate_  = true;
+			parallelGrainSize_ = _grainSize > 0 ? _grainSize : 1;
+		}
+
+		/// <summary>
+		/// [0, _count) を分割して _func(_begin, _end) を呼び出す.
+		/// 並列更新が有効なら JobSystem 上で並列に, 無効なら呼び出したスレッドで一度に実行する.
+		/// 分割ごとに記録したコマンドは分割順にコマンドバッファへ移すため, 反映順は逐次実行と変わらない.
+		/// 記録先はシステムが持つリストを使い回すため, _func の中から同じシステムの ParallelFor を呼んではいけない.
+		/// </summary>
+		/// <param name="_count">要素数</param>
+		/// <param name="_func">void(uint32_t _begin, uint32_t _end)</param>
+		template <typename Func>
+		void ParallelFor(uint32_t _count,Func&& _func);
+
+	protected:
+		/// <summary>
+		/// Update中に読み取るコンポーネント型を宣言する (コンストラクタで呼ぶ).
+		/// 読み書きを宣言したシステム同士は, 宣言が競合しなければ SystemRunner によって並列に実行される.
+		/// 宣言のないシステムは全てのシステムと競合するものとして扱われる.
+		/// </summary>
+		/// <typeparam name="ComponentTypes">読み取るコンポーネントの型</typeparam>
+		template <IsComponent... ComponentTypes>
+		void DeclareRead();
+		/// <summary>
+		/// Update中に書き込むコンポーネント型を宣言する (コンストラクタで呼ぶ)
+		/// </summary>
+		/// <typeparam name="ComponentTypes">書き込むコンポーネントの型</typeparam>
+		template <IsComponent... ComponentTypes>
+		void DeclareWrite();
+
 	protected:
 		std::vector<EntityHandle> entities_;
 
+	private:
+		static constexpr uint32_t kNotMember = 0xFFFFFFFF;
+		/// <summary>
+		/// entities_ 内の位置の逆引き. HasEntity / RemoveEntity を O(1) で行うために使う
+		/// </summary>
+		struct EntityMembership{
+			uint32_t generation = 0; // 登録時の世代番号
+			uint32_t position   = kNotMember; // entities_ 内の位置
+		};
+		// EntityHandle::index -> 登録状態
+		std::vector<EntityMembership> entityMembership_;
+		// 実行時インデックスを持たないまま登録されたEntityの数 (逆引きできないため, 生存確認を省略できない)
+		uint32_t unindexedEntityCount_ = 0;
+
+		// EraseDeadEntity の走査を省略するための状態
+		uint64_t checkedRemoveCount_ = 0; // 前回確認した EntityRepository::GetRemoveCount()
+		bool hasUncheckedEntity_     = false; // 前回確認以降に登録されたEntityがあるか
+
+		// Entity -> 登録されているシステム の逆引き表 (SystemRunner が所有)
+		EntityReverseIndex<ISystem*>* systemIndex_ = nullptr;
+
+		/// <summary>
+		/// 登録位置を記録する
+		/// </summary>
+		/// <param name="_entity">対象のエンティティハンドル</param>
+		/// <param name="_position">entities_ 内の位置 (kNotMember = 未登録)</param>
+		void SetMembership(const EntityHandle& _entity,uint32_t _position){
+			if(!_entity.HasRuntimeIndex()){
+				return;
+			}
+			if(_entity.index >= entityMembership_.size()){
+				if(_position == kNotMember){
+					return;
+				}
+				entityMembership_.resize(static_cast<size_t>(_entity.index) + 1);
+			}
+			entityMembership_[_entity.index] = {_entity.generation,_position};
+		}
+		/// <summary>
+		/// entities_ 内の位置を検索する
+		/// </summary>
+		/// <returns>見つからなければ kNotMember</returns>
+		uint32_t FindEntityPosition(const EntityHandle& _entity) const;
+		/// <summary>
+		/// entities_ の指定位置のEntityを末尾と入れ替えて取り除く
+		/// </summary>
+		/// <param name="_position">取り除く位置</param>
+		/// <param name="_updateSystemIndex">システムの逆引き表も更新するか (削除済みEntityは世代で無効になるため不要)</param>
+		void RemoveEntityAt(uint32_t _position,bool _updateSystemIndex);
+
 	#ifndef _RELEASE
 		DeltaTimer deltaTimer_;
 	#endif
@@ -176,6 +301,22 @@ namespace OriGine {
 		int32_t priority_ = 0;
 		bool isActive_    = false;
 
+		// 並列実行のための読み書き宣言 (昇順, 重複なし)
+		std::vector<ComponentTypeId> readComponentTypes_;
+		std::vector<ComponentTypeId> writeComponentTypes_;
+		bool hasAccessDeclaration_ = false;
+
+		// Entity単位の並列更新
+		bool isParallelUpdate_      = false;
+		uint32_t parallelGrainSize_  = kDefaultParallelGrainSize;
+		// ParallelFor の分割ごとのコマンド記録先. 毎フレーム確保し直さないよう, 容量を残したまま使い回す
+		std::vector<EntityCommandBuffer::CommandList> parallelChunkCommands_;
+
+		/// <summary>
+		/// 宣言リストへ型IDを昇順を保って追加する
+		/// </summary>
+		static void InsertComponentTypeId(std::vector<ComponentTypeId>& _list,ComponentTypeId _typeId);
+
 	public:
 		//==========================================
 		// accessor
@@ -214,41 +355,44 @@ namespace OriGine {
 		/// <param name="_entity">対象のエンティティハンドル</param>
 		/// <returns>登録されていればtrue</returns>
 		bool HasEntity(const EntityHandle& _entity) const{
-			return std::find_if(
-				entities_.begin(),
-				entities_.end(),
-				[&](const EntityHandle& e){ return e.uuid == _entity.uuid; })
-				!= entities_.end();
+			return FindEntityPosition(_entity) != kNotMember;
 		}
 
 		/// <summary>
 		/// Entityをシステムに登録する
 		/// </summary>
 		/// <param name="_entity">登録するエンティティハンドル</param>
-		void AddEntity(const EntityHandle& _entity){
-			if(!HasEntity(_entity)){
-				entities_.push_back(_entity);
-			}
-		}
+		void AddEntity(const EntityHandle& _entity);
 
 		/// <summary>
-		/// Entityをシステムから除外する
+		/// Entityをシステムから除外する.
+		/// 末尾のEntityと入れ替えて取り除くため, entities_ の並び順は保持されない.
 		/// </summary>
 		/// <param name="_entity">除外するエンティティハンドル</param>
-		void RemoveEntity(const EntityHandle& _entity){
-			entities_.erase(
-				std::remove_if(
-				entities_.begin(),
-				entities_.end(),
-				[&](const EntityHandle& e){ return e.uuid == _entity.uuid; }),
-				entities_.end());
-		}
+		void RemoveEntity(const EntityHandle& _entity);
 
 		/// <summary>
 		/// 全てのEntityをシステムから除外する
 		/// </summary>
-		void ClearEntities(){
-			entities_.clear();
+		void ClearEntities();
+
+		/// <summary>
+		/// Entity -> 登録されているシステム の逆引き表を設定する (SystemRunner が登録時に呼ぶ).
+		/// 登録済みのEntityは新しい表へ移す.
+		/// </summary>
+		/// <param name="_systemIndex">逆引き表 (nullptr で解除)</param>
+		void SetSystemIndex(EntityReverseIndex<ISystem*>* _systemIndex);
+
+		/// <summary>
+		/// 既にシステムから除外済みのEntityが EntityRepository から削除されたことを伝える.
+		/// 前回の確認以降に他の削除が無ければ, 次の EraseDeadEntity の走査を省略できるようにする.
+		/// </summary>
+		/// <param name="_prevRemoveCount">削除前の EntityRepository::GetRemoveCount()</param>
+		/// <param name="_removeCount">削除後の EntityRepository::GetRemoveCount()</param>
+		void SyncRemoveCount(uint64_t _prevRemoveCount,uint64_t _removeCount){
+			if(checkedRemoveCount_ == _prevRemoveCount && unindexedEntityCount_ == 0){
+				checkedRemoveCount_ = _removeCount;
+			}
 		}
 
 		/// <summary>
@@ -272,8 +416,104 @@ namespace OriGine {
 		/// </summary>
 		/// <param name="_isActive">アクティブにするならtrue</param>
 		void SetIsActive(bool _isActive){ isActive_ = _isActive; }
+
+		/// <summary>
+		/// Entity単位の並列更新が有効か
+		/// </summary>
+		bool IsParallelUpdate() const{ return isParallelUpdate_; }
+		/// <summary>
+		/// Entity単位の並列更新を切り替える (比較計測やデバッグ用)
+		/// </summary>
+		void SetParallelUpdate(bool _isParallel){ isParallelUpdate_ = _isParallel; }
+		/// <summary>
+		/// 並列更新時に1ジョブへまとめるEntity数
+		/// </summary>
+		uint32_t GetParallelGrainSize() const{ return parallelGrainSize_; }
+
+		/// <summary>
+		/// コンポーネントの読み書きを宣言しているか (していなければ並列実行されない)
+		/// </summary>
+		bool HasAccessDeclaration() const{ return hasAccessDeclaration_; }
+		/// <summary>
+		/// 読み取りを宣言したコンポーネント型
+		/// </summary>
+		const std::vector<ComponentTypeId>& GetReadComponentTypes() const{ return readComponentTypes_; }
+		/// <summary>
+		/// 書き込みを宣言したコンポーネント型
+		/// </summary>
+		const std::vector<ComponentTypeId>& GetWriteComponentTypes() const{ return writeComponentTypes_; }
+
+		/// <summary>
+		/// 他のシステムと同時に実行できないか.
+		/// どちらかが宣言を持たない場合, または一方の書き込みがもう一方の読み書きと重なる場合に競合する.
+		/// </summary>
+		/// <param name="_other">比較するシステム</param>
+		/// <returns>競合するなら true</returns>
+		bool IsConflictWith(const ISystem& _other) const;
 	};
 
+	/// <summary>
+	/// Update中に読み取るコンポーネント型を宣言する
+	/// </summary>
+	/// <typeparam name="ComponentTypes">読み取るコンポーネントの型</typeparam>
+	template <IsComponent... ComponentTypes>
+	inline void ISystem::DeclareRead(){
+		hasAccessDeclaration_ = true;
+		(InsertComponentTypeId(readComponentTypes_,GetComponentTypeId<ComponentTypes>()), ...);
+	}
+
+	/// <summary>
+	/// Update中に書き込むコンポーネント型を宣言する
+	/// </summary>
+	/// <typeparam name="ComponentTypes">書き込むコンポーネントの型</typeparam>
+	template <IsComponent... ComponentTypes>
+	inline void ISystem::DeclareWrite(){
+		hasAccessDeclaration_ = true;
+		(InsertComponentTypeId(writeComponentTypes_,GetComponentTypeId<ComponentTypes>()), ...);
+	}
+
+	/// <summary>
+	/// [0, _count) を分割して並列に実行する
+	/// </summary>
+	/// <param name="_count">要素数</param>
+	/// <param name="_func">void(uint32_t _begin, uint32_t _end)</param>
+	template <typename Func>
+	inline void ISystem::ParallelFor(uint32_t _count,Func&& _func){
+		JobSystem* jobSystem = JobSystem::GetInstance();
+		if(!isParallelUpdate_ || !jobSystem->IsRunning() || _count <= parallelGrainSize_){
+			_func(0u,_count);
+			return;
+		}
+
+		// 分割先で ComponentArray の遅延登録 (リポジトリの書き換え) が起きないよう, 宣言済みの型を用意しておく
+		if(componentRepository_){
+			componentRepository_->PrepareComponentArrays(readComponentTypes_);
+			componentRepository_->PrepareComponentArrays(writeComponentTypes_);
+		}
+
+		EntityCommandBuffer* commandBuffer = GetCommandBuffer();
+		const uint32_t grainSize           = parallelGrainSize_;
+		const uint32_t chunkCount          = (_count + grainSize - 1) / grainSize;
+		// 縮めると末尾のリストの容量を捨ててしまうので, 足りないときだけ伸ばす
+		if(parallelChunkCommands_.size() < chunkCount){
+			parallelChunkCommands_.resize(chunkCount);
+		}
+
+		jobSystem->ParallelFor(_count,grainSize,[&](uint32_t _begin,uint32_t _end){
+			EntityCommandBuffer::ScopedRecord record(commandBuffer,&parallelChunkCommands_[_begin / grainSize]);
+			_func(_begin,_end);
+		});
+
+		// Append は中身を移して空にする (容量は残る)
+		for(uint32_t chunk = 0; chunk < chunkCount; ++chunk){
+			if(commandBuffer){
+				commandBuffer->Append(parallelChunkCommands_[chunk]);
+			} else{
+				parallelChunkCommands_[chunk].clear();
+			}
+		}
+	}
+
 	/// <summary>
 	/// コンポーネントを取得する
 	/// </summary>
@@ -313,17 +553,32 @@ namespace OriGine {
 	/// <param name="_entity">対象のエンティティハンドル</param>
 	/// <returns>コンポーネントリストの参照</returns>
 	template <IsComponent ComponentType>
-	inline std::vector<ComponentType>& ISystem::GetComponents(const EntityHandle& _entity){
+	inline ComponentList<ComponentType>& ISystem::GetComponents(const EntityHandle& _entity){
 		auto* componentArray = GetComponentArray<ComponentType>();
 		if(!componentArray){
 			LOG_ERROR("ComponentArray is not found.");
 			// ダミーの空配列を返す
-			static std::vector<ComponentType> emptyComponents;
+			static ComponentList<ComponentType> emptyComponents;
 			return emptyComponents;
 		}
 		return componentArray->GetComponents(_entity);
 	}
 
+	/// <summary>
+	/// エンティティが特定の型のコンポーネントを持っているか
+	/// </summary>
+	/// <typeparam name="ComponentType">コンポーネントの型</typeparam>
+	/// <param name="_entity">対象のエンティティハンドル</param>
+	/// <returns>1つ以上持っていればtrue</returns>
+	template <IsComponent ComponentType>
+	inline bool ISystem::HasComponent(const EntityHandle& _entity) const{
+		if(!componentRepository_){
+			LOG_ERROR("ComponentRepository is not set.");
+			return false;
+		}
+		return componentRepository_->HasComponent<ComponentType>(_entity);
+	}
+
 	/// <summary>
 	/// コンポーネント配列を取得する
 	/// </summary>
@@ -338,6 +593,20 @@ namespace OriGine {
 		return componentRepository_->GetComponentArray<ComponentType>();
 	}
 
+	/// <summary>
+	/// 指定した型のコンポーネントを全て持つエンティティを列挙するクエリを作成する
+	/// </summary>
+	/// <typeparam name="ComponentTypes">コンポーネントの型</typeparam>
+	/// <returns>クエリ (ComponentRepository未設定時は空のクエリ)</returns>
+	template <IsComponent... ComponentTypes>
+	inline ComponentQuery<ComponentTypes...> ISystem::Query(){
+		if(!componentRepository_){
+			LOG_ERROR("ComponentRepository is not set.");
+			return ComponentQuery<ComponentTypes...>(static_cast<ComponentArray<ComponentTypes>*>(nullptr)...);
+		}
+		return componentRepository_->Query<ComponentTypes...>();
+	}
+
 	/// <summary>
 	/// コンポーネントを追加する
 	/// </summary>
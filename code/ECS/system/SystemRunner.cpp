@@ -4,6 +4,9 @@
 // system
 #include "SystemRegistry.h"
 
+/// engine
+#include "scene/Scene.h"
+
 using namespace OriGine;
 
 /// <summary>
@@ -142,11 +145,15 @@ void SystemRunner::AllUnregisterSystem(bool _isFinalize) {
         if (_isFinalize) {
             system->Finalize();
         }
+        system->SetSystemIndex(nullptr);
     }
     for (size_t i = 0; i < static_cast<size_t>(SystemCategory::Count); ++i) {
         activeSystems_[i].clear();
     }
     systems_.clear();
+    entitySystemIndex_.Clear();
+    // シーンの終了時に呼ばれるため, 未反映の構造変更は破棄する
+    commandBuffer_.Clear();
 }
 
 /// <summary>
@@ -158,12 +165,35 @@ void SystemRunner::UpdateCategory(SystemCategory _category) {
         return;
     }
 
-    for (size_t i = 0; i < activeSystems_[static_cast<size_t>(_category)].size(); ++i) {
-        auto& system = activeSystems_[static_cast<size_t>(_category)][i];
-        if (system) {
-            system->Run();
-        }
+    auto& activeSystems = activeSystems_[static_cast<size_t>(_category)];
+    if (!scheduler_.IsUpToDate(_category, activeSystems)) {
+        RebuildSchedule(_category);
+    }
+
+    scheduler_.ExecuteCategory(_category, scene_ ? scene_->GetComponentRepositoryRef() : nullptr);
+
+    // 同期点: 並列実行中に記録された構造変更を反映する
+    if (scene_ && !commandBuffer_.IsEmpty()) {
+        commandBuffer_.Execute(scene_);
+    }
+}
+
+/// <summary>
+/// 指定したカテゴリの実行計画を作り直す
+/// </summary>
+/// <param name="_category">対象のカテゴリ</param>
+void SystemRunner::RebuildSchedule(SystemCategory _category) {
+    auto& activeSystems = activeSystems_[static_cast<size_t>(_category)];
+
+    // タイムライン表示用に登録名を引いておく
+    ::std::vector<::std::string> systemNames;
+    systemNames.reserve(activeSystems.size());
+    for (auto& system : activeSystems) {
+        auto itr = ::std::find_if(systems_.begin(), systems_.end(), [&system](const auto& _pair) { return _pair.second == system; });
+        systemNames.emplace_back(itr != systems_.end() ? itr->first : ::std::string("Unknown"));
     }
+
+    scheduler_.BuildCategory(_category, activeSystems, systemNames);
 }
 
 /// <summary>
@@ -183,6 +213,7 @@ void SystemRunner::RegisterSystem(const std::string& _systemName, int32_t _prior
         }
 
         createdSystem->SetScene(scene_);
+        createdSystem->SetSystemIndex(&entitySystemIndex_);
 
         createdSystem->SetPriority(_priority);
         if (_isInitialize) {
@@ -242,7 +273,8 @@ void SystemRunner::ActivateSystem(const std::string& _systemName) {
 
     itr->second->SetIsActive(true);
     activeSystems.push_back(itr->second);
-    std::sort(
+    // 同じ優先度同士の順序も実行ごとに変わらないよう安定ソートする
+    std::stable_sort(
         activeSystems.begin(),
         activeSystems.end(),
         [](const std::shared_ptr<ISystem>& a, const std::shared_ptr<ISystem>& b) {
@@ -329,6 +361,14 @@ void SystemRunner::RemoveEntity(const std::string& _systemTypeName, const Entity
 /// </summary>
 /// <param name="_handle">対象のエンティティハンドル</param>
 void SystemRunner::RemoveEntityFromAllSystems(const EntityHandle& _handle) {
+    // 逆引きできれば, 登録されているシステムだけから削除する
+    if (entitySystemIndex_.Take(_handle, removingSystems_)) {
+        for (ISystem* system : removingSystems_) {
+            system->RemoveEntity(_handle);
+        }
+        return;
+    }
+
     // 各システムからエンティティを削除
     for (auto& [name, system] : systems_) {
         if (system) {
@@ -337,6 +377,17 @@ void SystemRunner::RemoveEntityFromAllSystems(const EntityHandle& _handle) {
     }
 }
 
+/// <summary>
+/// システムから除外済みのエンティティが削除されたことを全システムへ伝える
+/// </summary>
+void SystemRunner::SyncRemoveCount(uint64_t _prevRemoveCount, uint64_t _removeCount) {
+    for (auto& [name, system] : systems_) {
+        if (system) {
+            system->SyncRemoveCount(_prevRemoveCount, _removeCount);
+        }
+    }
+}
+
 /// <summary>
 /// システム名からシステムを取得する
 /// </summary>
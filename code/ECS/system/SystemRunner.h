@@ -5,8 +5,10 @@
 
 /// ECS
 // system
+#include "EntityCommandBuffer.h"
 #include "ISystem.h"
 #include "SystemCategory.h"
+#include "SystemScheduler.h"
 
 namespace OriGine {
 
@@ -100,7 +102,9 @@ public:
     void AllUnregisterSystem(bool _isFinalize = false);
 
     /// <summary>
-    /// 指定したカテゴリのSystemを更新する
+    /// 指定したカテゴリのSystemを更新する.
+    /// 読み書きを宣言したシステム同士は, 競合しなければ並列に実行される (SystemScheduler 参照).
+    /// カテゴリの実行後, システムが記録した構造変更 (EntityCommandBuffer) を反映する.
     /// </summary>
     /// <param name="_category">対象のカテゴリ</param>
     void UpdateCategory(SystemCategory _category);
@@ -193,6 +197,14 @@ public:
     /// <param name="_handle">削除するEntityハンドル</param>
     void RemoveEntityFromAllSystems(const EntityHandle& _handle);
 
+    /// <summary>
+    /// システムから除外済みのエンティティが EntityRepository から削除されたことを全システムへ伝える.
+    /// 他に削除が無ければ, 次の更新で各システムの生存確認 (ISystem::EraseDeadEntity) が省略される.
+    /// </summary>
+    /// <param name="_prevRemoveCount">削除前の EntityRepository::GetRemoveCount()</param>
+    /// <param name="_removeCount">削除後の EntityRepository::GetRemoveCount()</param>
+    void SyncRemoveCount(uint64_t _prevRemoveCount, uint64_t _removeCount);
+
 private:
     Scene* scene_ = nullptr; // 所属するシーン
 
@@ -201,6 +213,18 @@ private:
     ::std::unordered_map<::std::string, ::std::shared_ptr<ISystem>> systems_;
     ::std::array<::std::vector<::std::shared_ptr<ISystem>>, size_t(SystemCategory::Count)> activeSystems_;
 
+    SystemScheduler scheduler_; // カテゴリ内の実行計画と並列実行
+    EntityCommandBuffer commandBuffer_; // システムが遅延させた構造変更 (カテゴリの実行後に反映)
+
+    EntityReverseIndex<ISystem*> entitySystemIndex_; // Entity -> 登録されているシステム
+    ::std::vector<ISystem*> removingSystems_; // RemoveEntityFromAllSystems の作業領域
+
+    /// <summary>
+    /// 指定したカテゴリの実行計画を作り直す
+    /// </summary>
+    /// <param name="_category">対象のカテゴリ</param>
+    void RebuildSchedule(SystemCategory _category);
+
 public:
     /// <summary>
     /// カテゴリごとのアクティビティ状態を取得する
@@ -233,6 +257,20 @@ public:
         categoryActivity[static_cast<size_t>(_category)] = _isActive;
     }
 
+    /// <summary>
+    /// システムの実行計画 (実行方式, タイムライン記録) を取得する
+    /// </summary>
+    const SystemScheduler& GetScheduler() const { return scheduler_; }
+    /// <summary>
+    /// システムの実行計画 (実行方式, タイムライン記録) を取得する
+    /// </summary>
+    SystemScheduler& GetSchedulerRef() { return scheduler_; }
+
+    /// <summary>
+    /// システムが構造変更を遅延させるためのコマンドバッファを取得する
+    /// </summary>
+    EntityCommandBuffer* GetCommandBufferRef() { return &commandBuffer_; }
+
     /// <summary>
     /// 登録されている全てのシステムを取得する
     /// </summary>
@@ -0,0 +1,240 @@
+#include "SystemScheduler.h"
+
+/// stl
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+
+/// ECS
+// component
+#include "component/ComponentRepository.h"
+// system
+#include "ISystem.h"
+
+/// util
+#include "jobSystem/JobSystem.h"
+
+/// externals
+#include "logger/Logger.h"
+#include <nlohmann/json.hpp>
+
+using namespace OriGine;
+
+/// <summary>
+/// 実行計画が指定したシステム列から作られたものか
+/// </summary>
+bool SystemScheduler::IsUpToDate(SystemCategory _category, const std::vector<std::shared_ptr<ISystem>>& _systems) const {
+    const CategoryGraph& graph = graphs_[static_cast<size_t>(_category)];
+    if (graph.nodes.size() != _systems.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < _systems.size(); ++i) {
+        if (graph.nodes[i].system != _systems[i].get()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// <summary>
+/// カテゴリの実行計画を作り直す
+/// </summary>
+void SystemScheduler::BuildCategory(SystemCategory _category, const std::vector<std::shared_ptr<ISystem>>& _systems, const std::vector<std::string>& _systemNames) {
+    CategoryGraph& graph = graphs_[static_cast<size_t>(_category)];
+    graph.nodes.clear();
+    graph.declaredComponentTypes.clear();
+    graph.hasParallelism = false;
+
+    graph.nodes.resize(_systems.size());
+    for (size_t i = 0; i < _systems.size(); ++i) {
+        Node& node  = graph.nodes[i];
+        node.system = _systems[i].get();
+        node.name   = i < _systemNames.size() ? _systemNames[i] : std::string();
+        // 何を読み書きするか分からないシステムは, ワーカースレッドに渡さない
+        node.runsOnCallingThread = !node.system || !node.system->HasAccessDeclaration();
+    }
+
+    // 優先度順で前にあるシステムと競合するなら, その完了を待つ
+    for (uint32_t later = 0; later < graph.nodes.size(); ++later) {
+        ISystem* laterSystem = graph.nodes[later].system;
+        for (uint32_t earlier = 0; earlier < later; ++earlier) {
+            ISystem* earlierSystem = graph.nodes[earlier].system;
+            if (!laterSystem || !earlierSystem || laterSystem->IsConflictWith(*earlierSystem)) {
+                graph.nodes[earlier].successors.push_back(later);
+                ++graph.nodes[later].predecessorCount;
+            } else {
+                graph.hasParallelism = true;
+            }
+        }
+    }
+
+    for (const Node& node : graph.nodes) {
+        if (!node.system) {
+            continue;
+        }
+        for (auto* typeList : {&node.system->GetReadComponentTypes(), &node.system->GetWriteComponentTypes()}) {
+            graph.declaredComponentTypes.insert(graph.declaredComponentTypes.end(), typeList->begin(), typeList->end());
+        }
+    }
+    std::sort(graph.declaredComponentTypes.begin(), graph.declaredComponentTypes.end());
+    graph.declaredComponentTypes.erase(
+        std::unique(graph.declaredComponentTypes.begin(), graph.declaredComponentTypes.end()),
+        graph.declaredComponentTypes.end());
+}
+
+/// <summary>
+/// カテゴリのシステムを実行する
+/// </summary>
+void SystemScheduler::ExecuteCategory(SystemCategory _category, ComponentRepository* _componentRepository) {
+    CategoryGraph& graph = graphs_[static_cast<size_t>(_category)];
+    if (graph.nodes.empty()) {
+        return;
+    }
+
+    executionEvents_.assign(graph.nodes.size(), SystemTimelineEvent{});
+
+    bool canRunParallel = executionMode_ == SystemExecutionMode::Parallel
+                          && graph.hasParallelism
+                          && JobSystem::GetInstance()->IsRunning();
+    if (canRunParallel) {
+        ExecuteParallel(_category, graph, _componentRepository);
+    } else {
+        ExecuteSequential(_category, graph);
+    }
+
+    if (isRecordingTimeline_) {
+        for (auto& event : executionEvents_) {
+            if (!event.systemName.empty()) {
+                timeline_.emplace_back(std::move(event));
+            }
+        }
+    }
+}
+
+void SystemScheduler::ExecuteSequential(SystemCategory _category, CategoryGraph& _graph) {
+    for (size_t i = 0; i < _graph.nodes.size(); ++i) {
+        RunNode(_category, _graph.nodes[i], executionEvents_[i]);
+    }
+}
+
+void SystemScheduler::ExecuteParallel(SystemCategory _category, CategoryGraph& _graph, ComponentRepository* _componentRepository) {
+    // ComponentArray の遅延登録はリポジトリを書き換えるため, 並列実行前に済ませておく
+    if (_componentRepository) {
+        _componentRepository->PrepareComponentArrays(_graph.declaredComponentTypes);
+    }
+
+    const uint32_t nodeCount = static_cast<uint32_t>(_graph.nodes.size());
+    std::unique_ptr<std::atomic<uint32_t>[]> remainingCounts(new std::atomic<uint32_t>[nodeCount]);
+
+    JobSystem* jobSystem = JobSystem::GetInstance();
+
+    // アクセスを宣言していないシステムは前後の全てのシステムと競合するので, 実行計画を区切る境目になる.
+    // 境目の間にあるシステムはワーカーで並列に実行し, 境目のシステムは全ての完了を待ってから呼び出し元で実行する
+    uint32_t sectionBegin = 0;
+    while (sectionBegin < nodeCount) {
+        uint32_t sectionEnd = sectionBegin;
+        while (sectionEnd < nodeCount && !_graph.nodes[sectionEnd].runsOnCallingThread) {
+            ++sectionEnd;
+        }
+
+        if (sectionEnd > sectionBegin) {
+            // 区間の外の先行ノードは完了済みなので, 区間の中の先行ノードだけを数える
+            for (uint32_t i = sectionBegin; i < sectionEnd; ++i) {
+                remainingCounts[i].store(0, std::memory_order_relaxed);
+            }
+            for (uint32_t i = sectionBegin; i < sectionEnd; ++i) {
+                for (uint32_t successor : _graph.nodes[i].successors) {
+                    if (successor < sectionEnd) {
+                        remainingCounts[successor].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            JobCounter counter;
+
+            // 完了したノードの後続のうち, 区間の中で待ちが無くなったものを投入する
+            std::function<void(uint32_t)> runNode = [&](uint32_t _index) {
+                RunNode(_category, _graph.nodes[_index], executionEvents_[_index]);
+                for (uint32_t successor : _graph.nodes[_index].successors) {
+                    if (successor < sectionEnd && remainingCounts[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        jobSystem->Submit(counter, [&runNode, successor]() { runNode(successor); });
+                    }
+                }
+            };
+
+            for (uint32_t i = sectionBegin; i < sectionEnd; ++i) {
+                if (remainingCounts[i].load(std::memory_order_relaxed) == 0) {
+                    jobSystem->Submit(counter, [&runNode, i]() { runNode(i); });
+                }
+            }
+            jobSystem->Wait(counter);
+        }
+
+        if (sectionEnd < nodeCount) {
+            RunNode(_category, _graph.nodes[sectionEnd], executionEvents_[sectionEnd]);
+            ++sectionEnd;
+        }
+        sectionBegin = sectionEnd;
+    }
+}
+
+/// <summary>
+/// システムを1つ実行し, 記録中なら実行区間を _outEvent に書き込む
+/// </summary>
+void SystemScheduler::RunNode(SystemCategory _category, const Node& _node, SystemTimelineEvent& _outEvent) {
+    if (!_node.system) {
+        return;
+    }
+
+    if (!isRecordingTimeline_) {
+        _node.system->Run();
+        return;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    _node.system->Run();
+    auto end = std::chrono::steady_clock::now();
+
+    _outEvent.systemName  = _node.name;
+    _outEvent.category    = _category;
+    _outEvent.threadIndex = JobSystem::GetCurrentThreadIndex();
+    _outEvent.beginUs     = std::chrono::duration<double, std::micro>(begin - recordStartTime_).count();
+    _outEvent.endUs       = std::chrono::duration<double, std::micro>(end - recordStartTime_).count();
+}
+
+/// <summary>
+/// タイムラインの記録を開始する
+/// </summary>
+void SystemScheduler::StartTimelineRecording() {
+    timeline_.clear();
+    recordStartTime_     = std::chrono::steady_clock::now();
+    isRecordingTimeline_ = true;
+}
+
+/// <summary>
+/// 記録したタイムラインを Chrome Tracing 形式のJsonで書き出す
+/// </summary>
+bool SystemScheduler::DumpTimeline(const std::string& _filePath) const {
+    nlohmann::json traceEvents = nlohmann::json::array();
+    for (const auto& event : timeline_) {
+        size_t categoryIndex = static_cast<size_t>(event.category);
+        traceEvents.push_back({
+            {"name", event.systemName},
+            {"cat", categoryIndex < kSystemCategoryString.size() ? kSystemCategoryString[categoryIndex] : "Unknown"},
+            {"ph", "X"},
+            {"ts", event.beginUs},
+            {"dur", event.endUs - event.beginUs},
+            {"pid", 0},
+            {"tid", event.threadIndex},
+        });
+    }
+
+    std::ofstream ofs(_filePath);
+    if (!ofs) {
+        LOG_ERROR("SystemScheduler: Failed to open timeline file: {}", _filePath);
+        return false;
+    }
+    ofs << nlohmann::json{{"traceEvents", traceEvents}}.dump(2);
+    return true;
+}
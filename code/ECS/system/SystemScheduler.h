@@ -0,0 +1,130 @@
+#pragma once
+
+/// stl
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// ECS
+// component
+#include "component/ComponentTypeId.h"
+// system
+#include "SystemCategory.h"
+
+namespace OriGine {
+
+/// 前方宣言
+class ISystem;
+class ComponentRepository;
+
+/// <summary>
+/// SystemScheduler の実行方式
+/// </summary>
+enum class SystemExecutionMode {
+    Parallel, // 読み書き宣言が競合しないシステムを並列に実行する
+    Deterministic, // 優先度順に呼び出し元スレッドで逐次実行する (リプレイ用)
+};
+
+/// <summary>
+/// タイムラインに記録する1システム分の実行区間
+/// </summary>
+struct SystemTimelineEvent {
+    std::string systemName;
+    SystemCategory category = SystemCategory::Count;
+    uint32_t threadIndex    = 0; // JobSystem::GetCurrentThreadIndex() (0 = メインスレッド)
+    double beginUs          = 0.0; // 記録開始からの経過時間 (マイクロ秒)
+    double endUs            = 0.0;
+};
+
+/// <summary>
+/// カテゴリ内のシステムを読み書き宣言から依存グラフ(DAG)に組み, JobSystem 上で実行する.
+/// 優先度順で前にあるシステムと競合する場合のみ, その完了を待ってから実行する.
+/// </summary>
+class SystemScheduler final {
+public:
+    SystemScheduler()  = default;
+    ~SystemScheduler() = default;
+
+    /// <summary>
+    /// 実行計画が指定したシステム列から作られたものか
+    /// </summary>
+    bool IsUpToDate(SystemCategory _category, const std::vector<std::shared_ptr<ISystem>>& _systems) const;
+
+    /// <summary>
+    /// カテゴリの実行計画を作り直す
+    /// </summary>
+    /// <param name="_category">対象のカテゴリ</param>
+    /// <param name="_systems">優先度順に並んだシステム</param>
+    /// <param name="_systemNames">_systems と同じ順のシステム名 (タイムライン用)</param>
+    void BuildCategory(SystemCategory _category, const std::vector<std::shared_ptr<ISystem>>& _systems, const std::vector<std::string>& _systemNames);
+
+    /// <summary>
+    /// カテゴリのシステムを実行する. 全てのシステムが完了してから戻る.
+    /// </summary>
+    /// <param name="_category">対象のカテゴリ</param>
+    /// <param name="_componentRepository">並列実行前に宣言された ComponentArray を用意するためのリポジトリ</param>
+    void ExecuteCategory(SystemCategory _category, ComponentRepository* _componentRepository);
+
+    /// <summary>
+    /// 記録したタイムラインを Chrome Tracing 形式 (chrome://tracing, Perfetto で表示可能) のJsonで書き出す
+    /// </summary>
+    /// <param name="_filePath">出力先</param>
+    /// <returns>書き出せたら true</returns>
+    bool DumpTimeline(const std::string& _filePath) const;
+
+private:
+    /// <summary>
+    /// 依存グラフのノード (1システム)
+    /// </summary>
+    struct Node {
+        ISystem* system = nullptr;
+        std::string name;
+        std::vector<uint32_t> successors; // このノードの完了を待つノード
+        uint32_t predecessorCount = 0;
+        bool runsOnCallingThread  = false; // アクセスを宣言していないシステムは, 呼び出し元のスレッドで単独で実行する
+    };
+    /// <summary>
+    /// カテゴリ1つ分の実行計画
+    /// </summary>
+    struct CategoryGraph {
+        std::vector<Node> nodes;
+        std::vector<ComponentTypeId> declaredComponentTypes; // 並列実行前に ComponentArray を用意しておく型
+        bool hasParallelism = false; // 同時に実行できる組が1つでもあるか
+    };
+
+    void ExecuteSequential(SystemCategory _category, CategoryGraph& _graph);
+    void ExecuteParallel(SystemCategory _category, CategoryGraph& _graph, ComponentRepository* _componentRepository);
+    /// <summary>
+    /// システムを1つ実行し, 記録中なら実行区間を _outEvent に書き込む
+    /// </summary>
+    void RunNode(SystemCategory _category, const Node& _node, SystemTimelineEvent& _outEvent);
+
+private:
+    std::array<CategoryGraph, static_cast<size_t>(SystemCategory::Count)> graphs_;
+    SystemExecutionMode executionMode_ = SystemExecutionMode::Parallel;
+
+    bool isRecordingTimeline_ = false;
+    std::chrono::steady_clock::time_point recordStartTime_;
+    std::vector<SystemTimelineEvent> timeline_;
+    std::vector<SystemTimelineEvent> executionEvents_; // 1回の ExecuteCategory 分 (ノードごとに1要素)
+
+public:
+    SystemExecutionMode GetExecutionMode() const { return executionMode_; }
+    void SetExecutionMode(SystemExecutionMode _mode) { executionMode_ = _mode; }
+
+    /// <summary>
+    /// タイムラインの記録を開始する (記録済みの内容は破棄する)
+    /// </summary>
+    void StartTimelineRecording();
+    /// <summary>
+    /// タイムラインの記録を停止する
+    /// </summary>
+    void StopTimelineRecording() { isRecordingTimeline_ = false; }
+    bool IsRecordingTimeline() const { return isRecordingTimeline_; }
+    const std::vector<SystemTimelineEvent>& GetTimeline() const { return timeline_; }
+    void ClearTimeline() { timeline_.clear(); }
+};
+
+} // namespace OriGine
@@ -46,15 +46,15 @@ bool CheckCollisionPair(Scene* /*_scene*/, const EntityHandle& _handleA, const E
     CollisionPushBackInfo::Info aInfo;
     aInfo.pushBackType   = _bInfo->GetPushBackType();
     aInfo.collPoint      = collPoint;
-    aInfo.collFaceNormal = normal;
-    aInfo.collVec        = normal * penetration * overlapRate;
+    aInfo.collFaceNormal = -normal;
+    aInfo.collVec        = -normal * penetration * overlapRate;
     _aInfo->AddCollisionInfo(_handleB, aInfo);
 
     CollisionPushBackInfo::Info bInfo;
     bInfo.pushBackType   = _aInfo->GetPushBackType();
     bInfo.collPoint      = collPoint;
-    bInfo.collFaceNormal = -normal;
-    bInfo.collVec        = -normal * penetration * overlapRate;
+    bInfo.collFaceNormal = normal;
+    bInfo.collVec        = normal * penetration * overlapRate;
     _bInfo->AddCollisionInfo(_handleA, bInfo);
 
     return true;
@@ -91,15 +91,15 @@ bool CheckCollisionPair(Scene* /*_scene*/, const EntityHandle& _handleA, const E
     CollisionPushBackInfo::Info aInfo;
     aInfo.pushBackType   = _bInfo->GetPushBackType();
     aInfo.collPoint      = collPoint;
-    aInfo.collFaceNormal = normal;
-    aInfo.collVec        = normal * penetration * overlapRate;
+    aInfo.collFaceNormal = -normal;
+    aInfo.collVec        = -normal * penetration * overlapRate;
     _aInfo->AddCollisionInfo(_handleB, aInfo);
 
     CollisionPushBackInfo::Info bInfo;
     bInfo.pushBackType   = _aInfo->GetPushBackType();
     bInfo.collPoint      = collPoint;
-    bInfo.collFaceNormal = -normal;
-    bInfo.collVec        = -normal * penetration * overlapRate;
+    bInfo.collFaceNormal = normal;
+    bInfo.collVec        = normal * penetration * overlapRate;
     _bInfo->AddCollisionInfo(_handleA, bInfo);
 
     return true;
@@ -158,15 +158,15 @@ bool CheckCollisionPair(Scene* /*_scene*/, const EntityHandle& _handleA, const E
     CollisionPushBackInfo::Info aInfo;
     aInfo.pushBackType   = _bInfo->GetPushBackType();
     aInfo.collPoint      = collPoint;
-    aInfo.collFaceNormal = normal;
-    aInfo.collVec        = normal * penetration * overlapRate;
+    aInfo.collFaceNormal = -normal;
+    aInfo.collVec        = -normal * penetration * overlapRate;
     _aInfo->AddCollisionInfo(_handleB, aInfo);
 
     CollisionPushBackInfo::Info bInfo;
     bInfo.pushBackType   = _aInfo->GetPushBackType();
     bInfo.collPoint      = collPoint;
-    bInfo.collFaceNormal = -normal;
-    bInfo.collVec        = -normal * penetration * overlapRate;
+    bInfo.collFaceNormal = normal;
+    bInfo.collVec        = normal * penetration * overlapRate;
     _bInfo->AddCollisionInfo(_handleA, bInfo);
 
     return true;
@@ -224,15 +224,15 @@ bool CheckCollisionPair(Scene* /*_scene*/, const EntityHandle& _handleA, const E
     CollisionPushBackInfo::Info aInfo;
     aInfo.pushBackType   = _bInfo->GetPushBackType();
     aInfo.collPoint      = collPoint;
-    aInfo.collFaceNormal = normal;
-    aInfo.collVec        = normal * penetration * overlapRate;
+    aInfo.collFaceNormal = -normal;
+    aInfo.collVec        = -normal * penetration * overlapRate;
     _aInfo->AddCollisionInfo(_handleB, aInfo);
 
     CollisionPushBackInfo::Info bInfo;
     bInfo.pushBackType   = _aInfo->GetPushBackType();
     bInfo.collPoint      = collPoint;
-    bInfo.collFaceNormal = -normal;
-    bInfo.collVec        = -normal * penetration * overlapRate;
+    bInfo.collFaceNormal = normal;
+    bInfo.collVec        = normal * penetration * overlapRate;
     _bInfo->AddCollisionInfo(_handleA, bInfo);
 
     return true;
@@ -281,15 +281,15 @@ bool CheckCollisionPair(Scene* /*_scene*/, const EntityHandle& _handleA, const E
     CollisionPushBackInfo::Info aInfo;
     aInfo.pushBackType   = _bInfo->GetPushBackType();
     aInfo.collPoint      = collPoint;
-    aInfo.collFaceNormal = normal;
-    aInfo.collVec        = normal * penetration * overlapRate;
+    aInfo.collFaceNormal = -normal;
+    aInfo.collVec        = -normal * penetration * overlapRate;
     _aInfo->AddCollisionInfo(_handleB, aInfo);
 
     CollisionPushBackInfo::Info bInfo;
     bInfo.pushBackType   = _aInfo->GetPushBackType();
     bInfo.collPoint      = collPoint;
-    bInfo.collFaceNormal = -normal;
-    bInfo.collVec        = -normal * penetration * overlapRate;
+    bInfo.collFaceNormal = normal;
+    bInfo.collVec        = normal * penetration * overlapRate;
     _bInfo->AddCollisionInfo(_handleA, bInfo);
 
     return true;
@@ -141,7 +141,7 @@ bool CheckCollisionPair(Scene* _scene, const EntityHandle& _aabbEntity, const En
 
     if (!useSwept) {
         // AABBの最近接点を求める
-        closest = {
+        closest = Vec3f{
             std::clamp(sphereCenter[X], aabbMin[X], aabbMax[X]),
             std::clamp(sphereCenter[Y], aabbMin[Y], aabbMax[Y]),
             std::clamp(sphereCenter[Z], aabbMin[Z], aabbMax[Z])};
@@ -156,7 +156,7 @@ bool CheckCollisionPair(Scene* _scene, const EntityHandle& _aabbEntity, const En
             Vec3f diff = sphereCenter - closest;
             // 埋まっている場合、
             if (diff.lengthSq() <= 0.f) {
-                closest = {
+                closest = Vec3f{
                     std::clamp(sphereCenter[X], aabbMin[X], aabbMax[X]),
                     std::clamp(sphereCenter[Y], aabbMin[Y], aabbMax[Y]),
                     std::clamp(sphereCenter[Z], aabbMin[Z], aabbMax[Z])};
@@ -236,10 +236,10 @@ bool CheckCollisionPair(Scene* /*_scene*/, const EntityHandle& _handleA, const E
     const Vec3f& sphereCenter = sphere.center_;
     const Vec3f& obbHalfSize  = obb.halfSize_;
 
-    // --- Sphere中心を OBBローカル座標 へ ---
-    Vec3f localCenter = sphereCenter - obbCenter;
-    auto invRot       = obb.orientations_.rot.Conjugation();
-    localCenter       = (MakeMatrix4x4::RotateQuaternion(invRot) * MakeMatrix4x4::Translate(localCenter))[3];
+    // --- Sphere中心を OBBローカル座標 へ (ワールドへ戻す rotMat の逆回転) ---
+    // 中心差は平行移動ではなく方向として逆回転する (平行移動行列に掛けると [3] 行は回転の影響を受けない)
+    auto invRotMat    = MakeMatrix4x4::RotateQuaternion(obb.orientations_.rot.Conjugation());
+    Vec3f localCenter = (sphereCenter - obbCenter) * invRotMat;
 
     // --- localAABB との判定 ---
     Vec3f aabbMin = -obbHalfSize;
@@ -2,7 +2,10 @@
 
 /// stl
 #include <algorithm>
+#include <cassert>
 #include <cfloat>
+#include <chrono>
+#include <type_traits>
 
 /// util
 #include "util/globalVariables/GlobalVariables.h"
@@ -11,6 +14,7 @@
 // component
 #include "component/collision/collider/base/Collider.h"
 #include "component/collision/CollisionPushBackInfo.h"
+#include "component/physics/Rigidbody.h"
 #include "component/transform/Transform.h"
 // shape
 #include "component/collision/collider/AABBCollider.h"
@@ -22,6 +26,10 @@
 
 // func
 #include "system/collision/CollisionCheckPairFunc.h"
+#include "system/collision/CollisionQueryFunc.h"
+
+/// util
+#include "logger/Logger.h"
 
 using namespace OriGine;
 
@@ -29,7 +37,11 @@ using namespace OriGine;
 /// コンストラクタ
 /// </summary>
 CollisionCheckSystem::CollisionCheckSystem()
-    : ISystem(SystemCategory::Collision) {}
+    : ISystem(SystemCategory::Collision) {
+    // 狭域フェーズを JobSystem 上で並列に実行する (分割先で ComponentArray の遅延登録が起きないよう, 触れる型を宣言しておく)
+    EnableParallelUpdate(kNarrowphaseGrainSize);
+    DeclareWrite<Rigidbody, Transform, CollisionPushBackInfo, AABBCollider, SphereCollider, OBBCollider, CapsuleCollider, SegmentCollider, RayCollider>();
+}
 
 /// <summary>
 /// デストラクタ
@@ -49,128 +61,732 @@ void CollisionCheckSystem::Initialize() {
     if (cellSize > 0.0f) {
         spatialHash_.SetCellSize(cellSize);
     }
+
+    // 広域フェーズの種類と動的AABB木の余白
+    float fatMargin = *gv->AddValue<float>("Settings", "Collision", "DynamicTreeFatMargin");
+    if (fatMargin > 0.0f) {
+        dynamicTree_.SetFatMargin(fatMargin);
+    }
+    int32_t broadphaseType = *gv->AddValue<int32_t>("Settings", "Collision", "BroadphaseType");
+    SetBroadphaseType(broadphaseType == static_cast<int32_t>(CollisionBroadphaseType::DynamicAABBTree)
+                          ? CollisionBroadphaseType::DynamicAABBTree
+                          : CollisionBroadphaseType::SpatialHash);
 }
 
 /// <summary>
 /// 全体の衝突判定更新
 /// </summary>
 void CollisionCheckSystem::Update() {
+    auto broadphaseBegin = std::chrono::steady_clock::now();
+    stats_               = CollisionCheckStats{};
+
     EraseDeadEntity();
 
-    // SpatialHashをクリア
-    spatialHash_.Clear();
+    const bool useTree = broadphaseType_ == CollisionBroadphaseType::DynamicAABBTree;
 
-    // 衝突判定の記録開始処理 + SpatialHashへの登録
-    for (auto entity : entities_) {
-        Transform* transform = GetComponent<Transform>(entity);
-        if (transform) {
-            transform->UpdateMatrix();
+    // 衝突判定の記録開始 (静的BVHの作り直しで形状を更新する前に, 今フレームのスロットの割り当てをやり直す)
+    contactCache_.BeginFrame();
+
+    // 静的/動的/眠っている動的の振り分け (静的BVHは配置が変わった時だけ作り直す)
+    ClassifyEntities();
+    if (staticBvhDirty_) {
+        RebuildStaticBVH();
+    }
+    CheckStaticTransforms();
+
+    ++frameCount_;
+    if (useTree) {
+        updatedTreeProxyCount_ = 0;
+    } else {
+        // SpatialHashをクリア
+        spatialHash_.Clear();
+    }
+
+    // 衝突判定の記録開始処理 + 広域フェーズへの登録 (動的エンティティのみ)
+    dynamicAABBs_.clear();
+    dynamicLayers_.clear();
+    for (auto entity : dynamicEntities_) {
+        StartEntityCollision(entity);
+
+        // エンティティの包含AABBと衝突レイヤーを計算して広域フェーズに登録 (衝突し得ないレイヤー同士はペアにならない)
+        CollisionLayer entityLayer;
+        Bounds::AABB entityAABB = ComputeEntityAABB(entity, entityLayer);
+        dynamicAABBs_.push_back(entityAABB);
+        dynamicLayers_.push_back(entityLayer);
+        if (useTree) {
+            UpdateTreeProxy(entity, entityAABB, entityLayer);
+        } else if (entityAABB.halfSize.lengthSq() > 0.0f) {
+            spatialHash_.Insert(entity, entityAABB, entityLayer);
         }
+    }
+
+    // 眠っているエンティティは動かないので, 記録開始/終了とAABBの計算を省略して登録だけ行う
+    // (衝突状態は衝突がある間だけ EndPassiveContacts で更新する)
+    for (auto entity : sleepingEntities_) {
+        RegisterSleepingEntity(entity, useTree);
+    }
+    if (sleepingBounds_.size() > sleepingEntities_.size()) {
+        std::erase_if(sleepingBounds_, [this](const auto& _item) { return _item.second.updatedFrame != frameCount_; });
+    }
+
+    // 速いRigidbodyのすり抜け防止 (相手が今フレームの位置で登録された後に行う)
+    ClampFastEntities(useTree);
+
+    BeginPassiveContacts();
 
-        // AABB
-        auto& aabbColliders = GetComponents<AABBCollider>(entity);
-        for (auto& collider : aabbColliders) {
-            collider.SetParent(transform);
-            collider.StartCollision();
+    // 広域フェーズから衝突候補ペアを取得
+    if (useTree) {
+        RemoveStaleTreeProxies();
+        dynamicTree_.GetAllPairs(collisionPairs_);
+    } else {
+        spatialHash_.GetAllPairs(collisionPairs_);
+    }
+
+    // 衝突候補ペアと, 動的エンティティと静的BVHの組 (静的同士の組は作らない) を判定対象に並べる
+    // 眠っている相手は静的なものとして扱い, 起きている側を a にする (眠っている側にも押し戻し情報は記録され, 次のフレームで起きる合図になる)
+    narrowphaseTasks_.clear();
+    for (const auto& [aEntity, bEntity] : collisionPairs_) {
+        if (sleepingEntities_.empty()) {
+            narrowphaseTasks_.push_back(NarrowphaseTask{aEntity, bEntity, false});
+            continue;
         }
-        // Sphere
-        auto& sphereColliders = GetComponents<SphereCollider>(entity);
-        for (auto& collider : sphereColliders) {
-            collider.SetParent(transform);
-            collider.StartCollision();
+        bool aSleeping = IsSleepingEntity(aEntity);
+        bool bSleeping = IsSleepingEntity(bEntity);
+        if (aSleeping && bSleeping) {
+            continue;
         }
-        // OBB
-        auto& obbColliders = GetComponents<OBBCollider>(entity);
-        for (auto& collider : obbColliders) {
-            collider.SetParent(transform);
-            collider.StartCollision();
+        if (aSleeping) {
+            narrowphaseTasks_.push_back(NarrowphaseTask{bEntity, aEntity, true});
+        } else {
+            narrowphaseTasks_.push_back(NarrowphaseTask{aEntity, bEntity, bSleeping});
         }
-        // Capsule
-        auto& capsuleColliders = GetComponents<CapsuleCollider>(entity);
-        for (auto& collider : capsuleColliders) {
-            collider.SetParent(transform);
-            collider.StartCollision();
+    }
+    if (staticBvh_.GetEntityCount() > 0) {
+        for (size_t i = 0; i < dynamicEntities_.size(); ++i) {
+            if (dynamicAABBs_[i].halfSize.lengthSq() <= 0.0f) {
+                continue;
+            }
+            staticHits_.clear();
+            staticBvh_.Query(dynamicAABBs_[i], dynamicLayers_[i], staticHits_);
+            for (const EntityHandle& staticEntity : staticHits_) {
+                narrowphaseTasks_.push_back(NarrowphaseTask{dynamicEntities_[i], staticEntity, true});
+            }
         }
-        // Segment
-        auto& segmentColliders = GetComponents<SegmentCollider>(entity);
-        for (auto& collider : segmentColliders) {
-            collider.SetParent(transform);
-            collider.StartCollision();
+    }
+
+    auto narrowphaseBegin = std::chrono::steady_clock::now();
+
+    // 狭域フェーズ (見つかった衝突をコライダーごとにまとめる)
+    RunNarrowphase();
+    contactCache_.EndFrame();
+
+    // 衝突判定の記録終了処理
+    for (auto entity : dynamicEntities_) {
+        EndEntityCollision(entity);
+    }
+    EndPassiveContacts();
+
+    auto narrowphaseEnd         = std::chrono::steady_clock::now();
+    stats_.broadphaseMs         = std::chrono::duration<double, std::milli>(narrowphaseBegin - broadphaseBegin).count();
+    stats_.narrowphaseMs        = std::chrono::duration<double, std::milli>(narrowphaseEnd - narrowphaseBegin).count();
+    stats_.dynamicEntityCount   = dynamicEntities_.size();
+    stats_.staticEntityCount    = staticEntities_.size();
+    stats_.sleepingEntityCount  = sleepingEntities_.size();
+    stats_.candidatePairCount   = collisionPairs_.size();
+    stats_.narrowphaseTaskCount = narrowphaseTasks_.size();
+}
+
+/// <summary>
+/// narrowphaseTasks_ を分割して並列に判定し, 結果を分割順に反映する
+/// </summary>
+void CollisionCheckSystem::RunNarrowphase() {
+    uint32_t taskCount = static_cast<uint32_t>(narrowphaseTasks_.size());
+    if (taskCount == 0) {
+        return;
+    }
+
+    uint32_t grainSize = GetParallelGrainSize();
+    size_t bufferCount = (taskCount + grainSize - 1) / grainSize;
+    if (narrowphaseBuffers_.size() < bufferCount) {
+        narrowphaseBuffers_.resize(bufferCount);
+    }
+    for (size_t i = 0; i < bufferCount; ++i) {
+        narrowphaseBuffers_[i].contacts.clear();
+        narrowphaseBuffers_[i].pushBacks.clear();
+    }
+
+    // 判定: 各分割は自身の記録先にだけ書き込む (分割の区切りは grainSize の倍数)
+    ParallelFor(taskCount, [this, grainSize](uint32_t _begin, uint32_t _end) {
+        NarrowphaseBuffer& buffer = narrowphaseBuffers_[_begin / grainSize];
+        buffer.pairs.clear();
+        buffer.batch.Clear();
+        for (uint32_t i = _begin; i < _end; ++i) {
+            const NarrowphaseTask& task = narrowphaseTasks_[i];
+            AddEntityPairCandidates(task.aEntity, task.bEntity, task.bIsStatic, buffer);
+        }
+        ResolveCandidates(buffer);
+    });
+
+    // マージ: 分割順 = 判定対象の並び順に反映するため, 結果は逐次実行と同じになる
+    for (size_t i = 0; i < bufferCount; ++i) {
+        NarrowphaseBuffer& buffer = narrowphaseBuffers_[i];
+        for (const auto& pushBack : buffer.pushBacks) {
+            pushBack.target->AddCollisionInfo(pushBack.other, pushBack.info);
         }
-        // Ray
-        auto& rayColliders = GetComponents<RayCollider>(entity);
-        for (auto& collider : rayColliders) {
-            collider.SetParent(transform);
-            collider.StartCollision();
+        stats_.contactCount += buffer.contacts.size();
+        for (const auto& contact : buffer.contacts) {
+            contactCache_.AddContact(contact.colliderA->GetContactSlot(), contact.bEntity);
+            // 静的/眠っているコライダーは毎フレームの記録開始を行わないため, 衝突した時にスロットを割り当てる
+            uint32_t slotB = contact.bIsStatic ? AssignPassiveContactSlot(contact.colliderB, contact.bEntity) : contact.colliderB->GetContactSlot();
+            contactCache_.AddContact(slotB, contact.aEntity);
+        }
+    }
+}
+
+/// <summary>
+/// 判定待ちのコライダーの組をまとめて判定し, 結果を _buffer に記録する
+/// </summary>
+void CollisionCheckSystem::ResolveCandidates(NarrowphaseBuffer& _buffer) {
+    Scene* currentScene = GetScene();
+
+    // よく使う形状の組は SoA でまとめて判定し, 重なっていない組を取り除く
+    _buffer.batch.Evaluate();
+
+    // 残った組を追加した順に判定する. 押し戻し情報は代理に渡して _buffer に記録させる
+    for (const auto& candidate : _buffer.batch.GetCandidates()) {
+        if (!candidate.mayCollide) {
+            continue;
         }
+        const NarrowphasePair& pair = _buffer.pairs[candidate.pairIndex];
 
-        auto collPushbackInfo = GetComponent<CollisionPushBackInfo>(entity);
-        if (collPushbackInfo) {
-            collPushbackInfo->ClearInfo();
+        CollisionPushBackInfo* aInfo = nullptr;
+        CollisionPushBackInfo* bInfo = nullptr;
+        if (pair.aInfo) {
+            _buffer.aPushBackInfo.DeferTo(pair.aInfo, &_buffer.pushBacks);
+            aInfo = &_buffer.aPushBackInfo;
+        }
+        if (pair.bInfo) {
+            _buffer.bPushBackInfo.DeferTo(pair.bInfo, &_buffer.pushBacks);
+            bInfo = &_buffer.bPushBackInfo;
         }
 
-        // エンティティの包含AABBを計算してSpatialHashに登録
-        Bounds::AABB entityAABB = ComputeEntityAABB(entity);
-        if (entityAABB.halfSize.lengthSq() > 0.0f) {
-            spatialHash_.Insert(entity, entityAABB);
+        if (candidate.check(currentScene, pair.aEntity, pair.bEntity, candidate.colliderA, candidate.colliderB, aInfo, bInfo)) {
+            _buffer.contacts.push_back(NarrowphaseContact{candidate.colliderA, candidate.colliderB, pair.aEntity, pair.bEntity, pair.bIsStatic});
         }
     }
+}
 
-    // SpatialHashから衝突候補ペアを取得
-    spatialHash_.GetAllPairs(collisionPairs_);
+/// <summary>
+/// エンティティの衝突判定の記録開始処理
+/// </summary>
+void CollisionCheckSystem::StartEntityCollision(const EntityHandle& _entity, bool _assignContactSlot) {
+    Transform* transform = GetComponent<Transform>(_entity);
+    if (transform) {
+        transform->UpdateMatrix();
+    }
 
-    // 衝突候補ペアのみ判定
-    for (const auto& [aEntity, bEntity] : collisionPairs_) {
-        CheckEntityPair(aEntity, bEntity);
+    // AABB
+    auto& aabbColliders = GetComponents<AABBCollider>(_entity);
+    for (auto& collider : aabbColliders) {
+        collider.SetParent(transform);
+        collider.SetContactSlot(_assignContactSlot ? contactCache_.AddCollider() : CollisionContactCache::kInvalidSlot);
+        collider.StartCollision();
+    }
+    // Sphere
+    auto& sphereColliders = GetComponents<SphereCollider>(_entity);
+    for (auto& collider : sphereColliders) {
+        collider.SetParent(transform);
+        collider.SetContactSlot(_assignContactSlot ? contactCache_.AddCollider() : CollisionContactCache::kInvalidSlot);
+        collider.StartCollision();
+    }
+    // OBB
+    auto& obbColliders = GetComponents<OBBCollider>(_entity);
+    for (auto& collider : obbColliders) {
+        collider.SetParent(transform);
+        collider.SetContactSlot(_assignContactSlot ? contactCache_.AddCollider() : CollisionContactCache::kInvalidSlot);
+        collider.StartCollision();
+    }
+    // Capsule
+    auto& capsuleColliders = GetComponents<CapsuleCollider>(_entity);
+    for (auto& collider : capsuleColliders) {
+        collider.SetParent(transform);
+        collider.SetContactSlot(_assignContactSlot ? contactCache_.AddCollider() : CollisionContactCache::kInvalidSlot);
+        collider.StartCollision();
+    }
+    // Segment
+    auto& segmentColliders = GetComponents<SegmentCollider>(_entity);
+    for (auto& collider : segmentColliders) {
+        collider.SetParent(transform);
+        collider.SetContactSlot(_assignContactSlot ? contactCache_.AddCollider() : CollisionContactCache::kInvalidSlot);
+        collider.StartCollision();
+    }
+    // Ray
+    auto& rayColliders = GetComponents<RayCollider>(_entity);
+    for (auto& collider : rayColliders) {
+        collider.SetParent(transform);
+        collider.SetContactSlot(_assignContactSlot ? contactCache_.AddCollider() : CollisionContactCache::kInvalidSlot);
+        collider.StartCollision();
     }
 
-    // 衝突判定の記録終了処理
+    auto collPushbackInfo = GetComponent<CollisionPushBackInfo>(_entity);
+    if (collPushbackInfo) {
+        collPushbackInfo->ClearInfo();
+    }
+}
+
+/// <summary>
+/// エンティティの衝突判定の記録終了処理
+/// </summary>
+void CollisionCheckSystem::EndEntityCollision(const EntityHandle& _entity) {
+    // AABB
+    auto& aabbColliders = GetComponents<AABBCollider>(_entity);
+    for (auto& collider : aabbColliders) {
+        collider.EndCollision(contactCache_.GetContacts(collider.GetContactSlot()));
+    }
+    // Sphere
+    auto& sphereColliders = GetComponents<SphereCollider>(_entity);
+    for (auto& collider : sphereColliders) {
+        collider.EndCollision(contactCache_.GetContacts(collider.GetContactSlot()));
+    }
+    // OBB
+    auto& obbColliders = GetComponents<OBBCollider>(_entity);
+    for (auto& collider : obbColliders) {
+        collider.EndCollision(contactCache_.GetContacts(collider.GetContactSlot()));
+    }
+    // Capsule
+    auto& capsuleColliders = GetComponents<CapsuleCollider>(_entity);
+    for (auto& collider : capsuleColliders) {
+        collider.EndCollision(contactCache_.GetContacts(collider.GetContactSlot()));
+    }
+    // Segment
+    auto& segmentColliders = GetComponents<SegmentCollider>(_entity);
+    for (auto& collider : segmentColliders) {
+        collider.EndCollision(contactCache_.GetContacts(collider.GetContactSlot()));
+    }
+    // Ray
+    auto& rayColliders = GetComponents<RayCollider>(_entity);
+    for (auto& collider : rayColliders) {
+        collider.EndCollision(contactCache_.GetContacts(collider.GetContactSlot()));
+    }
+}
+
+/// <summary>
+/// エンティティの全てのコライダーごとに _func を呼ぶ
+/// </summary>
+template <typename Func>
+void CollisionCheckSystem::ForEachCollider(const EntityHandle& _entity, Func&& _func) {
+    auto visit = [&]<typename ColliderType>() {
+        if (!HasComponent<ColliderType>(_entity)) {
+            return;
+        }
+        for (auto& collider : GetComponents<ColliderType>(_entity)) {
+            _func(static_cast<ICollider&>(collider));
+        }
+    };
+
+    visit.template operator()<AABBCollider>();
+    visit.template operator()<SphereCollider>();
+    visit.template operator()<OBBCollider>();
+    visit.template operator()<CapsuleCollider>();
+    visit.template operator()<SegmentCollider>();
+    visit.template operator()<RayCollider>();
+}
+
+/// <summary>
+/// 静的または眠っているエンティティか
+/// </summary>
+bool CollisionCheckSystem::IsPassiveEntity(const EntityHandle& _entity) {
+    if (!HasEntity(_entity)) {
+        return false;
+    }
+    auto itr = staticClassifications_.find(_entity);
+    if (itr != staticClassifications_.end() && itr->second.isStatic) {
+        return true;
+    }
+    return IsSleepingEntity(_entity);
+}
+
+/// <summary>
+/// 静的または眠っているコライダーに今フレームのスロットを割り当てる
+/// </summary>
+uint32_t CollisionCheckSystem::AssignPassiveContactSlot(ICollider* _collider, const EntityHandle& _entity) {
+    if (_collider->GetContactSlot() == CollisionContactCache::kInvalidSlot) {
+        _collider->SetContactSlot(contactCache_.AddCollider());
+        passiveContactEntities_.push_back(_entity);
+    }
+    return _collider->GetContactSlot();
+}
+
+/// <summary>
+/// 前フレームに衝突状態を持っていた静的/眠っているエンティティのコライダーにスロットを割り当てる
+/// </summary>
+void CollisionCheckSystem::BeginPassiveContacts() {
+    if (passiveContactEntities_.empty()) {
+        return;
+    }
+
+    // 起きた (動的になった) エンティティは通常の記録開始/終了で更新されるので外す
+    std::sort(passiveContactEntities_.begin(), passiveContactEntities_.end());
+    passiveContactEntities_.erase(std::unique(passiveContactEntities_.begin(), passiveContactEntities_.end()), passiveContactEntities_.end());
+    std::erase_if(passiveContactEntities_, [this](const EntityHandle& _entity) { return !IsPassiveEntity(_entity); });
+
+    // AssignPassiveContactSlot が末尾に追加するので, 元の数だけ回す
+    size_t entityCount = passiveContactEntities_.size();
+    for (size_t i = 0; i < entityCount; ++i) {
+        EntityHandle entity = passiveContactEntities_[i];
+        ForEachCollider(entity, [this, &entity](ICollider& _collider) {
+            if (!_collider.GetCollisionContacts().empty()) {
+                AssignPassiveContactSlot(&_collider, entity);
+            }
+        });
+    }
+}
+
+/// <summary>
+/// 静的/眠っているエンティティのコライダーの衝突状態を更新する
+/// </summary>
+void CollisionCheckSystem::EndPassiveContacts() {
+    std::sort(passiveContactEntities_.begin(), passiveContactEntities_.end());
+    passiveContactEntities_.erase(std::unique(passiveContactEntities_.begin(), passiveContactEntities_.end()), passiveContactEntities_.end());
+
+    size_t keepCount = 0;
+    for (size_t i = 0; i < passiveContactEntities_.size(); ++i) {
+        EntityHandle entity = passiveContactEntities_[i];
+        bool hasContact     = false;
+        ForEachCollider(entity, [this, &hasContact](ICollider& _collider) {
+            if (_collider.GetContactSlot() == CollisionContactCache::kInvalidSlot) {
+                return;
+            }
+
+            // 今フレームの衝突 + 判定していない (静的/眠っている) 相手との前フレームの衝突
+            std::span<const EntityHandle> contacts = contactCache_.GetContacts(_collider.GetContactSlot());
+            passiveContactOthers_.assign(contacts.begin(), contacts.end());
+            for (const auto& pre : _collider.GetCollisionContacts()) {
+                if (pre.state != CollisionState::Exit && IsPassiveEntity(pre.other)) {
+                    passiveContactOthers_.push_back(pre.other);
+                }
+            }
+            std::sort(passiveContactOthers_.begin(), passiveContactOthers_.end());
+            passiveContactOthers_.erase(std::unique(passiveContactOthers_.begin(), passiveContactOthers_.end()), passiveContactOthers_.end());
+
+            _collider.EndCollision(passiveContactOthers_);
+            _collider.SetContactSlot(CollisionContactCache::kInvalidSlot);
+            hasContact |= !_collider.GetCollisionContacts().empty();
+        });
+
+        // Exit を含めて衝突状態が残っていれば, 次のフレームも更新する
+        if (hasContact) {
+            passiveContactEntities_[keepCount++] = entity;
+        }
+    }
+    passiveContactEntities_.resize(keepCount);
+}
+
+/// <summary>
+/// エンティティが静的か (有効なColliderを1つ以上持ち, それが全て静的)
+/// </summary>
+bool CollisionCheckSystem::IsStaticEntity(const EntityHandle& _entity) {
+    bool hasStaticCollider = false;
+    auto allStatic         = [&hasStaticCollider](auto& _colliders) {
+        for (auto& collider : _colliders) {
+            if (!collider.IsActive()) {
+                continue;
+            }
+            if (!collider.IsStatic()) {
+                return false;
+            }
+            hasStaticCollider = true;
+        }
+        return true;
+    };
+
+    if (HasComponent<AABBCollider>(_entity) && !allStatic(GetComponents<AABBCollider>(_entity))) {
+        return false;
+    }
+    if (HasComponent<SphereCollider>(_entity) && !allStatic(GetComponents<SphereCollider>(_entity))) {
+        return false;
+    }
+    if (HasComponent<OBBCollider>(_entity) && !allStatic(GetComponents<OBBCollider>(_entity))) {
+        return false;
+    }
+    if (HasComponent<CapsuleCollider>(_entity) && !allStatic(GetComponents<CapsuleCollider>(_entity))) {
+        return false;
+    }
+    if (HasComponent<SegmentCollider>(_entity) && !allStatic(GetComponents<SegmentCollider>(_entity))) {
+        return false;
+    }
+    if (HasComponent<RayCollider>(_entity) && !allStatic(GetComponents<RayCollider>(_entity))) {
+        return false;
+    }
+    return hasStaticCollider;
+}
+
+/// <summary>
+/// エンティティのRigidbodyが眠っているか
+/// </summary>
+bool CollisionCheckSystem::IsSleepingEntity(const EntityHandle& _entity) {
+    return HasComponent<Rigidbody>(_entity) && GetComponent<Rigidbody>(_entity)->IsSleeping();
+}
+
+/// <summary>
+/// エンティティが持つコライダーの構成 (型ごとの個数) を1つの値にまとめる
+/// </summary>
+uint64_t CollisionCheckSystem::ComputeColliderKey(const EntityHandle& _entity) {
+    // 型ごとに 8bit (個数は 255 で飽和させる)
+    auto countOf = [](auto& _colliders) -> uint64_t {
+        return static_cast<uint64_t>((std::min)(_colliders.size(), size_t(0xFF)));
+    };
+
+    uint64_t key = 0;
+    if (HasComponent<AABBCollider>(_entity)) {
+        key |= countOf(GetComponents<AABBCollider>(_entity));
+    }
+    if (HasComponent<SphereCollider>(_entity)) {
+        key |= countOf(GetComponents<SphereCollider>(_entity)) << 8;
+    }
+    if (HasComponent<OBBCollider>(_entity)) {
+        key |= countOf(GetComponents<OBBCollider>(_entity)) << 16;
+    }
+    if (HasComponent<CapsuleCollider>(_entity)) {
+        key |= countOf(GetComponents<CapsuleCollider>(_entity)) << 24;
+    }
+    if (HasComponent<SegmentCollider>(_entity)) {
+        key |= countOf(GetComponents<SegmentCollider>(_entity)) << 32;
+    }
+    if (HasComponent<RayCollider>(_entity)) {
+        key |= countOf(GetComponents<RayCollider>(_entity)) << 40;
+    }
+    return key;
+}
+
+/// <summary>
+/// entities_ を静的/動的/眠っている動的に振り分ける
+/// </summary>
+void CollisionCheckSystem::ClassifyEntities() {
+    // 静的コライダーの変更通知があった, または外れたエンティティの判定結果が溜まったら判定し直す
+    uint32_t revision = ICollider::GetStaticRevision();
+    if (revision != staticRevision_ || staticClassifications_.size() > entities_.size() * 2 + 64) {
+        staticRevision_ = revision;
+        staticClassifications_.clear();
+        staticBvhDirty_ = true;
+    }
+
+    dynamicEntities_.clear();
+    staticEntities_.clear();
+    sleepingEntities_.clear();
     for (auto entity : entities_) {
-        // AABB
-        auto& aabbColliders = GetComponents<AABBCollider>(entity);
-        for (auto& collider : aabbColliders) {
-            collider.EndCollision();
+        uint64_t colliderKey                 = ComputeColliderKey(entity);
+        auto [itr, inserted]                 = staticClassifications_.try_emplace(entity);
+        StaticClassification& classification = itr->second;
+        if (inserted || classification.colliderKey != colliderKey) {
+            bool wasStatic             = !inserted && classification.isStatic;
+            classification.colliderKey = colliderKey;
+            classification.isStatic    = IsStaticEntity(entity);
+            if (classification.isStatic || wasStatic) {
+                // 静的エンティティが増えた, 減った, またはコライダーが付け外しされた
+                staticBvhDirty_ = true;
+            }
+            if (classification.isStatic) {
+                // 動的だった間の衝突状態は, ここから EndPassiveContacts で更新する
+                passiveContactEntities_.push_back(entity);
+            }
         }
 
-        // Sphere
-        auto& sphereColliders = GetComponents<SphereCollider>(entity);
-        for (auto& collider : sphereColliders) {
-            collider.EndCollision();
+        if (classification.isStatic) {
+            staticEntities_.push_back(entity);
+        } else if (IsSleepingEntity(entity)) {
+            sleepingEntities_.push_back(entity);
+        } else {
+            dynamicEntities_.push_back(entity);
         }
-        // OBB
-        auto& obbColliders = GetComponents<OBBCollider>(entity);
-        for (auto& collider : obbColliders) {
-            collider.EndCollision();
+    }
+
+    // 静的エンティティがシステムから外れた
+    if (staticEntities_.size() != bakedStaticCount_) {
+        staticBvhDirty_ = true;
+    }
+}
+
+/// <summary>
+/// 眠っているエンティティを広域フェーズに登録する
+/// </summary>
+void CollisionCheckSystem::RegisterSleepingEntity(const EntityHandle& _entity, bool _useTree) {
+    auto [boundsItr, inserted] = sleepingBounds_.try_emplace(_entity);
+    SleepingBounds& bounds     = boundsItr->second;
+    if (inserted) {
+        // 眠る直前のフレームで計算したワールド形状のまま動いていない
+        bounds.aabb = ComputeEntityAABB(_entity, bounds.layer);
+        // 起きていた間の衝突状態は, ここから EndPassiveContacts で更新する (スロットは衝突した時に割り当てる)
+        ForEachCollider(_entity, [](ICollider& _collider) { _collider.SetContactSlot(CollisionContactCache::kInvalidSlot); });
+        passiveContactEntities_.push_back(_entity);
+    }
+    bounds.updatedFrame = frameCount_;
+
+    if (!_useTree) {
+        if (bounds.aabb.halfSize.lengthSq() > 0.0f) {
+            spatialHash_.Insert(_entity, bounds.aabb, bounds.layer);
         }
-        // Capsule
-        auto& capsuleColliders = GetComponents<CapsuleCollider>(entity);
-        for (auto& collider : capsuleColliders) {
-            collider.EndCollision();
+        return;
+    }
+
+    // 木の葉は眠る前のものをそのまま残す (葉が無ければ作る)
+    auto proxyItr = treeProxies_.find(_entity);
+    if (proxyItr == treeProxies_.end()) {
+        UpdateTreeProxy(_entity, bounds.aabb, bounds.layer);
+        return;
+    }
+    proxyItr->second.updatedFrame = frameCount_;
+    ++updatedTreeProxyCount_;
+}
+
+/// <summary>
+/// 静的エンティティから静的BVHを作り直す
+/// </summary>
+void CollisionCheckSystem::RebuildStaticBVH() {
+    staticBakeEntities_.clear();
+    staticAABBs_.clear();
+    staticLayers_.clear();
+    for (auto entity : staticEntities_) {
+        // ワールド形状はここで1度だけ計算する (衝突状態は EndPassiveContacts で更新する)
+        StartEntityCollision(entity, false);
+
+#ifdef _DEBUG
+        StaticClassification& classification = staticClassifications_[entity];
+        Transform* transform                 = GetComponent<Transform>(entity);
+        classification.hasBakedPose          = transform != nullptr;
+        if (transform) {
+            const Quaternion& rotate      = transform->rotate;
+            classification.bakedScale     = transform->scale;
+            classification.bakedRotate    = Vec4f(rotate[X], rotate[Y], rotate[Z], rotate[W]);
+            classification.bakedTranslate = transform->translate;
+            classification.bakedParent    = transform->parent;
+        }
+#endif // _DEBUG
+
+        CollisionLayer entityLayer;
+        Bounds::AABB entityAABB = ComputeEntityAABB(entity, entityLayer);
+        if (entityAABB.halfSize.lengthSq() > 0.0f) {
+            staticBakeEntities_.push_back(entity);
+            staticAABBs_.push_back(entityAABB);
+            staticLayers_.push_back(entityLayer);
+        }
+    }
+    staticBvh_.Build(staticBakeEntities_, staticAABBs_, staticLayers_);
+
+    bakedStaticCount_ = staticEntities_.size();
+    staticBvhDirty_   = false;
+}
+
+/// <summary>
+/// (Debug のみ) 静的BVHに焼き込んだ後で, ICollider::MarkStaticDirty を呼ばずに Transform を書き換えられた静的エンティティが無いか確かめる
+/// </summary>
+void CollisionCheckSystem::CheckStaticTransforms() {
+#ifdef _DEBUG
+    for (auto entity : staticEntities_) {
+        auto itr = staticClassifications_.find(entity);
+        if (itr == staticClassifications_.end() || !itr->second.hasBakedPose) {
+            continue;
         }
-        // Segment
-        auto& segmentColliders = GetComponents<SegmentCollider>(entity);
-        for (auto& collider : segmentColliders) {
-            collider.EndCollision();
+        StaticClassification& classification = itr->second;
+        const Transform* transform            = GetComponent<Transform>(entity);
+        if (!transform) {
+            continue;
         }
-        // Ray
-        auto& rayColliders = GetComponents<RayCollider>(entity);
-        for (auto& collider : rayColliders) {
-            collider.EndCollision();
+        const Quaternion& rotate = transform->rotate;
+        bool isMoved = transform->scale != classification.bakedScale
+                    || Vec4f(rotate[X], rotate[Y], rotate[Z], rotate[W]) != classification.bakedRotate
+                    || transform->translate != classification.bakedTranslate
+                    || transform->parent != classification.bakedParent;
+        if (isMoved) {
+            LOG_ERROR("Static collider entity {} was moved without ICollider::MarkStaticDirty(). Its baked position is used until the static BVH is rebuilt.", uuids::to_string(entity.uuid));
+            classification.hasBakedPose = false; // 同じエンティティは1度だけ報告する
+            assert(false && "Static collider was moved without ICollider::MarkStaticDirty().");
         }
     }
+#endif // _DEBUG
 }
 
 /// <summary>
 /// 終了処理
 /// </summary>
 void CollisionCheckSystem::Finalize() {
-    entities_.clear();
+    ClearEntities();
+    spatialHash_.Clear();
+    dynamicTree_.Clear();
+    treeProxies_.clear();
+    staticBvh_.Clear();
+    staticClassifications_.clear();
+    sleepingEntities_.clear();
+    sleepingBounds_.clear();
+    contactCache_.Clear();
+    passiveContactEntities_.clear();
+    bakedStaticCount_ = 0;
+    staticBvhDirty_   = true;
+}
+
+/// <summary>
+/// 広域フェーズの種類を切り替える
+/// </summary>
+void CollisionCheckSystem::SetBroadphaseType(CollisionBroadphaseType _type) {
+    broadphaseType_ = _type;
+    spatialHash_.Clear();
+    dynamicTree_.Clear();
+    treeProxies_.clear();
+}
+
+/// <summary>
+/// 動的AABB木のエンティティのAABBと衝突レイヤーを更新する
+/// </summary>
+void CollisionCheckSystem::UpdateTreeProxy(const EntityHandle& _entity, const Bounds::AABB& _aabb, const CollisionLayer& _layer) {
+    auto itr = treeProxies_.find(_entity);
+
+    if (_aabb.halfSize.lengthSq() <= 0.0f) {
+        // 有効なColliderが無くなったら木から外す
+        if (itr != treeProxies_.end()) {
+            dynamicTree_.DestroyProxy(itr->second.proxyId);
+            treeProxies_.erase(itr);
+        }
+        return;
+    }
+
+    if (itr == treeProxies_.end()) {
+        itr = treeProxies_.emplace(_entity, TreeProxy{dynamicTree_.CreateProxy(_aabb, _entity, _layer), 0}).first;
+    } else {
+        // fat AABB に収まっている間は木を組み替えない
+        dynamicTree_.MoveProxy(itr->second.proxyId, _aabb);
+        dynamicTree_.SetProxyLayer(itr->second.proxyId, _layer);
+    }
+    // 同じフレームに登録し直しても (連続衝突判定で戻した場合) 数え直さない
+    if (itr->second.updatedFrame != frameCount_) {
+        itr->second.updatedFrame = frameCount_;
+        ++updatedTreeProxyCount_;
+    }
+}
+
+/// <summary>
+/// 今フレーム更新されなかったエンティティを動的AABB木から外す
+/// </summary>
+void CollisionCheckSystem::RemoveStaleTreeProxies() {
+    // 全ての葉を更新済みなら走査しない
+    if (updatedTreeProxyCount_ == treeProxies_.size()) {
+        return;
+    }
+    for (auto itr = treeProxies_.begin(); itr != treeProxies_.end();) {
+        if (itr->second.updatedFrame != frameCount_) {
+            dynamicTree_.DestroyProxy(itr->second.proxyId);
+            itr = treeProxies_.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
 }
 
 /// <summary>
-/// エンティティの包含AABBを計算
+/// エンティティの包含AABBと衝突レイヤーを計算
 /// </summary>
-Bounds::AABB CollisionCheckSystem::ComputeEntityAABB(const EntityHandle& _entity) {
+Bounds::AABB CollisionCheckSystem::ComputeEntityAABB(const EntityHandle& _entity, CollisionLayer& _outLayer) {
+    _outLayer = CollisionLayer::Empty();
+
     Bounds::AABB result;
     result.center   = Vec3f(0.0f, 0.0f, 0.0f);
     result.halfSize = Vec3f(0.0f, 0.0f, 0.0f);
@@ -195,50 +811,62 @@ Bounds::AABB CollisionCheckSystem::ComputeEntityAABB(const EntityHandle& _entity
     };
 
     // AABB
-    auto& aabbColliders = GetComponents<AABBCollider>(_entity);
-    for (auto& collider : aabbColliders) {
-        if (collider.IsActive()) {
-            mergeAABB(collider.ToWorldAABB());
+    if (HasComponent<AABBCollider>(_entity)) {
+        for (auto& collider : GetComponents<AABBCollider>(_entity)) {
+            if (collider.IsActive()) {
+                mergeAABB(collider.ToWorldAABB());
+                _outLayer.Merge(collider.GetCollisionCategory());
+            }
         }
     }
 
     // Sphere
-    auto& sphereColliders = GetComponents<SphereCollider>(_entity);
-    for (auto& collider : sphereColliders) {
-        if (collider.IsActive()) {
-            mergeAABB(collider.ToWorldAABB());
+    if (HasComponent<SphereCollider>(_entity)) {
+        for (auto& collider : GetComponents<SphereCollider>(_entity)) {
+            if (collider.IsActive()) {
+                mergeAABB(collider.ToWorldAABB());
+                _outLayer.Merge(collider.GetCollisionCategory());
+            }
         }
     }
 
     // OBB
-    auto& obbColliders = GetComponents<OBBCollider>(_entity);
-    for (auto& collider : obbColliders) {
-        if (collider.IsActive()) {
-            mergeAABB(collider.ToWorldAABB());
+    if (HasComponent<OBBCollider>(_entity)) {
+        for (auto& collider : GetComponents<OBBCollider>(_entity)) {
+            if (collider.IsActive()) {
+                mergeAABB(collider.ToWorldAABB());
+                _outLayer.Merge(collider.GetCollisionCategory());
+            }
         }
     }
 
     // Capsule
-    auto& capsuleColliders = GetComponents<CapsuleCollider>(_entity);
-    for (auto& collider : capsuleColliders) {
-        if (collider.IsActive()) {
-            mergeAABB(collider.ToWorldAABB());
+    if (HasComponent<CapsuleCollider>(_entity)) {
+        for (auto& collider : GetComponents<CapsuleCollider>(_entity)) {
+            if (collider.IsActive()) {
+                mergeAABB(collider.ToWorldAABB());
+                _outLayer.Merge(collider.GetCollisionCategory());
+            }
         }
     }
 
     // Segment
-    auto& segmentColliders = GetComponents<SegmentCollider>(_entity);
-    for (auto& collider : segmentColliders) {
-        if (collider.IsActive()) {
-            mergeAABB(collider.ToWorldAABB());
+    if (HasComponent<SegmentCollider>(_entity)) {
+        for (auto& collider : GetComponents<SegmentCollider>(_entity)) {
+            if (collider.IsActive()) {
+                mergeAABB(collider.ToWorldAABB());
+                _outLayer.Merge(collider.GetCollisionCategory());
+            }
         }
     }
 
     // Ray
-    auto& rayColliders = GetComponents<RayCollider>(_entity);
-    for (auto& collider : rayColliders) {
-        if (collider.IsActive()) {
-            mergeAABB(collider.ToWorldAABB());
+    if (HasComponent<RayCollider>(_entity)) {
+        for (auto& collider : GetComponents<RayCollider>(_entity)) {
+            if (collider.IsActive()) {
+                mergeAABB(collider.ToWorldAABB());
+                _outLayer.Merge(collider.GetCollisionCategory());
+            }
         }
     }
 
@@ -251,12 +879,12 @@ Bounds::AABB CollisionCheckSystem::ComputeEntityAABB(const EntityHandle& _entity
 }
 
 /// <summary>
-/// エンティティペア間の衝突判定を行う
+/// エンティティペアのコライダーの組を判定待ちに追加する
 /// </summary>
-void CollisionCheckSystem::CheckEntityPair(const EntityHandle& _aEntity, const EntityHandle& _bEntity) {
-    Scene* currentScene = GetScene();
+void CollisionCheckSystem::AddEntityPairCandidates(const EntityHandle& _aEntity, const EntityHandle& _bEntity, bool _bIsStatic, NarrowphaseBuffer& _buffer) {
+    uint32_t pairIndex = static_cast<uint32_t>(_buffer.pairs.size());
+    _buffer.pairs.push_back(NarrowphasePair{_aEntity, _bEntity, GetComponent<CollisionPushBackInfo>(_aEntity), GetComponent<CollisionPushBackInfo>(_bEntity), _bIsStatic});
 
-    auto aCollPushbackInfo        = GetComponent<CollisionPushBackInfo>(_aEntity);
     auto& aEntityAabbColliders    = GetComponents<AABBCollider>(_aEntity);
     auto& aEntitySphereColliders  = GetComponents<SphereCollider>(_aEntity);
     auto& aEntityObbColliders     = GetComponents<OBBCollider>(_aEntity);
@@ -264,7 +892,6 @@ void CollisionCheckSystem::CheckEntityPair(const EntityHandle& _aEntity, const E
     auto& aEntitySegmentColliders = GetComponents<SegmentCollider>(_aEntity);
     auto& aEntityRayColliders     = GetComponents<RayCollider>(_aEntity);
 
-    auto bCollPushbackInfo        = GetComponent<CollisionPushBackInfo>(_bEntity);
     auto& bEntityAabbColliders    = GetComponents<AABBCollider>(_bEntity);
     auto& bEntitySphereColliders  = GetComponents<SphereCollider>(_bEntity);
     auto& bEntityObbColliders     = GetComponents<OBBCollider>(_bEntity);
@@ -272,14 +899,22 @@ void CollisionCheckSystem::CheckEntityPair(const EntityHandle& _aEntity, const E
     auto& bEntitySegmentColliders = GetComponents<SegmentCollider>(_bEntity);
     auto& bEntityRayColliders     = GetComponents<RayCollider>(_bEntity);
 
-    // 2つのリスト間の衝突判定をまとめる
-    auto checkCollisions = [&](
-                               const EntityHandle& aEntity,
-                               const EntityHandle& bEntity,
-                               auto& listA,
-                               auto& listB,
-                               CollisionPushBackInfo* _aInfo,
-                               CollisionPushBackInfo* _bInfo) {
+    // AABB-Sphere は球側の Rigidbody の速度で掃引判定を行うため, まとめて判定する際にも速度を渡す
+    Vec3f aVelocity(0.0f, 0.0f, 0.0f);
+    Vec3f bVelocity(0.0f, 0.0f, 0.0f);
+    if (!aEntitySphereColliders.empty() && !bEntityAabbColliders.empty()) {
+        if (Rigidbody* rigidbody = GetComponent<Rigidbody>(_aEntity)) {
+            aVelocity = rigidbody->GetRealVelocity();
+        }
+    }
+    if (!aEntityAabbColliders.empty() && !bEntitySphereColliders.empty()) {
+        if (Rigidbody* rigidbody = GetComponent<Rigidbody>(_bEntity)) {
+            bVelocity = rigidbody->GetRealVelocity();
+        }
+    }
+
+    // 2つのリスト間の組を判定待ちに追加する
+    auto addCandidates = [&](auto& listA, auto& listB) {
         for (auto& colliderA : listA) {
             if (!colliderA.IsActive()) {
                 continue;
@@ -291,135 +926,483 @@ void CollisionCheckSystem::CheckEntityPair(const EntityHandle& _aEntity, const E
                 if (!colliderA.CanCollideWith(colliderB)) {
                     continue;
                 }
-                if (CheckCollisionPair<>(currentScene, aEntity, bEntity, colliderA.GetWorldShape(), colliderB.GetWorldShape(), _aInfo, _bInfo)) {
-                    colliderA.SetCollisionState(bEntity);
-                    colliderB.SetCollisionState(aEntity);
-                }
+                _buffer.batch.Add(colliderA, colliderB, pairIndex, aVelocity, bVelocity);
             }
         }
     };
 
     if (!aEntityAabbColliders.empty()) {
         if (!bEntityAabbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityAabbColliders, bEntityAabbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityAabbColliders, bEntityAabbColliders);
         }
         if (!bEntitySphereColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityAabbColliders, bEntitySphereColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityAabbColliders, bEntitySphereColliders);
         }
         if (!bEntityObbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityAabbColliders, bEntityObbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityAabbColliders, bEntityObbColliders);
         }
         if (!bEntityCapsuleColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityAabbColliders, bEntityCapsuleColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityAabbColliders, bEntityCapsuleColliders);
         }
         if (!bEntitySegmentColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityAabbColliders, bEntitySegmentColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityAabbColliders, bEntitySegmentColliders);
         }
         if (!bEntityRayColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityAabbColliders, bEntityRayColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityAabbColliders, bEntityRayColliders);
         }
     }
     if (!aEntitySphereColliders.empty()) {
         if (!bEntityAabbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySphereColliders, bEntityAabbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySphereColliders, bEntityAabbColliders);
         }
         if (!bEntitySphereColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySphereColliders, bEntitySphereColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySphereColliders, bEntitySphereColliders);
         }
         if (!bEntityObbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySphereColliders, bEntityObbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySphereColliders, bEntityObbColliders);
         }
         if (!bEntityCapsuleColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySphereColliders, bEntityCapsuleColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySphereColliders, bEntityCapsuleColliders);
         }
         if (!bEntitySegmentColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySphereColliders, bEntitySegmentColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySphereColliders, bEntitySegmentColliders);
         }
         if (!bEntityRayColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySphereColliders, bEntityRayColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySphereColliders, bEntityRayColliders);
         }
     }
     if (!aEntityObbColliders.empty()) {
         if (!bEntityAabbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityObbColliders, bEntityAabbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityObbColliders, bEntityAabbColliders);
         }
         if (!bEntitySphereColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityObbColliders, bEntitySphereColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityObbColliders, bEntitySphereColliders);
         }
         if (!bEntityObbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityObbColliders, bEntityObbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityObbColliders, bEntityObbColliders);
         }
         if (!bEntityCapsuleColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityObbColliders, bEntityCapsuleColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityObbColliders, bEntityCapsuleColliders);
         }
         if (!bEntitySegmentColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityObbColliders, bEntitySegmentColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityObbColliders, bEntitySegmentColliders);
         }
         if (!bEntityRayColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityObbColliders, bEntityRayColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityObbColliders, bEntityRayColliders);
         }
     }
     // Capsule vs All
     if (!aEntityCapsuleColliders.empty()) {
         if (!bEntityAabbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityCapsuleColliders, bEntityAabbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityCapsuleColliders, bEntityAabbColliders);
         }
         if (!bEntitySphereColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityCapsuleColliders, bEntitySphereColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityCapsuleColliders, bEntitySphereColliders);
         }
         if (!bEntityObbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityCapsuleColliders, bEntityObbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityCapsuleColliders, bEntityObbColliders);
         }
         if (!bEntityCapsuleColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityCapsuleColliders, bEntityCapsuleColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityCapsuleColliders, bEntityCapsuleColliders);
         }
         if (!bEntitySegmentColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityCapsuleColliders, bEntitySegmentColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityCapsuleColliders, bEntitySegmentColliders);
         }
         if (!bEntityRayColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityCapsuleColliders, bEntityRayColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityCapsuleColliders, bEntityRayColliders);
         }
     }
     // Segment vs All
     if (!aEntitySegmentColliders.empty()) {
         if (!bEntityAabbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySegmentColliders, bEntityAabbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySegmentColliders, bEntityAabbColliders);
         }
         if (!bEntitySphereColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySegmentColliders, bEntitySphereColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySegmentColliders, bEntitySphereColliders);
         }
         if (!bEntityObbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySegmentColliders, bEntityObbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySegmentColliders, bEntityObbColliders);
         }
         if (!bEntityCapsuleColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySegmentColliders, bEntityCapsuleColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySegmentColliders, bEntityCapsuleColliders);
         }
         if (!bEntitySegmentColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySegmentColliders, bEntitySegmentColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySegmentColliders, bEntitySegmentColliders);
         }
         if (!bEntityRayColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntitySegmentColliders, bEntityRayColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntitySegmentColliders, bEntityRayColliders);
         }
     }
     // Ray vs All
     if (!aEntityRayColliders.empty()) {
         if (!bEntityAabbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityRayColliders, bEntityAabbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityRayColliders, bEntityAabbColliders);
         }
         if (!bEntitySphereColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityRayColliders, bEntitySphereColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityRayColliders, bEntitySphereColliders);
         }
         if (!bEntityObbColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityRayColliders, bEntityObbColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityRayColliders, bEntityObbColliders);
         }
         if (!bEntityCapsuleColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityRayColliders, bEntityCapsuleColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityRayColliders, bEntityCapsuleColliders);
         }
         if (!bEntitySegmentColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityRayColliders, bEntitySegmentColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityRayColliders, bEntitySegmentColliders);
         }
         if (!bEntityRayColliders.empty()) {
-            checkCollisions(_aEntity, _bEntity, aEntityRayColliders, bEntityRayColliders, aCollPushbackInfo, bCollPushbackInfo);
+            addCandidates(aEntityRayColliders, bEntityRayColliders);
+        }
+    }
+}
+
+#pragma region ContinuousCollision
+
+namespace {
+
+/// <summary>
+/// 連続衝突判定で動かす形状ごとの掃引
+/// </summary>
+template <typename Shape>
+bool SweepMovingShape(const Bounds::Sphere& _moving, const Vec3f& _direction, float _maxDistance, const Shape& _shape, float& _outDistance) {
+    Vec3f normal;
+    return SweepSphereShape(Bounds::Ray(_moving.center_, _direction), _moving.radius_, _maxDistance, _shape, _outDistance, normal);
+}
+template <typename Shape>
+bool SweepMovingShape(const Bounds::Capsule& _moving, const Vec3f& _direction, float _maxDistance, const Shape& _shape, float& _outDistance) {
+    Vec3f normal;
+    return SweepCapsuleShape(_moving, _direction, _maxDistance, _shape, _outDistance, normal);
+}
+
+} // namespace
+
+/// <summary>
+/// 移動量がしきい値を超えた動的エンティティを, 押し戻される相手に最初に接する位置まで戻す
+/// </summary>
+void CollisionCheckSystem::ClampFastEntities(bool _useTree) {
+    clampedEntityCount_ = 0;
+    for (size_t i = 0; i < dynamicEntities_.size(); ++i) {
+        const EntityHandle& entity = dynamicEntities_[i];
+        if (!HasComponent<Rigidbody>(entity)) {
+            continue;
+        }
+        Rigidbody* rigidbody = GetComponent<Rigidbody>(entity);
+        float threshold      = rigidbody->GetCcdThreshold();
+        if (!rigidbody->IsActive() || threshold <= 0.f) {
+            continue;
+        }
+        Transform* transform = GetComponent<Transform>(entity);
+        if (!transform) {
+            continue;
+        }
+
+        Vec3f displacement = transform->translate - rigidbody->GetPrePos();
+        if (displacement.lengthSq() <= threshold * threshold) {
+            continue;
+        }
+
+        // translate は親の空間なので, 掃引はワールド空間の移動量で行う (直線移動なので戻す割合はどちらの空間でも同じ)
+        transform->UpdateMatrix();
+        Vec3f worldDisplacement = transform->parent ? TransformNormal(displacement, transform->parent->worldMat) : displacement;
+        float distance          = worldDisplacement.length();
+        if (distance <= kEpsilon) {
+            continue;
+        }
+
+        float hitDistance = 0.f;
+        if (!SweepEntity(entity, transform, worldDisplacement * (1.0f / distance), distance, hitDistance)) {
+            continue;
         }
+        transform->translate = rigidbody->GetPrePos() + displacement * (hitDistance / distance);
+        rigidbody->SetRealVelocity(transform->translate - rigidbody->GetPrePos());
+        ++clampedEntityCount_;
+
+        // 戻した位置でワールド形状と包含AABBを求め直す
+        transform->UpdateMatrix();
+        ForEachCollider(entity, [](ICollider& _collider) { _collider.StartCollision(); });
+        dynamicAABBs_[i] = ComputeEntityAABB(entity, dynamicLayers_[i]);
+        if (_useTree) {
+            UpdateTreeProxy(entity, dynamicAABBs_[i], dynamicLayers_[i]);
+        }
+    }
+
+    // 空間ハッシュは登録を取り消せないので, 戻したエンティティがあれば登録し直す
+    if (_useTree || clampedEntityCount_ == 0) {
+        return;
+    }
+    spatialHash_.Clear();
+    for (size_t i = 0; i < dynamicEntities_.size(); ++i) {
+        if (dynamicAABBs_[i].halfSize.lengthSq() > 0.0f) {
+            spatialHash_.Insert(dynamicEntities_[i], dynamicAABBs_[i], dynamicLayers_[i]);
+        }
+    }
+    for (auto entity : sleepingEntities_) {
+        RegisterSleepingEntity(entity, false);
+    }
+}
+
+/// <summary>
+/// エンティティの Sphere/Capsule コライダーを移動前の位置から掃引し, 押し戻される相手に接するまでの距離を求める
+/// </summary>
+bool CollisionCheckSystem::SweepEntity(const EntityHandle& _entity, Transform* _transform, const Vec3f& _direction, float _distance, float& _outDistance) {
+    // 押し戻されないエンティティは止めない (狭域フェーズと同じく, 双方が押し戻し情報を持つ組だけが押し戻される)
+    if (!HasComponent<CollisionPushBackInfo>(_entity)) {
+        return false;
+    }
+
+    bool isHit   = false;
+    _outDistance = _distance;
+    auto sweep   = [&]<typename ColliderType>() {
+        if (!HasComponent<ColliderType>(_entity)) {
+            return;
+        }
+        for (auto& collider : GetComponents<ColliderType>(_entity)) {
+            if (!collider.IsActive()) {
+                continue;
+            }
+            collider.SetParent(_transform);
+            collider.CalculateWorldShape();
+
+            // 移動前の位置に戻し, 接した位置で kContinuousCollisionSkin だけ重なるよう細くして掃引する.
+            // (前の更新で押し戻されて接したままの相手も, 始点での重なりとして見落とさない)
+            auto shape = collider.GetWorldShape();
+            Vec3f origin;
+            float boundRadius = 0.f;
+            if constexpr (std::is_same_v<ColliderType, SphereCollider>) {
+                shape.center_ -= _direction * _distance;
+                shape.radius_ -= (std::min)(kContinuousCollisionSkin, shape.radius_ * 0.5f);
+                origin         = shape.center_;
+                boundRadius    = shape.radius_;
+            } else {
+                shape.segment.start -= _direction * _distance;
+                shape.segment.end   -= _direction * _distance;
+                shape.radius        -= (std::min)(kContinuousCollisionSkin, shape.radius * 0.5f);
+                origin               = (shape.segment.start + shape.segment.end) * 0.5f;
+                boundRadius          = shape.radius + Vec3f(shape.segment.end - shape.segment.start).length() * 0.5f;
+            }
+
+            GatherRayCandidates(Bounds::Ray(origin, _direction), _outDistance, boundRadius);
+            for (const EntityHandle& other : queryCandidates_) {
+                if (other == _entity || !HasComponent<CollisionPushBackInfo>(other)) {
+                    continue;
+                }
+                if (GetComponent<CollisionPushBackInfo>(other)->GetPushBackType() == CollisionPushBackType::None) {
+                    continue;
+                }
+                ForEachQueryCollider(other, kAllCollisionCategories, [&](ICollider& _otherCollider, const auto& _otherShape) {
+                    float hitDistance = 0.f;
+                    if (collider.CanCollideWith(_otherCollider)
+                        && SweepMovingShape(shape, _direction, _outDistance, _otherShape, hitDistance)
+                        && hitDistance < _outDistance) {
+                        _outDistance = hitDistance;
+                        isHit        = true;
+                    }
+                    return true;
+                });
+            }
+        }
+    };
+    sweep.template operator()<SphereCollider>();
+    sweep.template operator()<CapsuleCollider>();
+    return isHit;
+}
+
+#pragma endregion
+
+#pragma region SceneQuery
+
+/// <summary>
+/// レイ (半径を持たせると掃引球) が通る可能性のあるエンティティを集める
+/// </summary>
+void CollisionCheckSystem::GatherRayCandidates(const Bounds::Ray& _ray, float _maxDistance, float _radius) {
+    queryCandidates_.clear();
+    if (broadphaseType_ == CollisionBroadphaseType::DynamicAABBTree) {
+        dynamicTree_.QueryRay(_ray.origin, _ray.direction, _maxDistance, _radius, queryCandidates_);
+    } else {
+        spatialHash_.QueryRay(_ray.origin, _ray.direction, _maxDistance, _radius, queryCandidates_);
     }
+    staticBvh_.QueryRay(_ray.origin, _ray.direction, _maxDistance, _radius, queryCandidates_);
 }
+
+/// <summary>
+/// AABBと重なる可能性のあるエンティティを集める
+/// </summary>
+void CollisionCheckSystem::GatherAABBCandidates(const Bounds::AABB& _aabb) {
+    queryCandidates_.clear();
+    if (broadphaseType_ == CollisionBroadphaseType::DynamicAABBTree) {
+        dynamicTree_.Query(_aabb, queryCandidates_);
+    } else {
+        spatialHash_.Query(_aabb, queryCandidates_);
+    }
+    staticBvh_.Query(_aabb, queryCandidates_);
+}
+
+/// <summary>
+/// エンティティのシーンクエリ対象のコライダーごとに _func を呼ぶ
+/// </summary>
+template <typename Func>
+void CollisionCheckSystem::ForEachQueryCollider(const EntityHandle& _entity, uint32_t _categoryMask, Func&& _func) {
+    auto visit = [&]<typename ColliderType>() {
+        if (!HasComponent<ColliderType>(_entity)) {
+            return true;
+        }
+        for (auto& collider : GetComponents<ColliderType>(_entity)) {
+            if (!collider.IsActive()) {
+                continue;
+            }
+            if (_categoryMask != kAllCollisionCategories && (collider.GetCollisionCategory().GetBits() & _categoryMask) == 0) {
+                continue;
+            }
+            if (!_func(static_cast<ICollider&>(collider), collider.GetWorldShape())) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    visit.template operator()<AABBCollider>()
+        && visit.template operator()<SphereCollider>()
+        && visit.template operator()<OBBCollider>()
+        && visit.template operator()<CapsuleCollider>();
+}
+
+/// <summary>
+/// queryCandidates_ の中でレイが最初に当たるコライダーを求める
+/// </summary>
+bool CollisionCheckSystem::RaycastCandidates(const Bounds::Ray& _ray, float _maxDistance, CollisionQueryHit& _outHit, uint32_t _categoryMask) {
+    bool isHit = false;
+    for (const EntityHandle& entity : queryCandidates_) {
+        ForEachQueryCollider(entity, _categoryMask, [&](ICollider& _collider, const auto& _shape) {
+            // 見つかった当たりより遠いものは調べない
+            float maxDistance = isHit ? _outHit.distance : _maxDistance;
+            float distance    = 0.f;
+            Vec3f normal;
+            if (RaycastShape(_ray, maxDistance, _shape, distance, normal) && (!isHit || distance < _outHit.distance)) {
+                isHit   = true;
+                _outHit = CollisionQueryHit{entity, &_collider, distance, _ray.GetPoint(distance), normal};
+            }
+            return true;
+        });
+    }
+    return isHit;
+}
+
+/// <summary>
+/// レイが最初に当たるコライダーを取得
+/// </summary>
+bool CollisionCheckSystem::Raycast(const Bounds::Ray& _ray, float _maxDistance, CollisionQueryHit& _outHit, uint32_t _categoryMask) {
+    _outHit = CollisionQueryHit{};
+    GatherRayCandidates(_ray, _maxDistance, 0.f);
+    return RaycastCandidates(_ray, _maxDistance, _outHit, _categoryMask);
+}
+
+/// <summary>
+/// レイが当たる全てのコライダーを近い順に取得
+/// </summary>
+size_t CollisionCheckSystem::RaycastAll(const Bounds::Ray& _ray, float _maxDistance, std::vector<CollisionQueryHit>& _outHits, uint32_t _categoryMask) {
+    _outHits.clear();
+    GatherRayCandidates(_ray, _maxDistance, 0.f);
+    for (const EntityHandle& entity : queryCandidates_) {
+        ForEachQueryCollider(entity, _categoryMask, [&](ICollider& _collider, const auto& _shape) {
+            float distance = 0.f;
+            Vec3f normal;
+            if (RaycastShape(_ray, _maxDistance, _shape, distance, normal)) {
+                _outHits.push_back(CollisionQueryHit{entity, &_collider, distance, _ray.GetPoint(distance), normal});
+            }
+            return true;
+        });
+    }
+    std::sort(_outHits.begin(), _outHits.end(), [](const CollisionQueryHit& _a, const CollisionQueryHit& _b) {
+        return _a.distance < _b.distance;
+    });
+    return _outHits.size();
+}
+
+/// <summary>
+/// 複数のレイをまとめて判定する
+/// </summary>
+size_t CollisionCheckSystem::RaycastBatch(std::span<const Bounds::Ray> _rays, float _maxDistance, std::span<CollisionQueryHit> _outHits, uint32_t _categoryMask) {
+    if (_rays.size() != _outHits.size()) {
+        LOG_WARN("RaycastBatch: rays ({}) and hits ({}) differ in size. Extra entries are ignored.", _rays.size(), _outHits.size());
+    }
+
+    size_t count    = (std::min)(_rays.size(), _outHits.size());
+    size_t hitCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        _outHits[i] = CollisionQueryHit{};
+        GatherRayCandidates(_rays[i], _maxDistance, 0.f);
+        if (RaycastCandidates(_rays[i], _maxDistance, _outHits[i], _categoryMask)) {
+            ++hitCount;
+        }
+    }
+    return hitCount;
+}
+
+/// <summary>
+/// 球と重なるコライダーを持つエンティティを取得
+/// </summary>
+size_t CollisionCheckSystem::OverlapSphere(const Bounds::Sphere& _sphere, std::vector<EntityHandle>& _outEntities, uint32_t _categoryMask) {
+    _outEntities.clear();
+    GatherAABBCandidates(Bounds::AABB(_sphere.center_, Vec3f(_sphere.radius_, _sphere.radius_, _sphere.radius_)));
+    for (const EntityHandle& entity : queryCandidates_) {
+        bool isOverlap = false;
+        ForEachQueryCollider(entity, _categoryMask, [&](ICollider&, const auto& _shape) {
+            isOverlap = OverlapShape(_sphere, _shape);
+            return !isOverlap;
+        });
+        if (isOverlap) {
+            _outEntities.push_back(entity);
+        }
+    }
+    return _outEntities.size();
+}
+
+/// <summary>
+/// AABBと重なるコライダーを持つエンティティを取得
+/// </summary>
+size_t CollisionCheckSystem::OverlapAABB(const Bounds::AABB& _aabb, std::vector<EntityHandle>& _outEntities, uint32_t _categoryMask) {
+    _outEntities.clear();
+    GatherAABBCandidates(_aabb);
+    for (const EntityHandle& entity : queryCandidates_) {
+        bool isOverlap = false;
+        ForEachQueryCollider(entity, _categoryMask, [&](ICollider&, const auto& _shape) {
+            isOverlap = OverlapShape(_aabb, _shape);
+            return !isOverlap;
+        });
+        if (isOverlap) {
+            _outEntities.push_back(entity);
+        }
+    }
+    return _outEntities.size();
+}
+
+/// <summary>
+/// 球を動かした時に最初に接するコライダーを取得
+/// </summary>
+bool CollisionCheckSystem::SweepSphere(const Bounds::Sphere& _sphere, const Vec3f& _direction, float _maxDistance, CollisionQueryHit& _outHit, uint32_t _categoryMask) {
+    _outHit = CollisionQueryHit{};
+    if (_direction.lengthSq() <= kEpsilon * kEpsilon) {
+        LOG_WARN("SweepSphere: direction is zero.");
+        return false;
+    }
+
+    Bounds::Ray ray(_sphere.center_, _direction);
+    GatherRayCandidates(ray, _maxDistance, _sphere.radius_);
+
+    bool isHit = false;
+    for (const EntityHandle& entity : queryCandidates_) {
+        ForEachQueryCollider(entity, _categoryMask, [&](ICollider& _collider, const auto& _shape) {
+            float maxDistance = isHit ? _outHit.distance : _maxDistance;
+            float distance    = 0.f;
+            Vec3f normal;
+            if (SweepSphereShape(ray, _sphere.radius_, maxDistance, _shape, distance, normal) && (!isHit || distance < _outHit.distance)) {
+                isHit   = true;
+                _outHit = CollisionQueryHit{entity, &_collider, distance, ray.GetPoint(distance), normal};
+            }
+            return true;
+        });
+    }
+    return isHit;
+}
+
+#pragma endregion
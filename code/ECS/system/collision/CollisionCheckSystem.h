@@ -4,19 +4,75 @@
 #include "system/ISystem.h"
 
 /// stl
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
+/// ECS
+// component
+#include "component/collision/collider/base/Collider.h"
+#include "component/collision/CollisionPushBackInfo.h"
+
 /// collision
+#include "CollisionContactCache.h"
+#include "CollisionLayer.h"
+#include "DynamicAABBTree.h"
+#include "NarrowphaseBatch.h"
 #include "SpatialHash.h"
+#include "StaticBVH.h"
+
+/// math
+#include "math/bounds/AABB.h"
+#include "math/bounds/Ray.h"
+#include "math/bounds/Sphere.h"
 
 namespace OriGine {
 
+/// <summary>
+/// 衝突判定の広域フェーズの種類 (GlobalVariables の Settings/Collision/BroadphaseType に int で保存する)
+/// </summary>
+enum class CollisionBroadphaseType : int32_t {
+    SpatialHash     = 0, // 毎フレーム空間ハッシュを作り直す
+    DynamicAABBTree = 1, // fat AABB からはみ出したエンティティだけ木に挿入し直す
+};
+
+/// <summary>
+/// シーンクエリ (Raycast / SweepSphere) で当たったコライダー
+/// </summary>
+struct CollisionQueryHit {
+    EntityHandle entity; // 当たったエンティティ (当たらなければ無効なハンドル)
+    ICollider* collider = nullptr; // 当たったコライダー (コンポーネント配列が変わるまで有効)
+    float distance      = 0.f; // 始点から当たった位置までの距離
+    Vec3f point         = {0.f, 0.f, 0.f}; // 当たった位置 (SweepSphere では接した時の球の中心)
+    Vec3f normal        = {0.f, 0.f, 0.f}; // 当たった面の法線
+};
+
+/// <summary>
+/// 最後の Update の衝突判定の内訳 (ベンチマークや回帰の計測用)
+/// </summary>
+struct CollisionCheckStats {
+    double broadphaseMs         = 0.0; // 振り分け, 連続衝突判定, 広域フェーズへの登録と判定対象の列挙
+    double narrowphaseMs        = 0.0; // 狭域フェーズと衝突状態の記録
+    size_t dynamicEntityCount   = 0;
+    size_t staticEntityCount    = 0;
+    size_t sleepingEntityCount  = 0;
+    size_t candidatePairCount   = 0; // 広域フェーズが返したペア数 (静的BVHとの組は含まない)
+    size_t narrowphaseTaskCount = 0; // 狭域フェーズで判定したエンティティの組の数 (静的BVHとの組を含む)
+    size_t contactCount         = 0; // 衝突したコライダーの組の数
+};
+
 /// <summary>
 /// 衝突判定システム
 /// </summary>
 class CollisionCheckSystem
     : public ISystem {
 public:
+    static constexpr uint32_t kNarrowphaseGrainSize   = 64; // 狭域フェーズの1ジョブあたりのペア数
+    static constexpr uint32_t kAllCollisionCategories = 0xFFFFFFFF; // シーンクエリで全カテゴリを対象にするマスク
+    static constexpr float kContinuousCollisionSkin   = 0.01f; // 連続衝突判定で戻した位置に残す重なり (狭域フェーズで接触として拾わせる)
+
     /// <summary>
     /// コンストラクタ
     /// </summary>
@@ -42,28 +98,382 @@ public:
     /// </summary>
     void Finalize() override;
 
+    /// <summary>
+    /// 広域フェーズの種類を切り替える (切り替え前の登録内容は破棄する)
+    /// </summary>
+    void SetBroadphaseType(CollisionBroadphaseType _type);
+
+    /// <summary>
+    /// 広域フェーズの種類を取得
+    /// </summary>
+    CollisionBroadphaseType GetBroadphaseType() const { return broadphaseType_; }
+
+    /// <summary>
+    /// 最後の Update で眠っていた (AABBと衝突状態の更新を省略した) エンティティ数
+    /// </summary>
+    size_t GetSleepingEntityCount() const { return sleepingEntities_.size(); }
+
+    /// <summary>
+    /// 最後の Update で連続衝突判定により位置を戻したエンティティ数
+    /// </summary>
+    size_t GetClampedEntityCount() const { return clampedEntityCount_; }
+
+    /// <summary>
+    /// 最後の Update の衝突判定の内訳
+    /// </summary>
+    const CollisionCheckStats& GetStats() const { return stats_; }
+
+    // --- Scene Query ---
+    // 直前の Update 時点の広域フェーズとワールド形状を使う (それ以降に追加/移動したエンティティは反映されない).
+    // _categoryMask は対象にするコライダーの CollisionCategory のビット (kAllCollisionCategories なら未登録カテゴリも含めて全て).
+    // AABB/Sphere/OBB/Capsule コライダーが対象で, Ray/Segment コライダーには当たらない.
+    // 作業領域を共有するため, Update と同じスレッドから呼び出すこと.
+
+    /// <summary>
+    /// レイが最初に当たるコライダーを取得 (始点を内側に含むコライダーには当たらない)
+    /// </summary>
+    /// <param name="_ray">レイ (方向は正規化済み)</param>
+    /// <param name="_maxDistance">最大距離</param>
+    /// <param name="_outHit">当たったコライダー</param>
+    /// <returns>当たればtrue</returns>
+    bool Raycast(const Bounds::Ray& _ray, float _maxDistance, CollisionQueryHit& _outHit, uint32_t _categoryMask = kAllCollisionCategories);
+
+    /// <summary>
+    /// レイが当たる全てのコライダーを近い順に取得
+    /// </summary>
+    /// <param name="_outHits">結果 (呼び出し前の内容は破棄する)</param>
+    /// <returns>当たった数</returns>
+    size_t RaycastAll(const Bounds::Ray& _ray, float _maxDistance, std::vector<CollisionQueryHit>& _outHits, uint32_t _categoryMask = kAllCollisionCategories);
+
+    /// <summary>
+    /// 複数のレイをまとめて判定し, それぞれ最初に当たるコライダーを取得 (視線判定など. 作業領域を使い回すため1本ずつ呼ぶより確保が少ない)
+    /// </summary>
+    /// <param name="_rays">レイ</param>
+    /// <param name="_outHits">_rays と同じ数の結果 (当たらなかったレイは entity が無効になる)</param>
+    /// <returns>当たったレイの数</returns>
+    size_t RaycastBatch(std::span<const Bounds::Ray> _rays, float _maxDistance, std::span<CollisionQueryHit> _outHits, uint32_t _categoryMask = kAllCollisionCategories);
+
+    /// <summary>
+    /// 球と重なるコライダーを持つエンティティを取得
+    /// </summary>
+    /// <param name="_outEntities">結果 (呼び出し前の内容は破棄する. 重複なし)</param>
+    /// <returns>エンティティの数</returns>
+    size_t OverlapSphere(const Bounds::Sphere& _sphere, std::vector<EntityHandle>& _outEntities, uint32_t _categoryMask = kAllCollisionCategories);
+
+    /// <summary>
+    /// AABBと重なるコライダーを持つエンティティを取得
+    /// </summary>
+    /// <param name="_outEntities">結果 (呼び出し前の内容は破棄する. 重複なし)</param>
+    /// <returns>エンティティの数</returns>
+    size_t OverlapAABB(const Bounds::AABB& _aabb, std::vector<EntityHandle>& _outEntities, uint32_t _categoryMask = kAllCollisionCategories);
+
+    /// <summary>
+    /// 球を動かした時に最初に接するコライダーを取得 (始点で重なっているコライダーには当たらない)
+    /// </summary>
+    /// <param name="_sphere">動かす球</param>
+    /// <param name="_direction">移動方向</param>
+    /// <param name="_maxDistance">最大移動距離</param>
+    /// <param name="_outHit">接したコライダー</param>
+    /// <returns>接すればtrue</returns>
+    bool SweepSphere(const Bounds::Sphere& _sphere, const Vec3f& _direction, float _maxDistance, CollisionQueryHit& _outHit, uint32_t _categoryMask = kAllCollisionCategories);
+
+protected:
+    /// <summary>
+    /// 狭域フェーズで判定するエンティティの組
+    /// </summary>
+    struct NarrowphaseTask {
+        EntityHandle aEntity;
+        EntityHandle bEntity;
+        bool bIsStatic; // bEntity が静的または眠っているエンティティか
+    };
+
+    /// <summary>
+    /// 分割内で判定するエンティティの組 (NarrowphaseBatch::Candidate::pairIndex が指す)
+    /// </summary>
+    struct NarrowphasePair {
+        EntityHandle aEntity;
+        EntityHandle bEntity;
+        CollisionPushBackInfo* aInfo; // 本来の押し戻し情報 (無ければ nullptr)
+        CollisionPushBackInfo* bInfo;
+        bool bIsStatic;
+    };
+
+    /// <summary>
+    /// 狭域フェーズで見つかったコライダー同士の衝突 (マージ時に contactCache_ へ記録する)
+    /// </summary>
+    struct NarrowphaseContact {
+        ICollider* colliderA;
+        ICollider* colliderB;
+        EntityHandle aEntity;
+        EntityHandle bEntity;
+        bool bIsStatic;
+    };
+
+    /// <summary>
+    /// 狭域フェーズの分割ごとの記録先. 分割は要素の並び順に対応し, フレームをまたいで使い回す.
+    /// </summary>
+    struct NarrowphaseBuffer {
+        std::vector<NarrowphasePair> pairs;
+        NarrowphaseBatch batch;
+        std::vector<NarrowphaseContact> contacts;
+        std::vector<CollisionPushBackInfo::DeferredInfo> pushBacks;
+        CollisionPushBackInfo aPushBackInfo; // 押し戻し情報の代理 (DeferTo で本来の追加先を指す)
+        CollisionPushBackInfo bPushBackInfo;
+    };
+
 protected:
     /// <summary>
     /// エンティティの包含AABBを計算
     /// </summary>
-    Bounds::AABB ComputeEntityAABB(const EntityHandle& _entity);
+    /// <param name="_outLayer">有効なコライダーの衝突カテゴリをまとめたレイヤー</param>
+    Bounds::AABB ComputeEntityAABB(const EntityHandle& _entity, CollisionLayer& _outLayer);
+
+    /// <summary>
+    /// エンティティペアの有効なコライダーの組を _buffer の判定待ちに追加する (複数スレッドから呼び出せる)
+    /// </summary>
+    /// <param name="_bIsStatic">_bEntity が静的または眠っているエンティティか (記録開始/終了は EndPassiveContacts でまとめて行う)</param>
+    /// <param name="_buffer">追加先</param>
+    void AddEntityPairCandidates(const EntityHandle& _aEntity, const EntityHandle& _bEntity, bool _bIsStatic, NarrowphaseBuffer& _buffer);
+
+    /// <summary>
+    /// _buffer の判定待ちの組を判定する.
+    /// コライダーや押し戻し情報には書き込まず, 結果を _buffer に記録する (複数スレッドから呼び出せる).
+    /// </summary>
+    void ResolveCandidates(NarrowphaseBuffer& _buffer);
+
+    /// <summary>
+    /// narrowphaseTasks_ を分割して並列に判定し, 結果を分割順に反映する
+    /// </summary>
+    void RunNarrowphase();
+
+    /// <summary>
+    /// エンティティの衝突判定の記録開始処理 (Transform/ワールド形状の更新を含む)
+    /// </summary>
+    /// <param name="_assignContactSlot">今フレームの衝突を記録するスロットを割り当てるか (静的BVHの構築時は形状の更新だけ行う)</param>
+    void StartEntityCollision(const EntityHandle& _entity, bool _assignContactSlot = true);
+
+    /// <summary>
+    /// エンティティの衝突判定の記録終了処理
+    /// </summary>
+    void EndEntityCollision(const EntityHandle& _entity);
+
+    /// <summary>
+    /// エンティティの全てのコライダーごとに _func(ICollider&) を呼ぶ
+    /// </summary>
+    template <typename Func>
+    void ForEachCollider(const EntityHandle& _entity, Func&& _func);
+
+    /// <summary>
+    /// 静的または眠っているエンティティか (記録開始/終了を毎フレーム行わない側)
+    /// </summary>
+    bool IsPassiveEntity(const EntityHandle& _entity);
 
     /// <summary>
-    /// エンティティペア間の衝突判定を行う
+    /// 静的または眠っているコライダーに今フレームのスロットを割り当てる (割り当て済みならそのスロットを返す)
     /// </summary>
-    void CheckEntityPair(const EntityHandle& _aEntity, const EntityHandle& _bEntity);
+    uint32_t AssignPassiveContactSlot(ICollider* _collider, const EntityHandle& _entity);
+
+    /// <summary>
+    /// 前フレームに衝突状態を持っていた静的/眠っているエンティティのコライダーにスロットを割り当てる.
+    /// 今フレームに衝突が無くても EndPassiveContacts で Exit を求められるようにする.
+    /// </summary>
+    void BeginPassiveContacts();
+
+    /// <summary>
+    /// 静的/眠っているエンティティのコライダーの衝突状態を更新する.
+    /// 狭域フェーズで判定しない相手 (静的/眠っている同士) との衝突は, どちらも動いていないので前フレームのまま残す.
+    /// 衝突状態が残ったエンティティは次のフレームにも更新する.
+    /// </summary>
+    void EndPassiveContacts();
+
+    /// <summary>
+    /// エンティティが静的か (有効なColliderを1つ以上持ち, それが全て静的)
+    /// </summary>
+    bool IsStaticEntity(const EntityHandle& _entity);
+
+    /// <summary>
+    /// エンティティのRigidbodyが眠っているか
+    /// </summary>
+    bool IsSleepingEntity(const EntityHandle& _entity);
+
+    /// <summary>
+    /// エンティティが持つコライダーの構成 (型ごとの個数) を1つの値にまとめる.
+    /// コライダーの追加/削除では静的コライダーの変更通知が来ないため, 静的判定のやり直しの検出に使う.
+    /// </summary>
+    uint64_t ComputeColliderKey(const EntityHandle& _entity);
+
+    /// <summary>
+    /// entities_ を静的/動的/眠っている動的に振り分ける. 静的エンティティの増減や変更通知があれば staticBvhDirty_ を立てる.
+    /// </summary>
+    void ClassifyEntities();
+
+    /// <summary>
+    /// 眠っているエンティティを広域フェーズに登録する (AABBは眠った後の最初のフレームに1度だけ計算する)
+    /// </summary>
+    void RegisterSleepingEntity(const EntityHandle& _entity, bool _useTree);
+
+    /// <summary>
+    /// 静的エンティティから静的BVHを作り直す
+    /// </summary>
+    void RebuildStaticBVH();
+
+    /// <summary>
+    /// (Debug のみ) 静的BVHに焼き込んだ後で, ICollider::MarkStaticDirty を呼ばずに Transform を書き換えられた静的エンティティが無いか確かめる
+    /// </summary>
+    void CheckStaticTransforms();
+
+    /// <summary>
+    /// 移動量が Rigidbody の ccdThreshold を超えた動的エンティティを prePos から現在位置まで掃引し,
+    /// 押し戻される相手に最初に接する位置まで戻す (薄いコライダーのすり抜け防止).
+    /// 相手は今フレームの位置で登録し終えた広域フェーズと静的BVHから探し, 戻したエンティティは登録し直す.
+    /// </summary>
+    void ClampFastEntities(bool _useTree);
+
+    /// <summary>
+    /// エンティティの Sphere/Capsule コライダーを _distance だけ戻した位置から _direction へ掃引し, 押し戻される相手に接するまでの距離を求める
+    /// </summary>
+    /// <param name="_direction">ワールド空間の移動方向 (正規化済み)</param>
+    /// <param name="_distance">移動距離</param>
+    /// <param name="_outDistance">接するまでの移動距離</param>
+    /// <returns>_distance 以内で接すればtrue</returns>
+    bool SweepEntity(const EntityHandle& _entity, Transform* _transform, const Vec3f& _direction, float _distance, float& _outDistance);
+
+    /// <summary>
+    /// 動的AABB木のエンティティのAABBと衝突レイヤーを更新する (AABBが無くなったら木から外す)
+    /// </summary>
+    void UpdateTreeProxy(const EntityHandle& _entity, const Bounds::AABB& _aabb, const CollisionLayer& _layer);
+
+    /// <summary>
+    /// 今フレーム更新されなかった (システムから外れた) エンティティを動的AABB木から外す
+    /// </summary>
+    void RemoveStaleTreeProxies();
+
+    /// <summary>
+    /// レイ (半径を持たせると掃引球) が通る可能性のあるエンティティを広域フェーズと静的BVHから queryCandidates_ に集める
+    /// </summary>
+    void GatherRayCandidates(const Bounds::Ray& _ray, float _maxDistance, float _radius);
+
+    /// <summary>
+    /// AABBと重なる可能性のあるエンティティを広域フェーズと静的BVHから queryCandidates_ に集める
+    /// </summary>
+    void GatherAABBCandidates(const Bounds::AABB& _aabb);
+
+    /// <summary>
+    /// エンティティのシーンクエリ対象のコライダー (有効でカテゴリが一致する AABB/Sphere/OBB/Capsule) ごとに _func(collider, worldShape) を呼ぶ.
+    /// _func が false を返したら打ち切る.
+    /// </summary>
+    template <typename Func>
+    void ForEachQueryCollider(const EntityHandle& _entity, uint32_t _categoryMask, Func&& _func);
+
+    /// <summary>
+    /// queryCandidates_ の中でレイが最初に当たるコライダーを求める (_outHit.distance 未満の当たりだけを採用する)
+    /// </summary>
+    bool RaycastCandidates(const Bounds::Ray& _ray, float _maxDistance, CollisionQueryHit& _outHit, uint32_t _categoryMask);
 
 protected:
+    /// <summary>
+    /// 使用する広域フェーズ
+    /// </summary>
+    CollisionBroadphaseType broadphaseType_ = CollisionBroadphaseType::SpatialHash;
+
     /// <summary>
     /// 空間ハッシュ
     /// </summary>
     SpatialHash spatialHash_;
 
+    /// <summary>
+    /// 動的AABB木 (フレームをまたいで保持する)
+    /// </summary>
+    DynamicAABBTree dynamicTree_;
+
+    /// <summary>
+    /// 動的AABB木に登録したエンティティの葉
+    /// </summary>
+    struct TreeProxy {
+        int32_t proxyId       = DynamicAABBTree::kNullNode;
+        uint64_t updatedFrame = 0; // 最後にAABBを更新したフレーム
+    };
+    std::unordered_map<EntityHandle, TreeProxy> treeProxies_;
+    uint64_t frameCount_          = 0;
+    size_t updatedTreeProxyCount_ = 0; // 今フレームで更新した葉の数
+
+    /// <summary>
+    /// 静的エンティティを焼き込んだBVH (静的コライダーの配置が変わった時だけ作り直す)
+    /// </summary>
+    StaticBVH staticBvh_;
+    /// <summary>
+    /// エンティティごとの静的判定結果. コライダーの付け外しで判定し直せるよう, 判定時のコライダー構成も持つ
+    /// </summary>
+    struct StaticClassification {
+        uint64_t colliderKey = 0; // ComputeColliderKey の値
+        bool isStatic        = false;
+#ifdef _DEBUG
+        // 静的BVHに焼き込んだ時の Transform (CheckStaticTransforms で比べる)
+        bool hasBakedPose            = false;
+        Vec3f bakedScale             = {};
+        Vec4f bakedRotate            = {};
+        Vec3f bakedTranslate         = {};
+        const Transform* bakedParent = nullptr;
+#endif // _DEBUG
+    };
+    std::unordered_map<EntityHandle, StaticClassification> staticClassifications_;
+    std::vector<EntityHandle> staticEntities_; // 今フレームの静的エンティティ
+    std::vector<EntityHandle> dynamicEntities_; // 今フレームの動的エンティティ
+    std::vector<Bounds::AABB> dynamicAABBs_; // dynamicEntities_ の包含AABB
+    std::vector<CollisionLayer> dynamicLayers_; // dynamicEntities_ の衝突レイヤー
+    std::vector<EntityHandle> sleepingEntities_; // 今フレームの眠っている動的エンティティ
+    size_t clampedEntityCount_ = 0; // 今フレームで連続衝突判定により位置を戻したエンティティ数
+
+    /// <summary>
+    /// 眠っているエンティティの包含AABBと衝突レイヤー (眠っている間は動かないので使い回す)
+    /// </summary>
+    struct SleepingBounds {
+        Bounds::AABB aabb;
+        CollisionLayer layer;
+        uint64_t updatedFrame = 0; // 最後に登録したフレーム
+    };
+    std::unordered_map<EntityHandle, SleepingBounds> sleepingBounds_;
+    std::vector<EntityHandle> staticBakeEntities_; // BVH構築用の作業領域
+    std::vector<Bounds::AABB> staticAABBs_; // BVH構築用の作業領域
+    std::vector<CollisionLayer> staticLayers_; // BVH構築用の作業領域
+    std::vector<EntityHandle> staticHits_; // BVH検索結果の作業領域
+    uint32_t staticRevision_ = 0; // 最後に確認した ICollider::GetStaticRevision()
+    size_t bakedStaticCount_ = 0; // BVH構築時の静的エンティティ数
+    bool staticBvhDirty_     = true;
+
     /// <summary>
     /// 衝突候補ペア
     /// </summary>
     std::vector<std::pair<EntityHandle, EntityHandle>> collisionPairs_;
 
+    /// <summary>
+    /// 狭域フェーズ (判定する組と, 分割ごとの記録先)
+    /// </summary>
+    std::vector<NarrowphaseTask> narrowphaseTasks_;
+    std::vector<NarrowphaseBuffer> narrowphaseBuffers_;
+
+    /// <summary>
+    /// 今フレームの衝突をコライダーごとにまとめたもの (記録終了時に各コライダーへ渡し, 前フレームと突き合わせる)
+    /// </summary>
+    CollisionContactCache contactCache_;
+
+    /// <summary>
+    /// 静的/眠っているコライダーの衝突状態の記録 (衝突があった時だけスロットを割り当てて更新する).
+    /// これらのコライダーのスロットは, 割り当てたフレームの EndPassiveContacts で kInvalidSlot に戻す.
+    /// </summary>
+    std::vector<EntityHandle> passiveContactEntities_; // 衝突状態を更新する静的/眠っているエンティティ (フレームをまたいで持ち越す)
+    std::vector<EntityHandle> passiveContactOthers_; // EndPassiveContacts の作業領域
+
+    /// <summary>
+    /// 最後の Update の衝突判定の内訳
+    /// </summary>
+    CollisionCheckStats stats_;
+
+    /// <summary>
+    /// シーンクエリの候補エンティティの作業領域
+    /// </summary>
+    std::vector<EntityHandle> queryCandidates_;
+
     /// <summary>
     /// エンティティのペアを走査するためのイテレータ
     /// </summary>
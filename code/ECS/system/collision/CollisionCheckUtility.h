@@ -112,4 +112,34 @@ inline Vec3f ClosestPointOnOBB(const Vec3f& _point, const Bounds::OBB& _obb) {
     return result;
 }
 
+/// <summary>
+/// レイと箱 (min, max) の交差区間を求める (スラブ法).
+/// _tMin, _tMax に調べる区間を渡すと, 箱の内側にある区間に狭めて返す.
+/// </summary>
+/// <param name="_origin">レイの始点</param>
+/// <param name="_direction">レイの方向</param>
+/// <returns>区間が残っていればtrue</returns>
+inline bool ClipRayToBox(const Vec3f& _origin, const Vec3f& _direction, const Vec3f& _min, const Vec3f& _max, float& _tMin, float& _tMax) {
+    for (int i = 0; i < 3; ++i) {
+        if (std::abs(_direction[i]) < kEpsilon) {
+            if (_origin[i] < _min[i] || _origin[i] > _max[i]) {
+                return false;
+            }
+            continue;
+        }
+        float ood = 1.0f / _direction[i];
+        float t1  = (_min[i] - _origin[i]) * ood;
+        float t2  = (_max[i] - _origin[i]) * ood;
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        _tMin = (std::max)(_tMin, t1);
+        _tMax = (std::min)(_tMax, t2);
+        if (_tMin > _tMax) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace OriGine
@@ -0,0 +1,70 @@
+#include "CollisionContactCache.h"
+
+/// stl
+#include <algorithm>
+
+namespace OriGine {
+
+void CollisionContactCache::BeginFrame() {
+    colliderCount_ = 0;
+    records_.clear();
+    offsets_.clear();
+    contacts_.clear();
+}
+
+void CollisionContactCache::AddContact(uint32_t _slot, const EntityHandle& _other) {
+    if (_slot >= colliderCount_) {
+        return;
+    }
+    records_.push_back(ContactRecord{_slot, _other});
+}
+
+void CollisionContactCache::EndFrame() {
+    // スロットごとの数を数えて開始位置を求める (計数ソート)
+    offsets_.assign(colliderCount_ + 1, 0);
+    for (const auto& record : records_) {
+        ++offsets_[record.slot + 1];
+    }
+    for (uint32_t slot = 0; slot < colliderCount_; ++slot) {
+        offsets_[slot + 1] += offsets_[slot];
+    }
+
+    contacts_.resize(records_.size());
+    for (const auto& record : records_) {
+        // offsets_[slot] を書き込み位置として進め, 終わった後 offsets_[slot] は次のスロットの開始位置になる
+        contacts_[offsets_[record.slot]++] = record.other;
+    }
+
+    // スロット内を相手順に並べて重複を取り除き, 前に詰める
+    uint32_t write = 0;
+    uint32_t begin = 0;
+    for (uint32_t slot = 0; slot < colliderCount_; ++slot) {
+        uint32_t end = offsets_[slot];
+        std::sort(contacts_.begin() + begin, contacts_.begin() + end);
+        offsets_[slot] = write;
+        for (uint32_t i = begin; i < end; ++i) {
+            if (write == offsets_[slot] || !(contacts_[i] == contacts_[write - 1])) {
+                contacts_[write++] = contacts_[i];
+            }
+        }
+        begin = end;
+    }
+    offsets_[colliderCount_] = write;
+    contacts_.resize(write);
+}
+
+void CollisionContactCache::Clear() {
+    colliderCount_ = 0;
+    records_.clear();
+    offsets_.clear();
+    contacts_.clear();
+}
+
+std::span<const EntityHandle> CollisionContactCache::GetContacts(uint32_t _slot) const {
+    if (_slot >= colliderCount_ || offsets_.size() <= colliderCount_) {
+        return {};
+    }
+    return std::span<const EntityHandle>(contacts_.data() + offsets_[_slot], offsets_[_slot + 1] - offsets_[_slot]);
+}
+
+} // namespace OriGine
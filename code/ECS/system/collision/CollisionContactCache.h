@@ -0,0 +1,81 @@
+#pragma once
+
+/// stl
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// ECS
+#include "entity/EntityHandle.h"
+
+namespace OriGine {
+
+/// <summary>
+/// 1フレーム分の衝突をコライダーごとにまとめるキャッシュ.
+/// コライダーには毎フレーム連番のスロットを割り当て, 衝突相手をスロット順 (同じスロット内は相手のエンティティ順) の平らな配列に並べる.
+/// 各コライダーは自身のスロットの範囲を受け取り, 前フレームの衝突相手と突き合わせて Enter/Stay/Exit を求める.
+/// 配列はフレームをまたいで使い回すので, 定常状態では確保が起きない.
+/// </summary>
+class CollisionContactCache {
+public:
+    static constexpr uint32_t kInvalidSlot = 0xFFFFFFFF;
+
+    CollisionContactCache()  = default;
+    ~CollisionContactCache() = default;
+
+    /// <summary>
+    /// 今フレームの記録を開始する (スロットの割り当てもやり直す)
+    /// </summary>
+    void BeginFrame();
+
+    /// <summary>
+    /// コライダーのスロットを割り当てる
+    /// </summary>
+    /// <returns>今フレームのスロット番号</returns>
+    uint32_t AddCollider() { return colliderCount_++; }
+
+    /// <summary>
+    /// 今フレームの衝突を追加する (同じ組を複数回追加してもよい)
+    /// </summary>
+    /// <param name="_slot">衝突したコライダーのスロット</param>
+    /// <param name="_other">衝突相手のエンティティ</param>
+    void AddContact(uint32_t _slot, const EntityHandle& _other);
+
+    /// <summary>
+    /// 追加された衝突をスロットごとに並べる
+    /// </summary>
+    void EndFrame();
+
+    /// <summary>
+    /// 全ての記録を破棄する
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// スロットの衝突相手を取得 (相手のエンティティ順, 重複なし. 次の BeginFrame まで有効)
+    /// </summary>
+    std::span<const EntityHandle> GetContacts(uint32_t _slot) const;
+
+    /// <summary>
+    /// 今フレームの衝突の数を取得 (重複を除く)
+    /// </summary>
+    size_t GetContactCount() const { return contacts_.size(); }
+
+private:
+    /// <summary>
+    /// 追加された衝突
+    /// </summary>
+    struct ContactRecord {
+        uint32_t slot;
+        EntityHandle other;
+    };
+
+private:
+    uint32_t colliderCount_ = 0;
+    std::vector<ContactRecord> records_; // 追加順の衝突
+
+    std::vector<uint32_t> offsets_; // スロットごとの contacts_ の開始位置 (末尾に総数)
+    std::vector<EntityHandle> contacts_; // スロット順に並べた衝突相手
+};
+
+} // namespace OriGine
@@ -0,0 +1,53 @@
+#pragma once
+
+/// stl
+#include <cstdint>
+
+/// ECS
+// component
+#include "component/collision/collider/base/CollisionCategory.h"
+
+namespace OriGine {
+
+/// <summary>
+/// 広域フェーズで使うエンティティの衝突レイヤー.
+/// エンティティが持つ有効なコライダーの CollisionCategory のビットとマスクをそれぞれ OR でまとめたもの.
+/// 2つのレイヤーの CanCollideWith が false なら, その間のどのコライダーの組も ICollider::CanCollideWith を満たさない.
+/// </summary>
+struct CollisionLayer {
+    uint32_t bits = 0xFFFFFFFF; // 所属するカテゴリのビット
+    uint32_t mask = 0xFFFFFFFF; // 衝突相手として許可するカテゴリのビット
+
+    /// <summary>
+    /// どのカテゴリにも属さないレイヤー (Merge で積み上げる時の初期値)
+    /// </summary>
+    static CollisionLayer Empty() { return CollisionLayer{0, 0}; }
+
+    /// <summary>
+    /// コライダーのカテゴリを加える
+    /// </summary>
+    void Merge(const CollisionCategory& _category) {
+        bits |= _category.GetBits();
+        mask |= _category.GetMaskBits();
+    }
+
+    /// <summary>
+    /// 2つのレイヤーをまとめたレイヤー (木のノードなど, 子の全てを含むレイヤー)
+    /// </summary>
+    CollisionLayer Union(const CollisionLayer& _other) const {
+        return CollisionLayer{bits | _other.bits, mask | _other.mask};
+    }
+
+    /// <summary>
+    /// 双方向にマスクを満たすか (ICollider::CanCollideWith と同じ条件)
+    /// </summary>
+    bool CanCollideWith(const CollisionLayer& _other) const {
+        return (mask & _other.bits) != 0 && (_other.mask & bits) != 0;
+    }
+
+    bool operator==(const CollisionLayer& _other) const {
+        return bits == _other.bits && mask == _other.mask;
+    }
+};
+
+} // namespace OriGine
@@ -9,6 +9,14 @@
 
 using namespace OriGine;
 
+/// <summary>
+/// コンストラクタ
+/// </summary>
+CollisionPushBackSystem::CollisionPushBackSystem() : ISystem(SystemCategory::Collision) {
+    DeclareRead<CollisionPushBackInfo>();
+    DeclareWrite<Transform, Rigidbody>();
+}
+
 /// <summary>
 /// 初期化
 /// </summary>
@@ -25,16 +33,43 @@ void CollisionPushBackSystem::Finalize() {}
 /// <param name="_handle">対象のエンティティハンドル</param>
 void CollisionPushBackSystem::UpdateEntity(const EntityHandle& _handle) {
     CollisionPushBackInfo* collPushbackInfo = GetComponent<CollisionPushBackInfo>(_handle);
+    Transform* transform                    = GetComponent<Transform>(_handle);
+    if (collPushbackInfo == nullptr || transform == nullptr) {
+        ReportMissingComponents(_handle, collPushbackInfo != nullptr, transform != nullptr);
+        return;
+    }
+    // 眠っている物体は動かさない (触れられた分は, 次のフレームで起きてから判定し直して押し戻す)
+    if (HasComponent<Rigidbody>(_handle) && GetComponent<Rigidbody>(_handle)->IsSleeping()) {
+        return;
+    }
+
+    PushBack(_handle, *collPushbackInfo, *transform);
+}
 
-    if (collPushbackInfo == nullptr) {
+/// <summary>
+/// 登録されているエンティティに足りないコンポーネントを報告する
+/// </summary>
+void CollisionPushBackSystem::ReportMissingComponents(const EntityHandle& _handle, bool _hasPushBackInfo, bool _hasTransform) {
+    if (!_hasPushBackInfo) {
         LOG_ERROR("EntityHandle {} has no CollisionPushBackInfo component.", uuids::to_string(_handle.uuid));
         return;
     }
+    if (!_hasTransform) {
+        LOG_ERROR("EntityHandle {} has no Transform component.", uuids::to_string(_handle.uuid));
+    }
+}
 
+/// <summary>
+/// 衝突情報から押し戻し量を求め, Transformに反映する
+/// </summary>
+/// <param name="_handle">対象のエンティティハンドル</param>
+/// <param name="_pushBackInfo">衝突情報</param>
+/// <param name="_transform">押し戻すTransform</param>
+void CollisionPushBackSystem::PushBack(const EntityHandle& _handle, CollisionPushBackInfo& _pushBackInfo, Transform& _transform) {
     Vec3f pushBackSum = Vec3f(0.f, 0.f, 0.f);
 
     // PushBack処理
-    for (auto& [entityID, info] : collPushbackInfo->GetCollisionInfoMap()) {
+    for (auto& [entityID, info] : _pushBackInfo.GetCollisionInfoMap()) {
 
         switch (info.pushBackType) {
         case CollisionPushBackType::PushBack: {
@@ -46,16 +81,16 @@ void CollisionPushBackSystem::UpdateEntity(const EntityHandle& _handle) {
         case CollisionPushBackType::Reflect: {
             pushBackSum += info.collVec;
 
-            Rigidbody* rigidbody      = GetComponent<Rigidbody>(_handle);
-            Rigidbody* otherRigidbody = GetComponent<Rigidbody>(EntityHandle(entityID));
-
-            if (rigidbody) {
-                Vec3f velocity = rigidbody->GetVelocity();
-                Vec3f normal   = info.collVec.normalize();
+            // Rigidbody を持たないエンティティは反射させない (シグネチャで判定し, 配列を引かない)
+            if (HasComponent<Rigidbody>(_handle)) {
+                Rigidbody* rigidbody = GetComponent<Rigidbody>(_handle);
+                Vec3f velocity       = rigidbody->GetVelocity();
+                Vec3f normal         = info.collVec.normalize();
 
-                float restitution = rigidbody->GetRestitution();
-                if (otherRigidbody) {
-                    restitution = std::max(restitution, otherRigidbody->GetRestitution());
+                float restitution        = rigidbody->GetRestitution();
+                EntityHandle otherEntity = EntityHandle(entityID);
+                if (HasComponent<Rigidbody>(otherEntity)) {
+                    restitution = std::max(restitution, GetComponent<Rigidbody>(otherEntity)->GetRestitution());
                 }
 
                 velocity = Reflect(velocity, normal, restitution);
@@ -69,6 +104,5 @@ void CollisionPushBackSystem::UpdateEntity(const EntityHandle& _handle) {
         }
     }
 
-    Transform* transform = GetComponent<Transform>(_handle);
-    transform->translate += pushBackSum;
+    _transform.translate += pushBackSum;
 }
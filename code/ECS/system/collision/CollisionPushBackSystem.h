@@ -2,6 +2,9 @@
 #include "system/ISystem.h"
 
 namespace OriGine {
+/// 前方宣言
+struct Transform;
+class CollisionPushBackInfo;
 
 /// <summary>
 /// 衝突判定後に押し戻し処理を行うシステム
@@ -12,8 +15,7 @@ public:
     /// <summary>
     /// コンストラクタ
     /// </summary>
-    CollisionPushBackSystem()
-        : ISystem(SystemCategory::Collision) {}
+    CollisionPushBackSystem();
 
     /// <summary>
     /// デストラクタ
@@ -36,6 +38,22 @@ protected:
     /// </summary>
     /// <param name="_handle">対象のエンティティハンドル</param>
     void UpdateEntity(const EntityHandle& _handle) override;
+
+    /// <summary>
+    /// 登録されているエンティティに足りないコンポーネントを報告する (どちらも持っていれば何もしない)
+    /// </summary>
+    /// <param name="_handle">対象のエンティティハンドル</param>
+    /// <param name="_hasPushBackInfo">CollisionPushBackInfo を持っているか</param>
+    /// <param name="_hasTransform">Transform を持っているか</param>
+    void ReportMissingComponents(const EntityHandle& _handle, bool _hasPushBackInfo, bool _hasTransform);
+
+    /// <summary>
+    /// 衝突情報から押し戻し量を求め, Transformに反映する
+    /// </summary>
+    /// <param name="_handle">対象のエンティティハンドル</param>
+    /// <param name="_pushBackInfo">衝突情報</param>
+    /// <param name="_transform">押し戻すTransform</param>
+    void PushBack(const EntityHandle& _handle, CollisionPushBackInfo& _pushBackInfo, Transform& _transform);
 };
 
 } // namespace OriGine
@@ -0,0 +1,470 @@
+#include "CollisionQueryFunc.h"
+
+/// stl
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+/// collision
+#include "CollisionCheckPairFunc.h"
+#include "CollisionCheckUtility.h"
+
+/// math
+#include "math/MathEnv.h"
+
+namespace OriGine {
+
+namespace {
+
+constexpr int32_t kMaxAdvanceIterations    = 32; // 保守的前進の最大反復回数
+constexpr int32_t kSegmentSearchIterations = 32; // 線分上の最近接位置を探す反復回数
+constexpr float kAdvanceTolerance          = 1e-4f; // 接したとみなす隙間
+
+/// <summary>
+/// レイと球の交差判定 (始点が球の内側なら当たらない)
+/// </summary>
+bool IntersectRaySphere(const Vec3f& _origin, const Vec3f& _direction, const Vec3f& _center, float _radius, float _maxDistance, float& _outDistance) {
+    Vec3f m = _origin - _center;
+    float c = m.dot(m) - _radius * _radius;
+    float b = m.dot(_direction);
+    if (c <= 0.f || b > 0.f) {
+        return false; // 内側から, または離れていく
+    }
+    float discriminant = b * b - c;
+    if (discriminant < 0.f) {
+        return false;
+    }
+    float t = -b - std::sqrt(discriminant);
+    if (t > _maxDistance) {
+        return false;
+    }
+    _outDistance = (std::max)(t, 0.f);
+    return true;
+}
+
+/// <summary>
+/// レイとカプセルの交差判定 (始点がカプセルの内側なら当たらない). 円柱部分と両端の球のうち最も近い交点を使う.
+/// </summary>
+bool IntersectRayCapsule(const Vec3f& _origin, const Vec3f& _direction, const Vec3f& _start, const Vec3f& _end, float _radius, float _maxDistance, float& _outDistance) {
+    if (Vec3f(_origin - ClosestPointOnSegment(_origin, _start, _end)).lengthSq() <= _radius * _radius) {
+        return false;
+    }
+
+    float best = FLT_MAX;
+    Vec3f d    = _end - _start;
+    Vec3f m    = _origin - _start;
+    float dd   = d.dot(d);
+    float nd   = _direction.dot(d);
+    float a    = dd - nd * nd;
+    if (dd > kEpsilon && a > kEpsilon) {
+        // 軸を含む無限円柱との交点のうち, 軸方向の位置が線分の範囲にあるもの
+        float md           = m.dot(d);
+        float mn           = m.dot(_direction);
+        float c            = dd * (m.dot(m) - _radius * _radius) - md * md;
+        float b            = dd * mn - nd * md;
+        float discriminant = b * b - a * c;
+        if (discriminant >= 0.f) {
+            float t = (-b - std::sqrt(discriminant)) / a;
+            float s = md + t * nd;
+            if (t >= 0.f && s >= 0.f && s <= dd) {
+                best = t;
+            }
+        }
+    }
+
+    float t = 0.f;
+    if (IntersectRaySphere(_origin, _direction, _start, _radius, _maxDistance, t) && t < best) {
+        best = t;
+    }
+    if (IntersectRaySphere(_origin, _direction, _end, _radius, _maxDistance, t) && t < best) {
+        best = t;
+    }
+    if (best > _maxDistance) {
+        return false;
+    }
+    _outDistance = best;
+    return true;
+}
+
+/// <summary>
+/// 箱のローカル空間 (中心が原点, 軸が座標軸) でのレイとの交差判定 (始点が箱の内側なら当たらない)
+/// </summary>
+/// <param name="_outNormal">交点の法線 (ローカル空間)</param>
+bool IntersectRayLocalBox(const Vec3f& _origin, const Vec3f& _direction, const Vec3f& _halfSize, float _maxDistance, float& _outDistance, Vec3f& _outNormal) {
+    float tMin  = 0.f;
+    float tMax  = _maxDistance;
+    int hitAxis = -1;
+    for (int i = 0; i < 3; ++i) {
+        if (std::abs(_direction[i]) < kEpsilon) {
+            if (_origin[i] < -_halfSize[i] || _origin[i] > _halfSize[i]) {
+                return false;
+            }
+            continue;
+        }
+        float ood = 1.0f / _direction[i];
+        float t1  = (-_halfSize[i] - _origin[i]) * ood;
+        float t2  = (_halfSize[i] - _origin[i]) * ood;
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        if (t1 > tMin) {
+            tMin    = t1;
+            hitAxis = i;
+        }
+        tMax = (std::min)(tMax, t2);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+    // どの面からも入らない = 始点が箱の内側
+    if (hitAxis < 0) {
+        return false;
+    }
+
+    _outDistance        = tMin;
+    _outNormal          = Vec3f(0.f, 0.f, 0.f);
+    _outNormal[hitAxis] = _direction[hitAxis] > 0.f ? -1.f : 1.f;
+    return true;
+}
+
+/// <summary>
+/// 箱のローカル空間での掃引球との判定. 箱を球の半径で膨らませた形状 (各軸方向に伸ばした3つの箱と12本の辺のカプセルの和) とレイで判定する.
+/// </summary>
+bool SweepSphereLocalBox(const Vec3f& _origin, const Vec3f& _direction, float _radius, const Vec3f& _halfSize, float _maxDistance, float& _outDistance, Vec3f& _outNormal) {
+    Vec3f closest(std::clamp(_origin[X], -_halfSize[X], _halfSize[X]), std::clamp(_origin[Y], -_halfSize[Y], _halfSize[Y]), std::clamp(_origin[Z], -_halfSize[Z], _halfSize[Z]));
+    if (Vec3f(_origin - closest).lengthSq() <= _radius * _radius) {
+        return false;
+    }
+
+    float best = FLT_MAX;
+    float t    = 0.f;
+    Vec3f normal;
+
+    // 面: 1軸だけ半径分伸ばした箱
+    for (int axis = 0; axis < 3; ++axis) {
+        Vec3f halfSize  = _halfSize;
+        halfSize[axis] += _radius;
+        if (IntersectRayLocalBox(_origin, _direction, halfSize, _maxDistance, t, normal) && t < best) {
+            best       = t;
+            _outNormal = normal;
+        }
+    }
+
+    // 辺 (角は辺のカプセルの端の球に含まれる)
+    for (int axis = 0; axis < 3; ++axis) {
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+        for (int corner = 0; corner < 4; ++corner) {
+            Vec3f start;
+            start[axis] = -_halfSize[axis];
+            start[u]    = (corner & 1) ? _halfSize[u] : -_halfSize[u];
+            start[v]    = (corner & 2) ? _halfSize[v] : -_halfSize[v];
+            Vec3f end   = start;
+            end[axis]   = _halfSize[axis];
+            if (IntersectRayCapsule(_origin, _direction, start, end, _radius, _maxDistance, t) && t < best) {
+                best        = t;
+                Vec3f point = _origin + _direction * t;
+                _outNormal  = Vec3f(point - ClosestPointOnSegment(point, start, end)).normalize();
+            }
+        }
+    }
+
+    if (best > _maxDistance) {
+        return false;
+    }
+    _outDistance = best;
+    return true;
+}
+
+/// <summary>
+/// レイをOBBのローカル空間に移す
+/// </summary>
+void ToOBBLocal(const Bounds::Ray& _ray, const Bounds::OBB& _obb, Vec3f& _outOrigin, Vec3f& _outDirection) {
+    Vec3f offset = _ray.origin - _obb.center_;
+    for (int i = 0; i < 3; ++i) {
+        _outOrigin[i]    = offset.dot(_obb.orientations_.axis[i]);
+        _outDirection[i] = _ray.direction.dot(_obb.orientations_.axis[i]);
+    }
+}
+
+/// <summary>
+/// OBBのローカル空間の方向をワールド空間に戻す
+/// </summary>
+Vec3f FromOBBLocal(const Vec3f& _local, const Bounds::OBB& _obb) {
+    return _obb.orientations_.axis[0] * _local[X] + _obb.orientations_.axis[1] * _local[Y] + _obb.orientations_.axis[2] * _local[Z];
+}
+
+/// <summary>
+/// 点をOBBのローカル空間に移す
+/// </summary>
+Vec3f ToOBBLocal(const Vec3f& _point, const Bounds::OBB& _obb) {
+    Vec3f offset = _point - _obb.center_;
+    return Vec3f(offset.dot(_obb.orientations_.axis[0]), offset.dot(_obb.orientations_.axis[1]), offset.dot(_obb.orientations_.axis[2]));
+}
+
+/// <summary>
+/// 箱のローカル空間で線分と箱の最近接点を求める.
+/// 箱までの距離は線分上の位置について凸なので, 黄金分割探索で最小の位置を探す.
+/// </summary>
+/// <returns>最近接点間の距離</returns>
+float ClosestPointsSegmentLocalBox(const Vec3f& _start, const Vec3f& _end, const Vec3f& _halfSize, Vec3f& _outSegmentPoint, Vec3f& _outBoxPoint) {
+    constexpr float kInvGoldenRatio = 0.618034f;
+
+    Vec3f segment   = _end - _start;
+    auto clampToBox = [&_halfSize](const Vec3f& _point) {
+        return Vec3f(std::clamp(_point[X], -_halfSize[X], _halfSize[X]), std::clamp(_point[Y], -_halfSize[Y], _halfSize[Y]), std::clamp(_point[Z], -_halfSize[Z], _halfSize[Z]));
+    };
+    auto distanceSq = [&](float _t) {
+        Vec3f point = _start + segment * _t;
+        return Vec3f(point - clampToBox(point)).lengthSq();
+    };
+
+    float low   = 0.f;
+    float high  = 1.f;
+    float t1    = high - (high - low) * kInvGoldenRatio;
+    float t2    = low + (high - low) * kInvGoldenRatio;
+    float dist1 = distanceSq(t1);
+    float dist2 = distanceSq(t2);
+    for (int32_t i = 0; i < kSegmentSearchIterations; ++i) {
+        if (dist1 <= dist2) {
+            high  = t2;
+            t2    = t1;
+            dist2 = dist1;
+            t1    = high - (high - low) * kInvGoldenRatio;
+            dist1 = distanceSq(t1);
+        } else {
+            low   = t1;
+            t1    = t2;
+            dist1 = dist2;
+            t2    = low + (high - low) * kInvGoldenRatio;
+            dist2 = distanceSq(t2);
+        }
+    }
+
+    _outSegmentPoint = _start + segment * ((low + high) * 0.5f);
+    _outBoxPoint     = clampToBox(_outSegmentPoint);
+    return Vec3f(_outSegmentPoint - _outBoxPoint).length();
+}
+
+/// <summary>
+/// 保守的前進で, 動かす形状が相手に最初に接する移動量を求める.
+/// _gap(移動量, 法線) は隙間 (重なっていれば0以下) を返し, 離れていれば相手から動かす形状へ向かう法線を書き込む.
+/// 隙間は移動量について凸なので, 接線で見積もった接触位置まで進めても本当の接触位置を越えない.
+/// </summary>
+template <typename GapFunc>
+bool AdvanceUntilContact(const Vec3f& _direction, float _maxDistance, GapFunc&& _gap, float& _outDistance, Vec3f& _outNormal) {
+    float travel = 0.f;
+    Vec3f normal(0.f, 0.f, 0.f);
+    for (int32_t i = 0; i < kMaxAdvanceIterations; ++i) {
+        float gap = _gap(travel, normal);
+        if (i == 0 && gap <= 0.f) {
+            return false; // 始点で重なっている
+        }
+        float approach = -_direction.dot(normal);
+        if (approach <= kEpsilon) {
+            return false; // 離れていく (凸なのでこの先も近づかない)
+        }
+        if (gap <= kAdvanceTolerance) {
+            break;
+        }
+        travel += gap / approach;
+        if (travel > _maxDistance) {
+            return false;
+        }
+    }
+    // 反復が尽きても, ここまでの移動量は接触位置を越えていない
+    _outDistance = travel;
+    _outNormal   = normal;
+    return true;
+}
+
+/// <summary>
+/// 箱のローカル空間での掃引カプセルとの判定
+/// </summary>
+bool SweepCapsuleLocalBox(const Vec3f& _start, const Vec3f& _end, float _radius, const Vec3f& _direction, const Vec3f& _halfSize, float _maxDistance, float& _outDistance, Vec3f& _outNormal) {
+    return AdvanceUntilContact(
+        _direction, _maxDistance,
+        [&](float _travel, Vec3f& _normal) {
+            Vec3f offset = _direction * _travel;
+            Vec3f segmentPoint, boxPoint;
+            float distance = ClosestPointsSegmentLocalBox(_start + offset, _end + offset, _halfSize, segmentPoint, boxPoint);
+            if (distance > kEpsilon) {
+                _normal = (segmentPoint - boxPoint) * (1.0f / distance);
+            }
+            return distance - _radius;
+        },
+        _outDistance, _outNormal);
+}
+
+} // namespace
+
+#pragma region Raycast
+
+bool RaycastShape(const Bounds::Ray& _ray, float _maxDistance, const Bounds::Sphere& _shape, float& _outDistance, Vec3f& _outNormal) {
+    if (!IntersectRaySphere(_ray.origin, _ray.direction, _shape.center_, _shape.radius_, _maxDistance, _outDistance)) {
+        return false;
+    }
+    _outNormal = Vec3f(_ray.GetPoint(_outDistance) - _shape.center_).normalize();
+    return true;
+}
+
+bool RaycastShape(const Bounds::Ray& _ray, float _maxDistance, const Bounds::AABB& _shape, float& _outDistance, Vec3f& _outNormal) {
+    return IntersectRayLocalBox(_ray.origin - _shape.center, _ray.direction, _shape.halfSize, _maxDistance, _outDistance, _outNormal);
+}
+
+bool RaycastShape(const Bounds::Ray& _ray, float _maxDistance, const Bounds::OBB& _shape, float& _outDistance, Vec3f& _outNormal) {
+    Vec3f localOrigin, localDirection, localNormal;
+    ToOBBLocal(_ray, _shape, localOrigin, localDirection);
+    if (!IntersectRayLocalBox(localOrigin, localDirection, _shape.halfSize_, _maxDistance, _outDistance, localNormal)) {
+        return false;
+    }
+    _outNormal = FromOBBLocal(localNormal, _shape);
+    return true;
+}
+
+bool RaycastShape(const Bounds::Ray& _ray, float _maxDistance, const Bounds::Capsule& _shape, float& _outDistance, Vec3f& _outNormal) {
+    const Vec3f& start = _shape.segment.start;
+    const Vec3f& end   = _shape.segment.end;
+    if (!IntersectRayCapsule(_ray.origin, _ray.direction, start, end, _shape.radius, _maxDistance, _outDistance)) {
+        return false;
+    }
+    Vec3f point = _ray.GetPoint(_outDistance);
+    _outNormal  = Vec3f(point - ClosestPointOnSegment(point, start, end)).normalize();
+    return true;
+}
+
+#pragma endregion
+
+#pragma region SweepSphere
+
+bool SweepSphereShape(const Bounds::Ray& _ray, float _radius, float _maxDistance, const Bounds::Sphere& _shape, float& _outDistance, Vec3f& _outNormal) {
+    if (!IntersectRaySphere(_ray.origin, _ray.direction, _shape.center_, _shape.radius_ + _radius, _maxDistance, _outDistance)) {
+        return false;
+    }
+    _outNormal = Vec3f(_ray.GetPoint(_outDistance) - _shape.center_).normalize();
+    return true;
+}
+
+bool SweepSphereShape(const Bounds::Ray& _ray, float _radius, float _maxDistance, const Bounds::AABB& _shape, float& _outDistance, Vec3f& _outNormal) {
+    return SweepSphereLocalBox(_ray.origin - _shape.center, _ray.direction, _radius, _shape.halfSize, _maxDistance, _outDistance, _outNormal);
+}
+
+bool SweepSphereShape(const Bounds::Ray& _ray, float _radius, float _maxDistance, const Bounds::OBB& _shape, float& _outDistance, Vec3f& _outNormal) {
+    Vec3f localOrigin, localDirection, localNormal;
+    ToOBBLocal(_ray, _shape, localOrigin, localDirection);
+    if (!SweepSphereLocalBox(localOrigin, localDirection, _radius, _shape.halfSize_, _maxDistance, _outDistance, localNormal)) {
+        return false;
+    }
+    _outNormal = FromOBBLocal(localNormal, _shape);
+    return true;
+}
+
+bool SweepSphereShape(const Bounds::Ray& _ray, float _radius, float _maxDistance, const Bounds::Capsule& _shape, float& _outDistance, Vec3f& _outNormal) {
+    const Vec3f& start = _shape.segment.start;
+    const Vec3f& end   = _shape.segment.end;
+    if (!IntersectRayCapsule(_ray.origin, _ray.direction, start, end, _shape.radius + _radius, _maxDistance, _outDistance)) {
+        return false;
+    }
+    Vec3f point = _ray.GetPoint(_outDistance);
+    _outNormal  = Vec3f(point - ClosestPointOnSegment(point, start, end)).normalize();
+    return true;
+}
+
+#pragma endregion
+
+#pragma region SweepCapsule
+
+bool SweepCapsuleShape(const Bounds::Capsule& _capsule, const Vec3f& _direction, float _maxDistance, const Bounds::Sphere& _shape, float& _outDistance, Vec3f& _outNormal) {
+    // 球の側から逆向きに, 球の半径だけ太らせたカプセルへレイを飛ばす
+    const Vec3f& start = _capsule.segment.start;
+    const Vec3f& end   = _capsule.segment.end;
+    if (!IntersectRayCapsule(_shape.center_, -_direction, start, end, _capsule.radius + _shape.radius_, _maxDistance, _outDistance)) {
+        return false;
+    }
+    Vec3f point = _shape.center_ - _direction * _outDistance;
+    _outNormal  = Vec3f(ClosestPointOnSegment(point, start, end) - point).normalize();
+    return true;
+}
+
+bool SweepCapsuleShape(const Bounds::Capsule& _capsule, const Vec3f& _direction, float _maxDistance, const Bounds::AABB& _shape, float& _outDistance, Vec3f& _outNormal) {
+    return SweepCapsuleLocalBox(_capsule.segment.start - _shape.center, _capsule.segment.end - _shape.center, _capsule.radius, _direction, _shape.halfSize, _maxDistance, _outDistance, _outNormal);
+}
+
+bool SweepCapsuleShape(const Bounds::Capsule& _capsule, const Vec3f& _direction, float _maxDistance, const Bounds::OBB& _shape, float& _outDistance, Vec3f& _outNormal) {
+    Vec3f localStart     = ToOBBLocal(_capsule.segment.start, _shape);
+    Vec3f localEnd       = ToOBBLocal(_capsule.segment.end, _shape);
+    Vec3f localDirection = ToOBBLocal(_shape.center_ + _direction, _shape);
+    Vec3f localNormal;
+    if (!SweepCapsuleLocalBox(localStart, localEnd, _capsule.radius, localDirection, _shape.halfSize_, _maxDistance, _outDistance, localNormal)) {
+        return false;
+    }
+    _outNormal = FromOBBLocal(localNormal, _shape);
+    return true;
+}
+
+bool SweepCapsuleShape(const Bounds::Capsule& _capsule, const Vec3f& _direction, float _maxDistance, const Bounds::Capsule& _shape, float& _outDistance, Vec3f& _outNormal) {
+    float radius = _capsule.radius + _shape.radius;
+    return AdvanceUntilContact(
+        _direction, _maxDistance,
+        [&](float _travel, Vec3f& _normal) {
+            Vec3f offset = _direction * _travel;
+            Vec3f capsulePoint, shapePoint;
+            ClosestPointsBetweenSegments(_capsule.segment.start + offset, _capsule.segment.end + offset, _shape.segment.start, _shape.segment.end, capsulePoint, shapePoint);
+            float distance = Vec3f(capsulePoint - shapePoint).length();
+            if (distance > kEpsilon) {
+                _normal = (capsulePoint - shapePoint) * (1.0f / distance);
+            }
+            return distance - radius;
+        },
+        _outDistance, _outNormal);
+}
+
+#pragma endregion
+
+#pragma region Overlap
+
+bool OverlapShape(const Bounds::Sphere& _query, const Bounds::Sphere& _shape) {
+    float radius = _query.radius_ + _shape.radius_;
+    return Vec3f(_query.center_ - _shape.center_).lengthSq() <= radius * radius;
+}
+
+bool OverlapShape(const Bounds::Sphere& _query, const Bounds::AABB& _shape) {
+    return Vec3f(_query.center_ - ClosestPointOnAABB(_query.center_, _shape)).lengthSq() <= _query.radius_ * _query.radius_;
+}
+
+bool OverlapShape(const Bounds::Sphere& _query, const Bounds::OBB& _shape) {
+    return Vec3f(_query.center_ - ClosestPointOnOBB(_query.center_, _shape)).lengthSq() <= _query.radius_ * _query.radius_;
+}
+
+bool OverlapShape(const Bounds::Sphere& _query, const Bounds::Capsule& _shape) {
+    float radius = _query.radius_ + _shape.radius;
+    Vec3f offset = _query.center_ - ClosestPointOnSegment(_query.center_, _shape.segment.start, _shape.segment.end);
+    return offset.lengthSq() <= radius * radius;
+}
+
+bool OverlapShape(const Bounds::AABB& _query, const Bounds::Sphere& _shape) {
+    return OverlapShape(_shape, _query);
+}
+
+bool OverlapShape(const Bounds::AABB& _query, const Bounds::AABB& _shape) {
+    Vec3f queryMin = _query.Min();
+    Vec3f queryMax = _query.Max();
+    Vec3f shapeMin = _shape.Min();
+    Vec3f shapeMax = _shape.Max();
+    return queryMin[X] <= shapeMax[X] && shapeMin[X] <= queryMax[X]
+           && queryMin[Y] <= shapeMax[Y] && shapeMin[Y] <= queryMax[Y]
+           && queryMin[Z] <= shapeMax[Z] && shapeMin[Z] <= queryMax[Z];
+}
+
+bool OverlapShape(const Bounds::AABB& _query, const Bounds::OBB& _shape) {
+    // 押し戻し情報を渡さなければ判定だけを行う
+    return CheckCollisionPair<Bounds::AABB, Bounds::OBB>(nullptr, EntityHandle(), EntityHandle(), _query, _shape, nullptr, nullptr);
+}
+
+bool OverlapShape(const Bounds::AABB& _query, const Bounds::Capsule& _shape) {
+    return CheckCollisionPair<Bounds::Capsule, Bounds::AABB>(nullptr, EntityHandle(), EntityHandle(), _shape, _query, nullptr, nullptr);
+}
+
+#pragma endregion
+
+} // namespace OriGine
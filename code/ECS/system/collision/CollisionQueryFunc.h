@@ -0,0 +1,74 @@
+#pragma once
+
+/// math
+#include "math/bounds/AABB.h"
+#include "math/bounds/Capsule.h"
+#include "math/bounds/OBB.h"
+#include "math/bounds/Ray.h"
+#include "math/bounds/Sphere.h"
+#include "math/Vector3.h"
+
+namespace OriGine {
+
+/// シーンクエリ (Raycast / SweepSphere / Overlap) と連続衝突判定 (SweepCapsule) 用の形状ごとの判定.
+/// レイ・掃引形状は始点の時点で重なっている形状には当たらない (重なりは Overlap で調べる).
+
+/// <summary>
+/// レイと形状の交差判定
+/// </summary>
+/// <param name="_ray">レイ (方向は正規化済み)</param>
+/// <param name="_maxDistance">最大距離</param>
+/// <param name="_outDistance">始点から交点までの距離</param>
+/// <param name="_outNormal">交点の法線 (形状の外向き)</param>
+/// <returns>_maxDistance 以内で当たればtrue</returns>
+bool RaycastShape(const Bounds::Ray& _ray, float _maxDistance, const Bounds::Sphere& _shape, float& _outDistance, Vec3f& _outNormal);
+bool RaycastShape(const Bounds::Ray& _ray, float _maxDistance, const Bounds::AABB& _shape, float& _outDistance, Vec3f& _outNormal);
+bool RaycastShape(const Bounds::Ray& _ray, float _maxDistance, const Bounds::OBB& _shape, float& _outDistance, Vec3f& _outNormal);
+bool RaycastShape(const Bounds::Ray& _ray, float _maxDistance, const Bounds::Capsule& _shape, float& _outDistance, Vec3f& _outNormal);
+
+/// <summary>
+/// 球を _ray の方向へ動かした時に形状と最初に接する位置を求める
+/// </summary>
+/// <param name="_ray">球の中心の始点と移動方向 (正規化済み)</param>
+/// <param name="_radius">球の半径</param>
+/// <param name="_maxDistance">最大移動距離</param>
+/// <param name="_outDistance">接するまでの移動距離</param>
+/// <param name="_outNormal">接点の法線 (形状の外向き)</param>
+/// <returns>_maxDistance 以内で接すればtrue</returns>
+bool SweepSphereShape(const Bounds::Ray& _ray, float _radius, float _maxDistance, const Bounds::Sphere& _shape, float& _outDistance, Vec3f& _outNormal);
+bool SweepSphereShape(const Bounds::Ray& _ray, float _radius, float _maxDistance, const Bounds::AABB& _shape, float& _outDistance, Vec3f& _outNormal);
+bool SweepSphereShape(const Bounds::Ray& _ray, float _radius, float _maxDistance, const Bounds::OBB& _shape, float& _outDistance, Vec3f& _outNormal);
+bool SweepSphereShape(const Bounds::Ray& _ray, float _radius, float _maxDistance, const Bounds::Capsule& _shape, float& _outDistance, Vec3f& _outNormal);
+
+/// <summary>
+/// カプセルを _direction の方向へ動かした時に形状と最初に接する位置を求める.
+/// Sphere は厳密に, それ以外は保守的前進 (距離が移動量について凸であることを使ったニュートン法) で求めるため, 接する位置の僅かに手前を返すことがある.
+/// </summary>
+/// <param name="_capsule">動かすカプセル (始点での形状)</param>
+/// <param name="_direction">移動方向 (正規化済み)</param>
+/// <param name="_maxDistance">最大移動距離</param>
+/// <param name="_outDistance">接するまでの移動距離</param>
+/// <param name="_outNormal">接点の法線 (形状の外向き)</param>
+/// <returns>_maxDistance 以内で接すればtrue</returns>
+bool SweepCapsuleShape(const Bounds::Capsule& _capsule, const Vec3f& _direction, float _maxDistance, const Bounds::Sphere& _shape, float& _outDistance, Vec3f& _outNormal);
+bool SweepCapsuleShape(const Bounds::Capsule& _capsule, const Vec3f& _direction, float _maxDistance, const Bounds::AABB& _shape, float& _outDistance, Vec3f& _outNormal);
+bool SweepCapsuleShape(const Bounds::Capsule& _capsule, const Vec3f& _direction, float _maxDistance, const Bounds::OBB& _shape, float& _outDistance, Vec3f& _outNormal);
+bool SweepCapsuleShape(const Bounds::Capsule& _capsule, const Vec3f& _direction, float _maxDistance, const Bounds::Capsule& _shape, float& _outDistance, Vec3f& _outNormal);
+
+/// <summary>
+/// 球と形状の重なり判定 (接しているだけでも重なりとみなす)
+/// </summary>
+bool OverlapShape(const Bounds::Sphere& _query, const Bounds::Sphere& _shape);
+bool OverlapShape(const Bounds::Sphere& _query, const Bounds::AABB& _shape);
+bool OverlapShape(const Bounds::Sphere& _query, const Bounds::OBB& _shape);
+bool OverlapShape(const Bounds::Sphere& _query, const Bounds::Capsule& _shape);
+
+/// <summary>
+/// AABBと形状の重なり判定 (接しているだけでも重なりとみなす)
+/// </summary>
+bool OverlapShape(const Bounds::AABB& _query, const Bounds::Sphere& _shape);
+bool OverlapShape(const Bounds::AABB& _query, const Bounds::AABB& _shape);
+bool OverlapShape(const Bounds::AABB& _query, const Bounds::OBB& _shape);
+bool OverlapShape(const Bounds::AABB& _query, const Bounds::Capsule& _shape);
+
+} // namespace OriGine
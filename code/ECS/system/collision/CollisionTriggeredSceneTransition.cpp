@@ -24,8 +24,8 @@ void OriGine::CollisionTriggeredSceneTransition::UpdateEntity(const EntityHandle
             if (!aabbCollider.IsActive()) {
                 continue;
             }
-            for (const auto& [otherHandle, collisionState] : aabbCollider.GetCollisionStateMap()) {
-                if (collisionState == CollisionState::Enter) {
+            for (const auto& contact : aabbCollider.GetCollisionContacts()) {
+                if (contact.state == CollisionState::Enter) {
                     auto& sceneChangers = GetComponents<SceneChanger>(_handle);
                     for (auto& sceneChanger : sceneChangers) {
                         sceneChanger.ChangeScene();
@@ -33,15 +33,15 @@ void OriGine::CollisionTriggeredSceneTransition::UpdateEntity(const EntityHandle
                 }
             }
         }
-    }
+    }
 
     if (!sphereColliders.empty()) {
         for (auto& sphereCollider : sphereColliders) {
             if (!sphereCollider.IsActive()) {
                 continue;
             }
-            for (const auto& [otherHandle, collisionState] : sphereCollider.GetCollisionStateMap()) {
-                if (collisionState == CollisionState::Enter) {
+            for (const auto& contact : sphereCollider.GetCollisionContacts()) {
+                if (contact.state == CollisionState::Enter) {
                     auto& sceneChangers = GetComponents<SceneChanger>(_handle);
                     for (auto& sceneChanger : sceneChangers) {
                         sceneChanger.ChangeScene();
@@ -55,8 +55,8 @@ void OriGine::CollisionTriggeredSceneTransition::UpdateEntity(const EntityHandle
             if (!obbCollider.IsActive()) {
                 continue;
             }
-            for (const auto& [otherHandle, collisionState] : obbCollider.GetCollisionStateMap()) {
-                if (collisionState == CollisionState::Enter) {
+            for (const auto& contact : obbCollider.GetCollisionContacts()) {
+                if (contact.state == CollisionState::Enter) {
                     auto& sceneChangers = GetComponents<SceneChanger>(_handle);
                     for (auto& sceneChanger : sceneChangers) {
                         sceneChanger.ChangeScene();
@@ -0,0 +1,505 @@
+#include "DynamicAABBTree.h"
+
+#include <algorithm>
+
+/// collision
+#include "CollisionCheckUtility.h"
+
+namespace OriGine {
+
+namespace {
+
+Vec3f MinPoint(const Vec3f& _a, const Vec3f& _b) {
+    return Vec3f(std::min(_a[X], _b[X]), std::min(_a[Y], _b[Y]), std::min(_a[Z], _b[Z]));
+}
+
+Vec3f MaxPoint(const Vec3f& _a, const Vec3f& _b) {
+    return Vec3f(std::max(_a[X], _b[X]), std::max(_a[Y], _b[Y]), std::max(_a[Z], _b[Z]));
+}
+
+/// <summary>
+/// 表面積 (挿入先を選ぶコスト)
+/// </summary>
+float SurfaceArea(const Vec3f& _min, const Vec3f& _max) {
+    Vec3f d = _max - _min;
+    return 2.0f * (d[X] * d[Y] + d[Y] * d[Z] + d[Z] * d[X]);
+}
+
+bool Overlaps(const Vec3f& _aMin, const Vec3f& _aMax, const Vec3f& _bMin, const Vec3f& _bMax) {
+    return _aMin[X] <= _bMax[X] && _bMin[X] <= _aMax[X]
+           && _aMin[Y] <= _bMax[Y] && _bMin[Y] <= _aMax[Y]
+           && _aMin[Z] <= _bMax[Z] && _bMin[Z] <= _aMax[Z];
+}
+
+bool Contains(const Vec3f& _outerMin, const Vec3f& _outerMax, const Vec3f& _innerMin, const Vec3f& _innerMax) {
+    return _outerMin[X] <= _innerMin[X] && _outerMin[Y] <= _innerMin[Y] && _outerMin[Z] <= _innerMin[Z]
+           && _innerMax[X] <= _outerMax[X] && _innerMax[Y] <= _outerMax[Y] && _innerMax[Z] <= _outerMax[Z];
+}
+
+} // namespace
+
+DynamicAABBTree::DynamicAABBTree(float _fatMargin)
+    : fatMargin_(_fatMargin) {}
+
+void DynamicAABBTree::Clear() {
+    nodes_.clear();
+    pairs_.clear();
+    moveBuffer_.clear();
+    root_       = kNullNode;
+    freeList_   = kNullNode;
+    proxyCount_ = 0;
+}
+
+int32_t DynamicAABBTree::CreateProxy(const Bounds::AABB& _aabb, const EntityHandle& _entity, const CollisionLayer& _layer) {
+    int32_t proxyId = AllocateNode();
+    Node& leaf      = nodes_[proxyId];
+    leaf.entity     = _entity;
+    leaf.layer      = _layer;
+    leaf.height     = 0;
+    SetLeafBounds(leaf, _aabb);
+
+    InsertLeaf(proxyId);
+    MarkMoved(proxyId);
+    ++proxyCount_;
+    return proxyId;
+}
+
+void DynamicAABBTree::DestroyProxy(int32_t _proxyId) {
+    if (_proxyId < 0 || _proxyId >= static_cast<int32_t>(nodes_.size()) || !nodes_[_proxyId].IsLeaf() || nodes_[_proxyId].height != 0) {
+        return;
+    }
+    RemoveLeaf(_proxyId);
+    FreeNode(_proxyId);
+    --proxyCount_;
+}
+
+bool DynamicAABBTree::MoveProxy(int32_t _proxyId, const Bounds::AABB& _aabb) {
+    Node& leaf = nodes_[_proxyId];
+    leaf.min   = _aabb.Min();
+    leaf.max   = _aabb.Max();
+
+    // fat AABB に収まっていて, かつ膨らみすぎていなければ (縮んだ物を大きいまま残さない) 木はそのまま
+    if (Contains(leaf.fatMin, leaf.fatMax, leaf.min, leaf.max)) {
+        float slack = fatMargin_ * 4.0f;
+        Vec3f loose = Vec3f(slack, slack, slack);
+        if (Contains(leaf.min - loose, leaf.max + loose, leaf.fatMin, leaf.fatMax)) {
+            return false;
+        }
+    }
+
+    RemoveLeaf(_proxyId);
+    SetLeafBounds(nodes_[_proxyId], _aabb);
+    InsertLeaf(_proxyId);
+    MarkMoved(_proxyId);
+    ++reinsertCount_;
+    return true;
+}
+
+bool DynamicAABBTree::SetProxyLayer(int32_t _proxyId, const CollisionLayer& _layer) {
+    if (nodes_[_proxyId].layer == _layer) {
+        return false;
+    }
+
+    // 祖先のレイヤーを更新し, ペアも検索し直す
+    nodes_[_proxyId].layer = _layer;
+    if (nodes_[_proxyId].parent != kNullNode) {
+        RefitAncestors(nodes_[_proxyId].parent);
+    }
+    MarkMoved(_proxyId);
+    return true;
+}
+
+void DynamicAABBTree::Query(const Bounds::AABB& _aabb, std::vector<EntityHandle>& _outEntities) const {
+    if (root_ == kNullNode) {
+        return;
+    }
+    Vec3f queryMin = _aabb.Min();
+    Vec3f queryMax = _aabb.Max();
+
+    stack_.clear();
+    stack_.push_back(root_);
+    while (!stack_.empty()) {
+        const Node& node = nodes_[stack_.back()];
+        stack_.pop_back();
+
+        if (!Overlaps(node.fatMin, node.fatMax, queryMin, queryMax)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            if (Overlaps(node.min, node.max, queryMin, queryMax)) {
+                _outEntities.push_back(node.entity);
+            }
+            continue;
+        }
+        stack_.push_back(node.child1);
+        stack_.push_back(node.child2);
+    }
+}
+
+void DynamicAABBTree::QueryRay(const Vec3f& _origin, const Vec3f& _direction, float _maxDistance, float _radius, std::vector<EntityHandle>& _outEntities) const {
+    if (root_ == kNullNode) {
+        return;
+    }
+    Vec3f pad(_radius, _radius, _radius);
+    auto hitsBox = [&](const Vec3f& _min, const Vec3f& _max) {
+        float tMin = 0.f;
+        float tMax = _maxDistance;
+        return ClipRayToBox(_origin, _direction, _min - pad, _max + pad, tMin, tMax);
+    };
+
+    stack_.clear();
+    stack_.push_back(root_);
+    while (!stack_.empty()) {
+        const Node& node = nodes_[stack_.back()];
+        stack_.pop_back();
+
+        if (!hitsBox(node.fatMin, node.fatMax)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            if (hitsBox(node.min, node.max)) {
+                _outEntities.push_back(node.entity);
+            }
+            continue;
+        }
+        stack_.push_back(node.child1);
+        stack_.push_back(node.child2);
+    }
+}
+
+void DynamicAABBTree::GetAllPairs(std::vector<std::pair<EntityHandle, EntityHandle>>& _outPairs) {
+    _outPairs.clear();
+
+    // 動いた(または破棄された)葉を含むペアは検索し直すので一旦捨てる. 動いていない葉同士の fat AABB の重なりは変わらない
+    pairs_.erase(
+        std::remove_if(pairs_.begin(), pairs_.end(), [this](const std::pair<int32_t, int32_t>& _pair) {
+            return !IsProxy(_pair.first) || !IsProxy(_pair.second) || nodes_[_pair.first].moved || nodes_[_pair.second].moved;
+        }),
+        pairs_.end());
+
+    // 動いた葉の fat AABB で木を検索してペアを作り直す. 衝突し得ないレイヤーの部分木は降りない
+    bool added = false;
+    for (int32_t proxyId : moveBuffer_) {
+        if (!IsProxy(proxyId) || !nodes_[proxyId].moved) {
+            continue;
+        }
+        const Node& leaf = nodes_[proxyId];
+
+        stack_.clear();
+        stack_.push_back(root_);
+        while (!stack_.empty()) {
+            int32_t nodeId   = stack_.back();
+            const Node& node = nodes_[nodeId];
+            stack_.pop_back();
+
+            if (!leaf.layer.CanCollideWith(node.layer) || !Overlaps(node.fatMin, node.fatMax, leaf.fatMin, leaf.fatMax)) {
+                continue;
+            }
+            if (node.IsLeaf()) {
+                if (nodeId != proxyId) {
+                    pairs_.emplace_back(std::min(nodeId, proxyId), std::max(nodeId, proxyId));
+                    added = true;
+                }
+                continue;
+            }
+            stack_.push_back(node.child1);
+            stack_.push_back(node.child2);
+        }
+    }
+    for (int32_t proxyId : moveBuffer_) {
+        if (IsProxy(proxyId)) {
+            nodes_[proxyId].moved = false;
+        }
+    }
+    moveBuffer_.clear();
+
+    // 動いた葉同士は両方から見つかるため重複を取り除く
+    if (added) {
+        std::sort(pairs_.begin(), pairs_.end());
+        pairs_.erase(std::unique(pairs_.begin(), pairs_.end()), pairs_.end());
+    }
+
+    // 実AABBが重なっているペアだけを返す
+    for (const auto& [aId, bId] : pairs_) {
+        const Node& aNode = nodes_[aId];
+        const Node& bNode = nodes_[bId];
+        if (!Overlaps(aNode.min, aNode.max, bNode.min, bNode.max)) {
+            continue;
+        }
+        EntityHandle a = aNode.entity;
+        EntityHandle b = bNode.entity;
+        // 順序を正規化
+        if (b < a) {
+            std::swap(a, b);
+        }
+        _outPairs.emplace_back(a, b);
+    }
+}
+
+void DynamicAABBTree::MarkMoved(int32_t _proxyId) {
+    if (!nodes_[_proxyId].moved) {
+        nodes_[_proxyId].moved = true;
+        moveBuffer_.push_back(_proxyId);
+    }
+}
+
+int32_t DynamicAABBTree::AllocateNode() {
+    if (freeList_ == kNullNode) {
+        nodes_.emplace_back();
+        return static_cast<int32_t>(nodes_.size()) - 1;
+    }
+
+    int32_t node = freeList_;
+    freeList_    = nodes_[node].parent;
+    nodes_[node] = Node();
+    return node;
+}
+
+void DynamicAABBTree::FreeNode(int32_t _node) {
+    Node& node  = nodes_[_node];
+    node.entity = EntityHandle();
+    node.child1 = kNullNode;
+    node.child2 = kNullNode;
+    node.height = -1;
+    node.parent = freeList_;
+    freeList_   = _node;
+}
+
+void DynamicAABBTree::InsertLeaf(int32_t _leaf) {
+    if (root_ == kNullNode) {
+        root_                = _leaf;
+        nodes_[_leaf].parent = kNullNode;
+        return;
+    }
+
+    // 表面積の増加が最小になる兄弟を探す
+    Vec3f leafMin = nodes_[_leaf].fatMin;
+    Vec3f leafMax = nodes_[_leaf].fatMax;
+    int32_t index = root_;
+    while (!nodes_[index].IsLeaf()) {
+        const Node& node = nodes_[index];
+
+        float area         = SurfaceArea(node.fatMin, node.fatMax);
+        float combinedArea = SurfaceArea(MinPoint(node.fatMin, leafMin), MaxPoint(node.fatMax, leafMax));
+
+        // このノードと葉で新しい親を作るコスト
+        float cost = 2.0f * combinedArea;
+        // 子へ降りる場合に, このノードから上が広がる分のコスト
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t _child) {
+            const Node& child = nodes_[_child];
+            float newArea     = SurfaceArea(MinPoint(child.fatMin, leafMin), MaxPoint(child.fatMax, leafMax));
+            if (child.IsLeaf()) {
+                return newArea + inheritanceCost;
+            }
+            return (newArea - SurfaceArea(child.fatMin, child.fatMax)) + inheritanceCost;
+        };
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    int32_t sibling   = index;
+    int32_t oldParent = nodes_[sibling].parent;
+    int32_t newParent = AllocateNode(); // nodes_ が伸びる可能性があるため, ここより前の参照は使わない
+
+    Node& parentNode  = nodes_[newParent];
+    parentNode.parent = oldParent;
+    parentNode.fatMin = MinPoint(leafMin, nodes_[sibling].fatMin);
+    parentNode.fatMax = MaxPoint(leafMax, nodes_[sibling].fatMax);
+    parentNode.height = nodes_[sibling].height + 1;
+    parentNode.layer  = nodes_[_leaf].layer.Union(nodes_[sibling].layer);
+    parentNode.child1 = sibling;
+    parentNode.child2 = _leaf;
+
+    if (oldParent != kNullNode) {
+        if (nodes_[oldParent].child1 == sibling) {
+            nodes_[oldParent].child1 = newParent;
+        } else {
+            nodes_[oldParent].child2 = newParent;
+        }
+    } else {
+        root_ = newParent;
+    }
+    nodes_[sibling].parent = newParent;
+    nodes_[_leaf].parent   = newParent;
+
+    RefitAncestors(nodes_[_leaf].parent);
+}
+
+void DynamicAABBTree::RemoveLeaf(int32_t _leaf) {
+    if (_leaf == root_) {
+        root_ = kNullNode;
+        return;
+    }
+
+    int32_t parent      = nodes_[_leaf].parent;
+    int32_t grandParent = nodes_[parent].parent;
+    int32_t sibling     = nodes_[parent].child1 == _leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    if (grandParent != kNullNode) {
+        // 親を取り除き, 兄弟を祖父に直接つなぐ
+        if (nodes_[grandParent].child1 == parent) {
+            nodes_[grandParent].child1 = sibling;
+        } else {
+            nodes_[grandParent].child2 = sibling;
+        }
+        nodes_[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        RefitAncestors(grandParent);
+    } else {
+        root_                  = sibling;
+        nodes_[sibling].parent = kNullNode;
+        FreeNode(parent);
+    }
+    nodes_[_leaf].parent = kNullNode;
+}
+
+void DynamicAABBTree::RefitAncestors(int32_t _node) {
+    int32_t index = _node;
+    while (index != kNullNode) {
+        index = Balance(index);
+
+        Node& node         = nodes_[index];
+        const Node& child1 = nodes_[node.child1];
+        const Node& child2 = nodes_[node.child2];
+        node.height        = 1 + std::max(child1.height, child2.height);
+        node.fatMin        = MinPoint(child1.fatMin, child2.fatMin);
+        node.fatMax        = MaxPoint(child1.fatMax, child2.fatMax);
+        node.layer         = child1.layer.Union(child2.layer);
+
+        index = node.parent;
+    }
+}
+
+int32_t DynamicAABBTree::Balance(int32_t _node) {
+    int32_t iA = _node;
+    Node& a    = nodes_[iA];
+    if (a.IsLeaf() || a.height < 2) {
+        return iA;
+    }
+
+    int32_t iB = a.child1;
+    int32_t iC = a.child2;
+    Node& b    = nodes_[iB];
+    Node& c    = nodes_[iC];
+
+    int32_t balance = c.height - b.height;
+
+    // C を持ち上げる
+    if (balance > 1) {
+        int32_t iF = c.child1;
+        int32_t iG = c.child2;
+        Node& f    = nodes_[iF];
+        Node& g    = nodes_[iG];
+
+        c.child1 = iA;
+        c.parent = a.parent;
+        a.parent = iC;
+
+        if (c.parent != kNullNode) {
+            if (nodes_[c.parent].child1 == iA) {
+                nodes_[c.parent].child1 = iC;
+            } else {
+                nodes_[c.parent].child2 = iC;
+            }
+        } else {
+            root_ = iC;
+        }
+
+        // 高い方の孫を C 側に残す
+        if (f.height > g.height) {
+            c.child2 = iF;
+            a.child2 = iG;
+            g.parent = iA;
+            a.fatMin = MinPoint(b.fatMin, g.fatMin);
+            a.fatMax = MaxPoint(b.fatMax, g.fatMax);
+            c.fatMin = MinPoint(a.fatMin, f.fatMin);
+            c.fatMax = MaxPoint(a.fatMax, f.fatMax);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+            a.layer  = b.layer.Union(g.layer);
+            c.layer  = a.layer.Union(f.layer);
+        } else {
+            c.child2 = iG;
+            a.child2 = iF;
+            f.parent = iA;
+            a.fatMin = MinPoint(b.fatMin, f.fatMin);
+            a.fatMax = MaxPoint(b.fatMax, f.fatMax);
+            c.fatMin = MinPoint(a.fatMin, g.fatMin);
+            c.fatMax = MaxPoint(a.fatMax, g.fatMax);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+            a.layer  = b.layer.Union(f.layer);
+            c.layer  = a.layer.Union(g.layer);
+        }
+        return iC;
+    }
+
+    // B を持ち上げる
+    if (balance < -1) {
+        int32_t iD = b.child1;
+        int32_t iE = b.child2;
+        Node& d    = nodes_[iD];
+        Node& e    = nodes_[iE];
+
+        b.child1 = iA;
+        b.parent = a.parent;
+        a.parent = iB;
+
+        if (b.parent != kNullNode) {
+            if (nodes_[b.parent].child1 == iA) {
+                nodes_[b.parent].child1 = iB;
+            } else {
+                nodes_[b.parent].child2 = iB;
+            }
+        } else {
+            root_ = iB;
+        }
+
+        if (d.height > e.height) {
+            b.child2 = iD;
+            a.child1 = iE;
+            e.parent = iA;
+            a.fatMin = MinPoint(c.fatMin, e.fatMin);
+            a.fatMax = MaxPoint(c.fatMax, e.fatMax);
+            b.fatMin = MinPoint(a.fatMin, d.fatMin);
+            b.fatMax = MaxPoint(a.fatMax, d.fatMax);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+            a.layer  = c.layer.Union(e.layer);
+            b.layer  = a.layer.Union(d.layer);
+        } else {
+            b.child2 = iE;
+            a.child1 = iD;
+            d.parent = iA;
+            a.fatMin = MinPoint(c.fatMin, d.fatMin);
+            a.fatMax = MaxPoint(c.fatMax, d.fatMax);
+            b.fatMin = MinPoint(a.fatMin, e.fatMin);
+            b.fatMax = MaxPoint(a.fatMax, e.fatMax);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+            a.layer  = c.layer.Union(d.layer);
+            b.layer  = a.layer.Union(e.layer);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+void DynamicAABBTree::SetLeafBounds(Node& _leaf, const Bounds::AABB& _aabb) const {
+    Vec3f margin = Vec3f(fatMargin_, fatMargin_, fatMargin_);
+    _leaf.min    = _aabb.Min();
+    _leaf.max    = _aabb.Max();
+    _leaf.fatMin = _leaf.min - margin;
+    _leaf.fatMax = _leaf.max + margin;
+}
+
+} // namespace OriGine
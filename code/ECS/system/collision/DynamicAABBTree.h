@@ -0,0 +1,190 @@
+#pragma once
+
+/// stl
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// math
+#include "bounds/AABB.h"
+#include "Vector3.h"
+
+/// ECS
+#include "entity/EntityHandle.h"
+
+/// collision
+#include "CollisionLayer.h"
+
+namespace OriGine {
+
+/// <summary>
+/// 動的AABB木による広域フェーズ衝突検出.
+/// 葉には実際のAABBを余白 (fatMargin) で膨らませた fat AABB を持たせ, 実AABBが fat AABB からはみ出した時だけ木を組み替える.
+/// fat AABB 同士が重なる葉のペアはフレームをまたいで保持し, 組み替えた葉についてだけ検索し直すため,
+/// 動かないエンティティは毎フレームの更新コストがほぼ0になり, セルサイズのような全体設定にも依存しない.
+/// 各ノードは部分木の衝突レイヤーをまとめて持ち, ペアの検索では衝突し得ないレイヤーの部分木に降りない.
+/// </summary>
+class DynamicAABBTree {
+public:
+    static constexpr int32_t kNullNode = -1;
+
+    /// <summary>
+    /// コンストラクタ
+    /// </summary>
+    /// <param name="_fatMargin">fat AABB の余白 (動く量が多いほど大きくすると組み替えが減る)</param>
+    explicit DynamicAABBTree(float _fatMargin = 0.5f);
+    ~DynamicAABBTree() = default;
+
+    /// <summary>
+    /// fat AABB の余白を設定 (既存の葉には次の組み替え時から反映される)
+    /// </summary>
+    void SetFatMargin(float _fatMargin) { fatMargin_ = _fatMargin; }
+
+    /// <summary>
+    /// fat AABB の余白を取得
+    /// </summary>
+    float GetFatMargin() const { return fatMargin_; }
+
+    /// <summary>
+    /// 全ての葉を破棄する
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 葉(プロキシ)を作成して木に挿入する
+    /// </summary>
+    /// <param name="_aabb">エンティティのAABB</param>
+    /// <param name="_entity">エンティティハンドル</param>
+    /// <param name="_layer">衝突レイヤー</param>
+    /// <returns>プロキシID</returns>
+    int32_t CreateProxy(const Bounds::AABB& _aabb, const EntityHandle& _entity, const CollisionLayer& _layer = CollisionLayer());
+
+    /// <summary>
+    /// 葉(プロキシ)を木から取り除いて破棄する
+    /// </summary>
+    void DestroyProxy(int32_t _proxyId);
+
+    /// <summary>
+    /// 葉(プロキシ)のAABBを更新する. fat AABB に収まっていれば木は組み替えない.
+    /// </summary>
+    /// <param name="_proxyId">プロキシID</param>
+    /// <param name="_aabb">新しいAABB</param>
+    /// <returns>木に挿入し直したらtrue</returns>
+    bool MoveProxy(int32_t _proxyId, const Bounds::AABB& _aabb);
+
+    /// <summary>
+    /// 葉(プロキシ)の衝突レイヤーを更新する. 変わっていれば次の GetAllPairs でペアを検索し直す.
+    /// </summary>
+    /// <returns>レイヤーが変わったらtrue</returns>
+    bool SetProxyLayer(int32_t _proxyId, const CollisionLayer& _layer);
+
+    /// <summary>
+    /// 指定AABBと重なる葉のエンティティを取得
+    /// </summary>
+    /// <param name="_aabb">検索範囲のAABB</param>
+    /// <param name="_outEntities">結果の追加先</param>
+    void Query(const Bounds::AABB& _aabb, std::vector<EntityHandle>& _outEntities) const;
+
+    /// <summary>
+    /// レイ (半径を持たせると掃引球) が通る葉のエンティティを取得 (葉は実AABBで判定する)
+    /// </summary>
+    /// <param name="_origin">始点</param>
+    /// <param name="_direction">方向 (正規化済み)</param>
+    /// <param name="_maxDistance">最大距離</param>
+    /// <param name="_radius">各AABBを広げる量 (掃引する球の半径. レイなら0)</param>
+    /// <param name="_outEntities">結果の追加先</param>
+    void QueryRay(const Vec3f& _origin, const Vec3f& _direction, float _maxDistance, float _radius, std::vector<EntityHandle>& _outEntities) const;
+
+    /// <summary>
+    /// AABBが重なっている全ての葉のペアを取得 (fat AABB ではなく実AABB同士で判定する).
+    /// 前回の呼び出し以降に作成/挿入し直した葉についてだけ木を検索し, 保持しているペアを更新する.
+    /// 衝突し得ないレイヤー同士の葉はペアにしない.
+    /// </summary>
+    /// <param name="_outPairs">結果を格納するベクター（pair<EntityA, EntityB>）</param>
+    void GetAllPairs(std::vector<std::pair<EntityHandle, EntityHandle>>& _outPairs);
+
+    /// <summary>
+    /// 登録されている葉の数を取得
+    /// </summary>
+    size_t GetProxyCount() const { return proxyCount_; }
+
+    /// <summary>
+    /// 木の高さを取得 (空なら0)
+    /// </summary>
+    int32_t GetHeight() const { return root_ == kNullNode ? 0 : nodes_[root_].height; }
+
+    /// <summary>
+    /// 直近の MoveProxy で挿入し直した回数を取得 (ResetReinsertCount でリセット)
+    /// </summary>
+    size_t GetReinsertCount() const { return reinsertCount_; }
+    void ResetReinsertCount() { reinsertCount_ = 0; }
+
+private:
+    /// <summary>
+    /// 木のノード. 内部ノードは子の fat AABB を包む.
+    /// </summary>
+    struct Node {
+        Vec3f fatMin = {0.f, 0.f, 0.f};
+        Vec3f fatMax = {0.f, 0.f, 0.f};
+        Vec3f min    = {0.f, 0.f, 0.f}; // 葉のみ: 実AABB
+        Vec3f max    = {0.f, 0.f, 0.f}; // 葉のみ: 実AABB
+
+        EntityHandle entity; // 葉のみ
+        CollisionLayer layer; // 葉: エンティティの衝突レイヤー, 内部ノード: 子のレイヤーをまとめたもの
+
+        int32_t parent = kNullNode; // 未使用ノードでは次の空きノード
+        int32_t child1 = kNullNode;
+        int32_t child2 = kNullNode;
+        int32_t height = -1; // 葉は0, 未使用は-1
+        bool moved     = false; // 葉のみ: 前回の GetAllPairs 以降に作成/挿入し直した
+
+        bool IsLeaf() const { return child1 == kNullNode; }
+    };
+
+    /// <summary>
+    /// 使用中の葉(プロキシ)か
+    /// </summary>
+    bool IsProxy(int32_t _node) const { return _node >= 0 && _node < static_cast<int32_t>(nodes_.size()) && nodes_[_node].height == 0; }
+
+    /// <summary>
+    /// 葉を移動済みとして記録する (次の GetAllPairs でペアを検索し直す)
+    /// </summary>
+    void MarkMoved(int32_t _proxyId);
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t _node);
+
+    void InsertLeaf(int32_t _leaf);
+    void RemoveLeaf(int32_t _leaf);
+
+    /// <summary>
+    /// _node を根とする部分木の左右の高さの差が2以上なら回転して平衡を保つ
+    /// </summary>
+    /// <returns>回転後の部分木の根</returns>
+    int32_t Balance(int32_t _node);
+
+    /// <summary>
+    /// 子から AABB と高さを計算し直しながら根まで遡る
+    /// </summary>
+    void RefitAncestors(int32_t _node);
+
+    /// <summary>
+    /// 葉の fat AABB を実AABBから作り直す
+    /// </summary>
+    void SetLeafBounds(Node& _leaf, const Bounds::AABB& _aabb) const;
+
+private:
+    std::vector<Node> nodes_;
+    int32_t root_         = kNullNode;
+    int32_t freeList_     = kNullNode;
+    size_t proxyCount_    = 0;
+    size_t reinsertCount_ = 0;
+    float fatMargin_;
+
+    std::vector<std::pair<int32_t, int32_t>> pairs_; // fat AABB が重なる葉のペア (小さいID, 大きいID)
+    std::vector<int32_t> moveBuffer_; // 前回の GetAllPairs 以降に作成/挿入し直した葉
+
+    mutable std::vector<int32_t> stack_; // 走査用の作業領域 (フレーム間で使い回す)
+};
+
+} // namespace OriGine
@@ -0,0 +1,262 @@
+#include "NarrowphaseBatch.h"
+
+/// stl
+#include <algorithm>
+
+#ifdef ORIGINE_NARROWPHASE_SSE
+#include <emmintrin.h>
+#endif // ORIGINE_NARROWPHASE_SSE
+
+/// collision
+#include "CollisionCheckUtility.h"
+
+/// math
+#include "math/MathEnv.h"
+
+namespace OriGine {
+
+namespace {
+
+/// <summary>
+/// 掃引判定を箱の重なりで近似する際の余白 (丸め誤差で重なっている組を取り除かないよう, 少しだけ広げる)
+/// </summary>
+constexpr float kSweepSlackRate = 1.0e-3f;
+
+} // namespace
+
+void NarrowphaseBatch::Clear() {
+    candidates_.clear();
+    sphereSphere_.Clear();
+    aabbAabb_.Clear();
+    aabbSphere_.Clear();
+    capsuleSphere_.Clear();
+}
+
+void NarrowphaseBatch::PushSphereSphere(uint32_t _candidate, const Bounds::Sphere& _a, const Bounds::Sphere& _b) {
+    sphereSphere_.Push(_candidate, {_a.center_[X], _a.center_[Y], _a.center_[Z], _a.radius_, _b.center_[X], _b.center_[Y], _b.center_[Z], _b.radius_});
+}
+
+void NarrowphaseBatch::PushAABBAABB(uint32_t _candidate, const Bounds::AABB& _a, const Bounds::AABB& _b) {
+    // CheckCollisionPair と同じく Min()/Max() で求める
+    Vec3f aMin = _a.Min();
+    Vec3f aMax = _a.Max();
+    Vec3f bMin = _b.Min();
+    Vec3f bMax = _b.Max();
+    aabbAabb_.Push(_candidate, {aMin[X], aMin[Y], aMin[Z], aMax[X], aMax[Y], aMax[Z], bMin[X], bMin[Y], bMin[Z], bMax[X], bMax[Y], bMax[Z]});
+}
+
+void NarrowphaseBatch::PushAABBSphere(uint32_t _candidate, const Bounds::AABB& _aabb, const Bounds::Sphere& _sphere, const Vec3f& _sphereVelocity) {
+    Vec3f min = _aabb.Min();
+    Vec3f max = _aabb.Max();
+    aabbSphere_.Push(_candidate, {min[X], min[Y], min[Z], max[X], max[Y], max[Z], _sphere.center_[X], _sphere.center_[Y], _sphere.center_[Z], _sphere.radius_, _sphereVelocity[X], _sphereVelocity[Y], _sphereVelocity[Z]});
+}
+
+void NarrowphaseBatch::PushCapsuleSphere(uint32_t _candidate, const Bounds::Capsule& _capsule, const Bounds::Sphere& _sphere) {
+    const Vec3f& start = _capsule.segment.start;
+    const Vec3f& end   = _capsule.segment.end;
+    capsuleSphere_.Push(_candidate, {start[X], start[Y], start[Z], end[X], end[Y], end[Z], _capsule.radius, _sphere.center_[X], _sphere.center_[Y], _sphere.center_[Z], _sphere.radius_});
+}
+
+void NarrowphaseBatch::Evaluate() {
+    batchedCount_ = sphereSphere_.candidates.size() + aabbAabb_.candidates.size() + aabbSphere_.candidates.size() + capsuleSphere_.candidates.size();
+
+    EvaluateSphereSphere();
+    EvaluateAABBAABB();
+    EvaluateAABBSphere();
+    EvaluateCapsuleSphere();
+}
+
+// 以下の判定は CheckCollisionPair の該当部分と同じ順序で演算する (比較の向きも NaN の扱いまで合わせる).
+// 判定は重なっていない組を取り除くためだけに使い, 重なっている組は CheckCollisionPair で判定し直す.
+
+#ifdef ORIGINE_NARROWPHASE_SSE
+
+void NarrowphaseBatch::EvaluateSphereSphere() {
+    auto& bucket = sphereSphere_;
+    bucket.Pad();
+    const auto& l = bucket.lanes;
+    for (size_t i = 0; i < bucket.candidates.size(); i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&l[0][i]), _mm_loadu_ps(&l[4][i]));
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&l[1][i]), _mm_loadu_ps(&l[5][i]));
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(&l[2][i]), _mm_loadu_ps(&l[6][i]));
+        __m128 lengthSq  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        __m128 radiusSum = _mm_add_ps(_mm_loadu_ps(&l[3][i]), _mm_loadu_ps(&l[7][i]));
+
+        // !(lengthSq >= radiusSum^2)
+        int mask   = _mm_movemask_ps(_mm_cmpnge_ps(lengthSq, _mm_mul_ps(radiusSum, radiusSum)));
+        size_t end = (std::min)(i + 4, bucket.candidates.size());
+        for (size_t j = i; j < end; ++j) {
+            candidates_[bucket.candidates[j]].mayCollide = (mask >> (j - i)) & 1;
+        }
+    }
+}
+
+void NarrowphaseBatch::EvaluateAABBAABB() {
+    auto& bucket = aabbAabb_;
+    bucket.Pad();
+    const auto& l = bucket.lanes;
+    for (size_t i = 0; i < bucket.candidates.size(); i += 4) {
+        // 各軸 !(aMax < bMin) && !(aMin > bMax)
+        __m128 overlap = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (size_t axis = 0; axis < 3; ++axis) {
+            __m128 aMin = _mm_loadu_ps(&l[axis][i]);
+            __m128 aMax = _mm_loadu_ps(&l[3 + axis][i]);
+            __m128 bMin = _mm_loadu_ps(&l[6 + axis][i]);
+            __m128 bMax = _mm_loadu_ps(&l[9 + axis][i]);
+            overlap     = _mm_and_ps(overlap, _mm_and_ps(_mm_cmpnlt_ps(aMax, bMin), _mm_cmpngt_ps(aMin, bMax)));
+        }
+
+        int mask   = _mm_movemask_ps(overlap);
+        size_t end = (std::min)(i + 4, bucket.candidates.size());
+        for (size_t j = i; j < end; ++j) {
+            candidates_[bucket.candidates[j]].mayCollide = (mask >> (j - i)) & 1;
+        }
+    }
+}
+
+void NarrowphaseBatch::EvaluateAABBSphere() {
+    auto& bucket = aabbSphere_;
+    bucket.Pad();
+    const auto& l = bucket.lanes;
+    const __m128 zero      = _mm_setzero_ps();
+    const __m128 slackRate = _mm_set1_ps(1.0f + kSweepSlackRate);
+    const __m128 slack     = _mm_set1_ps(kSweepSlackRate);
+    for (size_t i = 0; i < bucket.candidates.size(); i += 4) {
+        __m128 radius = _mm_loadu_ps(&l[9][i]);
+
+        // 静止している球: AABB上の最近接点までの距離
+        __m128 lengthSq = zero;
+        // 動いている球: 半径分広げたAABBと, 前フレームから今フレームまでの中心の移動範囲の箱の重なり
+        __m128 sweptRadius = _mm_add_ps(_mm_mul_ps(radius, slackRate), slack);
+        __m128 sweptHit    = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        __m128 isStill     = sweptHit;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            __m128 min      = _mm_loadu_ps(&l[axis][i]);
+            __m128 max      = _mm_loadu_ps(&l[3 + axis][i]);
+            __m128 center   = _mm_loadu_ps(&l[6 + axis][i]);
+            __m128 velocity = _mm_loadu_ps(&l[10 + axis][i]);
+
+            __m128 closest = _mm_min_ps(_mm_max_ps(center, min), max);
+            __m128 d       = _mm_sub_ps(closest, center);
+            lengthSq       = _mm_add_ps(lengthSq, _mm_mul_ps(d, d));
+
+            __m128 prePos = _mm_sub_ps(center, velocity);
+            __m128 pathLo = _mm_min_ps(prePos, center);
+            __m128 pathHi = _mm_max_ps(prePos, center);
+            sweptHit      = _mm_and_ps(sweptHit, _mm_and_ps(_mm_cmple_ps(_mm_sub_ps(min, sweptRadius), pathHi), _mm_cmple_ps(pathLo, _mm_add_ps(max, sweptRadius))));
+            isStill       = _mm_and_ps(isStill, _mm_cmpeq_ps(velocity, zero));
+        }
+        __m128 stillHit = _mm_cmple_ps(lengthSq, _mm_mul_ps(radius, radius));
+        __m128 hit      = _mm_or_ps(_mm_and_ps(isStill, stillHit), _mm_andnot_ps(isStill, sweptHit));
+
+        int mask   = _mm_movemask_ps(hit);
+        size_t end = (std::min)(i + 4, bucket.candidates.size());
+        for (size_t j = i; j < end; ++j) {
+            candidates_[bucket.candidates[j]].mayCollide = (mask >> (j - i)) & 1;
+        }
+    }
+}
+
+void NarrowphaseBatch::EvaluateCapsuleSphere() {
+    auto& bucket = capsuleSphere_;
+    bucket.Pad();
+    const auto& l = bucket.lanes;
+    const __m128 zero    = _mm_setzero_ps();
+    const __m128 one     = _mm_set1_ps(1.0f);
+    const __m128 epsilon = _mm_set1_ps(kEpsilon);
+    for (size_t i = 0; i < bucket.candidates.size(); i += 4) {
+        __m128 start[3], ab[3], point[3];
+        __m128 abLengthSq = zero;
+        __m128 dot        = zero;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            start[axis] = _mm_loadu_ps(&l[axis][i]);
+            ab[axis]    = _mm_sub_ps(_mm_loadu_ps(&l[3 + axis][i]), start[axis]);
+            point[axis] = _mm_loadu_ps(&l[7 + axis][i]);
+            abLengthSq  = _mm_add_ps(abLengthSq, _mm_mul_ps(ab[axis], ab[axis]));
+            dot         = _mm_add_ps(dot, _mm_mul_ps(_mm_sub_ps(point[axis], start[axis]), ab[axis]));
+        }
+        // 線分が点に縮退していれば始点を最近接点にする
+        __m128 isPoint = _mm_cmplt_ps(abLengthSq, epsilon);
+        __m128 t       = _mm_min_ps(_mm_max_ps(_mm_div_ps(dot, abLengthSq), zero), one);
+        t              = _mm_andnot_ps(isPoint, t);
+
+        __m128 distSq = zero;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            __m128 closest = _mm_add_ps(start[axis], _mm_mul_ps(ab[axis], t));
+            closest        = _mm_or_ps(_mm_and_ps(isPoint, start[axis]), _mm_andnot_ps(isPoint, closest));
+            __m128 diff    = _mm_sub_ps(point[axis], closest);
+            distSq         = _mm_add_ps(distSq, _mm_mul_ps(diff, diff));
+        }
+        __m128 radiusSum = _mm_add_ps(_mm_loadu_ps(&l[6][i]), _mm_loadu_ps(&l[10][i]));
+
+        // !(distSq > radiusSum^2)
+        int mask   = _mm_movemask_ps(_mm_cmpngt_ps(distSq, _mm_mul_ps(radiusSum, radiusSum)));
+        size_t end = (std::min)(i + 4, bucket.candidates.size());
+        for (size_t j = i; j < end; ++j) {
+            candidates_[bucket.candidates[j]].mayCollide = (mask >> (j - i)) & 1;
+        }
+    }
+}
+
+#else // ORIGINE_NARROWPHASE_SSE
+
+void NarrowphaseBatch::EvaluateSphereSphere() {
+    const auto& l = sphereSphere_.lanes;
+    for (size_t i = 0; i < sphereSphere_.candidates.size(); ++i) {
+        Vec3f distance  = Vec3f(l[0][i], l[1][i], l[2][i]) - Vec3f(l[4][i], l[5][i], l[6][i]);
+        float radiusSum = l[3][i] + l[7][i];
+        candidates_[sphereSphere_.candidates[i]].mayCollide = !(distance.lengthSq() >= radiusSum * radiusSum);
+    }
+}
+
+void NarrowphaseBatch::EvaluateAABBAABB() {
+    const auto& l = aabbAabb_.lanes;
+    for (size_t i = 0; i < aabbAabb_.candidates.size(); ++i) {
+        bool overlap = true;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            overlap = overlap && !(l[3 + axis][i] < l[6 + axis][i]) && !(l[axis][i] > l[9 + axis][i]);
+        }
+        candidates_[aabbAabb_.candidates[i]].mayCollide = overlap;
+    }
+}
+
+void NarrowphaseBatch::EvaluateAABBSphere() {
+    const auto& l = aabbSphere_.lanes;
+    for (size_t i = 0; i < aabbSphere_.candidates.size(); ++i) {
+        float radius      = l[9][i];
+        float sweptRadius = radius * (1.0f + kSweepSlackRate) + kSweepSlackRate;
+        float lengthSq    = 0.0f;
+        bool sweptHit     = true;
+        bool isStill      = true;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            float min      = l[axis][i];
+            float max      = l[3 + axis][i];
+            float center   = l[6 + axis][i];
+            float velocity = l[10 + axis][i];
+
+            float d = std::clamp(center, min, max) - center;
+            lengthSq += d * d;
+
+            float prePos = center - velocity;
+            sweptHit     = sweptHit && min - sweptRadius <= (std::max)(prePos, center) && (std::min)(prePos, center) <= max + sweptRadius;
+            isStill      = isStill && velocity == 0.0f;
+        }
+        candidates_[aabbSphere_.candidates[i]].mayCollide = isStill ? lengthSq <= radius * radius : sweptHit;
+    }
+}
+
+void NarrowphaseBatch::EvaluateCapsuleSphere() {
+    const auto& l = capsuleSphere_.lanes;
+    for (size_t i = 0; i < capsuleSphere_.candidates.size(); ++i) {
+        Vec3f start(l[0][i], l[1][i], l[2][i]);
+        Vec3f end(l[3][i], l[4][i], l[5][i]);
+        Vec3f point(l[7][i], l[8][i], l[9][i]);
+        Vec3f diff      = point - ClosestPointOnSegment(point, start, end);
+        float radiusSum = l[6][i] + l[10][i];
+        candidates_[capsuleSphere_.candidates[i]].mayCollide = !(diff.lengthSq() > radiusSum * radiusSum);
+    }
+}
+
+#endif // ORIGINE_NARROWPHASE_SSE
+
+} // namespace OriGine
@@ -0,0 +1,167 @@
+#pragma once
+
+/// stl
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/// ECS
+// component
+#include "component/collision/collider/base/Collider.h"
+#include "component/collision/CollisionPushBackInfo.h"
+// func
+#include "system/collision/CollisionCheckPairFunc.h"
+
+/// math
+#include "math/bounds/AABB.h"
+#include "math/bounds/Capsule.h"
+#include "math/bounds/Sphere.h"
+#include "Vector3.h"
+
+/// SSE2 が使える環境 (x64 は常に使える) では4組ずつ判定する. それ以外はスカラーで判定する.
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define ORIGINE_NARROWPHASE_SSE
+#endif
+
+namespace OriGine {
+
+/// <summary>
+/// 狭域フェーズのコライダーの組をまとめて判定するバッチ.
+/// よく使う形状の組 (Sphere-Sphere, AABB-AABB, AABB-Sphere, Capsule-Sphere) は形状ごとに SoA に集めて4組ずつ重なりを判定し,
+/// 重なっていない組を取り除く. 残った組と, それ以外の形状の組は追加した順に既存の CheckCollisionPair で判定し直すため,
+/// 押し戻し情報は逐次判定と同じになる.
+/// </summary>
+class NarrowphaseBatch {
+public:
+    /// <summary>
+    /// コライダーの組を判定する関数 (形状の組ごとの CheckCollisionPair を呼び出す)
+    /// </summary>
+    using CheckFunc = bool (*)(Scene* _scene, const EntityHandle& _aEntity, const EntityHandle& _bEntity, ICollider* _colliderA, ICollider* _colliderB, CollisionPushBackInfo* _aInfo, CollisionPushBackInfo* _bInfo);
+
+    /// <summary>
+    /// 判定待ちのコライダーの組
+    /// </summary>
+    struct Candidate {
+        CheckFunc check;
+        ICollider* colliderA;
+        ICollider* colliderB;
+        uint32_t pairIndex; // 呼び出し側のエンティティの組の番号
+        bool mayCollide; // まとめて判定した結果 (false なら重なっていない)
+    };
+
+    NarrowphaseBatch()  = default;
+    ~NarrowphaseBatch() = default;
+
+    /// <summary>
+    /// 追加した組を全て破棄する (確保済みの容量は保持する)
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// コライダーの組を追加する
+    /// </summary>
+    /// <param name="_pairIndex">呼び出し側のエンティティの組の番号</param>
+    /// <param name="_aVelocity">A側エンティティの Rigidbody の速度 (AABB-Sphere の掃引判定に使う. 無ければ0)</param>
+    /// <param name="_bVelocity">B側エンティティの Rigidbody の速度</param>
+    template <typename ColliderA, typename ColliderB>
+    void Add(ColliderA& _colliderA, ColliderB& _colliderB, uint32_t _pairIndex, const Vec3f& _aVelocity, const Vec3f& _bVelocity);
+
+    /// <summary>
+    /// SoA に集めた組の重なりをまとめて判定し, 各 Candidate の mayCollide を更新する
+    /// </summary>
+    void Evaluate();
+
+    const std::vector<Candidate>& GetCandidates() const { return candidates_; }
+
+    /// <summary>
+    /// まとめて判定した組の数を取得 (最後の Evaluate 時点)
+    /// </summary>
+    size_t GetBatchedCount() const { return batchedCount_; }
+
+private:
+    /// <summary>
+    /// 形状の組ごとの SoA. lanes[i] が形状データの i 番目の成分, candidates がその組の Candidate の番号.
+    /// </summary>
+    template <size_t kLaneCount>
+    struct Bucket {
+        std::array<std::vector<float>, kLaneCount> lanes;
+        std::vector<uint32_t> candidates;
+
+        void Clear() {
+            for (auto& lane : lanes) {
+                lane.clear();
+            }
+            candidates.clear();
+        }
+        void Push(uint32_t _candidate, const std::array<float, kLaneCount>& _values) {
+            for (size_t i = 0; i < kLaneCount; ++i) {
+                lanes[i].push_back(_values[i]);
+            }
+            candidates.push_back(_candidate);
+        }
+        /// <summary>
+        /// 4の倍数になるまで最後の組を複製する (結果は使わない)
+        /// </summary>
+        void Pad() {
+            while (!candidates.empty() && lanes[0].size() % 4 != 0) {
+                for (auto& lane : lanes) {
+                    lane.push_back(lane.back());
+                }
+            }
+        }
+    };
+
+    template <typename ColliderA, typename ColliderB>
+    static bool CheckColliderPair(Scene* _scene, const EntityHandle& _aEntity, const EntityHandle& _bEntity, ICollider* _colliderA, ICollider* _colliderB, CollisionPushBackInfo* _aInfo, CollisionPushBackInfo* _bInfo) {
+        return CheckCollisionPair<>(_scene, _aEntity, _bEntity, static_cast<ColliderA*>(_colliderA)->GetWorldShape(), static_cast<ColliderB*>(_colliderB)->GetWorldShape(), _aInfo, _bInfo);
+    }
+
+    void PushSphereSphere(uint32_t _candidate, const Bounds::Sphere& _a, const Bounds::Sphere& _b);
+    void PushAABBAABB(uint32_t _candidate, const Bounds::AABB& _a, const Bounds::AABB& _b);
+    void PushAABBSphere(uint32_t _candidate, const Bounds::AABB& _aabb, const Bounds::Sphere& _sphere, const Vec3f& _sphereVelocity);
+    void PushCapsuleSphere(uint32_t _candidate, const Bounds::Capsule& _capsule, const Bounds::Sphere& _sphere);
+
+    void EvaluateSphereSphere();
+    void EvaluateAABBAABB();
+    void EvaluateAABBSphere();
+    void EvaluateCapsuleSphere();
+
+private:
+    std::vector<Candidate> candidates_;
+
+    Bucket<8> sphereSphere_; // aCenter(3), aRadius, bCenter(3), bRadius
+    Bucket<12> aabbAabb_; // aMin(3), aMax(3), bMin(3), bMax(3)
+    Bucket<13> aabbSphere_; // min(3), max(3), center(3), radius, velocity(3)
+    Bucket<11> capsuleSphere_; // start(3), end(3), capsuleRadius, center(3), sphereRadius
+
+    size_t batchedCount_ = 0;
+};
+
+template <typename ColliderA, typename ColliderB>
+inline void NarrowphaseBatch::Add(ColliderA& _colliderA, ColliderB& _colliderB, uint32_t _pairIndex, const Vec3f& _aVelocity, const Vec3f& _bVelocity) {
+    using ShapeA = std::remove_cvref_t<decltype(_colliderA.GetWorldShape())>;
+    using ShapeB = std::remove_cvref_t<decltype(_colliderB.GetWorldShape())>;
+
+    uint32_t candidate = static_cast<uint32_t>(candidates_.size());
+    candidates_.push_back(Candidate{&CheckColliderPair<ColliderA, ColliderB>, &_colliderA, &_colliderB, _pairIndex, true});
+
+    const ShapeA& shapeA = _colliderA.GetWorldShape();
+    const ShapeB& shapeB = _colliderB.GetWorldShape();
+    if constexpr (std::is_same_v<ShapeA, Bounds::Sphere> && std::is_same_v<ShapeB, Bounds::Sphere>) {
+        PushSphereSphere(candidate, shapeA, shapeB);
+    } else if constexpr (std::is_same_v<ShapeA, Bounds::AABB> && std::is_same_v<ShapeB, Bounds::AABB>) {
+        PushAABBAABB(candidate, shapeA, shapeB);
+    } else if constexpr (std::is_same_v<ShapeA, Bounds::AABB> && std::is_same_v<ShapeB, Bounds::Sphere>) {
+        PushAABBSphere(candidate, shapeA, shapeB, _bVelocity);
+    } else if constexpr (std::is_same_v<ShapeA, Bounds::Sphere> && std::is_same_v<ShapeB, Bounds::AABB>) {
+        PushAABBSphere(candidate, shapeB, shapeA, _aVelocity);
+    } else if constexpr (std::is_same_v<ShapeA, Bounds::Capsule> && std::is_same_v<ShapeB, Bounds::Sphere>) {
+        PushCapsuleSphere(candidate, shapeA, shapeB);
+    } else if constexpr (std::is_same_v<ShapeA, Bounds::Sphere> && std::is_same_v<ShapeB, Bounds::Capsule>) {
+        PushCapsuleSphere(candidate, shapeB, shapeA);
+    }
+    // それ以外の組は SoA に集めず, そのまま CheckCollisionPair で判定する
+}
+
+} // namespace OriGine
@@ -1,11 +1,31 @@
 #include "SpatialHash.h"
 
 #include <algorithm>
+#include <cfloat>
 #include <cmath>
-#include <set>
+
+/// collision
+#include "CollisionCheckUtility.h"
 
 namespace OriGine {
 
+namespace {
+
+/// <summary>
+/// セル順 (z, y, x) の比較
+/// </summary>
+bool CellLess(const CellKey& _a, const CellKey& _b) {
+    if (_a.z != _b.z) {
+        return _a.z < _b.z;
+    }
+    if (_a.y != _b.y) {
+        return _a.y < _b.y;
+    }
+    return _a.x < _b.x;
+}
+
+} // namespace
+
 SpatialHash::SpatialHash(float _cellSize)
     : cellSize_(_cellSize), inverseCellSize_(1.0f / _cellSize) {}
 
@@ -15,72 +35,248 @@ void SpatialHash::SetCellSize(float _cellSize) {
 }
 
 void SpatialHash::Clear() {
-    cells_.clear();
-    entityCells_.clear();
+    entities_.clear();
+    cellEntries_.clear();
+    layers_.clear();
+    isSorted_  = true;
+    cellCount_ = 0;
 }
 
-void SpatialHash::Insert(const EntityHandle& _entity, const Bounds::AABB& _aabb) {
+void SpatialHash::Insert(const EntityHandle& _entity, const Bounds::AABB& _aabb, const CollisionLayer& _layer) {
     CellKey minCell, maxCell;
     GetCellRange(_aabb, minCell, maxCell);
 
-    std::vector<CellKey>& cellList = entityCells_[_entity];
-    cellList.clear();
+    uint32_t layerId  = FindOrAddLayer(_layer);
+    uint32_t entityId = static_cast<uint32_t>(entities_.size());
+    entities_.push_back(_entity);
+
+    Vec3f aabbMin = _aabb.Min();
+    Vec3f aabbMax = _aabb.Max();
+    for (int axis = 0; axis < 3; ++axis) {
+        boundsMin_[axis] = entityId == 0 ? aabbMin[axis] : std::min(boundsMin_[axis], aabbMin[axis]);
+        boundsMax_[axis] = entityId == 0 ? aabbMax[axis] : std::max(boundsMax_[axis], aabbMax[axis]);
+    }
 
     // AABBがカバーする全てのセルに登録
     for (int32_t z = minCell.z; z <= maxCell.z; ++z) {
         for (int32_t y = minCell.y; y <= maxCell.y; ++y) {
             for (int32_t x = minCell.x; x <= maxCell.x; ++x) {
-                CellKey key{x, y, z};
-                cells_[key].push_back(_entity);
-                cellList.push_back(key);
+                cellEntries_.push_back(CellEntry{CellKey{x, y, z}, layerId, entityId});
             }
         }
     }
+    isSorted_ = false;
 }
 
-void SpatialHash::Query(const Bounds::AABB& _aabb, std::unordered_set<EntityHandle>& _outEntities) const {
+void SpatialHash::Query(const Bounds::AABB& _aabb, std::vector<EntityHandle>& _outEntities) {
+    SortEntries();
+    BeginQuery();
+
     CellKey minCell, maxCell;
     GetCellRange(_aabb, minCell, maxCell);
-
     for (int32_t z = minCell.z; z <= maxCell.z; ++z) {
         for (int32_t y = minCell.y; y <= maxCell.y; ++y) {
             for (int32_t x = minCell.x; x <= maxCell.x; ++x) {
-                CellKey key{x, y, z};
-                auto it = cells_.find(key);
-                if (it != cells_.end()) {
-                    for (EntityHandle entity : it->second) {
-                        _outEntities.insert(entity);
-                    }
-                }
+                CollectCell(CellKey{x, y, z}, _outEntities);
             }
         }
     }
 }
 
-void SpatialHash::GetAllPairs(std::vector<std::pair<EntityHandle, EntityHandle>>& _outPairs) const {
-    _outPairs.clear();
+void SpatialHash::QueryRay(const Vec3f& _origin, const Vec3f& _direction, float _maxDistance, float _radius, std::vector<EntityHandle>& _outEntities) {
+    if (entities_.empty()) {
+        return;
+    }
+
+    // 登録済みAABB全体の範囲に切り詰める (無限遠のレイでも辿るセルが有限になる)
+    Vec3f pad(_radius, _radius, _radius);
+    float tEnter = 0.f;
+    float tExit  = _maxDistance;
+    if (!ClipRayToBox(_origin, _direction, boundsMin_ - pad, boundsMax_ + pad, tEnter, tExit)) {
+        return;
+    }
+    Vec3f start = _origin + _direction * tEnter;
+    Vec3f end   = _origin + _direction * tExit;
 
-    // 重複チェック用セット（EntityHandle同士のペア）
-    std::set<std::pair<EntityHandle, EntityHandle>> checkedPairs;
+    // 掃引球は切り詰めた線分を包むAABBで検索する
+    if (_radius > 0.f) {
+        Vec3f minPos(std::min(start[X], end[X]), std::min(start[Y], end[Y]), std::min(start[Z], end[Z]));
+        Vec3f maxPos(std::max(start[X], end[X]), std::max(start[Y], end[Y]), std::max(start[Z], end[Z]));
+        minPos -= pad;
+        maxPos += pad;
+        Query(Bounds::AABB((minPos + maxPos) * 0.5f, (maxPos - minPos) * 0.5f), _outEntities);
+        return;
+    }
 
-    for (const auto& [cellKey, entities] : cells_) {
-        size_t count = entities.size();
-        for (size_t i = 0; i < count; ++i) {
-            for (size_t j = i + 1; j < count; ++j) {
-                EntityHandle a = entities[i];
-                EntityHandle b = entities[j];
+    SortEntries();
+    BeginQuery();
 
-                // 順序を正規化
-                if (b < a) {
-                    std::swap(a, b);
-                }
-                auto pairKey = std::make_pair(a, b);
+    // 3D DDA: レイが通るセルを始点側から順に辿る
+    CellKey cell    = PositionToCell(start);
+    CellKey endCell = PositionToCell(end);
+    int32_t step[3];
+    float tNext[3];
+    float tDelta[3];
+    int32_t* cellAxis[3] = {&cell.x, &cell.y, &cell.z};
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::abs(_direction[axis]) < kEpsilon) {
+            step[axis]   = 0;
+            tNext[axis]  = FLT_MAX;
+            tDelta[axis] = FLT_MAX;
+            continue;
+        }
+        step[axis]     = _direction[axis] > 0.f ? 1 : -1;
+        float boundary = static_cast<float>(*cellAxis[axis] + (step[axis] > 0 ? 1 : 0)) * cellSize_;
+        tNext[axis]    = tEnter + (boundary - start[axis]) / _direction[axis];
+        tDelta[axis]   = cellSize_ / std::abs(_direction[axis]);
+    }
+
+    // 始点と終点のセルの距離 (マンハッタン) を超えて辿らない
+    int32_t remaining = std::abs(endCell.x - cell.x) + std::abs(endCell.y - cell.y) + std::abs(endCell.z - cell.z);
+    while (true) {
+        CollectCell(cell, _outEntities);
+        if (remaining-- <= 0) {
+            break;
+        }
+        int axis = 0;
+        if (tNext[1] < tNext[axis]) {
+            axis = 1;
+        }
+        if (tNext[2] < tNext[axis]) {
+            axis = 2;
+        }
+        if (tNext[axis] > tExit) {
+            break;
+        }
+        *cellAxis[axis] += step[axis];
+        tNext[axis] += tDelta[axis];
+    }
+}
 
-                // 未チェックのペアのみ追加
-                if (checkedPairs.insert(pairKey).second) {
-                    _outPairs.emplace_back(a, b);
+void SpatialHash::GetAllPairs(std::vector<std::pair<EntityHandle, EntityHandle>>& _outPairs) {
+    _outPairs.clear();
+    SortEntries();
+
+    // 同じセルに入っているエンティティ番号の組を, 衝突し得るレイヤーの組についてだけ列挙する
+    pairIds_.clear();
+    size_t count      = cellEntries_.size();
+    size_t layerCount = layers_.size();
+    for (size_t begin = 0; begin < count;) {
+        size_t end = begin + 1;
+        while (end < count && cellEntries_[end].cell == cellEntries_[begin].cell) {
+            ++end;
+        }
+        // セル内はレイヤー順に並んでいるので, 同じレイヤーの範囲ごとに表を1回だけ引く
+        for (size_t groupA = begin; groupA < end;) {
+            uint32_t layerA  = cellEntries_[groupA].layerId;
+            size_t groupAEnd = groupA + 1;
+            while (groupAEnd < end && cellEntries_[groupAEnd].layerId == layerA) {
+                ++groupAEnd;
+            }
+            for (size_t groupB = groupA; groupB < end;) {
+                uint32_t layerB  = cellEntries_[groupB].layerId;
+                size_t groupBEnd = groupB + 1;
+                while (groupBEnd < end && cellEntries_[groupBEnd].layerId == layerB) {
+                    ++groupBEnd;
                 }
+                if (layerMatrix_[layerA * layerCount + layerB]) {
+                    for (size_t i = groupA; i < groupAEnd; ++i) {
+                        for (size_t j = (groupA == groupB ? i + 1 : groupB); j < groupBEnd; ++j) {
+                            uint64_t a = cellEntries_[i].entityId;
+                            uint64_t b = cellEntries_[j].entityId;
+                            if (b < a) {
+                                std::swap(a, b);
+                            }
+                            pairIds_.push_back((a << 32) | b);
+                        }
+                    }
+                }
+                groupB = groupBEnd;
+            }
+            groupA = groupAEnd;
+        }
+        begin = end;
+    }
+
+    // 複数セルに跨るペアの重複を取り除く
+    std::sort(pairIds_.begin(), pairIds_.end());
+    pairIds_.erase(std::unique(pairIds_.begin(), pairIds_.end()), pairIds_.end());
+
+    _outPairs.reserve(pairIds_.size());
+    for (uint64_t pairId : pairIds_) {
+        EntityHandle a = entities_[static_cast<uint32_t>(pairId >> 32)];
+        EntityHandle b = entities_[static_cast<uint32_t>(pairId)];
+
+        // 順序を正規化
+        if (b < a) {
+            std::swap(a, b);
+        }
+        _outPairs.emplace_back(a, b);
+    }
+}
+
+void SpatialHash::SortEntries() {
+    if (isSorted_) {
+        return;
+    }
+
+    // セル順, 同じセル内はレイヤー順, 同じレイヤー内はエンティティ番号順に並べる
+    std::sort(cellEntries_.begin(), cellEntries_.end(), [](const CellEntry& _a, const CellEntry& _b) {
+        if (_a.cell == _b.cell) {
+            if (_a.layerId != _b.layerId) {
+                return _a.layerId < _b.layerId;
             }
+            return _a.entityId < _b.entityId;
+        }
+        return CellLess(_a.cell, _b.cell);
+    });
+
+    // レイヤー間の表 (種類数は少ないので毎回作り直す)
+    size_t layerCount = layers_.size();
+    layerMatrix_.resize(layerCount * layerCount);
+    for (size_t a = 0; a < layerCount; ++a) {
+        for (size_t b = 0; b < layerCount; ++b) {
+            layerMatrix_[a * layerCount + b] = layers_[a].CanCollideWith(layers_[b]) ? 1 : 0;
+        }
+    }
+
+    cellCount_ = 0;
+    for (size_t i = 0; i < cellEntries_.size(); ++i) {
+        if (i == 0 || !(cellEntries_[i].cell == cellEntries_[i - 1].cell)) {
+            ++cellCount_;
+        }
+    }
+    isSorted_ = true;
+}
+
+uint32_t SpatialHash::FindOrAddLayer(const CollisionLayer& _layer) {
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        if (layers_[i] == _layer) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    layers_.push_back(_layer);
+    return static_cast<uint32_t>(layers_.size() - 1);
+}
+
+void SpatialHash::BeginQuery() {
+    // 同じエンティティを2回返さないよう, 今回のQuery番号で印を付ける
+    if (queryStamps_.size() < entities_.size()) {
+        queryStamps_.resize(entities_.size(), 0);
+    }
+    if (++queryStamp_ == 0) {
+        std::fill(queryStamps_.begin(), queryStamps_.end(), 0);
+        queryStamp_ = 1;
+    }
+}
+
+void SpatialHash::CollectCell(const CellKey& _cell, std::vector<EntityHandle>& _outEntities) {
+    auto entryLess = [](const CellEntry& _entry, const CellKey& _key) { return CellLess(_entry.cell, _key); };
+    auto itr       = std::lower_bound(cellEntries_.begin(), cellEntries_.end(), _cell, entryLess);
+    for (; itr != cellEntries_.end() && itr->cell == _cell; ++itr) {
+        if (queryStamps_[itr->entityId] != queryStamp_) {
+            queryStamps_[itr->entityId] = queryStamp_;
+            _outEntities.push_back(entities_[itr->entityId]);
         }
     }
 }
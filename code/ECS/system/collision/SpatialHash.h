@@ -2,8 +2,7 @@
 
 /// stl
 #include <cstdint>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
 /// math
@@ -13,6 +12,9 @@
 /// ECS
 #include "entity/EntityHandle.h"
 
+/// collision
+#include "CollisionLayer.h"
+
 namespace OriGine {
 
 /// <summary>
@@ -37,7 +39,10 @@ struct CellKeyHash {
 };
 
 /// <summary>
-/// 空間ハッシュによる広域フェーズ衝突検出
+/// 空間ハッシュによる広域フェーズ衝突検出.
+/// (セル, エンティティ番号) の平坦な配列をセル順に並べ替えて同じセルの組を列挙する.
+/// 配列はフレームをまたいで使い回すため, 容量が足りている間はヒープ確保を行わない.
+/// 同じセル内は衝突レイヤーごとにまとめて並べ, 衝突し得ないレイヤー同士 (レイヤー間の表で判定) の組は列挙しない.
 /// </summary>
 class SpatialHash {
 public:
@@ -59,41 +64,67 @@ public:
     float GetCellSize() const { return cellSize_; }
 
     /// <summary>
-    /// 全セルをクリア
+    /// 全セルをクリア (確保済みの容量は保持する)
     /// </summary>
     void Clear();
 
     /// <summary>
-    /// オブジェクトを登録
+    /// オブジェクトを登録 (Clear から次の Clear までに同じエンティティを複数回登録しないこと)
     /// </summary>
     /// <param name="_entity">エンティティハンドル</param>
     /// <param name="_aabb">オブジェクトのAABB</param>
-    void Insert(const EntityHandle& _entity, const Bounds::AABB& _aabb);
+    /// <param name="_layer">衝突レイヤー (GetAllPairs で衝突し得ないレイヤーの組を除く)</param>
+    void Insert(const EntityHandle& _entity, const Bounds::AABB& _aabb, const CollisionLayer& _layer = CollisionLayer());
 
     /// <summary>
-    /// 指定AABBと衝突する可能性のあるエンティティを取得
+    /// 指定AABBと衝突する可能性のあるエンティティを取得 (セルの並べ替えを行うため non-const)
     /// </summary>
     /// <param name="_aabb">検索範囲のAABB</param>
-    /// <param name="_outEntities">結果を格納するセット</param>
-    void Query(const Bounds::AABB& _aabb, std::unordered_set<EntityHandle>& _outEntities) const;
+    /// <param name="_outEntities">結果の追加先 (重複なし)</param>
+    void Query(const Bounds::AABB& _aabb, std::vector<EntityHandle>& _outEntities);
+
+    /// <summary>
+    /// レイ (半径を持たせると掃引球) が通るセルのエンティティを取得 (セルの並べ替えを行うため non-const).
+    /// レイは登録済みAABB全体の範囲に切り詰めてからセルを辿る. 半径があれば切り詰めた線分を包むAABBで検索する.
+    /// </summary>
+    /// <param name="_origin">始点</param>
+    /// <param name="_direction">方向 (正規化済み)</param>
+    /// <param name="_maxDistance">最大距離</param>
+    /// <param name="_radius">掃引する球の半径 (レイなら0)</param>
+    /// <param name="_outEntities">結果の追加先 (重複なし)</param>
+    void QueryRay(const Vec3f& _origin, const Vec3f& _direction, float _maxDistance, float _radius, std::vector<EntityHandle>& _outEntities);
 
     /// <summary>
-    /// 全ての衝突候補ペアを取得
+    /// 全ての衝突候補ペアを取得 (セルの並べ替えを行うため non-const). 衝突し得ないレイヤー同士の組は含まない.
     /// </summary>
     /// <param name="_outPairs">結果を格納するベクター（pair<EntityA, EntityB>）</param>
-    void GetAllPairs(std::vector<std::pair<EntityHandle, EntityHandle>>& _outPairs) const;
+    void GetAllPairs(std::vector<std::pair<EntityHandle, EntityHandle>>& _outPairs);
 
     /// <summary>
     /// 登録されているエンティティ数を取得
     /// </summary>
-    size_t GetEntityCount() const { return entityCells_.size(); }
+    size_t GetEntityCount() const { return entities_.size(); }
+
+    /// <summary>
+    /// 使用中のセル数を取得 (最後に並べ替えた時点の値)
+    /// </summary>
+    size_t GetCellCount() const { return cellCount_; }
 
     /// <summary>
-    /// 使用中のセル数を取得
+    /// 登録されている衝突レイヤーの種類数を取得
     /// </summary>
-    size_t GetCellCount() const { return cells_.size(); }
+    size_t GetLayerCount() const { return layers_.size(); }
 
 private:
+    /// <summary>
+    /// セルに登録されたエンティティ (entityId は entities_, layerId は layers_ のインデックス)
+    /// </summary>
+    struct CellEntry {
+        CellKey cell;
+        uint32_t layerId;
+        uint32_t entityId;
+    };
+
     /// <summary>
     /// 座標からセルキーを計算
     /// </summary>
@@ -104,15 +135,44 @@ private:
     /// </summary>
     void GetCellRange(const Bounds::AABB& _aabb, CellKey& _min, CellKey& _max) const;
 
+    /// <summary>
+    /// レイヤーの番号を取得 (初めてのレイヤーなら追加する)
+    /// </summary>
+    uint32_t FindOrAddLayer(const CollisionLayer& _layer);
+
+    /// <summary>
+    /// cellEntries_ をセル順 (同じセル内はレイヤー順) に並べ替え, レイヤー間の表を作り直す (Insert 後の初回のみ)
+    /// </summary>
+    void SortEntries();
+
+    /// <summary>
+    /// Query の重複除去用の番号を進める
+    /// </summary>
+    void BeginQuery();
+
+    /// <summary>
+    /// セルに登録されたエンティティのうち, 今回の Query でまだ返していないものを追加する
+    /// </summary>
+    void CollectCell(const CellKey& _cell, std::vector<EntityHandle>& _outEntities);
+
 private:
     float cellSize_;
     float inverseCellSize_; // 除算を避けるため逆数を保持
 
-    // セルごとのエンティティリスト
-    std::unordered_map<CellKey, std::vector<EntityHandle>, CellKeyHash> cells_;
+    std::vector<EntityHandle> entities_; // 登録順のエンティティ (インデックスをエンティティ番号として使う)
+    std::vector<CellEntry> cellEntries_; // (セル, エンティティ番号) の組
+    bool isSorted_    = true;
+    size_t cellCount_ = 0;
+
+    std::vector<CollisionLayer> layers_; // 登録されたレイヤーの種類
+    std::vector<uint8_t> layerMatrix_; // layers_ 同士が衝突し得るか (layers_.size() 四方の表)
+
+    Vec3f boundsMin_ = {0.f, 0.f, 0.f}; // 登録済みAABB全体の範囲 (QueryRay の切り詰め用)
+    Vec3f boundsMax_ = {0.f, 0.f, 0.f};
 
-    // エンティティが属するセルのリスト（複数セルに跨る場合あり）
-    std::unordered_map<EntityHandle, std::vector<CellKey>> entityCells_;
+    std::vector<uint64_t> pairIds_; // 候補ペア (小さい番号 << 32 | 大きい番号) の作業領域
+    std::vector<uint32_t> queryStamps_; // Query の重複除去用 (エンティティ番号ごとの最終Query番号)
+    uint32_t queryStamp_ = 0;
 };
 
 } // namespace OriGine
@@ -0,0 +1,187 @@
+#include "StaticBVH.h"
+
+#include <algorithm>
+
+/// collision
+#include "CollisionCheckUtility.h"
+
+namespace OriGine {
+
+namespace {
+
+bool Overlaps(const Vec3f& _aMin, const Vec3f& _aMax, const Vec3f& _bMin, const Vec3f& _bMax) {
+    return _aMin[X] <= _bMax[X] && _bMin[X] <= _aMax[X]
+           && _aMin[Y] <= _bMax[Y] && _bMin[Y] <= _aMax[Y]
+           && _aMin[Z] <= _bMax[Z] && _bMin[Z] <= _aMax[Z];
+}
+
+} // namespace
+
+void StaticBVH::Build(const std::vector<EntityHandle>& _entities, const std::vector<Bounds::AABB>& _aabbs, const std::vector<CollisionLayer>& _layers) {
+    Clear();
+
+    uint32_t count = static_cast<uint32_t>(std::min({_entities.size(), _aabbs.size(), _layers.size()}));
+    if (count == 0) {
+        return;
+    }
+
+    entities_.assign(_entities.begin(), _entities.begin() + count);
+    itemMin_.resize(count);
+    itemMax_.resize(count);
+    itemCenter_.resize(count);
+    itemLayers_.assign(_layers.begin(), _layers.begin() + count);
+    items_.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        itemMin_[i]    = _aabbs[i].Min();
+        itemMax_[i]    = _aabbs[i].Max();
+        itemCenter_[i] = _aabbs[i].center;
+        items_[i]      = i;
+    }
+
+    nodes_.reserve(2 * (count / kMaxLeafSize + 1));
+    BuildNode(0, count);
+}
+
+void StaticBVH::Clear() {
+    nodes_.clear();
+    items_.clear();
+    entities_.clear();
+    itemMin_.clear();
+    itemMax_.clear();
+    itemCenter_.clear();
+    itemLayers_.clear();
+}
+
+uint32_t StaticBVH::BuildNode(uint32_t _begin, uint32_t _end) {
+    uint32_t nodeIndex = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    // 要素と重心の範囲, 衝突レイヤーをまとめる
+    Vec3f nodeMin            = itemMin_[items_[_begin]];
+    Vec3f nodeMax            = itemMax_[items_[_begin]];
+    Vec3f centerMin          = itemCenter_[items_[_begin]];
+    Vec3f centerMax          = centerMin;
+    CollisionLayer nodeLayer = itemLayers_[items_[_begin]];
+    for (uint32_t i = _begin + 1; i < _end; ++i) {
+        uint32_t item = items_[i];
+        for (int axis = 0; axis < 3; ++axis) {
+            nodeMin[axis]   = std::min(nodeMin[axis], itemMin_[item][axis]);
+            nodeMax[axis]   = std::max(nodeMax[axis], itemMax_[item][axis]);
+            centerMin[axis] = std::min(centerMin[axis], itemCenter_[item][axis]);
+            centerMax[axis] = std::max(centerMax[axis], itemCenter_[item][axis]);
+        }
+        nodeLayer = nodeLayer.Union(itemLayers_[item]);
+    }
+    nodes_[nodeIndex].min   = nodeMin;
+    nodes_[nodeIndex].max   = nodeMax;
+    nodes_[nodeIndex].layer = nodeLayer;
+
+    uint32_t count = _end - _begin;
+    if (count <= kMaxLeafSize) {
+        nodes_[nodeIndex].first = _begin;
+        nodes_[nodeIndex].count = count;
+        return nodeIndex;
+    }
+
+    // 重心の広がりが最大の軸で, 中央値を境に2分割する
+    Vec3f extent = centerMax - centerMin;
+    int axis     = 0;
+    if (extent[Y] > extent[axis]) {
+        axis = 1;
+    }
+    if (extent[Z] > extent[axis]) {
+        axis = 2;
+    }
+    uint32_t mid = _begin + count / 2;
+    std::nth_element(items_.begin() + _begin, items_.begin() + mid, items_.begin() + _end, [this, axis](uint32_t _a, uint32_t _b) {
+        return itemCenter_[_a][axis] < itemCenter_[_b][axis];
+    });
+
+    BuildNode(_begin, mid); // 左の子は nodeIndex + 1
+    uint32_t right          = BuildNode(mid, _end);
+    nodes_[nodeIndex].first = right;
+    nodes_[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+void StaticBVH::Query(const Bounds::AABB& _aabb, std::vector<EntityHandle>& _outEntities) const {
+    QueryNodes(_aabb, nullptr, _outEntities);
+}
+
+void StaticBVH::Query(const Bounds::AABB& _aabb, const CollisionLayer& _layer, std::vector<EntityHandle>& _outEntities) const {
+    QueryNodes(_aabb, &_layer, _outEntities);
+}
+
+void StaticBVH::QueryNodes(const Bounds::AABB& _aabb, const CollisionLayer* _layer, std::vector<EntityHandle>& _outEntities) const {
+    if (nodes_.empty()) {
+        return;
+    }
+    Vec3f queryMin = _aabb.Min();
+    Vec3f queryMax = _aabb.Max();
+
+    stack_.clear();
+    stack_.push_back(0);
+    while (!stack_.empty()) {
+        uint32_t nodeIndex = stack_.back();
+        const Node& node   = nodes_[nodeIndex];
+        stack_.pop_back();
+
+        if (_layer && !_layer->CanCollideWith(node.layer)) {
+            continue;
+        }
+        if (!Overlaps(node.min, node.max, queryMin, queryMax)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                uint32_t item = items_[i];
+                if (_layer && !_layer->CanCollideWith(itemLayers_[item])) {
+                    continue;
+                }
+                if (Overlaps(itemMin_[item], itemMax_[item], queryMin, queryMax)) {
+                    _outEntities.push_back(entities_[item]);
+                }
+            }
+            continue;
+        }
+        stack_.push_back(node.first);
+        stack_.push_back(nodeIndex + 1);
+    }
+}
+
+void StaticBVH::QueryRay(const Vec3f& _origin, const Vec3f& _direction, float _maxDistance, float _radius, std::vector<EntityHandle>& _outEntities) const {
+    if (nodes_.empty()) {
+        return;
+    }
+    Vec3f pad(_radius, _radius, _radius);
+    auto hitsBox = [&](const Vec3f& _min, const Vec3f& _max) {
+        float tMin = 0.f;
+        float tMax = _maxDistance;
+        return ClipRayToBox(_origin, _direction, _min - pad, _max + pad, tMin, tMax);
+    };
+
+    stack_.clear();
+    stack_.push_back(0);
+    while (!stack_.empty()) {
+        uint32_t nodeIndex = stack_.back();
+        const Node& node   = nodes_[nodeIndex];
+        stack_.pop_back();
+
+        if (!hitsBox(node.min, node.max)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                uint32_t item = items_[i];
+                if (hitsBox(itemMin_[item], itemMax_[item])) {
+                    _outEntities.push_back(entities_[item]);
+                }
+            }
+            continue;
+        }
+        stack_.push_back(node.first);
+        stack_.push_back(nodeIndex + 1);
+    }
+}
+
+} // namespace OriGine
@@ -0,0 +1,115 @@
+#pragma once
+
+/// stl
+#include <cstdint>
+#include <vector>
+
+/// math
+#include "bounds/AABB.h"
+#include "Vector3.h"
+
+/// ECS
+#include "entity/EntityHandle.h"
+
+/// collision
+#include "CollisionLayer.h"
+
+namespace OriGine {
+
+/// <summary>
+/// 静的コライダー用の焼き込み済みBVH.
+/// 一度にまとめて構築し (重心の中央値で分割), 以後は検索だけを行う. 配置が変わったら Build し直す.
+/// 各ノードは部分木の衝突レイヤーをまとめて持ち, レイヤーを指定した検索では衝突し得ない部分木に降りない.
+/// </summary>
+class StaticBVH {
+public:
+    static constexpr uint32_t kMaxLeafSize = 4; // 葉に入れる最大要素数
+
+    StaticBVH()  = default;
+    ~StaticBVH() = default;
+
+    /// <summary>
+    /// BVHを構築する
+    /// </summary>
+    /// <param name="_entities">エンティティ</param>
+    /// <param name="_aabbs">各エンティティのAABB (_entities と同じ並び)</param>
+    /// <param name="_layers">各エンティティの衝突レイヤー (_entities と同じ並び)</param>
+    void Build(const std::vector<EntityHandle>& _entities, const std::vector<Bounds::AABB>& _aabbs, const std::vector<CollisionLayer>& _layers);
+
+    /// <summary>
+    /// 全要素を破棄する
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 指定AABBと重なるエンティティを取得
+    /// </summary>
+    /// <param name="_aabb">検索範囲のAABB</param>
+    /// <param name="_outEntities">結果の追加先</param>
+    void Query(const Bounds::AABB& _aabb, std::vector<EntityHandle>& _outEntities) const;
+
+    /// <summary>
+    /// 指定AABBと重なり, 指定レイヤーと衝突し得るエンティティを取得
+    /// </summary>
+    /// <param name="_aabb">検索範囲のAABB</param>
+    /// <param name="_layer">検索する側の衝突レイヤー</param>
+    /// <param name="_outEntities">結果の追加先</param>
+    void Query(const Bounds::AABB& _aabb, const CollisionLayer& _layer, std::vector<EntityHandle>& _outEntities) const;
+
+    /// <summary>
+    /// レイ (半径を持たせると掃引球) が通るAABBのエンティティを取得
+    /// </summary>
+    /// <param name="_origin">始点</param>
+    /// <param name="_direction">方向 (正規化済み)</param>
+    /// <param name="_maxDistance">最大距離</param>
+    /// <param name="_radius">各AABBを広げる量 (掃引する球の半径. レイなら0)</param>
+    /// <param name="_outEntities">結果の追加先</param>
+    void QueryRay(const Vec3f& _origin, const Vec3f& _direction, float _maxDistance, float _radius, std::vector<EntityHandle>& _outEntities) const;
+
+    /// <summary>
+    /// 登録されているエンティティ数を取得
+    /// </summary>
+    size_t GetEntityCount() const { return entities_.size(); }
+
+    /// <summary>
+    /// ノード数を取得
+    /// </summary>
+    size_t GetNodeCount() const { return nodes_.size(); }
+
+private:
+    /// <summary>
+    /// BVHのノード. 左の子は常に直後 (自身のインデックス + 1) に置く.
+    /// </summary>
+    struct Node {
+        Vec3f min;
+        Vec3f max;
+        uint32_t first = 0; // 葉: items_ の開始位置, 内部ノード: 右の子のインデックス
+        uint32_t count = 0; // 葉: 要素数, 内部ノード: 0
+        CollisionLayer layer; // 部分木の要素の衝突レイヤーをまとめたもの
+    };
+
+    /// <summary>
+    /// items_[_begin, _end) を包むノードを作り, 必要なら分割する
+    /// </summary>
+    /// <returns>作成したノードのインデックス</returns>
+    uint32_t BuildNode(uint32_t _begin, uint32_t _end);
+
+    /// <summary>
+    /// AABBと重なる要素を取得する (_layer が nullptr ならレイヤーで絞り込まない)
+    /// </summary>
+    void QueryNodes(const Bounds::AABB& _aabb, const CollisionLayer* _layer, std::vector<EntityHandle>& _outEntities) const;
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> items_; // 葉から参照する要素番号 (葉ごとに連続)
+
+    std::vector<EntityHandle> entities_;
+    std::vector<Vec3f> itemMin_;
+    std::vector<Vec3f> itemMax_;
+    std::vector<Vec3f> itemCenter_;
+    std::vector<CollisionLayer> itemLayers_;
+
+    mutable std::vector<uint32_t> stack_; // 走査用の作業領域
+};
+
+} // namespace OriGine
@@ -8,7 +8,9 @@ using namespace OriGine;
 /// <summary>
 /// コンストラクタ
 /// </summary>
-DissolveAnimationSystem::DissolveAnimationSystem() : ISystem(SystemCategory::Effect) {}
+DissolveAnimationSystem::DissolveAnimationSystem() : ISystem(SystemCategory::Effect) {
+    DeclareWrite<DissolveAnimation, DissolveEffectParam>();
+}
 
 /// <summary>
 /// デストラクタ
@@ -14,7 +14,7 @@ using namespace OriGine;
 void EntitySpawnerWorkSystem::Initialize() {}
 
 void EntitySpawnerWorkSystem::Finalize() {
-    entities_.clear();
+    ClearEntities();
 }
 
 void EntitySpawnerWorkSystem::UpdateEntity(const EntityHandle& _handle) {
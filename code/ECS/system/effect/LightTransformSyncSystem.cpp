@@ -8,6 +8,14 @@
 
 using namespace OriGine;
 
+/// <summary>
+/// コンストラクタ
+/// </summary>
+LightTransformSyncSystem::LightTransformSyncSystem() : ISystem(SystemCategory::Effect) {
+    DeclareRead<Transform>();
+    DeclareWrite<PointLight, SpotLight>();
+}
+
 void LightTransformSyncSystem::UpdateEntity(const EntityHandle& _handle) {
     // PointLight の位置を Transform から同期
     {
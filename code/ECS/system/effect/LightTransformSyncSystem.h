@@ -10,7 +10,7 @@ namespace OriGine {
 class LightTransformSyncSystem
     : public ISystem {
 public:
-    LightTransformSyncSystem() : ISystem(SystemCategory::Effect) {}
+    LightTransformSyncSystem();
     ~LightTransformSyncSystem() override = default;
 
     void Initialize() override {}
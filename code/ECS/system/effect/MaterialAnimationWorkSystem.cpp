@@ -9,6 +9,14 @@
 
 using namespace OriGine;
 
+/// <summary>
+/// コンストラクタ
+/// </summary>
+MaterialAnimationWorkSystem::MaterialAnimationWorkSystem() : ISystem(SystemCategory::Effect) {
+    DeclareWrite<MaterialAnimation, Material>();
+    EnableParallelUpdate();
+}
+
 /// <summary>
 /// 各エンティティのマテリアルアニメーションを更新する
 /// </summary>
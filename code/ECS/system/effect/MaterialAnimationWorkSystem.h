@@ -12,7 +12,7 @@ public:
     /// <summary>
     /// コンストラクタ
     /// </summary>
-    MaterialAnimationWorkSystem() : ISystem(SystemCategory::Effect) {}
+    MaterialAnimationWorkSystem();
 
     /// <summary>
     /// デストラクタ
@@ -21,7 +21,7 @@ void ParticleSystemWorkSystem::Initialize() {}
 /// 終了処理
 /// </summary>
 void ParticleSystemWorkSystem::Finalize() {
-    entities_.clear();
+    ClearEntities();
 }
 
 /// <summary>
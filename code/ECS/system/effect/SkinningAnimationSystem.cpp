@@ -17,51 +17,47 @@
 
 using namespace OriGine;
 
-static void ApplyAnimation(Skeleton& _skeleton, AnimationData* _animationData, float _animationTime) {
-    for (Joint& joint : _skeleton.joints) {
-        auto itr = _animationData->animationNodes_.find(joint.name);
-        if (itr == _animationData->animationNodes_.end()) {
-            LOG_WARN("Joint {} not found in animation data", joint.name);
-            continue;
-        }
-        const ModelAnimationNode& nodeAnimation = itr->second;
-        joint.transform.scale                   = CalculateValue::Linear(nodeAnimation.scale, _animationTime);
-        joint.transform.rotate                  = CalculateValue::Linear(nodeAnimation.rotate, _animationTime);
-        joint.transform.translate               = CalculateValue::Linear(nodeAnimation.translate, _animationTime);
+static void ApplyAnimation(Skeleton& _skeleton, AnimationClipBinding& _binding, float _animationTime) {
+    _binding.Prepare(_animationTime);
+    for (size_t i = 0; i < _skeleton.joints.size(); ++i) {
+        Joint& joint = _skeleton.joints[i];
+        // トラックの無い関節はそのまま (Bind 時に報告済み)
+        _binding.SampleJoint(i, _animationTime, joint.transform.scale, joint.transform.rotate, joint.transform.translate);
     }
 }
 
+// _bindingA と _bindingB は別の AnimationClipBinding であること (Prepare で展開した姿勢を共有するため)
 static void ApplyBlendedAnimation(
     Skeleton& _skeleton,
-    AnimationData* _animA, float _timeA,
-    AnimationData* _animB, float _timeB,
+    AnimationClipBinding& _bindingA, float _timeA,
+    AnimationClipBinding& _bindingB, float _timeB,
     float blendWeight) {
+    _bindingA.Prepare(_timeA);
+    _bindingB.Prepare(_timeB);
     for (size_t i = 0; i < _skeleton.joints.size(); ++i) {
         Joint& joint = _skeleton.joints[i];
-        auto itA     = _animA->animationNodes_.find(joint.name);
-        auto itB     = _animB->animationNodes_.find(joint.name);
-
-        if (itA == _animA->animationNodes_.end() || itB == _animB->animationNodes_.end()) {
-            if (itA != _animA->animationNodes_.end()) {
-                const ModelAnimationNode& nodeAnimation = itA->second;
-                joint.transform.scale                   = CalculateValue::Linear(nodeAnimation.scale, _timeA);
-                joint.transform.rotate                  = CalculateValue::Linear(nodeAnimation.rotate, _timeA);
-                joint.transform.translate               = CalculateValue::Linear(nodeAnimation.translate, _timeA);
-            } else if (itB != _animB->animationNodes_.end()) {
-                const ModelAnimationNode& nodeAnimation = itB->second;
-                joint.transform.scale                   = CalculateValue::Linear(nodeAnimation.scale, _timeB);
-                joint.transform.rotate                  = CalculateValue::Linear(nodeAnimation.rotate, _timeB);
-                joint.transform.translate               = CalculateValue::Linear(nodeAnimation.translate, _timeB);
+
+        Vec3f scaleA, scaleB, translateA, translateB;
+        Quaternion rotateA, rotateB;
+        bool hasA = _bindingA.SampleJoint(i, _timeA, scaleA, rotateA, translateA);
+        bool hasB = _bindingB.SampleJoint(i, _timeB, scaleB, rotateB, translateB);
+
+        if (!hasA || !hasB) {
+            if (hasA) {
+                joint.transform.scale     = scaleA;
+                joint.transform.rotate    = rotateA;
+                joint.transform.translate = translateA;
+            } else if (hasB) {
+                joint.transform.scale     = scaleB;
+                joint.transform.rotate    = rotateB;
+                joint.transform.translate = translateB;
             }
             continue;
         }
 
-        const ModelAnimationNode& nodeA = itA->second;
-        const ModelAnimationNode& nodeB = itB->second;
-
-        joint.transform.scale     = Lerp(CalculateValue::Linear(nodeA.scale, _timeA), CalculateValue::Linear(nodeB.scale, _timeB), blendWeight);
-        joint.transform.rotate    = Slerp(CalculateValue::Linear(nodeA.rotate, _timeA), CalculateValue::Linear(nodeB.rotate, _timeB), blendWeight);
-        joint.transform.translate = Lerp(CalculateValue::Linear(nodeA.translate, _timeA), CalculateValue::Linear(nodeB.translate, _timeB), blendWeight);
+        joint.transform.scale     = Lerp(scaleA, scaleB, blendWeight);
+        joint.transform.rotate    = Slerp(rotateA, rotateB, blendWeight);
+        joint.transform.translate = Lerp(translateA, translateB, blendWeight);
     }
 }
 
@@ -174,17 +170,26 @@ void SkinningAnimationSystem::UpdateEntity(const EntityHandle& _handle) {
             }
             animationComponent.SetAnimationCurrentTime(nextAnimationIndex, nextAnimationCurrentTime);
 
-            ApplyBlendedAnimation(
-                skeleton,
-                animationComponent.GetAnimationData(currentAnimationIndex).get(),
-                currentTime,
-                animationComponent.GetAnimationData(nextAnimationIndex).get(),
-                nextAnimationCurrentTime,
-                transitionCurrentTime / animationComponent.GetBlendTime());
+            if (nextAnimationIndex == currentAnimationIndex) {
+                // 同じクリップへの遷移は同じ AnimationClipBinding を返すので, 2回 Prepare すると
+                // 展開した姿勢 (圧縮したもの) が後の時刻で上書きされる. ブレンドせずに1回だけサンプリングする
+                ApplyAnimation(
+                    skeleton,
+                    animationComponent.BindAnimation(nextAnimationIndex),
+                    nextAnimationCurrentTime);
+            } else {
+                ApplyBlendedAnimation(
+                    skeleton,
+                    animationComponent.BindAnimation(currentAnimationIndex),
+                    currentTime,
+                    animationComponent.BindAnimation(nextAnimationIndex),
+                    nextAnimationCurrentTime,
+                    transitionCurrentTime / animationComponent.GetBlendTime());
+            }
         } else {
             ApplyAnimation(
                 skeleton,
-                animationComponent.GetAnimationData(currentAnimationIndex).get(),
+                animationComponent.BindAnimation(currentAnimationIndex),
                 currentTime);
         }
         skeleton.Update();
@@ -1,5 +1,8 @@
 #include "SpriteAnimationSystem.h"
 
+/// stl
+#include <algorithm>
+
 /// engine
 #include "Engine.h"
 #define ENGINE_ECS
@@ -10,7 +13,9 @@
 
 using namespace OriGine;
 
-SpriteAnimationSystem::SpriteAnimationSystem() : ISystem(SystemCategory::Effect) {}
+SpriteAnimationSystem::SpriteAnimationSystem() : ISystem(SystemCategory::Effect) {
+    DeclareWrite<SpriteAnimation, SpriteRenderer>();
+}
 
 /// <summary>
 /// デストラクタ
@@ -41,13 +46,16 @@ void SpriteAnimationSystem::UpdateEntity(const EntityHandle& _handle) {
     // DeltaTimerを取得
     const float deltaTime = Engine::GetInstance()->GetDeltaTimer()->GetScaledDeltaTime("Effect");
     for (auto& spriteAnimation : spriteAnimations) {
-        // 対応するSpriteRendererコンポーネントを取得
-        SpriteRenderer* spriteRenderer = GetComponent<SpriteRenderer>(spriteAnimation.GetSpriteComponentHandle());
-        if (!spriteRenderer) {
-            // インデックスが範囲外の場合、またはコンポーネントが見つからない場合はスキップ
+        // 対応するSpriteRendererコンポーネントを, 処理中のエンティティが持つものの中から探す
+        // (他のエンティティのSpriteRendererを指すHandleでは書き換えない)
+        auto spriteRendererItr = std::find_if(spriteRenderers.begin(), spriteRenderers.end(), [&spriteAnimation](const SpriteRenderer& _renderer) {
+            return _renderer.GetHandle() == spriteAnimation.GetSpriteComponentHandle();
+        });
+        if (spriteRendererItr == spriteRenderers.end()) {
+            // コンポーネントが見つからない場合はスキップ
             continue;
         }
         // スプライトアニメーションの更新
-        spriteAnimation.UpdateSpriteAnimation(deltaTime, spriteRenderer);
+        spriteAnimation.UpdateSpriteAnimation(deltaTime, &(*spriteRendererItr));
     }
 }
@@ -10,6 +10,38 @@
 
 using namespace OriGine;
 
+/// <summary>
+/// コンストラクタ
+/// </summary>
+TransformAnimationWorkSystem::TransformAnimationWorkSystem() : ISystem(SystemCategory::Effect) {
+    DeclareWrite<TransformAnimation, Transform>();
+    EnableParallelUpdate();
+}
+
+/// <summary>
+/// TransformAnimation と Transform を持つエンティティをクエリで列挙し, 分割して並列に更新する
+/// </summary>
+void TransformAnimationWorkSystem::Update() {
+    if (entities_.empty()) {
+        return;
+    }
+
+    EraseDeadEntity();
+
+    const float deltaTime = Engine::GetInstance()->GetDeltaTimer()->GetScaledDeltaTime("Effect");
+
+    auto query = Query<TransformAnimation, Transform>();
+    ParallelFor(query.GetDriveSize(), [this, &query, deltaTime](uint32_t _begin, uint32_t _end) {
+        query.ForEachAll(_begin, _end,
+            [this, deltaTime](const EntityHandle& _handle, std::vector<TransformAnimation>& _animations, std::vector<Transform>& _transforms) {
+                if (!HasEntity(_handle)) {
+                    return;
+                }
+                UpdateAnimations(_animations, _transforms, deltaTime);
+            });
+    });
+}
+
 /// <summary>
 /// 各エンティティのトランスフォームアニメーションを更新する
 /// </summary>
@@ -31,3 +63,20 @@ void TransformAnimationWorkSystem::UpdateEntity(const EntityHandle& _handle) {
         transAnim.Update(deltaTime, trans);
     }
 }
+
+/// <summary>
+/// アニメーションを進め, 対象のTransformへ反映する
+/// </summary>
+/// <param name="_animations">エンティティが持つTransformAnimation</param>
+/// <param name="_transforms">エンティティが持つTransform</param>
+/// <param name="_deltaTime">経過時間</param>
+void TransformAnimationWorkSystem::UpdateAnimations(std::vector<TransformAnimation>& _animations, std::vector<Transform>& _transforms, float _deltaTime) {
+    for (auto& transAnim : _animations) {
+        int32_t transformIndex = transAnim.GetTargetTransformIndex();
+        if (transformIndex < 0) {
+            continue;
+        }
+        Transform* trans = static_cast<size_t>(transformIndex) < _transforms.size() ? &_transforms[transformIndex] : nullptr;
+        transAnim.Update(_deltaTime, trans);
+    }
+}
@@ -2,6 +2,9 @@
 #include "system/ISystem.h"
 
 namespace OriGine {
+/// 前方宣言
+struct Transform;
+class TransformAnimation;
 
 /// <summary>
 /// トランスフォーム（座標・回転・スケール）のアニメーションを制御するシステム
@@ -12,7 +15,7 @@ public:
     /// <summary>
     /// コンストラクタ
     /// </summary>
-    TransformAnimationWorkSystem() : ISystem(SystemCategory::Effect) {}
+    TransformAnimationWorkSystem();
 
     /// <summary>
     /// デストラクタ
@@ -29,12 +32,25 @@ public:
     /// </summary>
     void Finalize() override {}
 
+    /// <summary>
+    /// TransformAnimation と Transform を持つエンティティをクエリで列挙して更新する
+    /// </summary>
+    void Update() override;
+
 protected:
     /// <summary>
     /// 各エンティティのトランスフォームアニメーションを更新する
     /// </summary>
     /// <param name="_handle">対象のエンティティハンドル</param>
     void UpdateEntity(const EntityHandle& _handle) override;
+
+    /// <summary>
+    /// アニメーションを進め, 対象のTransformへ反映する
+    /// </summary>
+    /// <param name="_animations">エンティティが持つTransformAnimation</param>
+    /// <param name="_transforms">エンティティが持つTransform</param>
+    /// <param name="_deltaTime">経過時間</param>
+    void UpdateAnimations(std::vector<TransformAnimation>& _animations, std::vector<Transform>& _transforms, float _deltaTime);
 };
 
 } // namespace OriGine
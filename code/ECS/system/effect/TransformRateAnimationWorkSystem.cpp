@@ -10,6 +10,13 @@
 
 using namespace OriGine;
 
+/// <summary>
+/// コンストラクタ
+/// </summary>
+TransformRateAnimationWorkSystem::TransformRateAnimationWorkSystem() : ISystem(SystemCategory::Effect) {
+    DeclareWrite<TransformRateAnimation, Transform>();
+}
+
 /// <summary>
 /// 各エンティティの速度・加速度アニメーションを更新する
 /// </summary>
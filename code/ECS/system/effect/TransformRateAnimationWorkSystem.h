@@ -12,7 +12,7 @@ public:
     /// <summary>
     /// コンストラクタ
     /// </summary>
-    TransformRateAnimationWorkSystem() : ISystem(SystemCategory::Effect) {}
+    TransformRateAnimationWorkSystem();
 
     /// <summary>
     /// デストラクタ
@@ -6,6 +6,7 @@
 #include "scene/Scene.h"
 /// ECS
 // component
+#include "component/collision/CollisionPushBackInfo.h"
 #include "component/physics/Rigidbody.h"
 #include "component/transform/Transform.h"
 
@@ -13,7 +14,10 @@
 
 using namespace OriGine;
 
-MoveSystemByRigidBody::MoveSystemByRigidBody() : ISystem(SystemCategory::Movement) {}
+MoveSystemByRigidBody::MoveSystemByRigidBody() : ISystem(SystemCategory::Movement) {
+    DeclareWrite<Transform, Rigidbody, CollisionPushBackInfo>();
+    EnableParallelUpdate();
+}
 
 /// <summary>
 /// デストラクタ
@@ -28,40 +32,82 @@ void MoveSystemByRigidBody::Initialize() {}
 /// <summary>
 /// 終了処理
 /// </summary>
-void MoveSystemByRigidBody::Finalize() {}
+void MoveSystemByRigidBody::Finalize() {
+    sleepingIslands_.clear();
+    sleepNodes_.clear();
+    nodeOfEntityIndex_.clear();
+    sleepingBodyCount_ = 0;
+    awakeBodyCount_    = 0;
+}
+
+/// <summary>
+/// 眠りの判定をしてから, 登録エンティティを分割して並列に更新する.
+/// 各エンティティは自身の Transform と Rigidbody しか書き換えないため, 更新順に依存しない.
+/// </summary>
+void MoveSystemByRigidBody::Update() {
+    if (entities_.empty()) {
+        return;
+    }
+
+    EraseDeadEntity();
+
+    UpdateSleep();
+
+    ParallelFor(static_cast<uint32_t>(entities_.size()), [this](uint32_t _begin, uint32_t _end) {
+        for (uint32_t i = _begin; i < _end; ++i) {
+            UpdateEntity(entities_[i]);
+        }
+    });
+}
 
 /// <summary>
 /// 各エンティティのRigidbodyに基づいた物理移動を計算し、Transformを更新する
 /// </summary>
 /// <param name="_handle">対象のエンティティハンドル</param>
 void MoveSystemByRigidBody::UpdateEntity(const EntityHandle& _handle) {
-    float deltaTime = 0.f;
-
     Transform* transform = GetComponent<Transform>(_handle);
 
     Rigidbody* rigidbody = GetComponent<Rigidbody>(_handle);
     bool resourceCheck   = (transform != nullptr) && (rigidbody != nullptr);
 
     if (!resourceCheck) {
-        Entity* entity = GetScene()->GetEntity(_handle);
-        if (!transform) {
-            LOG_ERROR("{} doesn't have Transform", entity->GetUniqueID());
-        }
-        if (!rigidbody) {
-            LOG_ERROR("{} doesn't have Rigidbody", entity->GetUniqueID());
-        }
+        ReportMissingComponents(_handle, transform != nullptr, rigidbody != nullptr);
         return;
     }
-    if (!rigidbody->IsActive()) {
+
+    UpdateRigidbody(*transform, *rigidbody);
+}
+
+/// <summary>
+/// 登録されているエンティティに足りないコンポーネントを報告する
+/// </summary>
+void MoveSystemByRigidBody::ReportMissingComponents(const EntityHandle& _handle, bool _hasTransform, bool _hasRigidbody) {
+    if (_hasTransform && _hasRigidbody) {
         return;
     }
+    Entity* entity = GetScene()->GetEntity(_handle);
+    if (!_hasTransform) {
+        LOG_ERROR("{} doesn't have Transform", entity->GetUniqueID());
+    }
+    if (!_hasRigidbody) {
+        LOG_ERROR("{} doesn't have Rigidbody", entity->GetUniqueID());
+    }
+}
 
-    if (rigidbody->IsUsingLocalDeltaTime()) {
-        deltaTime = Engine::GetInstance()->GetDeltaTimer()->GetScaledDeltaTime(rigidbody->GetLocalDeltaTimeName());
-    } else {
-        deltaTime = Engine::GetInstance()->GetDeltaTime();
+/// <summary>
+/// Rigidbodyに基づいた物理移動を計算し、Transformを更新する
+/// </summary>
+/// <param name="_transform">更新するTransform</param>
+/// <param name="_rigidbody">参照するRigidbody</param>
+void MoveSystemByRigidBody::UpdateRigidbody(Transform& _transform, Rigidbody& _rigidbody) {
+    Transform* transform = &_transform;
+    Rigidbody* rigidbody = &_rigidbody;
+    if (!rigidbody->IsActive() || rigidbody->IsSleeping()) {
+        return;
     }
 
+    float deltaTime = GetDeltaTime(*rigidbody);
+
     /// --------------------------------------- 速度の更新 --------------------------------------- ///
     Vec3f acceleration = rigidbody->GetAcceleration();
     Vec3f velocity     = rigidbody->GetVelocity();
@@ -100,3 +146,247 @@ void MoveSystemByRigidBody::UpdateEntity(const EntityHandle& _handle) {
     // worldMatの更新
     transform->UpdateMatrix();
 }
+
+/// <summary>
+/// Rigidbodyが使う経過時間を取得する
+/// </summary>
+float MoveSystemByRigidBody::GetDeltaTime(const Rigidbody& _rigidbody) const {
+    if (_rigidbody.IsUsingLocalDeltaTime()) {
+        return Engine::GetInstance()->GetDeltaTimer()->GetScaledDeltaTime(_rigidbody.GetLocalDeltaTimeName());
+    }
+    return Engine::GetInstance()->GetDeltaTime();
+}
+
+/// <summary>
+/// 前フレームの結果から, 触れられた島を起こし, 静止し続けた島を眠らせる.
+/// 押し戻し情報は前フレームの衝突判定の結果なので, 眠っている物体が触れられてから起きるまでに1フレームの遅れがある.
+/// </summary>
+void MoveSystemByRigidBody::UpdateSleep() {
+    sleepNodes_.clear();
+    wakeIslandIds_.clear();
+    sleepingBodyCount_ = 0;
+    awakeBodyCount_    = 0;
+
+    int32_t sleepFrameCount = sleepFrameCount_;
+
+    /// --------------------------------------- 物体を集める --------------------------------------- ///
+    uint32_t maxEntityIndex = 0;
+    Query<Transform, Rigidbody>().ForEach([this, &maxEntityIndex](const EntityHandle& _handle, Transform& _transform, Rigidbody& _rigidbody) {
+        if (!HasEntity(_handle) || !_rigidbody.IsActive()) {
+            return;
+        }
+        SleepNode node;
+        node.handle       = _handle;
+        node.transform    = &_transform;
+        node.rigidbody    = &_rigidbody;
+        node.pushBackInfo = HasComponent<CollisionPushBackInfo>(_handle) ? GetComponent<CollisionPushBackInfo>(_handle) : nullptr;
+        node.parent       = static_cast<uint32_t>(sleepNodes_.size());
+        sleepNodes_.push_back(node);
+
+        if (_handle.HasRuntimeIndex()) {
+            maxEntityIndex = (std::max)(maxEntityIndex, _handle.index + 1);
+        }
+    });
+
+    /// --------------------------------------- 島を起こす --------------------------------------- ///
+    for (SleepNode& node : sleepNodes_) {
+        Rigidbody* rigidbody = node.rigidbody;
+        uint32_t islandId    = rigidbody->GetIslandId();
+        if (!rigidbody->IsSleeping()) {
+            // 外から WakeUp された物体は, 島の残りも起こす
+            if (islandId != Rigidbody::kNoIsland) {
+                wakeIslandIds_.push_back(islandId);
+            }
+            continue;
+        }
+
+        bool touched = node.pushBackInfo && !node.pushBackInfo->GetCollisionInfoMap().empty();
+        if (sleepFrameCount > 0 && rigidbody->CanSleep() && !touched) {
+            continue;
+        }
+        if (islandId == Rigidbody::kNoIsland) {
+            // 島に属さず直接 Sleep された物体
+            rigidbody->WakeUp();
+            continue;
+        }
+        wakeIslandIds_.push_back(islandId);
+    }
+    for (uint32_t islandId : wakeIslandIds_) {
+        WakeIsland(islandId);
+    }
+
+    if (sleepFrameCount <= 0) {
+        awakeBodyCount_ = static_cast<int32_t>(sleepNodes_.size());
+        return;
+    }
+
+    /// --------------------------------------- 静止の判定 --------------------------------------- ///
+    nodeOfEntityIndex_.assign(maxEntityIndex, kNoNode);
+    for (uint32_t i = 0; i < sleepNodes_.size(); ++i) {
+        SleepNode& node = sleepNodes_[i];
+        if (node.rigidbody->IsSleeping()) {
+            ++sleepingBodyCount_;
+            continue;
+        }
+        ++awakeBodyCount_;
+
+        if (node.handle.HasRuntimeIndex()) {
+            nodeOfEntityIndex_[node.handle.index] = i;
+        }
+
+        // 時間が止まっている間は数えない
+        if (GetDeltaTime(*node.rigidbody) <= 0.f) {
+            continue;
+        }
+        if (IsResting(*node.transform, *node.rigidbody, node.pushBackInfo)) {
+            node.rigidbody->SetRestFrameCount(node.rigidbody->GetRestFrameCount() + 1);
+        } else {
+            node.rigidbody->SetRestFrameCount(0);
+        }
+    }
+    if (awakeBodyCount_ == 0) {
+        return;
+    }
+
+    /// --------------------------------------- 島を求める --------------------------------------- ///
+    // 起きている物体同士を押し戻し情報で繋ぐ (眠っている島は上で起こしたので, 残っているのは触れられていない島だけ)
+    for (uint32_t i = 0; i < sleepNodes_.size(); ++i) {
+        const SleepNode& node = sleepNodes_[i];
+        if (node.rigidbody->IsSleeping() || !node.pushBackInfo) {
+            continue;
+        }
+        for (const auto& [other, info] : node.pushBackInfo->GetCollisionInfoMap()) {
+            if (!other.HasRuntimeIndex() || other.index >= nodeOfEntityIndex_.size()) {
+                continue;
+            }
+            uint32_t otherNode = nodeOfEntityIndex_[other.index];
+            if (otherNode == kNoNode || sleepNodes_[otherNode].handle != other) {
+                continue;
+            }
+            uint32_t rootA = FindRoot(i);
+            uint32_t rootB = FindRoot(otherNode);
+            if (rootA != rootB) {
+                sleepNodes_[rootB].parent = rootA;
+            }
+        }
+    }
+
+    islandMinRestFrames_.assign(sleepNodes_.size(), 0xFFFFFFFF);
+    islandCanSleep_.assign(sleepNodes_.size(), 1);
+    for (uint32_t i = 0; i < sleepNodes_.size(); ++i) {
+        const SleepNode& node = sleepNodes_[i];
+        if (node.rigidbody->IsSleeping()) {
+            continue;
+        }
+        uint32_t root              = FindRoot(i);
+        uint32_t restFrames        = static_cast<uint32_t>((std::max)(node.rigidbody->GetRestFrameCount(), 0));
+        islandMinRestFrames_[root] = (std::min)(islandMinRestFrames_[root], restFrames);
+        if (!node.rigidbody->CanSleep()) {
+            islandCanSleep_[root] = 0;
+        }
+    }
+
+    /// --------------------------------------- 島を眠らせる --------------------------------------- ///
+    islandIdOfRoot_.assign(sleepNodes_.size(), Rigidbody::kNoIsland);
+    for (uint32_t i = 0; i < sleepNodes_.size(); ++i) {
+        const SleepNode& node = sleepNodes_[i];
+        if (node.rigidbody->IsSleeping()) {
+            continue;
+        }
+        uint32_t root = FindRoot(i);
+        if (!islandCanSleep_[root] || islandMinRestFrames_[root] < static_cast<uint32_t>(sleepFrameCount)) {
+            continue;
+        }
+
+        uint32_t& islandId = islandIdOfRoot_[root];
+        if (islandId == Rigidbody::kNoIsland) {
+            islandId = nextIslandId_++;
+            if (nextIslandId_ == Rigidbody::kNoIsland) {
+                nextIslandId_ = Rigidbody::kNoIsland + 1;
+            }
+        }
+
+        node.rigidbody->Sleep();
+        node.rigidbody->SetIslandId(islandId);
+        if (node.pushBackInfo) {
+            node.pushBackInfo->ClearInfo();
+        }
+        sleepingIslands_[islandId].push_back(node.handle);
+
+        ++sleepingBodyCount_;
+        --awakeBodyCount_;
+    }
+}
+
+/// <summary>
+/// 眠っている島の物体を全て起こす
+/// </summary>
+/// <param name="_islandId">島の番号</param>
+void MoveSystemByRigidBody::WakeIsland(uint32_t _islandId) {
+    auto itr = sleepingIslands_.find(_islandId);
+    if (itr == sleepingIslands_.end()) {
+        return;
+    }
+    for (const EntityHandle& handle : itr->second) {
+        // 眠っている間に削除された物体や, 別の島に移った物体は触らない
+        if (!HasComponent<Rigidbody>(handle)) {
+            continue;
+        }
+        Rigidbody* rigidbody = GetComponent<Rigidbody>(handle);
+        if (rigidbody->GetIslandId() != _islandId) {
+            continue;
+        }
+        rigidbody->WakeUp();
+        rigidbody->SetIslandId(Rigidbody::kNoIsland);
+    }
+    sleepingIslands_.erase(itr);
+}
+
+/// <summary>
+/// 前フレームの移動量・加速度・押し戻し量が閾値以下か.
+/// 重力は毎フレーム加速度に積まれ, 接地中は押し戻しで打ち消されるため, 重力を使う物体は加速度と押し戻し量のY成分を見ない.
+/// </summary>
+bool MoveSystemByRigidBody::IsResting(const Transform& _transform, const Rigidbody& _rigidbody, const CollisionPushBackInfo* _pushBackInfo) const {
+    float velocityThreshold = sleepVelocityThreshold_ * GetDeltaTime(_rigidbody);
+    Vec3f displacement      = _transform.translate - _rigidbody.GetPrePos();
+    if (displacement.lengthSq() > velocityThreshold * velocityThreshold) {
+        return false;
+    }
+
+    bool ignoreY       = _rigidbody.GetUseGravity();
+    Vec3f acceleration = _rigidbody.GetAcceleration();
+    if (ignoreY) {
+        acceleration[Y] = 0.f;
+    }
+    float accelerationThreshold = sleepAccelerationThreshold_;
+    if (acceleration.lengthSq() > accelerationThreshold * accelerationThreshold) {
+        return false;
+    }
+
+    if (!_pushBackInfo) {
+        return true;
+    }
+    Vec3f pushBackSum = Vec3f(0.f, 0.f, 0.f);
+    for (const auto& [other, info] : _pushBackInfo->GetCollisionInfoMap()) {
+        if (info.pushBackType == CollisionPushBackType::PushBack || info.pushBackType == CollisionPushBackType::Reflect) {
+            pushBackSum += info.collVec;
+        }
+    }
+    if (ignoreY) {
+        pushBackSum[Y] = 0.f;
+    }
+    float pushBackThreshold = sleepPushBackThreshold_;
+    return pushBackSum.lengthSq() <= pushBackThreshold * pushBackThreshold;
+}
+
+/// <summary>
+/// 島を求める union-find の根を取得する (経路を半分に縮めながら辿る)
+/// </summary>
+uint32_t MoveSystemByRigidBody::FindRoot(uint32_t _node) {
+    while (sleepNodes_[_node].parent != _node) {
+        uint32_t parent           = sleepNodes_[_node].parent;
+        sleepNodes_[_node].parent = sleepNodes_[parent].parent;
+        _node                     = parent;
+    }
+    return _node;
+}
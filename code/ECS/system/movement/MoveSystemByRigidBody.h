@@ -2,13 +2,23 @@
 // parent
 #include "system/ISystem.h"
 
+/// stl
+#include <unordered_map>
+#include <vector>
+
 /// util
 #include "util/globalVariables/SerializedField.h"
 
 namespace OriGine {
+/// 前方宣言
+struct Transform;
+class Rigidbody;
+class CollisionPushBackInfo;
 
 /// <summary>
-/// Rigidbodyコンポーネントによる物理挙動（移動・加速度・速度）をTransformに反映するシステム
+/// Rigidbodyコンポーネントによる物理挙動（移動・加速度・速度）をTransformに反映するシステム.
+/// 押し戻し情報で繋がった物体を島としてまとめ, 島全体が一定フレーム静止し続けたら島ごと眠らせる.
+/// 眠っている物体は積分・押し戻し・衝突判定の更新を省略し, 起きている物体に触れられたら次のフレームで島ごと起きる.
 /// </summary>
 class MoveSystemByRigidBody
     : public ISystem {
@@ -33,6 +43,11 @@ public:
     /// </summary>
     void Finalize() override;
 
+    /// <summary>
+    /// 眠りの判定をしてから, 登録エンティティを並列に更新する
+    /// </summary>
+    void Update() override;
+
 protected:
     /// <summary>
     /// 各エンティティのRigidbodyに基づいた物理移動を計算し、Transformを更新する
@@ -40,11 +55,110 @@ protected:
     /// <param name="_handle">対象のエンティティハンドル</param>
     void UpdateEntity(const EntityHandle& _handle) override;
 
+    /// <summary>
+    /// 登録されているエンティティに足りないコンポーネントを報告する (どちらも持っていれば何もしない)
+    /// </summary>
+    /// <param name="_handle">対象のエンティティハンドル</param>
+    /// <param name="_hasTransform">Transform を持っているか</param>
+    /// <param name="_hasRigidbody">Rigidbody を持っているか</param>
+    void ReportMissingComponents(const EntityHandle& _handle, bool _hasTransform, bool _hasRigidbody);
+
+    /// <summary>
+    /// Rigidbodyに基づいた物理移動を計算し、Transformを更新する
+    /// </summary>
+    /// <param name="_transform">更新するTransform</param>
+    /// <param name="_rigidbody">参照するRigidbody</param>
+    void UpdateRigidbody(Transform& _transform, Rigidbody& _rigidbody);
+
+    /// <summary>
+    /// Rigidbodyが使う経過時間を取得する
+    /// </summary>
+    float GetDeltaTime(const Rigidbody& _rigidbody) const;
+
+    /// <summary>
+    /// 前フレームの結果から, 触れられた島を起こし, 静止し続けた島を眠らせる (積分の前に直列で行う)
+    /// </summary>
+    void UpdateSleep();
+
+    /// <summary>
+    /// 眠っている島の物体を全て起こす
+    /// </summary>
+    /// <param name="_islandId">島の番号</param>
+    void WakeIsland(uint32_t _islandId);
+
+    /// <summary>
+    /// 前フレームの移動量・加速度・押し戻し量が閾値以下か
+    /// </summary>
+    bool IsResting(const Transform& _transform, const Rigidbody& _rigidbody, const CollisionPushBackInfo* _pushBackInfo) const;
+
+    /// <summary>
+    /// 島を求める union-find の根を取得する
+    /// </summary>
+    uint32_t FindRoot(uint32_t _node);
+
+protected:
+    /// <summary>
+    /// UpdateSleep で扱う1物体分の情報
+    /// </summary>
+    struct SleepNode {
+        EntityHandle handle;
+        Transform* transform                = nullptr;
+        Rigidbody* rigidbody                = nullptr;
+        CollisionPushBackInfo* pushBackInfo = nullptr;
+        uint32_t parent                     = 0; // union-find の親
+    };
+
+    static constexpr uint32_t kNoNode = 0xFFFFFFFF;
+
+    std::vector<SleepNode> sleepNodes_;
+    std::vector<uint32_t> nodeOfEntityIndex_; // エンティティの実行時インデックス -> sleepNodes_ の位置
+    std::vector<uint32_t> islandMinRestFrames_; // 根ごとの, 島内で最小の静止フレーム数
+    std::vector<uint8_t> islandCanSleep_; // 根ごとの, 島内の全員が眠れるか
+    std::vector<uint32_t> islandIdOfRoot_; // 根ごとの, 今回眠らせる島の番号
+    std::vector<uint32_t> wakeIslandIds_;
+
+    std::unordered_map<uint32_t, std::vector<EntityHandle>> sleepingIslands_; // 眠っている島の番号 -> 所属する物体
+    uint32_t nextIslandId_ = 1;
+
+    int32_t sleepingBodyCount_ = 0;
+    int32_t awakeBodyCount_    = 0;
+
+public:
+    /// <summary>
+    /// 最後の Update で眠っていた物体数
+    /// </summary>
+    int32_t GetSleepingBodyCount() const { return sleepingBodyCount_; }
+    /// <summary>
+    /// 最後の Update で起きていた物体数
+    /// </summary>
+    int32_t GetAwakeBodyCount() const { return awakeBodyCount_; }
+    /// <summary>
+    /// 眠っている島の数
+    /// </summary>
+    int32_t GetSleepingIslandCount() const { return static_cast<int32_t>(sleepingIslands_.size()); }
+
 protected:
     /// <summary>
     /// 重力加速度の設定値
     /// </summary>
     SerializedField<float> gravity_ = SerializedField<float>("Settings", "Physics", "Gravity");
+
+    /// <summary>
+    /// 静止とみなす速さ (1フレームの移動量 / 経過時間)
+    /// </summary>
+    SerializedField<float> sleepVelocityThreshold_ = SerializedField<float>("Settings", "Physics", "SleepVelocityThreshold", 0.05f);
+    /// <summary>
+    /// 静止とみなす加速度の大きさ (重力を使う物体はY成分を除く)
+    /// </summary>
+    SerializedField<float> sleepAccelerationThreshold_ = SerializedField<float>("Settings", "Physics", "SleepAccelerationThreshold", 0.05f);
+    /// <summary>
+    /// 静止とみなす押し戻し量の合計 (重力を使う物体はY成分を除く)
+    /// </summary>
+    SerializedField<float> sleepPushBackThreshold_ = SerializedField<float>("Settings", "Physics", "SleepPushBackThreshold", 0.01f);
+    /// <summary>
+    /// 眠るまでに静止し続けるフレーム数 (0以下で眠らせない). 既定は 0 で, 眠らせるシーンだけが設定で有効にする
+    /// </summary>
+    SerializedField<int32_t> sleepFrameCount_ = SerializedField<int32_t>("Settings", "Physics", "SleepFrameCount", 0);
 };
 
 } // namespace OriGine
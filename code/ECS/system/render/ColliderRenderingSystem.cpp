@@ -263,10 +263,10 @@ void ColliderRenderingSystem::CreateRenderMesh() {
 
                 // 色の設定
                 Vec4f color    = {1, 1, 1, 1};
-                auto& stateMap = aabb.GetCollisionStateMap();
-                if (!stateMap.empty()) {
-                    for (auto& [collEntityIdx, state] : stateMap) {
-                        if (state != CollisionState::None) {
+                auto& contacts = aabb.GetCollisionContacts();
+                if (!contacts.empty()) {
+                    for (auto& contact : contacts) {
+                        if (contact.state != CollisionState::None) {
                             color = {1, 0, 0, 1};
                             break; // 1つでも衝突していたら赤にする
                         }
@@ -335,10 +335,10 @@ void ColliderRenderingSystem::CreateRenderMesh() {
 
                 // 色の設定
                 Vec4f color    = {1, 1, 1, 1};
-                auto& stateMap = obb.GetCollisionStateMap();
-                if (!stateMap.empty()) {
-                    for (auto& [collEntityIdx, state] : stateMap) {
-                        if (state != CollisionState::None) {
+                auto& contacts = obb.GetCollisionContacts();
+                if (!contacts.empty()) {
+                    for (auto& contact : contacts) {
+                        if (contact.state != CollisionState::None) {
                             color = {1, 0, 0, 1};
                             break; // 1つでも衝突していたら赤にする
                         }
@@ -406,10 +406,10 @@ void ColliderRenderingSystem::CreateRenderMesh() {
 
                 // 色の設定
                 Vec4f color    = {1, 1, 1, 1};
-                auto& stateMap = sphere.GetCollisionStateMap();
-                if (!stateMap.empty()) {
-                    for (auto& [collEntityIdx, state] : stateMap) {
-                        if (state != CollisionState::None) {
+                auto& contacts = sphere.GetCollisionContacts();
+                if (!contacts.empty()) {
+                    for (auto& contact : contacts) {
+                        if (contact.state != CollisionState::None) {
                             color = {1, 0, 0, 1};
                             break; // 1つでも衝突していたら赤にする
                         }
@@ -472,10 +472,10 @@ void ColliderRenderingSystem::CreateRenderMesh() {
                 }
 
                 Vec4f color    = {1, 1, 1, 1};
-                auto& stateMap = ray.GetCollisionStateMap();
-                if (!stateMap.empty()) {
-                    for (auto& [collEntityIdx, state] : stateMap) {
-                        if (state != CollisionState::None) {
+                auto& contacts = ray.GetCollisionContacts();
+                if (!contacts.empty()) {
+                    for (auto& contact : contacts) {
+                        if (contact.state != CollisionState::None) {
                             color = {1, 0, 0, 1};
                             break;
                         }
@@ -537,10 +537,10 @@ void ColliderRenderingSystem::CreateRenderMesh() {
                 }
 
                 Vec4f color    = {1, 1, 1, 1};
-                auto& stateMap = segment.GetCollisionStateMap();
-                if (!stateMap.empty()) {
-                    for (auto& [collEntityIdx, state] : stateMap) {
-                        if (state != CollisionState::None) {
+                auto& contacts = segment.GetCollisionContacts();
+                if (!contacts.empty()) {
+                    for (auto& contact : contacts) {
+                        if (contact.state != CollisionState::None) {
                             color = {1, 0, 0, 1};
                             break;
                         }
@@ -605,10 +605,10 @@ void ColliderRenderingSystem::CreateRenderMesh() {
                 }
 
                 Vec4f color    = {1, 1, 1, 1};
-                auto& stateMap = capsule.GetCollisionStateMap();
-                if (!stateMap.empty()) {
-                    for (auto& [collEntityIdx, state] : stateMap) {
-                        if (state != CollisionState::None) {
+                auto& contacts = capsule.GetCollisionContacts();
+                if (!contacts.empty()) {
+                    for (auto& contact : contacts) {
+                        if (contact.state != CollisionState::None) {
                             color = {1, 0, 0, 1};
                             break;
                         }
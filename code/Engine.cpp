@@ -38,6 +38,7 @@
 #include "EngineConfig.h"
 
 /// util
+#include "jobSystem/JobSystem.h"
 #include "util/StringUtil.h"
 
 #ifdef _DEBUG
@@ -148,6 +149,9 @@ void Engine::Initialize() {
     deltaTimer_ = std::make_unique<DeltaTimer>();
     deltaTimer_->Initialize();
 
+    // システムの並列実行用ワーカー
+    JobSystem::GetInstance()->Initialize();
+
     AnimationManager::GetInstance()->Initialize();
     CameraManager::GetInstance()->Initialize();
 
@@ -159,6 +163,7 @@ void Engine::Initialize() {
 
 /// <summary> エンジンの終了処理. 各システムの Finalize を逆順に呼び出し、DX12 リソースを安全に解放する. </summary>
 void Engine::Finalize() {
+    JobSystem::GetInstance()->Finalize();
 
     AssetSystem::GetInstance()->Finalize();
 
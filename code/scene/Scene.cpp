@@ -1,5 +1,8 @@
 #include "Scene.h"
 
+/// stl
+#include <cmath>
+
 /// engine
 #define ENGINE_INCLUDE
 #define RESOURCE_DIRECTORY
@@ -20,6 +23,8 @@
 // component
 #include "component/animation/SkinningAnimationComponent.h"
 #include "component/ComponentRepository.h"
+#include "component/physics/Rigidbody.h"
+#include "component/transform/Transform.h"
 
 #include "component/renderer/ModelMeshRenderer.h"
 #include "component/renderer/primitive/BoxRenderer.h"
@@ -55,13 +60,6 @@ void Scene::Initialize() {
     systemRunner_->UpdateCategory<SystemCategory::Initialize>();
 }
 
-void Scene::InitializeECS() {
-    entityRepository_ = ::std::make_unique<EntityRepository>();
-    entityRepository_->Initialize();
-    componentRepository_ = ::std::make_unique<ComponentRepository>();
-    systemRunner_        = ::std::make_unique<SystemRunner>(this);
-}
-
 void Scene::InitializeSceneView() {
     sceneView_ = ::std::make_unique<RenderTexture>();
 
@@ -96,12 +94,61 @@ void Scene::Update() {
     }
     systemRunner_->UpdateCategory<SystemCategory::Input>();
     systemRunner_->UpdateCategory<SystemCategory::StateTransition>();
-    systemRunner_->UpdateCategory<SystemCategory::Movement>();
-    systemRunner_->UpdateCategory<SystemCategory::Collision>();
+    if (useFixedTimestep_) {
+        UpdatePhysicsFixedStep();
+    } else {
+        systemRunner_->UpdateCategory<SystemCategory::Movement>();
+        systemRunner_->UpdateCategory<SystemCategory::Collision>();
+        physicsAccumulator_ = 0.0f;
+        interpolationAlpha_ = 1.0f;
+        fixedStepCount_     = 1;
+    }
+
+    // パーティクルやカメラの追従などが描画と同じ位置を読むよう, Effect の間も補間した位置にしておく
+    ApplyRenderInterpolation();
     systemRunner_->UpdateCategory<SystemCategory::Effect>();
+    RestoreRenderInterpolation();
+}
+
+void Scene::UpdatePhysicsFixedStep() {
+    float tickRate = fixedTickRate_;
+    if (tickRate <= 0.0f) {
+        LOG_WARN("FixedTickRate must be positive. tickRate : {}", tickRate);
+        systemRunner_->UpdateCategory<SystemCategory::Movement>();
+        systemRunner_->UpdateCategory<SystemCategory::Collision>();
+        interpolationAlpha_ = 1.0f;
+        fixedStepCount_     = 1;
+        return;
+    }
+
+    DeltaTimer* deltaTimer = Engine::GetInstance()->GetDeltaTimer();
+    float frameDeltaTime   = deltaTimer->GetDeltaTime();
+    float fixedDeltaTime   = 1.0f / tickRate;
+    int32_t maxSubsteps    = (std::max)(static_cast<int32_t>(maxSubsteps_), 1);
+
+    // 物理の各システムからは, 経過時間が常に刻み幅に見えるようにする
+    physicsAccumulator_ += frameDeltaTime;
+    fixedStepCount_ = 0;
+    deltaTimer->SetDeltaTime(fixedDeltaTime);
+    while (physicsAccumulator_ >= fixedDeltaTime && fixedStepCount_ < maxSubsteps) {
+        systemRunner_->UpdateCategory<SystemCategory::Movement>();
+        systemRunner_->UpdateCategory<SystemCategory::Collision>();
+        physicsAccumulator_ -= fixedDeltaTime;
+        ++fixedStepCount_;
+    }
+    deltaTimer->SetDeltaTime(frameDeltaTime);
+
+    // 上限で消費しきれなかった時間は意図的に捨て, 刻み幅未満の端数だけを次のフレームへ持ち越す.
+    // (処理落ちで遅れが積み上がり, 更新回数が増え続けないように. その分だけ物理の時間は実時間より遅れる)
+    if (physicsAccumulator_ >= fixedDeltaTime) {
+        physicsAccumulator_ = std::fmod(physicsAccumulator_, fixedDeltaTime);
+    }
+    interpolationAlpha_ = physicsAccumulator_ / fixedDeltaTime;
 }
 
 void Scene::Render() {
+    ApplyRenderInterpolation();
+
     // worldの描画
     sceneView_->PreDraw();
     systemRunner_->UpdateCategory<SystemCategory::Render>();
@@ -109,20 +156,51 @@ void Scene::Render() {
 
     // ポストレンダリング
     int32_t postRenderInt = static_cast<int32_t>(SystemCategory::PostRender);
-    if (systemRunner_->GetActiveSystems()[postRenderInt].empty() || !systemRunner_->GetCategoryActivity(SystemCategory::PostRender)) {
+    if (!systemRunner_->GetActiveSystems()[postRenderInt].empty() && systemRunner_->GetCategoryActivity(SystemCategory::PostRender)) {
+        systemRunner_->UpdateCategory<SystemCategory::PostRender>();
+    }
+
+    RestoreRenderInterpolation();
+}
+
+void Scene::ApplyRenderInterpolation() {
+    if (!useFixedTimestep_ || !componentRepository_) {
         return;
     }
-    systemRunner_->UpdateCategory<SystemCategory::PostRender>();
+
+    // 眠っている物体は前回の位置が古いので補間しない
+    float alpha = interpolationAlpha_;
+    componentRepository_->Query<Transform, Rigidbody>().ForEach([alpha](const EntityHandle& /*_handle*/, Transform& _transform, Rigidbody& _rigidbody) {
+        if (!_rigidbody.IsActive() || _rigidbody.IsSleeping()) {
+            return;
+        }
+        Vec3f interpolated = Lerp(_rigidbody.GetPrePos(), _transform.translate, alpha);
+        _rigidbody.SetRenderOffset(interpolated - _transform.translate);
+        _transform.translate = interpolated;
+        _transform.UpdateMatrix();
+    });
+    isRenderInterpolated_ = true;
 }
 
-void Scene::Finalize() {
-    systemRunner_->AllUnregisterSystem(true);
-    entityRepository_->Finalize();
-    componentRepository_->Clear();
+void Scene::RestoreRenderInterpolation() {
+    if (!isRenderInterpolated_) {
+        return;
+    }
+    isRenderInterpolated_ = false;
 
-    systemRunner_.reset();
-    componentRepository_.reset();
-    entityRepository_.reset();
+    componentRepository_->Query<Transform, Rigidbody>().ForEach([](const EntityHandle& /*_handle*/, Transform& _transform, Rigidbody& _rigidbody) {
+        const Vec3f& offset = _rigidbody.GetRenderOffset();
+        if (offset == Vec3f(0.0f, 0.0f, 0.0f)) {
+            return;
+        }
+        _transform.translate -= offset;
+        _rigidbody.SetRenderOffset(Vec3f(0.0f, 0.0f, 0.0f));
+        _transform.UpdateMatrix();
+    });
+}
+
+void Scene::Finalize() {
+    FinalizeECS();
 
     if (raytracingScene_) {
         raytracingScene_->Finalize();
@@ -139,22 +217,6 @@ void Scene::Finalize() {
     CameraManager::GetInstance()->UnregisterSceneCamera(this);
 }
 
-void Scene::ExecuteDeleteEntities() {
-    for (EntityHandle entityID : deleteEntities_) {
-        if (!entityID.IsValid()) {
-            LOG_ERROR("Failed Delete Entity : {}", uuids::to_string(entityID.uuid));
-            return;
-        }
-        // コンポーネント を削除
-        componentRepository_->RemoveEntity(entityID);
-        // システムからエンティティを削除
-        systemRunner_->RemoveEntityFromAllSystems(entityID);
-        // エンティティを削除
-        entityRepository_->RemoveEntity(entityID);
-    }
-    deleteEntities_.clear();
-}
-
 void Scene::DispatchMeshForRaytracing() {
     // ModelMeshRendererを持つエンティティのメッシュをレイトレーシング用リストへ収集する
     auto* modelRendererComponentArray = componentRepository_->GetComponentArray<ModelMeshRenderer>();
@@ -285,101 +347,4 @@ void Scene::UpdateRaytracingScene() {
     meshForRaytracing_.clear();
 }
 
-void Scene::AddDeleteEntity(const EntityHandle& _entityId) {
-    if (!_entityId.IsValid()) {
-        LOG_ERROR("Invalid entity ID: {}", uuids::to_string(_entityId.uuid));
-        return;
-    }
-    deleteEntities_.push_back(_entityId);
-}
-
-const EntityRepository* Scene::GetEntityRepository() const { return entityRepository_.get(); }
-EntityRepository* Scene::GetEntityRepositoryRef() { return entityRepository_.get(); }
-
-const ComponentRepository* Scene::GetComponentRepository() const { return componentRepository_.get(); }
-ComponentRepository* Scene::GetComponentRepositoryRef() { return componentRepository_.get(); }
-
-const SystemRunner* Scene::GetSystemRunner() const { return systemRunner_.get(); }
-SystemRunner* Scene::GetSystemRunnerRef() { return systemRunner_.get(); }
-
-Entity* Scene::GetEntity(const EntityHandle& _handle) const {
-    return entityRepository_->GetEntity(_handle);
-}
-
-EntityHandle Scene::GetUniqueEntity(const ::std::string& _dataType) const {
-    if (!_dataType.empty()) {
-        return entityRepository_->GetUniqueEntity(_dataType);
-    }
-    LOG_ERROR("Data type is empty.");
-    return EntityHandle();
-}
-
-EntityHandle Scene::CreateEntity(const ::std::string& _dataType, bool _isUnique) {
-    if (!_dataType.empty()) {
-        return entityRepository_->CreateEntity(_dataType, _isUnique);
-    }
-    LOG_ERROR("Data type is empty.");
-    return EntityHandle();
-}
-
-bool Scene::RegisterUniqueEntity(Entity* _entity) {
-    if (_entity) {
-        return entityRepository_->RegisterUniqueEntity(_entity);
-    }
-    LOG_ERROR("Entity is empty.");
-    return false;
-}
-
-bool Scene::UnregisterUniqueEntity(Entity* _entity) {
-    if (_entity) {
-        return entityRepository_->UnregisterUniqueEntity(_entity);
-    }
-    LOG_ERROR("Entity is empty.");
-    return false;
-}
-
-bool Scene::AddComponent(const ::std::string& _compTypeName, const EntityHandle& _handle) {
-    if (!_handle.IsValid()) {
-        LOG_ERROR("Entity with ID '{}' not found.", uuids::to_string(_handle.uuid));
-        return false;
-    }
-    componentRepository_->AddComponent(this, _compTypeName, _handle);
-    return true;
-}
-
-bool Scene::RemoveComponent(const ::std::string& _compTypeName, const EntityHandle& _handle, int32_t _componentIndex) {
-    if (!_handle.IsValid()) {
-        LOG_ERROR("Entity with ID '{}' not found.", uuids::to_string(_handle.uuid));
-        return false;
-    }
-    componentRepository_->RemoveComponent(_compTypeName, _handle, _componentIndex);
-    return true;
-}
-
-::std::shared_ptr<ISystem> Scene::GetSystem(const ::std::string& _systemTypeName) const {
-    if (systemRunner_) {
-        return systemRunner_->GetSystem(_systemTypeName);
-    }
-    LOG_ERROR("SystemRunner is not initialized.");
-    return nullptr;
-}
-
-bool Scene::RegisterSystem(const ::std::string& _systemTypeName, int32_t _priority, bool _activity) {
-    if (systemRunner_) {
-        systemRunner_->RegisterSystem(_systemTypeName, _priority, _activity);
-        return true;
-    }
-    LOG_ERROR("SystemRunner is not initialized.");
-    return false;
-}
-
-bool Scene::UnregisterSystem(const ::std::string& _systemTypeName) {
-    if (systemRunner_) {
-        systemRunner_->UnregisterSystem(_systemTypeName);
-        return true;
-    }
-    LOG_ERROR("SystemRunner is not initialized.");
-    return false;
-}
-
 } // namespace OriGine
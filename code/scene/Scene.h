@@ -18,6 +18,9 @@
 /// logger
 #include <logger/Logger.h>
 
+/// util
+#include "util/globalVariables/SerializedField.h"
+
 namespace OriGine {
 
 /// engine
@@ -56,11 +59,13 @@ public:
 
     /// <summary>
     /// シーンの毎フレームの更新処理を行う. システムの実行やエンティティの削除予約処理が含まれる.
+    /// 固定タイムステップが有効なら, Movement と Collision は固定の経過時間で 0 回以上まとめて実行する.
     /// </summary>
     void Update();
 
     /// <summary>
     /// シーンの描画処理を行う.
+    /// 固定タイムステップが有効なら, 描画の間だけ Rigidbody を持つ Transform を直前2回の物理状態の間で補間する.
     /// </summary>
     void Render();
 
@@ -74,6 +79,11 @@ public:
     /// </summary>
     void InitializeECS();
 
+    /// <summary>
+    /// ECS (Entity, Component, System) 関連のストレージを破棄する.
+    /// </summary>
+    void FinalizeECS();
+
     /// <summary>
     /// 描画結果を格納するメインのレンダーターゲット (SceneView) を初期化する.
     /// </summary>
@@ -101,6 +111,25 @@ protected:
     /// </summary>
     void DispatchMeshForRaytracing();
 
+    /// <summary>
+    /// 蓄積した経過時間を固定の刻みで消費し, Movement と Collision を実行する.
+    /// 実行中は DeltaTimer の経過時間を刻み幅に差し替える.
+    /// MaxSubsteps 回で消費しきれなかった時間は, 刻み幅未満の端数 (fmod) を残して捨てる.
+    /// </summary>
+    void UpdatePhysicsFixedStep();
+
+    /// <summary>
+    /// Rigidbody を持つ Transform を前回の物理状態 (Rigidbody::prePos_) と今回の物理状態の間で補間する.
+    /// Effect と Render の間だけ適用し, 終わったら RestoreRenderInterpolation で戻す.
+    /// その間に補間中の Transform::translate へ書き込んだ値は, 戻す時に補間のずれの分だけ動く.
+    /// </summary>
+    void ApplyRenderInterpolation();
+
+    /// <summary>
+    /// ApplyRenderInterpolation で動かした Transform を物理状態に戻す.
+    /// </summary>
+    void RestoreRenderInterpolation();
+
 protected:
     /// <summary>このシーンを管理しているシーンマネージャーへのポインタ</summary>
     SceneManager* sceneManager_ = nullptr;
@@ -136,12 +165,32 @@ protected:
     /// <summary>シーンがアクティブ (動作中) かどうか</summary>
     bool isActive_ = false;
 
+    // --- Fixed Timestep ---
+    /// <summary>Movement と Collision を固定タイムステップで実行するか</summary>
+    SerializedField<bool> useFixedTimestep_ = SerializedField<bool>("Settings", "Physics", "UseFixedTimestep", false);
+    /// <summary>1秒あたりの物理の更新回数</summary>
+    SerializedField<float> fixedTickRate_ = SerializedField<float>("Settings", "Physics", "FixedTickRate", 60.0f);
+    /// <summary>1フレームで実行する物理の更新回数の上限 (超えた分の時間は捨てる)</summary>
+    SerializedField<int32_t> maxSubsteps_ = SerializedField<int32_t>("Settings", "Physics", "MaxSubsteps", 4);
+
+    float physicsAccumulator_  = 0.0f; // まだ物理の更新に使っていない経過時間
+    float interpolationAlpha_  = 1.0f; // 描画時の補間率 (0 = 前回の物理状態, 1 = 今回の物理状態)
+    int32_t fixedStepCount_    = 0; // 直前の Update で実行した物理の更新回数
+    bool isRenderInterpolated_ = false; // Transform を補間した状態か
+
 public:
     /// <summary>シーンがアクティブ状態か取得する.</summary>
     bool IsActive() const { return isActive_; }
     /// <summary>シーンのアクティブ状態を設定する.</summary>
     void SetActive(bool _isActive) { isActive_ = _isActive; }
 
+    /// <summary>Movement と Collision を固定タイムステップで実行しているか取得する.</summary>
+    bool IsFixedTimestep() const { return useFixedTimestep_; }
+    /// <summary>直前の Update で実行した物理の更新回数を取得する (固定タイムステップでなければ 1).</summary>
+    int32_t GetFixedStepCount() const { return fixedStepCount_; }
+    /// <summary>描画時の補間率を取得する (固定タイムステップでなければ 1).</summary>
+    float GetInterpolationAlpha() const { return interpolationAlpha_; }
+
     /// <summary>レイトレーシングシーンを取得する.</summary>
     const RaytracingScene* GetRaytracingScene() const { return raytracingScene_.get(); }
     /// <summary>レイトレーシングシーンを取得する (非 const 版).</summary>
@@ -246,10 +295,19 @@ public:
     /// 指定したエンティティが持つ、特定の型のコンポーネントリストをすべて取得する.
     /// </summary>
     template <IsComponent ComponentType>
-    ::std::vector<ComponentType>& GetComponents(const EntityHandle& _handle) {
+    ComponentList<ComponentType>& GetComponents(const EntityHandle& _handle) {
         return componentRepository_->GetComponents<ComponentType>(_handle);
     }
 
+    /// <summary>
+    /// 指定した型のコンポーネントを全て持つエンティティを列挙するクエリを作成する.
+    /// </summary>
+    /// <example>scene->Query&lt;Transform, Rigidbody&gt;().ForEach([](const EntityHandle&amp;, Transform&amp;, Rigidbody&amp;) {});</example>
+    template <IsComponent... ComponentTypes>
+    ComponentQuery<ComponentTypes...> Query() {
+        return componentRepository_->Query<ComponentTypes...>();
+    }
+
     /// <summary>
     /// 型名を指定してエンティティにコンポーネントを追加する.
     /// </summary>
@@ -301,37 +359,6 @@ public:
     bool UnregisterSystem(const ::std::string& _systemTypeName);
 };
 
-template <IsComponent ComponentType>
-/// <summary>
-/// コンポーネントを取得する
-/// </summary>
-/// <typeparam name="ComponentType">コンポーネント型</typeparam>
-/// <param name="_handle">エンティティハンドル</param>
-/// <param name="_index">インデックス</param>
-/// <returns>コンポーネントのポインタ</returns>
-inline ComponentType* Scene::GetComponent(const EntityHandle& _handle, uint32_t _index) const {
-    if (!_handle.IsValid()) {
-        LOG_ERROR("Entity is null. EntityName :{}", nameof<ComponentType>());
-        return nullptr;
-    }
-    return componentRepository_->GetComponent<ComponentType>(_handle, _index);
-}
-template <IsComponent ComponentType>
-inline ComponentType* Scene::GetComponent(ComponentHandle _handle) const {
-    if (!_handle.IsValid()) {
-        LOG_ERROR("Entity is null. EntityName :{}", nameof<ComponentType>());
-        return nullptr;
-    }
-    return componentRepository_->GetComponent<ComponentType>(_handle);
-}
-
-template <IsComponent ComponentType>
-inline bool Scene::AddComponent(const EntityHandle& _handle) {
-    if (!_handle.IsValid()) {
-        LOG_ERROR("Entity with ID '{}' not found.", uuids::to_string(_handle.uuid));
-        return false;
-    }
-    componentRepository_->AddComponent<ComponentType>(this, _handle);
-    return true;
-}
 } // namespace OriGine
+
+#include "Scene.inl"
@@ -0,0 +1,41 @@
+#pragma once
+
+/// Scene のテンプレート関数の定義.
+/// ヘッドレスのツール (tools/headless/scene/Scene.h) もこれを include する.
+
+namespace OriGine {
+
+template <IsComponent ComponentType>
+/// <summary>
+/// コンポーネントを取得する
+/// </summary>
+/// <typeparam name="ComponentType">コンポーネント型</typeparam>
+/// <param name="_handle">エンティティハンドル</param>
+/// <param name="_index">インデックス</param>
+/// <returns>コンポーネントのポインタ</returns>
+inline ComponentType* Scene::GetComponent(const EntityHandle& _handle, uint32_t _index) const {
+    if (!_handle.IsValid()) {
+        LOG_ERROR("Entity is null. EntityName :{}", nameof<ComponentType>());
+        return nullptr;
+    }
+    return componentRepository_->GetComponent<ComponentType>(_handle, _index);
+}
+template <IsComponent ComponentType>
+inline ComponentType* Scene::GetComponent(ComponentHandle _handle) const {
+    if (!_handle.IsValid()) {
+        LOG_ERROR("Entity is null. EntityName :{}", nameof<ComponentType>());
+        return nullptr;
+    }
+    return componentRepository_->GetComponent<ComponentType>(_handle);
+}
+
+template <IsComponent ComponentType>
+inline bool Scene::AddComponent(const EntityHandle& _handle) {
+    if (!_handle.IsValid()) {
+        LOG_ERROR("Entity with ID '{}' not found.", uuids::to_string(_handle.uuid));
+        return false;
+    }
+    componentRepository_->AddComponent<ComponentType>(this, _handle);
+    return true;
+}
+} // namespace OriGine
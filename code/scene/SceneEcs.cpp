@@ -0,0 +1,161 @@
+/// ECS のリソースだけを扱う Scene の関数.
+/// 描画や入力に依存しないので, ヘッドレスのツール (tools/headless) も同じものをコンパイルする.
+/// ツールは include パスで scene/Scene.h を差し替えるので, 同じディレクトリの "Scene.h" ではなく "scene/Scene.h" を読むこと.
+#include "scene/Scene.h"
+
+/// ECS
+#include "entity/Entity.h"
+// component
+#include "component/ComponentRepository.h"
+// system
+#include "system/ISystem.h"
+#include "system/SystemRunner.h"
+
+namespace OriGine {
+
+void Scene::InitializeECS() {
+    entityRepository_ = ::std::make_unique<EntityRepository>();
+    entityRepository_->Initialize();
+    componentRepository_ = ::std::make_unique<ComponentRepository>();
+    systemRunner_        = ::std::make_unique<SystemRunner>(this);
+
+    // Componentの追加/削除を Entity のシグネチャへ反映させる
+    componentRepository_->BindEntityRepository(entityRepository_.get());
+}
+
+void Scene::FinalizeECS() {
+    if (!systemRunner_) {
+        return;
+    }
+    systemRunner_->AllUnregisterSystem(true);
+    entityRepository_->Finalize();
+    componentRepository_->Clear();
+
+    systemRunner_.reset();
+    componentRepository_.reset();
+    entityRepository_.reset();
+}
+
+void Scene::ExecuteDeleteEntities() {
+    if (deleteEntities_.empty()) {
+        return;
+    }
+
+    const uint64_t prevRemoveCount = entityRepository_->GetRemoveCount();
+    for (const EntityHandle& entityID : deleteEntities_) {
+        if (!entityID.IsValid()) {
+            // 無効なハンドルだけを飛ばし, 残りの削除予約は処理する
+            LOG_ERROR("Failed Delete Entity : {}", uuids::to_string(entityID.uuid));
+            continue;
+        }
+        // コンポーネント を削除 (エンティティが持つ ComponentArray だけを辿る)
+        componentRepository_->RemoveEntity(entityID);
+        // システムからエンティティを削除 (エンティティが登録されているシステムだけを辿る)
+        systemRunner_->RemoveEntityFromAllSystems(entityID);
+        // エンティティを削除
+        entityRepository_->RemoveEntity(entityID);
+    }
+    deleteEntities_.clear();
+
+    // 削除したエンティティは全てシステムから除外済みなので, 次の更新での生存確認の走査を省略させる
+    systemRunner_->SyncRemoveCount(prevRemoveCount, entityRepository_->GetRemoveCount());
+}
+
+void Scene::AddDeleteEntity(const EntityHandle& _entityId) {
+    if (!_entityId.IsValid()) {
+        LOG_ERROR("Invalid entity ID: {}", uuids::to_string(_entityId.uuid));
+        return;
+    }
+    deleteEntities_.push_back(_entityId);
+}
+
+const EntityRepository* Scene::GetEntityRepository() const { return entityRepository_.get(); }
+EntityRepository* Scene::GetEntityRepositoryRef() { return entityRepository_.get(); }
+
+const ComponentRepository* Scene::GetComponentRepository() const { return componentRepository_.get(); }
+ComponentRepository* Scene::GetComponentRepositoryRef() { return componentRepository_.get(); }
+
+const SystemRunner* Scene::GetSystemRunner() const { return systemRunner_.get(); }
+SystemRunner* Scene::GetSystemRunnerRef() { return systemRunner_.get(); }
+
+Entity* Scene::GetEntity(const EntityHandle& _handle) const {
+    return entityRepository_->GetEntity(_handle);
+}
+
+EntityHandle Scene::GetUniqueEntity(const ::std::string& _dataType) const {
+    if (!_dataType.empty()) {
+        return entityRepository_->GetUniqueEntity(_dataType);
+    }
+    LOG_ERROR("Data type is empty.");
+    return EntityHandle();
+}
+
+EntityHandle Scene::CreateEntity(const ::std::string& _dataType, bool _isUnique) {
+    if (!_dataType.empty()) {
+        return entityRepository_->CreateEntity(_dataType, _isUnique);
+    }
+    LOG_ERROR("Data type is empty.");
+    return EntityHandle();
+}
+
+bool Scene::RegisterUniqueEntity(Entity* _entity) {
+    if (_entity) {
+        return entityRepository_->RegisterUniqueEntity(_entity);
+    }
+    LOG_ERROR("Entity is empty.");
+    return false;
+}
+
+bool Scene::UnregisterUniqueEntity(Entity* _entity) {
+    if (_entity) {
+        return entityRepository_->UnregisterUniqueEntity(_entity);
+    }
+    LOG_ERROR("Entity is empty.");
+    return false;
+}
+
+bool Scene::AddComponent(const ::std::string& _compTypeName, const EntityHandle& _handle) {
+    if (!_handle.IsValid()) {
+        LOG_ERROR("Entity with ID '{}' not found.", uuids::to_string(_handle.uuid));
+        return false;
+    }
+    componentRepository_->AddComponent(this, _compTypeName, _handle);
+    return true;
+}
+
+bool Scene::RemoveComponent(const ::std::string& _compTypeName, const EntityHandle& _handle, int32_t _componentIndex) {
+    if (!_handle.IsValid()) {
+        LOG_ERROR("Entity with ID '{}' not found.", uuids::to_string(_handle.uuid));
+        return false;
+    }
+    componentRepository_->RemoveComponent(_compTypeName, _handle, _componentIndex);
+    return true;
+}
+
+::std::shared_ptr<ISystem> Scene::GetSystem(const ::std::string& _systemTypeName) const {
+    if (systemRunner_) {
+        return systemRunner_->GetSystem(_systemTypeName);
+    }
+    LOG_ERROR("SystemRunner is not initialized.");
+    return nullptr;
+}
+
+bool Scene::RegisterSystem(const ::std::string& _systemTypeName, int32_t _priority, bool _activity) {
+    if (systemRunner_) {
+        systemRunner_->RegisterSystem(_systemTypeName, _priority, _activity);
+        return true;
+    }
+    LOG_ERROR("SystemRunner is not initialized.");
+    return false;
+}
+
+bool Scene::UnregisterSystem(const ::std::string& _systemTypeName) {
+    if (systemRunner_) {
+        systemRunner_->UnregisterSystem(_systemTypeName);
+        return true;
+    }
+    LOG_ERROR("SystemRunner is not initialized.");
+    return false;
+}
+
+} // namespace OriGine
@@ -42,7 +42,7 @@ void EntityHierarchyRegion::DrawGui() {
         ImGui::SeparatorText("No current scene found.");
         return;
     }
-    auto& entityRepository = currentScene->GetEntityRepositoryRef()->GetEntities();
+    auto entityRepository = currentScene->GetEntityRepositoryRef()->GetEntities();
     if (entityRepository.empty()) {
         ImGui::SeparatorText("No entities in the current scene.");
         return;
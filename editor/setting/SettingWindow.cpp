@@ -524,6 +524,19 @@ void CollisionSettingRegion::Initialize() {
     if (spatialHashCellSize_ <= 0.0f) {
         spatialHashCellSize_ = 100.0f; // デフォルト値
     }
+
+    // 広域フェーズの種類と動的AABB木の余白
+    broadphaseType_ = *gv->AddValue<int32_t>(
+        SettingWindow::kGlobalVariablesSceneName,
+        "Collision",
+        "BroadphaseType");
+    dynamicTreeFatMargin_ = *gv->AddValue<float>(
+        SettingWindow::kGlobalVariablesSceneName,
+        "Collision",
+        "DynamicTreeFatMargin");
+    if (dynamicTreeFatMargin_ <= 0.0f) {
+        dynamicTreeFatMargin_ = 0.5f; // デフォルト値
+    }
 }
 
 void CollisionSettingRegion::DrawGui() {
@@ -534,6 +547,13 @@ void CollisionSettingRegion::DrawGui() {
     ImGui::Text("Spatial Hash Settings:");
     ImGui::DragFloat("Cell Size", &spatialHashCellSize_, 1.0f, 1.0f, 1000.0f, "%.1f");
     ImGui::Spacing();
+
+    // Broadphase設定
+    ImGui::Text("Broadphase Settings:");
+    const char* broadphaseTypeNames[] = {"SpatialHash", "DynamicAABBTree"};
+    ImGui::Combo("Broadphase", &broadphaseType_, broadphaseTypeNames, IM_ARRAYSIZE(broadphaseTypeNames));
+    ImGui::DragFloat("Fat Margin", &dynamicTreeFatMargin_, 0.01f, 0.01f, 100.0f, "%.2f");
+    ImGui::Spacing();
     ImGui::Separator();
     ImGui::Spacing();
 
@@ -604,6 +624,16 @@ void CollisionSettingRegion::DrawGui() {
             "Collision",
             "SpatialHashCellSize",
             spatialHashCellSize_);
+        gv->SetValue<int32_t>(
+            SettingWindow::kGlobalVariablesSceneName,
+            "Collision",
+            "BroadphaseType",
+            broadphaseType_);
+        gv->SetValue<float>(
+            SettingWindow::kGlobalVariablesSceneName,
+            "Collision",
+            "DynamicTreeFatMargin",
+            dynamicTreeFatMargin_);
         gv->SaveFile(
             SettingWindow::kGlobalVariablesSceneName,
             "Collision");
@@ -157,7 +157,9 @@ public:
     void Finalize() override;
 
 private:
-    char newCategoryName_[64]  = "";
-    float spatialHashCellSize_ = 100.0f;
+    char newCategoryName_[64]   = "";
+    float spatialHashCellSize_  = 100.0f;
+    int32_t broadphaseType_     = 0; // CollisionBroadphaseType (0: SpatialHash, 1: DynamicAABBTree)
+    float dynamicTreeFatMargin_ = 0.5f;
 };
 #endif // _DEBUG
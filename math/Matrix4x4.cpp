@@ -147,15 +147,15 @@ Matrix4x4 MakeMatrix4x4::Scale(const Vec3f& vec) {
 }
 
 Matrix4x4 MakeMatrix4x4::RotateX(const float& radian) {
-    return Matrix4x4({01.0f, .0f, 0.0f, 0.0f, 0.0f, std::cosf(radian), std::sinf(radian), 0.0f, 0.0f, -std::sinf(radian), std::cosf(radian), 0.0f, 0.0f, 0.0f, 0.0f, 1.0f});
+    return Matrix4x4({01.0f, .0f, 0.0f, 0.0f, 0.0f, std::cos(radian), std::sin(radian), 0.0f, 0.0f, -std::sin(radian), std::cos(radian), 0.0f, 0.0f, 0.0f, 0.0f, 1.0f});
 }
 
 Matrix4x4 MakeMatrix4x4::RotateY(const float& radian) {
-    return Matrix4x4({std::cosf(radian), 0.0f, -std::sinf(radian), 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, std::sinf(radian), 0.0f, std::cosf(radian), 0.0f, 0.0f, 0.0f, 0.0f, 1.0f});
+    return Matrix4x4({std::cos(radian), 0.0f, -std::sin(radian), 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, std::sin(radian), 0.0f, std::cos(radian), 0.0f, 0.0f, 0.0f, 0.0f, 1.0f});
 }
 
 Matrix4x4 MakeMatrix4x4::RotateZ(const float& radian) {
-    return Matrix4x4({std::cosf(radian), std::sinf(radian), 0.0f, 0.0f, -std::sinf(radian), std::cosf(radian), 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f});
+    return Matrix4x4({std::cos(radian), std::sin(radian), 0.0f, 0.0f, -std::sin(radian), std::cos(radian), 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f});
 }
 
 Matrix4x4 MakeMatrix4x4::RotateXYZ(const Vec3f& radian) {
@@ -195,7 +195,7 @@ Matrix4x4 MakeMatrix4x4::RotateAxisAngle(const Vec3f& axis, float angle) {
 }
 
 Matrix4x4 MakeMatrix4x4::RotateAxisAngle(const Vec3f& fromV, const Vec3f& toV) {
-    float angle = std::acosf(fromV.dot(toV));
+    float angle = std::acos(fromV.dot(toV));
     Vec3f axis  = fromV.cross(toV).normalize();
     return MakeMatrix4x4::RotateAxisAngle(axis, angle);
 }
@@ -252,7 +252,7 @@ Vec3f ScreenToWorld(const Vec2f& screenPos, const float& depth, const Matrix4x4&
 }
 
 Matrix4x4 MakeMatrix4x4::PerspectiveFov(const float& fovY, const float& aspectRatio, const float& nearClip, const float& farClip) {
-    const float cot = 1.0f / std::tanf(fovY / 2.0f);
+    const float cot = 1.0f / std::tan(fovY / 2.0f);
     return Matrix4x4(
         {(1.0f / aspectRatio) * cot, 0.0f, 0.0f, 0.0f, 0.0f, cot, 0.0f, 0.0f, 0.0f, 0.0f, farClip / (farClip - nearClip), 1.0f, 0.0f, 0.0f, (-nearClip * farClip) / (farClip - nearClip), 0.0f});
 }
@@ -14,17 +14,17 @@ float Linear(float t) {
 }
 
 float EaseInSine(float time) {
-    float easedT = 1.0f - ::std::cosf((time * kPi) / 2.0f);
+    float easedT = 1.0f - ::std::cos((time * kPi) / 2.0f);
     return easedT;
 }
 
 float EaseOutSine(float t) {
-    float easedT = ::std::sinf(t * kHalfPi);
+    float easedT = ::std::sin(t * kHalfPi);
     return easedT;
 }
 
 float EaseInOutSine(float t) {
-    float easedT = -(::std::cosf(t * kPi) - 1.0f) / 2.0f;
+    float easedT = -(::std::cos(t * kPi) - 1.0f) / 2.0f;
     return easedT;
 }
 
@@ -43,7 +43,7 @@ float EaseInOutQuad(float t) {
     if (t < 0.5f) {
         easedT = 2.0f * t * t;
     } else {
-        easedT = 1.0f - ::std::powf(-2.0f * t + 2.0f, 2.0f) / 2;
+        easedT = 1.0f - ::std::pow(-2.0f * t + 2.0f, 2.0f) / 2;
     }
     return easedT;
 }
@@ -54,7 +54,7 @@ float EaseInCubic(float t) {
 }
 
 float EaseOutCubic(float t) {
-    float easedT = 1.0f - ::std::powf(1.0f - t, 3.0f);
+    float easedT = 1.0f - ::std::pow(1.0f - t, 3.0f);
     return easedT;
 }
 
@@ -63,7 +63,7 @@ float EaseInOutCubic(float t) {
     if (t < 0.5f) {
         easedT = 4.0f * t * t * t;
     } else {
-        easedT = 1.0f - ::std::powf(-2.0f * t + 2.0f, 3.0f) / 2.0f;
+        easedT = 1.0f - ::std::pow(-2.0f * t + 2.0f, 3.0f) / 2.0f;
     }
     return easedT;
 }
@@ -74,7 +74,7 @@ float EaseInQuart(float t) {
 }
 
 float EaseOutQuart(float t) {
-    float easedT = 1.0f - ::std::powf(1.0f - t, 4.0f);
+    float easedT = 1.0f - ::std::pow(1.0f - t, 4.0f);
     return easedT;
 }
 
@@ -83,7 +83,7 @@ float EaseInOutQuart(float t) {
     if (t < 0.5f) {
         easedT = 8.0f * t * t * t * t;
     } else {
-        easedT = 1.0f - ::std::powf(-2.0f * t + 2.0f, 4.0f) / 2.0f;
+        easedT = 1.0f - ::std::pow(-2.0f * t + 2.0f, 4.0f) / 2.0f;
     }
     return easedT;
 }
@@ -100,7 +100,7 @@ float EaseOutBack(float t) {
     const float c1 = 1.70158f;
     const float c3 = c1 + 1.0f;
 
-    float easedT = 1.0f + c3 * ::std::powf(t - 1.0f, 3.0f) + c1 * ::std::powf(t - 1.0f, 2.0f);
+    float easedT = 1.0f + c3 * ::std::pow(t - 1.0f, 3.0f) + c1 * ::std::pow(t - 1.0f, 2.0f);
     return easedT;
 }
 
@@ -109,9 +109,9 @@ float EaseInOutBack(float t) {
     const float c2 = c1 * 1.525f;
     float easedT   = 0.0f;
     if (t < 0.5f) {
-        easedT = (::std::powf(2.0f * t, 2.0f) * ((c2 + 1.0f) * 2.0f * t - c2)) / 2.0f;
+        easedT = (::std::pow(2.0f * t, 2.0f) * ((c2 + 1.0f) * 2.0f * t - c2)) / 2.0f;
     } else {
-        easedT = (::std::powf(2.0f * t - 2.0f, 2.0f) * ((c2 + 1.0f) * (t * 2.0f - 2.0f) + c2) + 2.0f) / 2.0f;
+        easedT = (::std::pow(2.0f * t - 2.0f, 2.0f) * ((c2 + 1.0f) * (t * 2.0f - 2.0f) + c2) + 2.0f) / 2.0f;
     }
     return easedT;
 }
@@ -124,7 +124,7 @@ float EaseInElastic(float t) {
     } else if (t == 1.0f) {
         easedT = 1.0f;
     } else {
-        easedT = -::std::powf(2.0f, 10.0f * t - 10.0f) * ::std::sinf((t * 10.0f - 10.75f) * c4);
+        easedT = -::std::pow(2.0f, 10.0f * t - 10.0f) * ::std::sin((t * 10.0f - 10.75f) * c4);
     }
 
     return easedT;
@@ -139,7 +139,7 @@ float EaseOutElastic(float t) {
     } else if (t == 1.0f) {
         easedT = 1.0f;
     } else {
-        easedT = ::std::powf(2.0f, -10.0f * t) * ::std::sinf((t * 10.0f - 0.75f) * c4) + 1.0f;
+        easedT = ::std::pow(2.0f, -10.0f * t) * ::std::sin((t * 10.0f - 0.75f) * c4) + 1.0f;
     }
 
     return easedT;
@@ -154,9 +154,9 @@ float EaseInOutElastic(float t) {
     } else if (t == 1.0f) {
         easedT = 1.0f;
     } else if (t < 0.5f) {
-        easedT = -(::std::powf(2.0f, 20.0f * t - 10.0f) * ::std::sinf((20.0f * t - 11.125f) * c5)) / 2.0f;
+        easedT = -(::std::pow(2.0f, 20.0f * t - 10.0f) * ::std::sin((20.0f * t - 11.125f) * c5)) / 2.0f;
     } else {
-        easedT = (::std::powf(2.0f, -20.0f * t + 10.0f) * ::std::sinf((20.0f * t - 11.125f) * c5)) / 2.0f + 1.0f;
+        easedT = (::std::pow(2.0f, -20.0f * t + 10.0f) * ::std::sin((20.0f * t - 11.125f) * c5)) / 2.0f + 1.0f;
     }
     return easedT;
 }
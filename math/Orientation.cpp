@@ -14,8 +14,10 @@ Orientation Orientation::Identity() {
 void Orientation::UpdateAxes() {
     rot = rot.normalize();
 
+    // 行ベクトル (v * M) の規約なので, ローカル軸 e_i のワールドでの向き e_i * M は回転行列の i 行目.
+    // 列を取ると転置 (= 逆回転) の軸になる (tools/collisionBenchmark の --verify で確認できる)
     Matrix4x4 m = MakeMatrix4x4::RotateQuaternion(rot);
-    axis[0]     = Vec3(m[0][0], m[1][0], m[2][0]).normalize();
-    axis[1]     = Vec3(m[0][1], m[1][1], m[2][1]).normalize();
-    axis[2]     = Vec3(m[0][2], m[1][2], m[2][2]).normalize();
+    axis[0]     = Vec3(m[0][0], m[0][1], m[0][2]).normalize();
+    axis[1]     = Vec3(m[1][0], m[1][1], m[1][2]).normalize();
+    axis[2]     = Vec3(m[2][0], m[2][1], m[2][2]).normalize();
 }
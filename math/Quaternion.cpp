@@ -136,7 +136,7 @@ Quaternion Quaternion::RotateAxisAngle(const Vec3f& axis, float angle) {
 }
 
 const Quaternion Quaternion::RotateAxisVector(const Vec3f& from, const Vec3f& to) {
-    float angle = std::acosf(from.dot(to));
+    float angle = std::acos(from.dot(to));
     Vec3f axis  = from.cross(to).normalize();
 
     float halfAngle = angle / 2.0f;
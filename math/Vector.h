@@ -509,7 +509,7 @@ template <int dimension, typename valueType>
 inline constexpr valueType Vector<dimension, valueType>::Dot(const Vector& vec) {
     valueType sum = 0;
     for (int i = 0; i < dim; i++) {
-        sum += v.v[i] * vec.v[i];
+        sum += vec.v[i] * vec.v[i];
     }
     return sum;
 }
@@ -14,6 +14,9 @@
 --        $ .\tools\premake5.exe vs2026
 --        → _standalone/OriGine-Standalone.sln が生成され、Engine だけ
 --          StaticLib としてビルドしてコンパイル確認できる。
+--        Linux では DX12 を使わない CollisionBenchmark だけの workspace になる:
+--        $ premake5 --file=premake.lua gmake2
+--        $ make -C _standalone config=release CollisionBenchmark
 --
 -- ==========================================================================
 
@@ -187,6 +190,193 @@ function defineEngineProjects(engineRoot)
             staticruntime "On"
 end
 
+-- --------------------------------------------------------------------------
+-- ヘッドレスのベンチマーク共通設定
+-- --------------------------------------------------------------------------
+-- Engine の StaticLib にはリンクせず、必要なソースだけを直接コンパイルする ConsoleApp 用。
+-- tools/headless が Engine.h / Scene.h / Logger.h / DirectXMath.h 等を差し替えるので、
+-- include パスの先頭に置くこと。
+-- _DEBUG ではエディタ (imgui) 依存のコードが入るため、全構成を Release 扱いでビルドする。
+-- project の中から呼ぶこと。
+local function applyHeadlessBenchmarkSettings(engineRoot)
+    includedirs {
+        p(engineRoot, "tools/headless"),
+        (engineRoot == "" and "." or engineRoot),
+        p(engineRoot, "code"),
+        p(engineRoot, "code/ECS"),
+        p(engineRoot, "math"),
+        p(engineRoot, "util"),
+        p(engineRoot, "externals"),
+    }
+
+    defines { "NDEBUG", "_RELEASE", "RELEASE" }
+    warnings "Extra"
+
+    filter "configurations:Debug"
+        symbols "On"
+        optimize "Off"
+    filter "configurations:Develop"
+        symbols "On"
+        optimize "On"
+    filter "configurations:Release"
+        optimize "Full"
+
+    filter "system:windows"
+        systemversion "latest"
+        runtime "Release"
+        staticruntime "On"
+        multiprocessorcompile "On"
+        buildoptions { "/utf-8" }
+    filter "system:linux"
+        links { "pthread" }
+    filter {}
+end
+
+-- ヘッドレスのベンチマークがコンパイルする ECS / 衝突判定 / math / util のソース。
+-- project の中から呼ぶこと。
+local function applyHeadlessEcsFiles(engineRoot)
+    files {
+        p(engineRoot, "tools/headless/**.h"),
+        p(engineRoot, "tools/headless/**.cpp"),
+
+        -- ECS
+        p(engineRoot, "code/ECS/entity/*.cpp"),
+        p(engineRoot, "code/ECS/component/ComponentHandle.cpp"),
+        p(engineRoot, "code/ECS/component/ComponentRegistry.cpp"),
+        p(engineRoot, "code/ECS/component/ComponentRepository.cpp"),
+        p(engineRoot, "code/ECS/component/ComponentTypeId.cpp"),
+        p(engineRoot, "code/ECS/component/IComponent.cpp"),
+        p(engineRoot, "code/ECS/system/EntityCommandBuffer.cpp"),
+        p(engineRoot, "code/ECS/system/ISystem.cpp"),
+        p(engineRoot, "code/ECS/system/SystemCategory.cpp"),
+        p(engineRoot, "code/ECS/system/SystemRegistry.cpp"),
+        p(engineRoot, "code/ECS/system/SystemRunner.cpp"),
+        p(engineRoot, "code/ECS/system/SystemScheduler.cpp"),
+        -- component
+        p(engineRoot, "code/ECS/component/transform/Transform.cpp"),
+        p(engineRoot, "code/ECS/component/physics/Rigidbody.cpp"),
+        p(engineRoot, "code/ECS/component/collision/**.cpp"),
+        -- collision
+        p(engineRoot, "code/ECS/system/collision/*.cpp"),
+        -- scene (ECS の部分だけ. 残りは tools/headless/scene)
+        p(engineRoot, "code/scene/SceneEcs.cpp"),
+
+        -- math / util
+        p(engineRoot, "math/*.cpp"),
+        p(engineRoot, "util/StringUtil.cpp"),
+        p(engineRoot, "util/deltaTime/DeltaTimer.cpp"),
+        p(engineRoot, "util/jobSystem/JobSystem.cpp"),
+        p(engineRoot, "util/uuidGenerator/UuidGenerator.cpp"),
+    }
+    -- シーン遷移を伴うシステムは Scene 本体に依存する
+    removefiles { p(engineRoot, "code/ECS/system/collision/CollisionTriggeredSceneTransition*") }
+end
+
+-- --------------------------------------------------------------------------
+-- CollisionBenchmark (ヘッドレスの衝突判定ベンチマーク)
+-- --------------------------------------------------------------------------
+-- ウィンドウも GPU も使わずに CollisionCheckSystem を回す ConsoleApp。
+-- ECS / 衝突判定 / math の必要なソースだけを直接コンパイルする (applyHeadlessEcsFiles)。
+function defineCollisionBenchmarkProject(engineRoot)
+    engineRoot = engineRoot or "engine"
+
+    project "CollisionBenchmark"
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++20"
+        targetdir "../generated/output/%{cfg.buildcfg}/"
+        objdir "../generated/obj/%{cfg.buildcfg}/CollisionBenchmark/"
+
+        files {
+            p(engineRoot, "tools/collisionBenchmark/**.h"),
+            p(engineRoot, "tools/collisionBenchmark/**.cpp"),
+        }
+        applyHeadlessEcsFiles(engineRoot)
+
+        applyHeadlessBenchmarkSettings(engineRoot)
+end
+
+-- --------------------------------------------------------------------------
+-- EcsBenchmark (ヘッドレスの ECS ベンチマーク)
+-- --------------------------------------------------------------------------
+-- コンポーネントの参照などの ECS の基本操作の時間を計測する ConsoleApp。
+function defineEcsBenchmarkProject(engineRoot)
+    engineRoot = engineRoot or "engine"
+
+    project "EcsBenchmark"
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++20"
+        targetdir "../generated/output/%{cfg.buildcfg}/"
+        objdir "../generated/obj/%{cfg.buildcfg}/EcsBenchmark/"
+
+        files {
+            p(engineRoot, "tools/ecsBenchmark/**.h"),
+            p(engineRoot, "tools/ecsBenchmark/**.cpp"),
+            p(engineRoot, "code/ECS/system/movement/MoveSystemByRigidBody.cpp"),
+        }
+        applyHeadlessEcsFiles(engineRoot)
+
+        applyHeadlessBenchmarkSettings(engineRoot)
+end
+
+-- --------------------------------------------------------------------------
+-- AnimationBenchmark (ヘッドレスのキーフレーム検索ベンチマーク)
+-- --------------------------------------------------------------------------
+-- 旧実装の線形走査 / 二分探索 / カーソル付き検索でクリップをサンプリングして比較する ConsoleApp。
+-- --compress では CompressedAnimationData の圧縮率と誤差も出す。
+-- AnimationData.h はヘッダだけなので CompressedAnimationData と math のソースだけをコンパイルする。
+function defineAnimationBenchmarkProject(engineRoot)
+    engineRoot = engineRoot or "engine"
+
+    project "AnimationBenchmark"
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++20"
+        targetdir "../generated/output/%{cfg.buildcfg}/"
+        objdir "../generated/obj/%{cfg.buildcfg}/AnimationBenchmark/"
+
+        files {
+            p(engineRoot, "tools/animationBenchmark/**.h"),
+            p(engineRoot, "tools/animationBenchmark/**.cpp"),
+            p(engineRoot, "tools/headless/**.h"),
+
+            p(engineRoot, "code/ECS/component/animation/AnimationData.h"),
+            p(engineRoot, "code/ECS/component/animation/CompressedAnimationData.h"),
+            p(engineRoot, "code/ECS/component/animation/CompressedAnimationData.cpp"),
+            p(engineRoot, "math/*.cpp"),
+        }
+
+        applyHeadlessBenchmarkSettings(engineRoot)
+end
+
+-- --------------------------------------------------------------------------
+-- MathCheck (ヘッドレスの math の確認ツール)
+-- --------------------------------------------------------------------------
+-- イージングや回転行列, 文字列の変換などを手で求めた値と突き合わせる ConsoleApp。一致しなければ終了コード 2。
+-- math のソースと util/StringUtil.cpp だけをコンパイルする。
+function defineMathCheckProject(engineRoot)
+    engineRoot = engineRoot or "engine"
+
+    project "MathCheck"
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++20"
+        targetdir "../generated/output/%{cfg.buildcfg}/"
+        objdir "../generated/obj/%{cfg.buildcfg}/MathCheck/"
+
+        files {
+            p(engineRoot, "tools/mathCheck/**.h"),
+            p(engineRoot, "tools/mathCheck/**.cpp"),
+            p(engineRoot, "tools/headless/**.h"),
+
+            p(engineRoot, "math/*.cpp"),
+            p(engineRoot, "util/StringUtil.cpp"),
+        }
+
+        applyHeadlessBenchmarkSettings(engineRoot)
+end
+
 -- ==========================================================================
 -- Standalone モード
 -- --------------------------------------------------------------------------
@@ -201,6 +391,15 @@ if _MAIN_SCRIPT == _SCRIPT and _ACTION ~= nil then
         configurations { "Debug", "Develop", "Release" }
         startproject "OriGine"
 
-    -- Engine リポジトリ自身をルートとして全 project を定義
-    defineEngineProjects(".")
+    if os.target() == "windows" then
+        -- Engine リポジトリ自身をルートとして全 project を定義
+        defineEngineProjects(".")
+    else
+        -- DX12 が無い環境ではヘッドレスのベンチマークだけをビルドする
+        startproject "CollisionBenchmark"
+    end
+    defineCollisionBenchmarkProject(".")
+    defineEcsBenchmarkProject(".")
+    defineAnimationBenchmarkProject(".")
+    defineMathCheckProject(".")
 end
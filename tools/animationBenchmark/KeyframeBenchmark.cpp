@@ -0,0 +1,529 @@
+/// <summary>
+/// ヘッドレスのキーフレーム検索ベンチマーク.
+/// 一定レートでサンプリングされたクリップ (関節ごとに scale / rotate / translate の3トラック) を生成し,
+/// 旧実装の線形走査, 二分探索 (CalculateValue::Linear), カーソル付き検索の3通りでサンプリングして
+/// 1サンプルあたりの時間と, 線形走査と結果が一致するかを出力する.
+/// --compress では CompressedAnimationData に圧縮したときのメモリ, 誤差, サンプリング時間を出力する.
+/// </summary>
+
+/// stl
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+/// ECS
+// component
+#include "component/animation/AnimationData.h"
+#include "component/animation/CompressedAnimationData.h"
+
+using namespace OriGine;
+
+namespace {
+
+/// <summary>
+/// コマンドライン引数
+/// </summary>
+struct BenchmarkOptions {
+    std::vector<uint32_t> keyCounts = {30, 300, 3000, 18000}; // 1トラックあたりのキーフレーム数
+    uint32_t joints                 = 80;
+    uint32_t samples                = 600; // 1トラックあたりのサンプル数
+    uint32_t seed                   = 1;
+    float keyRate                   = 30.f; // キーフレームのレート (Hz)
+    float playbackRate              = 60.f; // 再生時のサンプリングレート (Hz)
+    float compressRate              = 30.f; // 圧縮時の再サンプリングのレート (Hz)
+    bool compress                   = false; // 検索の比較の代わりに圧縮のレポートを出す
+    bool csv                        = false;
+};
+
+/// <summary>
+/// サンプリングする時刻の並び方
+/// </summary>
+enum class SamplePattern {
+    Playback, // クリップの途中から一定レートでループ再生する (時刻は前に進み, 終端で先頭へ戻る)
+    Scrub, // ランダムな時刻 (タイムラインのスクラブ)
+
+    Count
+};
+
+/// <summary>
+/// キーフレームの検索方法
+/// </summary>
+enum class SearchMethod {
+    Scan, // 旧実装の線形走査 (基準)
+    Search, // 二分探索
+    Cursor, // カーソル + 二分探索
+
+    Count
+};
+
+const char* SamplePatternToString(SamplePattern _pattern) {
+    return _pattern == SamplePattern::Playback ? "playback" : "scrub";
+}
+
+const char* SearchMethodToString(SearchMethod _method) {
+    switch (_method) {
+    case SearchMethod::Scan:
+        return "scan";
+    case SearchMethod::Search:
+        return "search";
+    case SearchMethod::Cursor:
+        return "cursor";
+    default:
+        return "unknown";
+    }
+}
+
+/// <summary>
+/// 1つのクリップ長, 時刻の並び, 検索方法の組み合わせの結果
+/// </summary>
+struct BenchmarkResult {
+    uint32_t keyCount = 0;
+    SamplePattern pattern;
+    SearchMethod method;
+
+    double nsPerSample = 0.0;
+    double speedup     = 1.0; // 線形走査に対する倍率
+    size_t mismatches  = 0; // 線形走査と値が一致しなかったサンプル数
+};
+
+/// <summary>
+/// サンプリングした1関節分の値
+/// </summary>
+struct JointSample {
+    Vec3f scale;
+    Quaternion rotate;
+    Vec3f translate;
+};
+
+/// <summary>
+/// 旧実装 (CalculateValue::Linear の二分探索化前) の線形走査. 結果の基準と速度の比較に使う.
+/// </summary>
+template <typename T>
+T ScanLinear(const std::vector<Keyframe<T>>& _keyframes, float _time) {
+    if (_keyframes.empty()) {
+        return CalculateValue::DefaultValueTraits<T>::Default();
+    }
+    if (_keyframes.size() == 1 || _time <= _keyframes[0].time) {
+        return _keyframes[0].value;
+    }
+
+    for (size_t index = 0; index < _keyframes.size() - 1; ++index) {
+        size_t nextIndex = index + 1;
+        if (_keyframes[index].time <= _time && _time <= _keyframes[nextIndex].time) {
+            float t = (_time - _keyframes[index].time) / (_keyframes[nextIndex].time - _keyframes[index].time);
+            return CalculateValue::InterpolationTraits<T>::Interpolate(_keyframes[index].value, _keyframes[nextIndex].value, t);
+        }
+    }
+    return _keyframes.back().value;
+}
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "usage: KeyframeBenchmark [options]\n"
+        "  --keys <n[,n...]>  keyframes per track (default: 30,300,3000,18000)\n"
+        "  --joints <n>       joints per clip, 3 tracks each (default: 80)\n"
+        "  --samples <n>      samples per track (default: 600)\n"
+        "  --seed <n>         random seed of the clip and scrub times (default: 1)\n"
+        "  --compress         report CompressedAnimationData memory, error and sampling time instead\n"
+        "  --rate <hz>        resample rate of --compress (default: 30)\n"
+        "  --csv              print results as CSV\n");
+}
+
+bool ParseUint(const char* _text, uint32_t& _out) {
+    const char* end = _text + std::strlen(_text);
+    auto [ptr, ec]  = std::from_chars(_text, end, _out);
+    return ec == std::errc() && ptr == end;
+}
+
+bool ParseUintList(const char* _text, std::vector<uint32_t>& _out) {
+    _out.clear();
+    const char* begin = _text;
+    const char* end   = _text + std::strlen(_text);
+    while (begin < end) {
+        const char* comma = std::find(begin, end, ',');
+        uint32_t value    = 0;
+        auto [ptr, ec]    = std::from_chars(begin, comma, value);
+        if (ec != std::errc() || ptr != comma || value < 2) {
+            return false;
+        }
+        _out.push_back(value);
+        begin = comma + 1;
+    }
+    return !_out.empty();
+}
+
+bool ParseOptions(int _argc, char** _argv, BenchmarkOptions& _out) {
+    for (int i = 1; i < _argc; ++i) {
+        std::string arg = _argv[i];
+        if (arg == "--csv") {
+            _out.csv = true;
+            continue;
+        }
+        if (arg == "--compress") {
+            _out.compress = true;
+            continue;
+        }
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= _argc) {
+            std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const char* value = _argv[++i];
+
+        bool parsed = true;
+        if (arg == "--keys") {
+            parsed = ParseUintList(value, _out.keyCounts);
+        } else if (arg == "--joints") {
+            parsed = ParseUint(value, _out.joints) && _out.joints > 0;
+        } else if (arg == "--samples") {
+            parsed = ParseUint(value, _out.samples) && _out.samples > 0;
+        } else if (arg == "--seed") {
+            parsed = ParseUint(value, _out.seed);
+        } else if (arg == "--rate") {
+            uint32_t rate     = 0;
+            parsed            = ParseUint(value, rate) && rate > 0;
+            _out.compressRate = static_cast<float>(rate);
+        } else {
+            std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return false;
+        }
+        if (!parsed) {
+            std::fprintf(stderr, "invalid value for %s: %s\n", arg.c_str(), value);
+            return false;
+        }
+    }
+    return true;
+}
+
+/// <summary>
+/// 一定レートでサンプリングされたクリップを生成する (値はランダムウォーク)
+/// </summary>
+std::vector<ModelAnimationNode> CreateClip(const BenchmarkOptions& _options, uint32_t _keyCount) {
+    std::mt19937 random(_options.seed);
+    std::uniform_real_distribution<float> step(-0.05f, 0.05f);
+
+    std::vector<ModelAnimationNode> clip(_options.joints);
+    for (ModelAnimationNode& node : clip) {
+        node.scale.reserve(_keyCount);
+        node.rotate.reserve(_keyCount);
+        node.translate.reserve(_keyCount);
+
+        Vec3f scale(1.f, 1.f, 1.f);
+        Quaternion rotate = Quaternion::Identity();
+        Vec3f translate(0.f, 0.f, 0.f);
+        for (uint32_t i = 0; i < _keyCount; ++i) {
+            float time = static_cast<float>(i) / _options.keyRate;
+            node.scale.emplace_back(time, scale);
+            node.rotate.emplace_back(time, rotate);
+            node.translate.emplace_back(time, translate);
+
+            scale += Vec3f(step(random), step(random), step(random)) * 0.1f;
+            rotate = Quaternion::Normalize(rotate + Quaternion(step(random), step(random), step(random), 0.f));
+            translate += Vec3f(step(random), step(random), step(random));
+        }
+    }
+    return clip;
+}
+
+/// <summary>
+/// サンプリングする時刻の列を作る
+/// </summary>
+std::vector<float> CreateSampleTimes(const BenchmarkOptions& _options, SamplePattern _pattern, float _duration) {
+    std::mt19937 random(_options.seed + 1);
+    std::uniform_real_distribution<float> time(0.f, _duration);
+
+    std::vector<float> times(_options.samples);
+    if (_pattern == SamplePattern::Playback) {
+        // 先頭から再生すると長いクリップでも線形走査が先頭付近で終わるので, 再生開始位置はランダムにする
+        float start = time(random);
+        for (uint32_t i = 0; i < _options.samples; ++i) {
+            times[i] = std::fmod(start + static_cast<float>(i) / _options.playbackRate, _duration);
+        }
+    } else {
+        for (float& t : times) {
+            t = time(random);
+        }
+    }
+    return times;
+}
+
+/// <summary>
+/// 全関節を全時刻でサンプリングし, かかった時間 (ns) を返す.
+/// 再生と同じく, 1時刻ごとに全関節をサンプリングする.
+/// </summary>
+double Sample(const std::vector<ModelAnimationNode>& _clip, const std::vector<float>& _times, SearchMethod _method, std::vector<JointSample>& _out) {
+    _out.resize(_clip.size() * _times.size());
+    std::vector<KeyframeCursor> cursors(_clip.size() * 3);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t frame = 0; frame < _times.size(); ++frame) {
+        float time          = _times[frame];
+        JointSample* output = _out.data() + frame * _clip.size();
+        for (size_t joint = 0; joint < _clip.size(); ++joint) {
+            const ModelAnimationNode& node = _clip[joint];
+            JointSample& sample            = output[joint];
+            switch (_method) {
+            case SearchMethod::Scan:
+                sample.scale     = ScanLinear(node.scale, time);
+                sample.rotate    = ScanLinear(node.rotate, time);
+                sample.translate = ScanLinear(node.translate, time);
+                break;
+            case SearchMethod::Search:
+                sample.scale     = CalculateValue::Linear(node.scale, time);
+                sample.rotate    = CalculateValue::Linear(node.rotate, time);
+                sample.translate = CalculateValue::Linear(node.translate, time);
+                break;
+            case SearchMethod::Cursor:
+                sample.scale     = CalculateValue::Linear(node.scale, time, cursors[joint * 3 + 0]);
+                sample.rotate    = CalculateValue::Linear(node.rotate, time, cursors[joint * 3 + 1]);
+                sample.translate = CalculateValue::Linear(node.translate, time, cursors[joint * 3 + 2]);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+size_t CountMismatches(const std::vector<JointSample>& _expected, const std::vector<JointSample>& _actual) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < _expected.size(); ++i) {
+        if (_expected[i].scale != _actual[i].scale
+            || _expected[i].rotate != _actual[i].rotate
+            || _expected[i].translate != _actual[i].translate) {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+void PrintHeader(const BenchmarkOptions& _options) {
+    if (_options.csv) {
+        std::printf("keys,pattern,method,ns_per_sample,speedup,mismatches\n");
+        return;
+    }
+    std::printf("# joints %u (x3 tracks), samples %u, key rate %.0f Hz, playback %.0f Hz, seed %u\n",
+        _options.joints, _options.samples, _options.keyRate, _options.playbackRate, _options.seed);
+    std::printf("%6s %-8s %-6s | %10s %8s | %10s\n", "keys", "pattern", "method", "ns/sample", "speedup", "mismatch");
+}
+
+void PrintResult(const BenchmarkOptions& _options, const BenchmarkResult& _result) {
+    if (_options.csv) {
+        std::printf("%u,%s,%s,%.2f,%.2f,%zu\n",
+            _result.keyCount, SamplePatternToString(_result.pattern), SearchMethodToString(_result.method),
+            _result.nsPerSample, _result.speedup, _result.mismatches);
+        return;
+    }
+    std::printf("%6u %-8s %-6s | %10.2f %7.1fx | %10zu\n",
+        _result.keyCount, SamplePatternToString(_result.pattern), SearchMethodToString(_result.method),
+        _result.nsPerSample, _result.speedup, _result.mismatches);
+}
+
+#pragma region "Compression"
+
+/// <summary>
+/// 人型のキャラクターに近いクリップを生成する.
+/// scale は動かず, translate はルートだけが動き, rotate は関節ごとに周期の違う滑らかな曲線 (末端の一部は動かない).
+/// </summary>
+std::vector<ModelAnimationNode> CreateCharacterClip(const BenchmarkOptions& _options, uint32_t _keyCount) {
+    std::mt19937 random(_options.seed);
+    std::uniform_real_distribution<float> phase(0.f, 6.2831853f);
+    std::uniform_real_distribution<float> frequency(0.5f, 3.f);
+    std::uniform_real_distribution<float> offset(-0.3f, 0.3f);
+
+    std::vector<ModelAnimationNode> clip(_options.joints);
+    for (uint32_t joint = 0; joint < _options.joints; ++joint) {
+        ModelAnimationNode& node = clip[joint];
+        node.scale.reserve(_keyCount);
+        node.rotate.reserve(_keyCount);
+        node.translate.reserve(_keyCount);
+
+        Vec3f boneOffset(offset(random), offset(random) + 0.3f, offset(random));
+        Vec3f axisPhase(phase(random), phase(random), phase(random));
+        Vec3f axisFrequency(frequency(random), frequency(random), frequency(random));
+        bool isStatic = joint % 8 == 7;
+
+        for (uint32_t i = 0; i < _keyCount; ++i) {
+            float time = static_cast<float>(i) / _options.keyRate;
+
+            Vec3f translate = boneOffset;
+            if (joint == 0) {
+                translate = Vec3f(std::sin(time * 2.f) * 0.1f, 1.f + std::sin(time * 4.f) * 0.05f, time * 1.5f);
+            }
+            Quaternion rotate = Quaternion::Identity();
+            if (!isStatic) {
+                rotate = Quaternion::Normalize(Quaternion(
+                    std::sin(time * axisFrequency[X] + axisPhase[X]) * 0.4f,
+                    std::sin(time * axisFrequency[Y] + axisPhase[Y]) * 0.2f,
+                    std::sin(time * axisFrequency[Z] + axisPhase[Z]) * 0.3f,
+                    1.f));
+            }
+
+            node.scale.emplace_back(time, Vec3f(1.f, 1.f, 1.f));
+            node.rotate.emplace_back(time, rotate);
+            node.translate.emplace_back(time, translate);
+        }
+    }
+    return clip;
+}
+
+AnimationData CreateAnimationData(const std::vector<ModelAnimationNode>& _clip, float _duration) {
+    AnimationData animationData(_duration);
+    for (size_t joint = 0; joint < _clip.size(); ++joint) {
+        animationData.animationNodes_["joint" + std::to_string(joint)] = _clip[joint];
+    }
+    return animationData;
+}
+
+/// <summary>
+/// 元のキーフレーム (カーソル付き) と圧縮したもので全関節を全時刻サンプリングし, 1関節あたりの時間 (ns) を返す
+/// </summary>
+void MeasureSampling(const AnimationData& _animationData, const CompressedAnimationData& _compressed, const std::vector<float>& _times, double& _rawNs, double& _compressedNs) {
+    std::vector<const ModelAnimationNode*> nodes;
+    for (const std::string& name : _compressed.GetTrackNames()) {
+        nodes.push_back(&_animationData.animationNodes_.at(name));
+    }
+    std::vector<KeyframeCursor> cursors(nodes.size() * 3);
+    std::vector<JointSample> raw(nodes.size());
+    AnimationPose pose;
+
+    auto start = std::chrono::steady_clock::now();
+    for (float time : _times) {
+        for (size_t joint = 0; joint < nodes.size(); ++joint) {
+            raw[joint].scale     = CalculateValue::Linear(nodes[joint]->scale, time, cursors[joint * 3 + 0]);
+            raw[joint].rotate    = CalculateValue::Linear(nodes[joint]->rotate, time, cursors[joint * 3 + 1]);
+            raw[joint].translate = CalculateValue::Linear(nodes[joint]->translate, time, cursors[joint * 3 + 2]);
+        }
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (float time : _times) {
+        _compressed.SamplePose(time, pose);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double sampleCount = static_cast<double>(_times.size() * nodes.size());
+    _rawNs             = std::chrono::duration<double, std::nano>(middle - start).count() / sampleCount;
+    _compressedNs      = std::chrono::duration<double, std::nano>(end - middle).count() / sampleCount;
+}
+
+/// <summary>
+/// クリップの種類ごとに圧縮し, メモリ, 誤差, サンプリング時間を出力する
+/// </summary>
+void RunCompressionReport(const BenchmarkOptions& _options) {
+    constexpr float kRadToDeg = 57.2957795f;
+
+    if (_options.csv) {
+        std::printf("keys,clip,tracks,frames,animated_scale,animated_rotate,animated_translate,source_bytes,compressed_bytes,ratio,"
+                    "max_scale_error,max_rotate_error_deg,mean_rotate_error_deg,max_translate_error,mean_translate_error,raw_ns_per_joint,compressed_ns_per_joint\n");
+    } else {
+        std::printf("# joints %u, key rate %.0f Hz, resample %.0f Hz, playback %.0f Hz x %u samples, seed %u\n",
+            _options.joints, _options.keyRate, _options.compressRate, _options.playbackRate, _options.samples, _options.seed);
+        std::printf("%6s %-9s %6s | %11s | %10s %10s %6s | %9s %9s %9s %9s | %8s %8s\n",
+            "keys", "clip", "frames", "anim S/R/T", "source KB", "packed KB", "ratio",
+            "maxR deg", "meanR deg", "maxT", "maxS", "raw ns", "pack ns");
+    }
+
+    AnimationCompressionSettings settings;
+    settings.sampleRate = _options.compressRate;
+
+    for (uint32_t keyCount : _options.keyCounts) {
+        float duration = static_cast<float>(keyCount - 1) / _options.keyRate;
+        for (int kind = 0; kind < 2; ++kind) {
+            const char* clipName                 = kind == 0 ? "character" : "walk";
+            std::vector<ModelAnimationNode> clip = kind == 0 ? CreateCharacterClip(_options, keyCount) : CreateClip(_options, keyCount);
+            AnimationData animationData          = CreateAnimationData(clip, duration);
+
+            CompressedAnimationData compressed = CompressedAnimationData::Compress(animationData, settings);
+            AnimationCompressionReport report  = compressed.Measure(animationData);
+
+            double rawNs        = 0.0;
+            double compressedNs = 0.0;
+            MeasureSampling(animationData, compressed, CreateSampleTimes(_options, SamplePattern::Playback, duration), rawNs, compressedNs);
+
+            double ratio = static_cast<double>(report.sourceBytes) / static_cast<double>((std::max)(report.compressedBytes, size_t(1)));
+            if (_options.csv) {
+                std::printf("%u,%s,%u,%u,%u,%u,%u,%zu,%zu,%.2f,%g,%g,%g,%g,%g,%.2f,%.2f\n",
+                    keyCount, clipName, report.trackCount, report.frameCount,
+                    report.animatedScaleCount, report.animatedRotateCount, report.animatedTranslateCount,
+                    report.sourceBytes, report.compressedBytes, ratio,
+                    report.maxScaleError, report.maxRotateError * kRadToDeg, report.meanRotateError * kRadToDeg,
+                    report.maxTranslateError, report.meanTranslateError, rawNs, compressedNs);
+            } else {
+                std::printf("%6u %-9s %6u | %3u/%3u/%3u | %10.1f %10.1f %5.1fx | %9.4f %9.5f %9.2e %9.2e | %8.2f %8.2f\n",
+                    keyCount, clipName, report.frameCount,
+                    report.animatedScaleCount, report.animatedRotateCount, report.animatedTranslateCount,
+                    static_cast<double>(report.sourceBytes) / 1024.0, static_cast<double>(report.compressedBytes) / 1024.0, ratio,
+                    report.maxRotateError * kRadToDeg, report.meanRotateError * kRadToDeg, report.maxTranslateError, report.maxScaleError,
+                    rawNs, compressedNs);
+            }
+            std::fflush(stdout);
+        }
+    }
+}
+
+#pragma endregion
+
+} // namespace
+
+int main(int _argc, char** _argv) {
+    BenchmarkOptions options;
+    if (!ParseOptions(_argc, _argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    if (options.compress) {
+        RunCompressionReport(options);
+        return 0;
+    }
+
+    PrintHeader(options);
+
+    bool allMatched = true;
+    std::vector<JointSample> expected;
+    std::vector<JointSample> actual;
+    for (uint32_t keyCount : options.keyCounts) {
+        std::vector<ModelAnimationNode> clip = CreateClip(options, keyCount);
+        float duration                       = static_cast<float>(keyCount - 1) / options.keyRate;
+
+        for (int p = 0; p < static_cast<int>(SamplePattern::Count); ++p) {
+            SamplePattern pattern    = static_cast<SamplePattern>(p);
+            std::vector<float> times = CreateSampleTimes(options, pattern, duration);
+            double sampleCount       = static_cast<double>(times.size() * clip.size() * 3);
+
+            double scanNs = Sample(clip, times, SearchMethod::Scan, expected);
+
+            for (int m = 0; m < static_cast<int>(SearchMethod::Count); ++m) {
+                BenchmarkResult result;
+                result.keyCount = keyCount;
+                result.pattern  = pattern;
+                result.method   = static_cast<SearchMethod>(m);
+
+                double ns = scanNs;
+                if (result.method != SearchMethod::Scan) {
+                    ns                = Sample(clip, times, result.method, actual);
+                    result.mismatches = CountMismatches(expected, actual);
+                }
+                result.nsPerSample = ns / sampleCount;
+                result.speedup     = scanNs / ns;
+                allMatched         = allMatched && result.mismatches == 0;
+
+                PrintResult(options, result);
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    // 線形走査と値が変わった場合は失敗として返す
+    return allMatched ? 0 : 2;
+}
@@ -0,0 +1,75 @@
+#include "AllocationCounter.h"
+
+/// stl
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<uint64_t> gAllocationCount{0};
+std::atomic<uint64_t> gAllocationBytes{0};
+
+void* CountedAllocate(std::size_t _size) {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    gAllocationBytes.fetch_add(_size, std::memory_order_relaxed);
+    // 0 バイトの確保でも一意なポインタを返す
+    return std::malloc(_size != 0 ? _size : 1);
+}
+} // namespace
+
+OriGine::AllocationSnapshot OriGine::AllocationCounter::GetSnapshot() {
+    return AllocationSnapshot{gAllocationCount.load(std::memory_order_relaxed), gAllocationBytes.load(std::memory_order_relaxed)};
+}
+
+#pragma region "Replaceable allocation functions"
+// アラインメント指定付きの operator new は置き換えない (衝突判定のコードは使っていない)
+
+void* operator new(std::size_t _size) {
+    void* ptr = CountedAllocate(_size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t _size) {
+    void* ptr = CountedAllocate(_size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new(std::size_t _size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(_size);
+}
+
+void* operator new[](std::size_t _size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(_size);
+}
+
+void operator delete(void* _ptr) noexcept {
+    std::free(_ptr);
+}
+
+void operator delete[](void* _ptr) noexcept {
+    std::free(_ptr);
+}
+
+void operator delete(void* _ptr, std::size_t) noexcept {
+    std::free(_ptr);
+}
+
+void operator delete[](void* _ptr, std::size_t) noexcept {
+    std::free(_ptr);
+}
+
+void operator delete(void* _ptr, const std::nothrow_t&) noexcept {
+    std::free(_ptr);
+}
+
+void operator delete[](void* _ptr, const std::nothrow_t&) noexcept {
+    std::free(_ptr);
+}
+
+#pragma endregion
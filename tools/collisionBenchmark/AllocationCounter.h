@@ -0,0 +1,31 @@
+#pragma once
+
+/// stl
+#include <cstddef>
+#include <cstdint>
+
+namespace OriGine {
+
+/// <summary>
+/// ベンチマーク全体の operator new の呼び出し回数と確保バイト数.
+/// AllocationCounter.cpp がグローバルの operator new / delete を置き換えて数える.
+/// </summary>
+struct AllocationSnapshot {
+    uint64_t count = 0; // operator new の呼び出し回数
+    uint64_t bytes = 0; // 確保したバイト数 (解放は差し引かない)
+
+    AllocationSnapshot operator-(const AllocationSnapshot& _other) const {
+        return AllocationSnapshot{count - _other.count, bytes - _other.bytes};
+    }
+};
+
+namespace AllocationCounter {
+
+/// <summary>
+/// 現在までの累計を取得 (複数スレッドからの確保も含む)
+/// </summary>
+AllocationSnapshot GetSnapshot();
+
+} // namespace AllocationCounter
+
+} // namespace OriGine
@@ -0,0 +1,362 @@
+#include "BenchmarkScene.h"
+
+/// stl
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+/// engine
+#include "scene/Scene.h"
+
+/// ECS
+// component
+#include "component/collision/collider/AABBCollider.h"
+#include "component/collision/collider/CapsuleCollider.h"
+#include "component/collision/collider/OBBCollider.h"
+#include "component/collision/collider/RayCollider.h"
+#include "component/collision/collider/SegmentCollider.h"
+#include "component/collision/collider/SphereCollider.h"
+#include "component/collision/CollisionPushBackInfo.h"
+#include "component/ComponentRegistry.h"
+#include "component/physics/Rigidbody.h"
+#include "component/transform/Transform.h"
+
+/// util
+#include "globalVariables/GlobalVariables.h"
+
+/// math
+#include "math/Quaternion.h"
+
+using namespace OriGine;
+
+namespace {
+constexpr float kSphereRadius   = 0.5f;
+constexpr float kAABBHalfSize   = 0.4f;
+constexpr float kCapsuleHalfLen = 0.4f;
+constexpr float kCapsuleRadius  = 0.3f;
+constexpr float kPi             = 3.14159265f;
+
+constexpr const char* kSceneTypeNames[] = {"uniform", "clustered", "corridor", "mixed"};
+static_assert(std::size(kSceneTypeNames) == static_cast<size_t>(BenchmarkSceneType::Count));
+} // namespace
+
+const char* OriGine::BenchmarkSceneTypeToString(BenchmarkSceneType _type) {
+    if (_type >= BenchmarkSceneType::Count) {
+        return "unknown";
+    }
+    return kSceneTypeNames[static_cast<size_t>(_type)];
+}
+
+bool OriGine::BenchmarkSceneTypeFromString(const std::string& _name, BenchmarkSceneType& _outType) {
+    for (size_t i = 0; i < std::size(kSceneTypeNames); ++i) {
+        if (_name == kSceneTypeNames[i]) {
+            _outType = static_cast<BenchmarkSceneType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+BenchmarkScene::BenchmarkScene() {}
+
+BenchmarkScene::~BenchmarkScene() {
+    Finalize();
+}
+
+void BenchmarkScene::RegisterComponents() {
+    ComponentRegistry* registry = ComponentRegistry::GetInstance();
+    registry->RegisterComponent<Transform>();
+    registry->RegisterComponent<Rigidbody>();
+    registry->RegisterComponent<CollisionPushBackInfo>();
+    registry->RegisterComponent<AABBCollider>();
+    registry->RegisterComponent<SphereCollider>();
+    registry->RegisterComponent<OBBCollider>();
+    registry->RegisterComponent<CapsuleCollider>();
+    registry->RegisterComponent<SegmentCollider>();
+    registry->RegisterComponent<RayCollider>();
+
+    // CollisionCheckSystem::Initialize が読む設定値
+    GlobalVariables* gv = GlobalVariables::GetInstance();
+    gv->SetValue<float>("Settings", "Collision", "SpatialHashCellSize", kSpatialHashCellSize);
+}
+
+void BenchmarkScene::Initialize(const BenchmarkSceneDesc& _desc) {
+    Finalize();
+
+    desc_ = _desc;
+    random_.seed(desc_.seed);
+
+    scene_ = std::make_unique<Scene>(BenchmarkSceneTypeToString(desc_.type));
+    scene_->InitializeECS();
+
+    collisionCheckSystem_ = std::make_unique<CollisionCheckSystem>();
+    collisionCheckSystem_->SetScene(scene_.get());
+    collisionCheckSystem_->SetIsActive(true);
+    collisionCheckSystem_->Initialize();
+    collisionCheckSystem_->SetBroadphaseType(desc_.broadphaseType);
+
+    switch (desc_.type) {
+    case BenchmarkSceneType::Uniform:
+        GenerateUniform();
+        break;
+    case BenchmarkSceneType::Clustered:
+        GenerateClustered();
+        break;
+    case BenchmarkSceneType::Corridor:
+        GenerateCorridor();
+        break;
+    case BenchmarkSceneType::Mixed:
+        GenerateMixed();
+        break;
+    default:
+        LOG_ERROR("Unknown benchmark scene type: {}", static_cast<int>(desc_.type));
+        break;
+    }
+
+    // 生成が終わってコンポーネント配列が伸びなくなったので Transform を控えておく
+    for (Body& body : bodies_) {
+        body.transform = scene_->GetComponent<Transform>(body.entity);
+    }
+}
+
+void BenchmarkScene::Finalize() {
+    if (collisionCheckSystem_) {
+        collisionCheckSystem_->Finalize();
+        collisionCheckSystem_.reset();
+    }
+    if (scene_) {
+        scene_->Finalize();
+        scene_.reset();
+    }
+    bodies_.clear();
+    staticCount_ = 0;
+}
+
+BenchmarkFrameStats BenchmarkScene::Step(float _deltaTime) {
+    BenchmarkFrameStats stats;
+
+    auto moveBegin = std::chrono::steady_clock::now();
+    Move(_deltaTime);
+    stats.moveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - moveBegin).count();
+
+    CheckCollision();
+    stats.collision = collisionCheckSystem_->GetStats();
+    return stats;
+}
+
+void BenchmarkScene::Move(float _deltaTime) {
+    for (Body& body : bodies_) {
+        Vec3f& translate = body.transform->translate;
+        translate += body.velocity * _deltaTime;
+
+        // 範囲の外へ向かっている軸だけ反転させる (押し戻しは行わないので, 重なったまま動き続ける)
+        for (int axis = 0; axis < 3; ++axis) {
+            if ((translate[axis] < boundsMin_[axis] && body.velocity[axis] < 0.f)
+                || (translate[axis] > boundsMax_[axis] && body.velocity[axis] > 0.f)) {
+                body.velocity[axis] = -body.velocity[axis];
+            }
+        }
+    }
+}
+
+void BenchmarkScene::CheckCollision() {
+    collisionCheckSystem_->Run();
+}
+
+#pragma region "Generator"
+
+void BenchmarkScene::GenerateUniform() {
+    float side = std::cbrt(static_cast<float>(desc_.colliderCount)) * kBodySpacing;
+    boundsMin_ = Vec3f(0.f, 0.f, 0.f);
+    boundsMax_ = Vec3f(side, side, side);
+
+    for (uint32_t i = 0; i < desc_.colliderCount; ++i) {
+        CreateBody(ShapeType::Sphere, RandomPointInBounds(), RandomVelocity(2.f));
+    }
+}
+
+void BenchmarkScene::GenerateClustered() {
+    // 範囲は一様配置と同じで, 512 個ごとに1つの塊へ集める
+    constexpr uint32_t kBodiesPerCluster = 512;
+    constexpr float kClusterSigma        = 2.5f;
+
+    float side = std::cbrt(static_cast<float>(desc_.colliderCount)) * kBodySpacing;
+    boundsMin_ = Vec3f(0.f, 0.f, 0.f);
+    boundsMax_ = Vec3f(side, side, side);
+
+    uint32_t clusterCount = (std::max)(1u, desc_.colliderCount / kBodiesPerCluster);
+    std::vector<Vec3f> clusterCenters(clusterCount);
+    for (Vec3f& center : clusterCenters) {
+        center = RandomPointInBounds();
+    }
+
+    std::normal_distribution<float> offset(0.f, kClusterSigma);
+    for (uint32_t i = 0; i < desc_.colliderCount; ++i) {
+        const Vec3f& center = clusterCenters[i % clusterCount];
+        Vec3f position(center[X] + offset(random_), center[Y] + offset(random_), center[Z] + offset(random_));
+        for (int axis = 0; axis < 3; ++axis) {
+            position[axis] = std::clamp(position[axis], boundsMin_[axis], boundsMax_[axis]);
+        }
+        CreateBody(ShapeType::Sphere, position, RandomVelocity(1.f));
+    }
+}
+
+void BenchmarkScene::GenerateCorridor() {
+    // 幅 8, 高さ 4 の通路を, 一様配置と同じ密度になる長さだけ伸ばす
+    constexpr float kWidth         = 8.f;
+    constexpr float kHeight        = 4.f;
+    constexpr float kSegmentLength = 16.f; // 壁と床を分割する長さ
+    constexpr float kPillarPitch   = 8.f; // 柱の間隔
+    constexpr float kWallThickness = 0.25f;
+
+    float volume = static_cast<float>(desc_.colliderCount) * kBodySpacing * kBodySpacing * kBodySpacing;
+    float length = (std::max)(kSegmentLength, volume / (kWidth * kHeight));
+    boundsMin_   = Vec3f(0.f, 0.f, -kWidth * 0.5f);
+    boundsMax_   = Vec3f(length, kHeight, kWidth * 0.5f);
+
+    // 左右の壁と床
+    for (float x = 0.f; x < length; x += kSegmentLength) {
+        float halfLength = kSegmentLength * 0.5f;
+        float centerX    = x + halfLength;
+        CreateStaticBox(Vec3f(centerX, kHeight * 0.5f, -kWidth * 0.5f - kWallThickness), Vec3f(halfLength, kHeight * 0.5f, kWallThickness), 0.f);
+        CreateStaticBox(Vec3f(centerX, kHeight * 0.5f, kWidth * 0.5f + kWallThickness), Vec3f(halfLength, kHeight * 0.5f, kWallThickness), 0.f);
+        CreateStaticBox(Vec3f(centerX, -kWallThickness, 0.f), Vec3f(halfLength, kWallThickness, kWidth * 0.5f), 0.f);
+    }
+    // 通路の中の傾いた柱
+    std::uniform_real_distribution<float> lateral(-kWidth * 0.35f, kWidth * 0.35f);
+    std::uniform_real_distribution<float> yaw(0.f, kPi);
+    for (float x = kPillarPitch * 0.5f; x < length; x += kPillarPitch) {
+        CreateStaticBox(Vec3f(x, kHeight * 0.5f, lateral(random_)), Vec3f(0.3f, kHeight * 0.5f, 0.6f), yaw(random_));
+    }
+
+    // 通路に沿って流れる球とカプセル
+    std::uniform_real_distribution<float> speed(1.f, 4.f);
+    std::uniform_real_distribution<float> drift(-0.5f, 0.5f);
+    std::bernoulli_distribution direction(0.5);
+    for (uint32_t i = 0; i < desc_.colliderCount; ++i) {
+        ShapeType shape = (i % 2 == 0) ? ShapeType::Sphere : ShapeType::Capsule;
+        Vec3f velocity(direction(random_) ? speed(random_) : -speed(random_), drift(random_), drift(random_));
+        CreateBody(shape, RandomPointInBounds(), velocity);
+    }
+}
+
+void BenchmarkScene::GenerateMixed() {
+    // 動的コライダー 8 個あたり 1 個の静的な箱を置く
+    constexpr uint32_t kDynamicPerStatic = 8;
+
+    float side = std::cbrt(static_cast<float>(desc_.colliderCount)) * kBodySpacing;
+    boundsMin_ = Vec3f(0.f, 0.f, 0.f);
+    boundsMax_ = Vec3f(side, side, side);
+
+    std::uniform_int_distribution<int> shape(0, static_cast<int>(ShapeType::Count) - 1);
+    for (uint32_t i = 0; i < desc_.colliderCount; ++i) {
+        CreateBody(static_cast<ShapeType>(shape(random_)), RandomPointInBounds(), RandomVelocity(2.f));
+    }
+
+    std::uniform_real_distribution<float> halfSize(0.5f, 2.f);
+    std::uniform_real_distribution<float> yaw(0.f, kPi);
+    for (uint32_t i = 0; i < desc_.colliderCount / kDynamicPerStatic; ++i) {
+        CreateStaticBox(RandomPointInBounds(), Vec3f(halfSize(random_), halfSize(random_), halfSize(random_)), yaw(random_));
+    }
+}
+
+#pragma endregion
+
+void BenchmarkScene::CreateBody(ShapeType _shape, const Vec3f& _position, const Vec3f& _velocity) {
+    static const CollisionCategory kCategory("Default", 1);
+
+    EntityHandle entity = scene_->CreateEntity("Body");
+
+    scene_->AddComponent<Transform>(entity);
+    Transform* transform = scene_->GetComponent<Transform>(entity);
+    transform->translate = _position;
+
+    switch (_shape) {
+    case ShapeType::Sphere: {
+        scene_->AddComponent<SphereCollider>(entity);
+        SphereCollider* collider = scene_->GetComponent<SphereCollider>(entity);
+        collider->SetLocalRadius(kSphereRadius);
+        collider->SetCollisionCategory(kCategory);
+        break;
+    }
+    case ShapeType::AABB: {
+        scene_->AddComponent<AABBCollider>(entity);
+        AABBCollider* collider = scene_->GetComponent<AABBCollider>(entity);
+        *collider->GetLocalShapePtr() = Bounds::AABB(Vec3f(0.f, 0.f, 0.f), Vec3f(kAABBHalfSize, kAABBHalfSize, kAABBHalfSize));
+        collider->SetCollisionCategory(kCategory);
+        break;
+    }
+    case ShapeType::OBB: {
+        std::uniform_real_distribution<float> angle(-kPi, kPi);
+        // Quaternion のコピー代入は暗黙の宣言 (-Wdeprecated-copy) なので, 代入せずにその場で構築する
+        std::construct_at(&transform->rotate, Quaternion::FromEulerAngles(angle(random_), angle(random_), angle(random_)));
+
+        scene_->AddComponent<OBBCollider>(entity);
+        OBBCollider* collider = scene_->GetComponent<OBBCollider>(entity);
+        collider->SetLocalHalfSize(Vec3f(0.5f, 0.3f, 0.4f));
+        collider->SetCollisionCategory(kCategory);
+        break;
+    }
+    case ShapeType::Capsule: {
+        scene_->AddComponent<CapsuleCollider>(entity);
+        CapsuleCollider* collider = scene_->GetComponent<CapsuleCollider>(entity);
+        collider->SetLocalStart(Vec3f(0.f, -kCapsuleHalfLen, 0.f));
+        collider->SetLocalEnd(Vec3f(0.f, kCapsuleHalfLen, 0.f));
+        collider->SetLocalRadius(kCapsuleRadius);
+        collider->SetCollisionCategory(kCategory);
+        break;
+    }
+    default:
+        break;
+    }
+
+    // 押し戻し情報を持たせて, 狭域フェーズで押し戻し量まで計算させる
+    scene_->AddComponent<CollisionPushBackInfo>(entity);
+    scene_->GetComponent<CollisionPushBackInfo>(entity)->SetPushBackType(CollisionPushBackType::PushBack);
+
+    collisionCheckSystem_->AddEntity(entity);
+    bodies_.push_back(Body{entity, nullptr, _velocity});
+}
+
+void BenchmarkScene::CreateStaticBox(const Vec3f& _center, const Vec3f& _halfSize, float _yaw) {
+    static const CollisionCategory kCategory("Default", 1);
+
+    EntityHandle entity = scene_->CreateEntity("Static");
+
+    scene_->AddComponent<Transform>(entity);
+    Transform* transform = scene_->GetComponent<Transform>(entity);
+    transform->translate = _center;
+    std::construct_at(&transform->rotate, Quaternion::RotateAxisAngle(Vec3f(0.f, 1.f, 0.f), _yaw));
+
+    scene_->AddComponent<OBBCollider>(entity);
+    OBBCollider* collider = scene_->GetComponent<OBBCollider>(entity);
+    collider->SetLocalHalfSize(_halfSize);
+    collider->SetCollisionCategory(kCategory);
+    collider->SetStatic(true);
+
+    scene_->AddComponent<CollisionPushBackInfo>(entity);
+    scene_->GetComponent<CollisionPushBackInfo>(entity)->SetPushBackType(CollisionPushBackType::PushBack);
+
+    collisionCheckSystem_->AddEntity(entity);
+    ++staticCount_;
+}
+
+Vec3f BenchmarkScene::RandomPointInBounds() {
+    std::uniform_real_distribution<float> t(0.f, 1.f);
+    Vec3f point;
+    for (int axis = 0; axis < 3; ++axis) {
+        point[axis] = boundsMin_[axis] + (boundsMax_[axis] - boundsMin_[axis]) * t(random_);
+    }
+    return point;
+}
+
+Vec3f BenchmarkScene::RandomVelocity(float _maxSpeed) {
+    std::uniform_real_distribution<float> component(-1.f, 1.f);
+    Vec3f velocity(component(random_), component(random_), component(random_));
+    float length = velocity.length();
+    if (length > 1.f) {
+        velocity = velocity / length;
+    }
+    return velocity * _maxSpeed;
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+/// stl
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/// ECS
+#include "entity/EntityHandle.h"
+// system
+#include "system/collision/CollisionCheckSystem.h"
+
+/// math
+#include "math/Vector3.h"
+
+namespace OriGine {
+
+/// ECS
+class Scene;
+class Transform;
+
+/// <summary>
+/// ベンチマークで生成するコライダーの配置
+/// </summary>
+enum class BenchmarkSceneType {
+    Uniform, // 立方体の中に一様に並べた球
+    Clustered, // 正規分布の塊に集めた球 (1セルあたりのペアが多い)
+    Corridor, // 静的な OBB の壁に囲まれた細長い通路を流れる球とカプセル (静的BVH との判定が多い)
+    Mixed, // Sphere / AABB / OBB / Capsule を混ぜ, 一部を静的にしたもの
+
+    Count
+};
+
+/// <summary>
+/// BenchmarkSceneType の名前 (コマンドライン引数と結果の出力に使う)
+/// </summary>
+const char* BenchmarkSceneTypeToString(BenchmarkSceneType _type);
+
+/// <summary>
+/// 名前から BenchmarkSceneType を取得
+/// </summary>
+/// <returns>見つからなければ false</returns>
+bool BenchmarkSceneTypeFromString(const std::string& _name, BenchmarkSceneType& _outType);
+
+/// <summary>
+/// ベンチマークのシーンの生成条件. 同じ条件なら同じ配置と動きになる.
+/// </summary>
+struct BenchmarkSceneDesc {
+    BenchmarkSceneType type                = BenchmarkSceneType::Uniform;
+    uint32_t colliderCount                 = 4096; // 動的コライダーの数 (通路の壁などの静的コライダーは含まない)
+    uint32_t seed                          = 1;
+    CollisionBroadphaseType broadphaseType = CollisionBroadphaseType::SpatialHash;
+};
+
+/// <summary>
+/// 1フレームの計測結果
+/// </summary>
+struct BenchmarkFrameStats {
+    double moveMs = 0.0; // Transform の移動
+    CollisionCheckStats collision;
+};
+
+/// <summary>
+/// ヘッドレスで CollisionCheckSystem を動かすシーン.
+/// Rigidbody を持たせず, Transform をベンチマーク側で決まった速度で動かす (スリープや連続衝突判定で結果が揺れないようにするため).
+/// </summary>
+class BenchmarkScene {
+public:
+    static constexpr float kSpatialHashCellSize = 2.f;
+    static constexpr float kBodySpacing         = 2.f; // 一様配置での動的コライダーの平均間隔
+
+    BenchmarkScene();
+    ~BenchmarkScene();
+
+    /// <summary>
+    /// 使用するコンポーネントの登録と CollisionCheckSystem の設定値を与える (プロセスで1度だけ呼ぶ)
+    /// </summary>
+    static void RegisterComponents();
+
+    /// <summary>
+    /// シーンを生成する
+    /// </summary>
+    void Initialize(const BenchmarkSceneDesc& _desc);
+
+    /// <summary>
+    /// 生成したエンティティとシステムを破棄する
+    /// </summary>
+    void Finalize();
+
+    /// <summary>
+    /// 1フレーム分動かして衝突判定を行う
+    /// </summary>
+    /// <param name="_deltaTime">経過時間 (秒)</param>
+    BenchmarkFrameStats Step(float _deltaTime);
+
+    /// <summary>
+    /// 動的コライダーを _deltaTime 分動かし, 範囲の外に出たものは速度を反転させる
+    /// </summary>
+    void Move(float _deltaTime);
+
+    /// <summary>
+    /// 衝突判定を1フレーム分行う
+    /// </summary>
+    void CheckCollision();
+
+    const BenchmarkSceneDesc& GetDesc() const { return desc_; }
+    const CollisionCheckStats& GetCollisionStats() const { return collisionCheckSystem_->GetStats(); }
+    size_t GetDynamicCount() const { return bodies_.size(); }
+    size_t GetStaticCount() const { return staticCount_; }
+
+private:
+    /// <summary>
+    /// 動的コライダーの形状
+    /// </summary>
+    enum class ShapeType {
+        Sphere,
+        AABB,
+        OBB,
+        Capsule,
+
+        Count
+    };
+
+    /// <summary>
+    /// ベンチマーク側で動かす動的エンティティ
+    /// </summary>
+    struct Body {
+        EntityHandle entity;
+        Transform* transform = nullptr; // 生成が終わった後に取得する (生成中はコンポーネント配列が伸びるため)
+        Vec3f velocity;
+    };
+
+    void GenerateUniform();
+    void GenerateClustered();
+    void GenerateCorridor();
+    void GenerateMixed();
+
+    /// <summary>
+    /// 動的エンティティを生成する
+    /// </summary>
+    void CreateBody(ShapeType _shape, const Vec3f& _position, const Vec3f& _velocity);
+
+    /// <summary>
+    /// 静的な OBB のエンティティを生成する
+    /// </summary>
+    void CreateStaticBox(const Vec3f& _center, const Vec3f& _halfSize, float _yaw);
+
+    /// <summary>
+    /// 範囲内のランダムな位置
+    /// </summary>
+    Vec3f RandomPointInBounds();
+
+    /// <summary>
+    /// 大きさが _maxSpeed 以下のランダムな速度
+    /// </summary>
+    Vec3f RandomVelocity(float _maxSpeed);
+
+private:
+    BenchmarkSceneDesc desc_;
+    std::mt19937 random_;
+
+    std::unique_ptr<Scene> scene_;
+    std::unique_ptr<CollisionCheckSystem> collisionCheckSystem_;
+
+    std::vector<Body> bodies_;
+    size_t staticCount_ = 0;
+
+    // 動的コライダーが動ける範囲
+    Vec3f boundsMin_ = {0.f, 0.f, 0.f};
+    Vec3f boundsMax_ = {0.f, 0.f, 0.f};
+};
+
+} // namespace OriGine
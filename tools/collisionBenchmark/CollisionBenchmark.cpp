@@ -0,0 +1,334 @@
+/// <summary>
+/// ヘッドレスの衝突判定ベンチマーク.
+/// BenchmarkScene で生成したコライダーを決まった速度で動かしながら CollisionCheckSystem を回し,
+/// フェーズごとの時間, ペア数, 確保回数を出力する. 同じ引数なら同じシーンと動きになる.
+/// </summary>
+
+/// stl
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// benchmark
+#include "AllocationCounter.h"
+#include "BenchmarkScene.h"
+#include "ShapeCheck.h"
+
+/// util
+#include "jobSystem/JobSystem.h"
+
+using namespace OriGine;
+
+namespace {
+
+/// <summary>
+/// コマンドライン引数
+/// </summary>
+struct BenchmarkOptions {
+    std::vector<BenchmarkSceneType> scenes;
+    std::vector<CollisionBroadphaseType> broadphases;
+    std::vector<uint32_t> colliderCounts = {4096};
+    uint32_t frames                      = 300;
+    uint32_t warmupFrames                = 30;
+    uint32_t seed                        = 1;
+    uint32_t threads                     = 0; // 0 なら JobSystem を起動せず, 呼び出したスレッドだけで実行する
+    float deltaTime                      = 1.f / 60.f;
+    bool csv                             = false;
+    bool verify                          = false; // ベンチマークの代わりに形状の判定を期待値と突き合わせる
+};
+
+/// <summary>
+/// 1つのシーンと広域フェーズの組み合わせの結果
+/// </summary>
+struct BenchmarkResult {
+    BenchmarkSceneType scene;
+    CollisionBroadphaseType broadphase;
+    size_t dynamicCount = 0;
+    size_t staticCount  = 0;
+    uint32_t frames     = 0;
+
+    // 1フレームあたりの平均
+    double moveMs           = 0.0;
+    double broadphaseMs     = 0.0;
+    double narrowphaseMs    = 0.0;
+    double candidatePairs   = 0.0;
+    double narrowphaseTasks = 0.0;
+    double contacts         = 0.0;
+    double collisionAllocs  = 0.0;
+    double collisionBytes   = 0.0;
+
+    // 衝突判定 (広域 + 狭域) の1フレームの時間の分布
+    double collisionP50Ms = 0.0;
+    double collisionP95Ms = 0.0;
+    double collisionMaxMs = 0.0;
+};
+
+const char* BroadphaseTypeToString(CollisionBroadphaseType _type) {
+    return _type == CollisionBroadphaseType::DynamicAABBTree ? "tree" : "hash";
+}
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "usage: CollisionBenchmark [options]\n"
+        "  --scene <uniform|clustered|corridor|mixed|all>  generated collider layout (default: all)\n"
+        "  --count <n,...>    dynamic collider counts, comma separated (default: 4096)\n"
+        "  --preset broadphase  uniform and clustered scenes with 1000,10000,50000 colliders (overrides --scene and --count)\n"
+        "  --frames <n>       measured frames (default: 300)\n"
+        "  --warmup <n>       frames run before measuring (default: 30)\n"
+        "  --seed <n>         random seed of the scene generator (default: 1)\n"
+        "  --broadphase <hash|tree|both>  broadphase type (default: both)\n"
+        "  --threads <n>      JobSystem worker count, 0 runs on the calling thread only (default: 0)\n"
+        "  --csv              print results as CSV\n"
+        "  --verify           check rotated OBB axes and hits against known results instead of benchmarking (exit code 2 on mismatch)\n");
+}
+
+bool ParseUint(const char* _text, uint32_t& _out) {
+    const char* end = _text + std::strlen(_text);
+    auto [ptr, ec]  = std::from_chars(_text, end, _out);
+    return ec == std::errc() && ptr == end;
+}
+
+bool ParseUintList(const char* _text, std::vector<uint32_t>& _out) {
+    _out.clear();
+    const char* begin = _text;
+    const char* end   = _text + std::strlen(_text);
+    while (begin < end) {
+        const char* comma = std::find(begin, end, ',');
+        uint32_t value    = 0;
+        auto [ptr, ec]    = std::from_chars(begin, comma, value);
+        if (ec != std::errc() || ptr != comma) {
+            return false;
+        }
+        _out.push_back(value);
+        begin = comma + 1;
+    }
+    return !_out.empty();
+}
+
+bool ParseOptions(int _argc, char** _argv, BenchmarkOptions& _out) {
+    std::string sceneName      = "all";
+    std::string broadphaseName = "both";
+    std::string presetName;
+
+    for (int i = 1; i < _argc; ++i) {
+        std::string arg = _argv[i];
+        if (arg == "--csv") {
+            _out.csv = true;
+            continue;
+        }
+        if (arg == "--verify") {
+            _out.verify = true;
+            continue;
+        }
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= _argc) {
+            std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const char* value = _argv[++i];
+
+        bool parsed = true;
+        if (arg == "--scene") {
+            sceneName = value;
+        } else if (arg == "--broadphase") {
+            broadphaseName = value;
+        } else if (arg == "--count") {
+            parsed = ParseUintList(value, _out.colliderCounts);
+        } else if (arg == "--preset") {
+            presetName = value;
+        } else if (arg == "--frames") {
+            parsed = ParseUint(value, _out.frames) && _out.frames > 0;
+        } else if (arg == "--warmup") {
+            parsed = ParseUint(value, _out.warmupFrames);
+        } else if (arg == "--seed") {
+            parsed = ParseUint(value, _out.seed);
+        } else if (arg == "--threads") {
+            parsed = ParseUint(value, _out.threads);
+        } else {
+            std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return false;
+        }
+        if (!parsed) {
+            std::fprintf(stderr, "invalid value for %s: %s\n", arg.c_str(), value);
+            return false;
+        }
+    }
+
+    // 広域フェーズの比較用の組み合わせ (一様 / 密集 x 1k / 10k / 50k)
+    if (presetName == "broadphase") {
+        _out.scenes         = {BenchmarkSceneType::Uniform, BenchmarkSceneType::Clustered};
+        _out.colliderCounts = {1000, 10000, 50000};
+    } else if (!presetName.empty()) {
+        std::fprintf(stderr, "unknown preset: %s\n", presetName.c_str());
+        return false;
+    } else if (sceneName == "all") {
+        for (int i = 0; i < static_cast<int>(BenchmarkSceneType::Count); ++i) {
+            _out.scenes.push_back(static_cast<BenchmarkSceneType>(i));
+        }
+    } else {
+        BenchmarkSceneType type;
+        if (!BenchmarkSceneTypeFromString(sceneName, type)) {
+            std::fprintf(stderr, "unknown scene: %s\n", sceneName.c_str());
+            return false;
+        }
+        _out.scenes.push_back(type);
+    }
+
+    if (broadphaseName == "hash" || broadphaseName == "both") {
+        _out.broadphases.push_back(CollisionBroadphaseType::SpatialHash);
+    }
+    if (broadphaseName == "tree" || broadphaseName == "both") {
+        _out.broadphases.push_back(CollisionBroadphaseType::DynamicAABBTree);
+    }
+    if (_out.broadphases.empty()) {
+        std::fprintf(stderr, "unknown broadphase: %s\n", broadphaseName.c_str());
+        return false;
+    }
+    return true;
+}
+
+/// <summary>
+/// 昇順に並んだ値の _ratio の位置の値
+/// </summary>
+double Percentile(const std::vector<double>& _sorted, double _ratio) {
+    size_t index = static_cast<size_t>(_ratio * static_cast<double>(_sorted.size() - 1) + 0.5);
+    return _sorted[(std::min)(index, _sorted.size() - 1)];
+}
+
+BenchmarkResult RunBenchmark(const BenchmarkOptions& _options, BenchmarkSceneType _sceneType, uint32_t _colliderCount, CollisionBroadphaseType _broadphase) {
+    BenchmarkSceneDesc desc;
+    desc.type           = _sceneType;
+    desc.colliderCount  = _colliderCount;
+    desc.seed           = _options.seed;
+    desc.broadphaseType = _broadphase;
+
+    BenchmarkScene scene;
+    scene.Initialize(desc);
+
+    // 初回の確保 (作業領域の伸長, 静的BVHの構築) を計測から外す
+    for (uint32_t i = 0; i < _options.warmupFrames; ++i) {
+        scene.Step(_options.deltaTime);
+    }
+
+    BenchmarkResult result;
+    result.scene        = _sceneType;
+    result.broadphase   = _broadphase;
+    result.dynamicCount = scene.GetDynamicCount();
+    result.staticCount  = scene.GetStaticCount();
+    result.frames       = _options.frames;
+
+    std::vector<double> collisionMs;
+    collisionMs.reserve(_options.frames);
+
+    for (uint32_t i = 0; i < _options.frames; ++i) {
+        AllocationSnapshot beforeStep = AllocationCounter::GetSnapshot();
+        BenchmarkFrameStats stats     = scene.Step(_options.deltaTime);
+        AllocationSnapshot afterStep  = AllocationCounter::GetSnapshot();
+
+        // Move は Transform を書き換えるだけで確保しないので, Step 全体の確保を衝突判定の確保とみなす
+        AllocationSnapshot stepAllocs = afterStep - beforeStep;
+
+        result.moveMs           += stats.moveMs;
+        result.broadphaseMs     += stats.collision.broadphaseMs;
+        result.narrowphaseMs    += stats.collision.narrowphaseMs;
+        result.candidatePairs   += static_cast<double>(stats.collision.candidatePairCount);
+        result.narrowphaseTasks += static_cast<double>(stats.collision.narrowphaseTaskCount);
+        result.contacts         += static_cast<double>(stats.collision.contactCount);
+        result.collisionAllocs  += static_cast<double>(stepAllocs.count);
+        result.collisionBytes   += static_cast<double>(stepAllocs.bytes);
+
+        collisionMs.push_back(stats.collision.broadphaseMs + stats.collision.narrowphaseMs);
+    }
+
+    double invFrames = 1.0 / static_cast<double>(_options.frames);
+    result.moveMs           *= invFrames;
+    result.broadphaseMs     *= invFrames;
+    result.narrowphaseMs    *= invFrames;
+    result.candidatePairs   *= invFrames;
+    result.narrowphaseTasks *= invFrames;
+    result.contacts         *= invFrames;
+    result.collisionAllocs  *= invFrames;
+    result.collisionBytes   *= invFrames;
+
+    std::sort(collisionMs.begin(), collisionMs.end());
+    result.collisionP50Ms = Percentile(collisionMs, 0.5);
+    result.collisionP95Ms = Percentile(collisionMs, 0.95);
+    result.collisionMaxMs = collisionMs.back();
+
+    scene.Finalize();
+    return result;
+}
+
+void PrintHeader(const BenchmarkOptions& _options) {
+    if (_options.csv) {
+        std::printf("scene,broadphase,dynamic,static,frames,move_ms,broadphase_ms,narrowphase_ms,collision_p50_ms,collision_p95_ms,collision_max_ms,"
+                    "candidate_pairs,narrowphase_tasks,contacts,collision_allocs,collision_bytes\n");
+        return;
+    }
+    std::string counts;
+    for (uint32_t count : _options.colliderCounts) {
+        counts += (counts.empty() ? "" : ",") + std::to_string(count);
+    }
+    std::printf("# count %s, frames %u (+%u warmup), seed %u, threads %u, dt %.4f\n",
+        counts.c_str(), _options.frames, _options.warmupFrames, _options.seed, _options.threads, _options.deltaTime);
+    std::printf("%-9s %-5s %7s %6s | %8s %8s %8s | %8s %8s %8s | %9s %9s %8s | %8s %10s\n",
+        "scene", "bp", "dynamic", "static", "move", "broad", "narrow", "p50", "p95", "max", "pairs", "tasks", "contacts", "allocs", "bytes");
+}
+
+void PrintResult(const BenchmarkOptions& _options, const BenchmarkResult& _result) {
+    if (_options.csv) {
+        std::printf("%s,%s,%zu,%zu,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.1f,%.1f,%.1f,%.2f,%.1f\n",
+            BenchmarkSceneTypeToString(_result.scene), BroadphaseTypeToString(_result.broadphase),
+            _result.dynamicCount, _result.staticCount, _result.frames,
+            _result.moveMs, _result.broadphaseMs, _result.narrowphaseMs,
+            _result.collisionP50Ms, _result.collisionP95Ms, _result.collisionMaxMs,
+            _result.candidatePairs, _result.narrowphaseTasks, _result.contacts,
+            _result.collisionAllocs, _result.collisionBytes);
+        return;
+    }
+    std::printf("%-9s %-5s %7zu %6zu | %8.3f %8.3f %8.3f | %8.3f %8.3f %8.3f | %9.0f %9.0f %8.0f | %8.2f %10.0f\n",
+        BenchmarkSceneTypeToString(_result.scene), BroadphaseTypeToString(_result.broadphase),
+        _result.dynamicCount, _result.staticCount,
+        _result.moveMs, _result.broadphaseMs, _result.narrowphaseMs,
+        _result.collisionP50Ms, _result.collisionP95Ms, _result.collisionMaxMs,
+        _result.candidatePairs, _result.narrowphaseTasks, _result.contacts,
+        _result.collisionAllocs, _result.collisionBytes);
+}
+
+} // namespace
+
+int main(int _argc, char** _argv) {
+    BenchmarkOptions options;
+    if (!ParseOptions(_argc, _argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+    if (options.verify) {
+        return RunShapeChecks(options.csv) ? 0 : 2;
+    }
+
+    if (options.threads > 0) {
+        JobSystem::GetInstance()->Initialize(options.threads);
+    }
+    BenchmarkScene::RegisterComponents();
+
+    PrintHeader(options);
+    for (BenchmarkSceneType sceneType : options.scenes) {
+        for (uint32_t colliderCount : options.colliderCounts) {
+            for (CollisionBroadphaseType broadphase : options.broadphases) {
+                PrintResult(options, RunBenchmark(options, sceneType, colliderCount, broadphase));
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    if (options.threads > 0) {
+        JobSystem::GetInstance()->Finalize();
+    }
+    return 0;
+}
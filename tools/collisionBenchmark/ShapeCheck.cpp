@@ -0,0 +1,124 @@
+#include "ShapeCheck.h"
+
+/// stl
+#include <cstdio>
+#include <numbers>
+
+/// ECS
+// system
+#include "system/collision/CollisionCheckPairFunc.h"
+#include "system/collision/CollisionCheckUtility.h"
+
+/// math
+#include "math/bounds/OBB.h"
+#include "math/bounds/Sphere.h"
+#include "math/Orientation.h"
+
+namespace OriGine {
+
+namespace {
+
+constexpr float kAxisTolerance = 1e-5f;
+
+bool NearlyEqual(const Vec3f& _a, const Vec3f& _b) {
+    return Vec3f(_a - _b).lengthSq() <= kAxisTolerance;
+}
+
+/// <summary>
+/// 1件の結果を出力する
+/// </summary>
+void PrintCheck(bool _csv, const char* _name, bool _matched) {
+    if (_csv) {
+        std::printf("verify,%s,%d\n", _name, _matched ? 1 : 0);
+    } else {
+        std::printf("verify  %-28s %s\n", _name, _matched ? "ok" : "MISMATCH");
+    }
+}
+
+/// <summary>
+/// 回転後の各軸が期待した向きになるか
+/// </summary>
+bool CheckAxes(bool _csv, const char* _name, const Quaternion& _rot, const Vec3f (&_expected)[3]) {
+    Orientation orientation;
+    orientation.SetRotation(_rot);
+    bool matched = true;
+    for (int i = 0; i < 3; ++i) {
+        matched = matched && NearlyEqual(orientation.axis[i], _expected[i]);
+    }
+    PrintCheck(_csv, _name, matched);
+    return matched;
+}
+
+/// <summary>
+/// OBB 上の最近接点が期待した位置になるか
+/// </summary>
+bool CheckClosestPoint(bool _csv, const char* _name, const Vec3f& _point, const Bounds::OBB& _obb, const Vec3f& _expected) {
+    bool matched = NearlyEqual(ClosestPointOnOBB(_point, _obb), _expected);
+    PrintCheck(_csv, _name, matched);
+    return matched;
+}
+
+/// <summary>
+/// 形状の組が期待通りに当たる / 当たらないか
+/// </summary>
+template <typename ShapeA, typename ShapeB>
+bool CheckHit(bool _csv, const char* _name, const ShapeA& _a, const ShapeB& _b, bool _expectHit) {
+    bool isHit = CheckCollisionPair<ShapeA, ShapeB>(nullptr, EntityHandle(), EntityHandle(), _a, _b, nullptr, nullptr);
+    PrintCheck(_csv, _name, isHit == _expectHit);
+    return isHit == _expectHit;
+}
+
+} // namespace
+
+bool RunShapeChecks(bool _csv) {
+    constexpr float kHalfPi    = std::numbers::pi_v<float> * 0.5f;
+    constexpr float kQuarterPi = std::numbers::pi_v<float> * 0.25f;
+    const float kInvSqrt2      = 1.0f / std::numbers::sqrt2_v<float>;
+
+    const Quaternion rotZ90 = Quaternion::RotateAxisAngle(Vec3f(0.f, 0.f, 1.f), kHalfPi);
+    const Quaternion rotX90 = Quaternion::RotateAxisAngle(Vec3f(1.f, 0.f, 0.f), kHalfPi);
+    const Quaternion rotZ45 = Quaternion::RotateAxisAngle(Vec3f(0.f, 0.f, 1.f), kQuarterPi);
+    // 1つの軸回りの回転では逆回転の軸も符号違いの同じ組になるので, OBB 同士 (SAT) は2軸を合わせた回転で見る
+    const Quaternion rotXZ = Quaternion::RotateAxisAngle(Vec3f(1.f, 0.f, 0.f), 0.5f) * rotZ45;
+
+    bool allMatched = true;
+
+    // ローカル軸はワールドで回転した向きになる (逆回転の向きではない)
+    allMatched &= CheckAxes(_csv, "axes z90", rotZ90, {Vec3f(0.f, 1.f, 0.f), Vec3f(-1.f, 0.f, 0.f), Vec3f(0.f, 0.f, 1.f)});
+    allMatched &= CheckAxes(_csv, "axes x90", rotX90, {Vec3f(1.f, 0.f, 0.f), Vec3f(0.f, 0.f, 1.f), Vec3f(0.f, -1.f, 0.f)});
+    allMatched &= CheckAxes(_csv, "axes z45", rotZ45, {Vec3f(kInvSqrt2, kInvSqrt2, 0.f), Vec3f(-kInvSqrt2, kInvSqrt2, 0.f), Vec3f(0.f, 0.f, 1.f)});
+    // 一般の回転では Quaternion で回した各基底と一致する
+    allMatched &= CheckAxes(_csv, "axes xz", rotXZ, {rotXZ.RotateVector(Vec3f(1.f, 0.f, 0.f)), rotXZ.RotateVector(Vec3f(0.f, 1.f, 0.f)), rotXZ.RotateVector(Vec3f(0.f, 0.f, 1.f))});
+
+    // x 方向に長い箱を z 軸回りに 90 度回すと y 方向に長くなる
+    Bounds::OBB pillar(Vec3f(1.f, 0.f, 0.f), Vec3f(2.f, 0.25f, 0.25f), Orientation::Identity());
+    pillar.orientations_.SetRotation(rotZ90);
+    allMatched &= CheckHit(_csv, "sphere-obb z90 along", Bounds::Sphere(Vec3f(1.f, 1.8f, 0.f), 0.2f), pillar, true);
+    allMatched &= CheckHit(_csv, "sphere-obb z90 across", Bounds::Sphere(Vec3f(2.8f, 0.f, 0.f), 0.2f), pillar, false);
+
+    // 斜めの箱でも長い辺の上だけに当たる
+    Bounds::OBB diagonal(Vec3f(0.f, 0.f, 0.f), Vec3f(2.f, 0.1f, 0.1f), Orientation::Identity());
+    diagonal.orientations_.SetRotation(rotZ45);
+    allMatched &= CheckHit(_csv, "sphere-obb z45 along", Bounds::Sphere(Vec3f(1.2f, 1.2f, 0.f), 0.1f), diagonal, true);
+    allMatched &= CheckHit(_csv, "sphere-obb z45 across", Bounds::Sphere(Vec3f(1.2f, -1.2f, 0.f), 0.1f), diagonal, false);
+
+    // 長い辺の上の点と, そこから細い辺の方向へ外した点 (向きは UpdateAxes を通さず Quaternion で求める)
+    Bounds::OBB slanted(Vec3f(0.f, 0.f, 0.f), Vec3f(2.f, 0.1f, 0.1f), Orientation::Identity());
+    slanted.orientations_.SetRotation(rotXZ);
+    Vec3f alongLong = rotXZ.RotateVector(Vec3f(1.f, 0.f, 0.f)) * 1.5f;
+    Vec3f offThin   = alongLong + rotXZ.RotateVector(Vec3f(0.f, 1.f, 0.f)) * 0.3f;
+    allMatched &= CheckHit(_csv, "obb-obb xz along", Bounds::OBB(alongLong, Vec3f(0.1f, 0.1f, 0.1f), Orientation::Identity()), slanted, true);
+    allMatched &= CheckHit(_csv, "obb-obb xz off", Bounds::OBB(offThin, Vec3f(0.1f, 0.1f, 0.1f), Orientation::Identity()), slanted, false);
+    allMatched &= CheckHit(_csv, "sphere-obb xz along", Bounds::Sphere(alongLong, 0.1f), slanted, true);
+    allMatched &= CheckHit(_csv, "sphere-obb xz off", Bounds::Sphere(offThin, 0.1f), slanted, false);
+
+    // 長い辺の先の点は長い辺の端へ寄せられ, 細い辺の範囲内のずれはそのまま残る
+    Vec3f thinOffset = rotXZ.RotateVector(Vec3f(0.f, 0.f, 1.f)) * 0.05f;
+    Vec3f beyondEnd  = rotXZ.RotateVector(Vec3f(1.f, 0.f, 0.f)) * 5.f + thinOffset;
+    Vec3f longEnd    = rotXZ.RotateVector(Vec3f(1.f, 0.f, 0.f)) * 2.f + thinOffset;
+    allMatched &= CheckClosestPoint(_csv, "closest point xz", beyondEnd, slanted, longEnd);
+
+    return allMatched;
+}
+
+} // namespace OriGine
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace OriGine {
+
+/// <summary>
+/// 回転を知っている OBB で, 軸 (Orientation::UpdateAxes) と Sphere / OBB との当たりを期待値と突き合わせる.
+/// 結果を1件ずつ出力し, 全て一致すれば true.
+/// </summary>
+/// <param name="_csv">CSV で出力するか</param>
+bool RunShapeChecks(bool _csv);
+
+} // namespace OriGine
@@ -0,0 +1,757 @@
+/// <summary>
+/// ヘッドレスの ECS ベンチマーク.
+/// lookup: GetComponent<T> の型からコンポーネント配列を引く処理を, 旧実装の型名 (std::string) のマップ,
+///         std::type_index のマップ, ComponentTypeId の配列の3通りで比較する.
+/// update: MoveSystemByRigidBody と CollisionPushBackSystem の1フレームの時間を, 登録順に UpdateEntity を呼ぶ現在の実装と
+///         クエリ (コンポーネント配列の順) で列挙する実装で比較する.
+/// commands: 並列更新中に記録した構造変更の反映結果を逐次実行と比較する.
+/// sleep: 眠りを有効にした MoveSystemByRigidBody で, 止まっている物体だけが眠り, Transform を書き換えて
+///        動かしている物体は眠らないことを確かめる.
+/// 同じ引数なら同じエンティティと参照順になる.
+/// </summary>
+
+/// stl
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+/// engine
+#include "Engine.h"
+#include "scene/Scene.h"
+
+/// ECS
+// component
+#include "component/collision/CollisionPushBackInfo.h"
+#include "component/collision/collider/AABBCollider.h"
+#include "component/collision/collider/CapsuleCollider.h"
+#include "component/collision/collider/OBBCollider.h"
+#include "component/collision/collider/SphereCollider.h"
+#include "component/physics/Rigidbody.h"
+#include "component/transform/Transform.h"
+// system
+#include "system/collision/CollisionPushBackSystem.h"
+#include "system/movement/MoveSystemByRigidBody.h"
+#include "system/SystemRunner.h"
+
+/// util
+#include "globalVariables/GlobalVariables.h"
+#include "jobSystem/JobSystem.h"
+
+using namespace OriGine;
+
+namespace {
+
+/// <summary>
+/// ベンチマークの種類
+/// </summary>
+enum class BenchmarkType {
+    Lookup, // GetComponent<T> の型の解決
+    Update, // エンティティ順とクエリ順のシステムの更新
+    Commands, // 並列更新中に記録したコマンドの反映順
+    Sleep, // 眠りの判定
+
+    Count
+};
+
+const char* BenchmarkTypeToString(BenchmarkType _type) {
+    switch (_type) {
+    case BenchmarkType::Lookup:
+        return "lookup";
+    case BenchmarkType::Update:
+        return "update";
+    case BenchmarkType::Commands:
+        return "commands";
+    case BenchmarkType::Sleep:
+        return "sleep";
+    default:
+        return "unknown";
+    }
+}
+
+/// <summary>
+/// コマンドライン引数
+/// </summary>
+struct BenchmarkOptions {
+    std::vector<BenchmarkType> benchmarks;
+    std::vector<uint32_t> entityCounts = {10000, 50000, 100000};
+    uint32_t repeat                    = 10; // 計測の繰り返し回数 (最速の回を採る)
+    uint32_t seed                      = 1;
+    uint32_t threadCount               = 4; // commands で使う JobSystem のスレッド数 (呼び出し元を含む)
+    float deltaTime                    = 1.f / 60.f;
+    bool csv                           = false;
+};
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "usage: EcsBenchmark [options]\n"
+        "  --bench <lookup|update|commands|sleep|all>  benchmark to run (default: all)\n"
+        "  --entities <n,...>    entity counts, comma separated (default: 10000,50000,100000)\n"
+        "  --repeat <n>          measured repetitions, the fastest is reported (default: 10)\n"
+        "  --seed <n>            random seed of the access order and initial state (default: 1)\n"
+        "  --threads <n>         job system threads for commands, including the caller (default: 4)\n"
+        "  --csv                 print results as CSV\n");
+}
+
+bool ParseUint(const char* _text, uint32_t& _out) {
+    const char* end = _text + std::strlen(_text);
+    auto [ptr, ec]  = std::from_chars(_text, end, _out);
+    return ec == std::errc() && ptr == end;
+}
+
+bool ParseUintList(const char* _text, std::vector<uint32_t>& _out) {
+    _out.clear();
+    const char* begin = _text;
+    const char* end   = _text + std::strlen(_text);
+    while (begin < end) {
+        const char* comma = std::find(begin, end, ',');
+        uint32_t value    = 0;
+        auto [ptr, ec]    = std::from_chars(begin, comma, value);
+        if (ec != std::errc() || ptr != comma || value == 0) {
+            return false;
+        }
+        _out.push_back(value);
+        begin = comma + 1;
+    }
+    return !_out.empty();
+}
+
+bool ParseOptions(int _argc, char** _argv, BenchmarkOptions& _out) {
+    std::string benchmarkName = "all";
+
+    for (int i = 1; i < _argc; ++i) {
+        std::string arg = _argv[i];
+        if (arg == "--csv") {
+            _out.csv = true;
+            continue;
+        }
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= _argc) {
+            std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const char* value = _argv[++i];
+
+        bool parsed = true;
+        if (arg == "--bench") {
+            benchmarkName = value;
+        } else if (arg == "--entities") {
+            parsed = ParseUintList(value, _out.entityCounts);
+        } else if (arg == "--repeat") {
+            parsed = ParseUint(value, _out.repeat) && _out.repeat > 0;
+        } else if (arg == "--seed") {
+            parsed = ParseUint(value, _out.seed);
+        } else if (arg == "--threads") {
+            parsed = ParseUint(value, _out.threadCount) && _out.threadCount > 0;
+        } else {
+            std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return false;
+        }
+        if (!parsed) {
+            std::fprintf(stderr, "invalid value for %s: %s\n", arg.c_str(), value);
+            return false;
+        }
+    }
+
+    for (int i = 0; i < static_cast<int>(BenchmarkType::Count); ++i) {
+        BenchmarkType type = static_cast<BenchmarkType>(i);
+        if (benchmarkName == "all" || benchmarkName == BenchmarkTypeToString(type)) {
+            _out.benchmarks.push_back(type);
+        }
+    }
+    if (_out.benchmarks.empty()) {
+        std::fprintf(stderr, "unknown benchmark: %s\n", benchmarkName.c_str());
+        return false;
+    }
+    return true;
+}
+
+/// <summary>
+/// _function を _repeat 回実行し, 最速の時間 (ms) を返す
+/// </summary>
+template <typename Function>
+double MeasureBestMs(uint32_t _repeat, Function&& _function) {
+    double best = 0.0;
+    for (uint32_t i = 0; i < _repeat; ++i) {
+        auto start     = std::chrono::steady_clock::now();
+        _function();
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best           = (i == 0) ? elapsed : (std::min)(best, elapsed);
+    }
+    return best;
+}
+
+void RegisterComponents() {
+    ComponentRegistry* registry = ComponentRegistry::GetInstance();
+    registry->RegisterComponent<Transform>();
+    registry->RegisterComponent<Rigidbody>();
+    registry->RegisterComponent<AABBCollider>();
+    registry->RegisterComponent<SphereCollider>();
+    registry->RegisterComponent<OBBCollider>();
+    registry->RegisterComponent<CapsuleCollider>();
+    registry->RegisterComponent<CollisionPushBackInfo>();
+
+    // MoveSystemByRigidBody が読む設定値 (眠りは sleep の間だけ有効にする)
+    GlobalVariables* gv = GlobalVariables::GetInstance();
+    gv->SetValue<float>("Settings", "Physics", "Gravity", 9.8f);
+    gv->SetValue<int32_t>("Settings", "Physics", "SleepFrameCount", 0);
+}
+
+#pragma region "Lookup"
+
+/// <summary>
+/// 旧実装の GetComponent<T> と同じく, 呼び出しごとに型名を作ってマップを引く
+/// </summary>
+class LegacyNameLookup {
+public:
+    explicit LegacyNameLookup(ComponentRepository* _repository) {
+        for (auto& [typeName, componentArray] : _repository->GetComponentArrayMapRef()) {
+            componentArrays_[typeName] = componentArray.get();
+        }
+    }
+
+    template <IsComponent ComponentType>
+    ComponentType* GetComponent(const EntityHandle& _handle) {
+        std::string typeName = nameof<ComponentType>();
+        auto itr             = componentArrays_.find(typeName);
+        if (itr == componentArrays_.end()) {
+            return nullptr;
+        }
+        return static_cast<ComponentArray<ComponentType>*>(itr->second)->GetComponent(_handle);
+    }
+
+private:
+    std::unordered_map<std::string, IComponentArray*> componentArrays_;
+};
+
+/// <summary>
+/// std::type_index をキーにしたマップで引く (文字列を作らない場合の比較用)
+/// </summary>
+class TypeIndexLookup {
+public:
+    explicit TypeIndexLookup(ComponentRepository* _repository) {
+        componentArrays_[std::type_index(typeid(Transform))] = _repository->GetComponentArray<Transform>();
+        componentArrays_[std::type_index(typeid(Rigidbody))] = _repository->GetComponentArray<Rigidbody>();
+    }
+
+    template <IsComponent ComponentType>
+    ComponentType* GetComponent(const EntityHandle& _handle) {
+        auto itr = componentArrays_.find(std::type_index(typeid(ComponentType)));
+        if (itr == componentArrays_.end()) {
+            return nullptr;
+        }
+        return static_cast<ComponentArray<ComponentType>*>(itr->second)->GetComponent(_handle);
+    }
+
+private:
+    std::unordered_map<std::type_index, IComponentArray*> componentArrays_;
+};
+
+/// <summary>
+/// ComponentRepository::GetComponent<T> をそのまま呼ぶ (ComponentTypeId の配列で引く)
+/// </summary>
+struct RepositoryLookup {
+    ComponentRepository* repository = nullptr;
+
+    template <IsComponent ComponentType>
+    ComponentType* GetComponent(const EntityHandle& _handle) {
+        return repository->GetComponent<ComponentType>(_handle);
+    }
+};
+
+/// <summary>
+/// Transform と Rigidbody を交互に引き, 見つかったコンポーネントのアドレスを混ぜた値を返す (3通りの結果の照合用)
+/// </summary>
+template <typename Lookup>
+uintptr_t LookupAll(Lookup& _lookup, const std::vector<EntityHandle>& _handles) {
+    uintptr_t checksum = 0;
+    for (const EntityHandle& handle : _handles) {
+        checksum = checksum * 31 + reinterpret_cast<uintptr_t>(_lookup.template GetComponent<Transform>(handle));
+        checksum = checksum * 31 + reinterpret_cast<uintptr_t>(_lookup.template GetComponent<Rigidbody>(handle));
+    }
+    return checksum;
+}
+
+/// <returns>3通りの結果が一致すれば true</returns>
+bool RunLookupBenchmark(const BenchmarkOptions& _options, uint32_t _entityCount) {
+    Scene scene("LookupBenchmark");
+    scene.InitializeECS();
+
+    std::vector<EntityHandle> handles;
+    handles.reserve(_entityCount);
+    for (uint32_t i = 0; i < _entityCount; ++i) {
+        EntityHandle handle = scene.CreateEntity("Entity");
+        scene.AddComponent<Transform>(handle);
+        scene.AddComponent<Rigidbody>(handle);
+        handles.push_back(handle);
+    }
+    // 生成順に引くとコンポーネントの配置順と一致して実際より速く見えるため, 参照順を並べ替える
+    std::mt19937 random(_options.seed);
+    std::shuffle(handles.begin(), handles.end(), random);
+
+    ComponentRepository* repository = scene.GetComponentRepositoryRef();
+    LegacyNameLookup nameLookup(repository);
+    TypeIndexLookup typeIndexLookup(repository);
+    RepositoryLookup idLookup{repository};
+
+    uintptr_t nameChecksum      = 0;
+    uintptr_t typeIndexChecksum = 0;
+    uintptr_t idChecksum        = 0;
+    double nameMs               = MeasureBestMs(_options.repeat, [&]() { nameChecksum = LookupAll(nameLookup, handles); });
+    double typeIndexMs          = MeasureBestMs(_options.repeat, [&]() { typeIndexChecksum = LookupAll(typeIndexLookup, handles); });
+    double idMs                 = MeasureBestMs(_options.repeat, [&]() { idChecksum = LookupAll(idLookup, handles); });
+
+    bool matched          = nameChecksum == idChecksum && typeIndexChecksum == idChecksum;
+    double lookupCount    = static_cast<double>(handles.size()) * 2.0;
+    const char* names[]   = {"string", "type_index", "type_id"};
+    const double timeMs[] = {nameMs, typeIndexMs, idMs};
+    for (int i = 0; i < 3; ++i) {
+        double nsPerLookup = timeMs[i] * 1e6 / lookupCount;
+        if (_options.csv) {
+            std::printf("lookup,%u,%s,%.4f,%.2f,%.2f,%d\n", _entityCount, names[i], timeMs[i], nsPerLookup, nameMs / timeMs[i], matched ? 1 : 0);
+        } else {
+            std::printf("%-8s %9u %-10s | %10.3f %10.2f %7.1fx | %s\n",
+                "lookup", _entityCount, names[i], timeMs[i], nsPerLookup, nameMs / timeMs[i], matched ? "ok" : "MISMATCH");
+        }
+    }
+
+    scene.Finalize();
+    return matched;
+}
+
+#pragma endregion
+
+#pragma region "Update"
+
+/// <summary>
+/// MoveSystemByRigidBody の更新を, Transform と Rigidbody のクエリで列挙して行う (比較用).
+/// 眠り判定は元の Update と同じく先に行う
+/// </summary>
+class QueryMoveSystem
+    : public MoveSystemByRigidBody {
+public:
+    void Update() override {
+        if (entities_.empty()) {
+            return;
+        }
+        EraseDeadEntity();
+        UpdateSleep();
+
+        auto query = Query<Transform, Rigidbody>();
+        ParallelFor(query.GetDriveSize(), [this, &query](uint32_t _begin, uint32_t _end) {
+            query.ForEach(_begin, _end, [this](const EntityHandle& _handle, Transform& _transform, Rigidbody& _rigidbody) {
+                if (HasEntity(_handle)) {
+                    UpdateRigidbody(_transform, _rigidbody);
+                }
+            });
+        });
+    }
+};
+
+/// <summary>
+/// CollisionPushBackSystem の更新を, CollisionPushBackInfo と Transform のクエリで列挙して行う (比較用)
+/// </summary>
+class QueryPushBackSystem
+    : public CollisionPushBackSystem {
+public:
+    void Update() override {
+        if (entities_.empty()) {
+            return;
+        }
+        EraseDeadEntity();
+
+        Query<CollisionPushBackInfo, Transform>().ForEach(
+            [this](const EntityHandle& _handle, CollisionPushBackInfo& _pushBackInfo, Transform& _transform) {
+                if (!HasEntity(_handle)) {
+                    return;
+                }
+                if (HasComponent<Rigidbody>(_handle) && GetComponent<Rigidbody>(_handle)->IsSleeping()) {
+                    return;
+                }
+                PushBack(_handle, _pushBackInfo, _transform);
+            });
+    }
+};
+
+/// <summary>
+/// Transform / Rigidbody / CollisionPushBackInfo を持つエンティティを生成し,
+/// MoveSystemType と PushBackSystemType を --repeat 回更新して最速の1フレームの時間 (ms) を返す.
+/// 4体に1体は uuid だけのHandleで登録し, 実行時インデックスを持つHandleと同じく更新されることを確かめる.
+/// 更新後の位置を _outTranslates に生成順に書き出す.
+/// </summary>
+template <typename MoveSystemType, typename PushBackSystemType>
+double MeasureSystemUpdate(const BenchmarkOptions& _options, uint32_t _entityCount, std::vector<Vec3f>& _outTranslates) {
+    Scene scene("UpdateBenchmark");
+    scene.InitializeECS();
+
+    MoveSystemType moveSystem;
+    PushBackSystemType pushBackSystem;
+    ISystem* systems[] = {&moveSystem, &pushBackSystem};
+    for (ISystem* system : systems) {
+        system->SetScene(&scene);
+        system->SetIsActive(true);
+        system->Initialize();
+    }
+
+    std::mt19937 random(_options.seed);
+    std::uniform_real_distribution<float> position(-100.f, 100.f);
+    std::uniform_real_distribution<float> velocity(-5.f, 5.f);
+
+    std::vector<EntityHandle> handles;
+    handles.reserve(_entityCount);
+    for (uint32_t i = 0; i < _entityCount; ++i) {
+        EntityHandle handle = scene.CreateEntity("Body");
+        scene.AddComponent<Transform>(handle);
+        scene.AddComponent<Rigidbody>(handle);
+        scene.AddComponent<CollisionPushBackInfo>(handle);
+
+        scene.GetComponent<Transform>(handle)->translate = Vec3f(position(random), position(random), position(random));
+        scene.GetComponent<Rigidbody>(handle)->SetVelocity(Vec3f(velocity(random), velocity(random), velocity(random)));
+        const EntityHandle registerHandle = (i % 4 == 0) ? EntityHandle(handle.uuid) : handle;
+        for (ISystem* system : systems) {
+            system->AddEntity(registerHandle);
+        }
+        handles.push_back(handle);
+    }
+
+    double bestMs = MeasureBestMs(_options.repeat, [&]() {
+        for (ISystem* system : systems) {
+            system->Update();
+        }
+    });
+
+    _outTranslates.clear();
+    for (const EntityHandle& handle : handles) {
+        _outTranslates.push_back(scene.GetComponent<Transform>(handle)->translate);
+    }
+
+    for (ISystem* system : systems) {
+        system->Finalize();
+    }
+    scene.Finalize();
+    return bestMs;
+}
+
+/// <returns>2通りの更新後の位置が一致すれば true</returns>
+bool RunUpdateBenchmark(const BenchmarkOptions& _options, uint32_t _entityCount) {
+    Engine::GetInstance()->GetDeltaTimer()->SetDeltaTime(_options.deltaTime);
+
+    std::vector<Vec3f> entityTranslates;
+    std::vector<Vec3f> queryTranslates;
+    double entityMs = MeasureSystemUpdate<MoveSystemByRigidBody, CollisionPushBackSystem>(_options, _entityCount, entityTranslates);
+    double queryMs  = MeasureSystemUpdate<QueryMoveSystem, QueryPushBackSystem>(_options, _entityCount, queryTranslates);
+
+    // 同じ初期状態から同じ回数だけ更新しているので, 位置はビット単位で一致する (読み飛ばされたエンティティがあれば一致しない)
+    bool matched = entityTranslates.size() == queryTranslates.size()
+                && std::memcmp(entityTranslates.data(), queryTranslates.data(), entityTranslates.size() * sizeof(Vec3f)) == 0;
+
+    const char* names[]   = {"entity", "query"};
+    const double timeMs[] = {entityMs, queryMs};
+    for (int i = 0; i < 2; ++i) {
+        double nsPerEntity = timeMs[i] * 1e6 / static_cast<double>(_entityCount);
+        if (_options.csv) {
+            std::printf("update,%u,%s,%.4f,%.2f,%.2f,%d\n", _entityCount, names[i], timeMs[i], nsPerEntity, entityMs / timeMs[i], matched ? 1 : 0);
+        } else {
+            std::printf("%-8s %9u %-10s | %10.3f %10.2f %7.1fx | %s\n",
+                "update", _entityCount, names[i], timeMs[i], nsPerEntity, entityMs / timeMs[i], matched ? "ok" : "MISMATCH");
+        }
+    }
+    return matched;
+}
+
+#pragma endregion
+
+#pragma region "Commands"
+
+/// <summary>
+/// UpdateEntity で構造変更 (生成, 追加, 削除予約) をコマンドバッファに記録するシステム.
+/// Transform::translate.x にエンティティの通し番号を入れておき, 反映された順番を番号で追えるようにする
+/// </summary>
+class CommandRecordSystem
+    : public ISystem {
+public:
+    CommandRecordSystem() : ISystem(SystemCategory::Movement) {
+        DeclareRead<Transform>();
+        // 分割を細かくして, 記録がスレッドをまたいで入り混じるようにする
+        EnableParallelUpdate(16);
+    }
+
+    void Initialize() override {}
+    void Finalize() override {}
+
+    /// <summary>
+    /// 生成されたエンティティの元の通し番号 (反映順)
+    /// </summary>
+    std::vector<uint32_t> createdLog;
+
+protected:
+    void UpdateEntity(const EntityHandle& _handle) override {
+        Transform* transform = GetComponent<Transform>(_handle);
+        if (transform == nullptr) {
+            return;
+        }
+        uint32_t serial                    = static_cast<uint32_t>(transform->translate[X]);
+        EntityCommandBuffer* commandBuffer = GetCommandBuffer();
+
+        if (serial % 2 == 0) {
+            commandBuffer->CreateEntity("Spawned", false, [this, serial](Scene* _scene, const EntityHandle& _entity) {
+                createdLog.push_back(serial);
+                _scene->AddComponent<Transform>(_entity);
+                _scene->GetComponent<Transform>(_entity)->translate[X] = static_cast<float>(serial);
+            });
+        }
+        if (serial % 3 == 0) {
+            commandBuffer->AddComponent<Rigidbody>(_handle);
+        }
+        if (serial % 5 == 0) {
+            commandBuffer->AddDeleteEntity(_handle);
+        }
+    }
+};
+
+/// <summary>
+/// 構造変更を反映した結果. 生成のコールバックの順, 追加された Rigidbody の並び, 生き残った Transform の並びを通し番号で持つ
+/// </summary>
+struct CommandResult {
+    std::vector<uint32_t> createdSerials;
+    std::vector<uint32_t> rigidbodySerials;
+    std::vector<uint32_t> transformSerials;
+
+    bool operator==(const CommandResult&) const = default;
+};
+
+/// <summary>
+/// 通し番号付きのエンティティを生成して CommandRecordSystem を更新し, 最後のフレームのコマンドを反映した結果を返す.
+/// それより前のフレームで記録したコマンドは反映せずに捨てる (時間の計測用).
+/// </summary>
+/// <param name="_outMs">Update (記録まで) にかかった最速の時間</param>
+CommandResult RecordAndExecuteCommands(uint32_t _entityCount, bool _isParallel, uint32_t _repeat, double& _outMs) {
+    Scene scene("CommandBenchmark");
+    scene.InitializeECS();
+
+    CommandRecordSystem system;
+    system.SetScene(&scene);
+    system.SetIsActive(true);
+    system.SetParallelUpdate(_isParallel);
+    system.Initialize();
+
+    for (uint32_t i = 0; i < _entityCount; ++i) {
+        EntityHandle handle = scene.CreateEntity("Entity");
+        scene.AddComponent<Transform>(handle);
+        scene.GetComponent<Transform>(handle)->translate[X] = static_cast<float>(i);
+        system.AddEntity(handle);
+    }
+
+    EntityCommandBuffer* commandBuffer = scene.GetSystemRunnerRef()->GetCommandBufferRef();
+    _outMs = MeasureBestMs(_repeat, [&]() {
+        commandBuffer->Clear();
+        system.Update();
+    });
+
+    commandBuffer->Execute(&scene);
+    scene.ExecuteDeleteEntities();
+
+    CommandResult result;
+    result.createdSerials = system.createdLog;
+    scene.Query<Transform, Rigidbody>().ForEach([&result](const EntityHandle&, Transform& _transform, Rigidbody&) {
+        result.rigidbodySerials.push_back(static_cast<uint32_t>(_transform.translate[X]));
+    });
+    scene.Query<Transform>().ForEach([&result](const EntityHandle&, Transform& _transform) {
+        result.transformSerials.push_back(static_cast<uint32_t>(_transform.translate[X]));
+    });
+
+    system.Finalize();
+    scene.Finalize();
+    return result;
+}
+
+// 並列に記録して反映する回数
+constexpr uint32_t kCommandCheckCount = 4;
+
+/// <returns>並列に記録した結果が毎回逐次実行と一致すれば true</returns>
+bool RunCommandsBenchmark(const BenchmarkOptions& _options, uint32_t _entityCount) {
+    double sequentialMs    = 0.0;
+    double parallelMs      = 0.0;
+    CommandResult expected = RecordAndExecuteCommands(_entityCount, false, _options.repeat, sequentialMs);
+
+    // 並列側はスレッドの割り当てが毎回変わるので, シーンを作り直して何度か確かめる
+    bool matched = true;
+    for (uint32_t i = 0; i < kCommandCheckCount; ++i) {
+        double elapsedMs = 0.0;
+        matched &= RecordAndExecuteCommands(_entityCount, true, _options.repeat, elapsedMs) == expected;
+        parallelMs = (i == 0) ? elapsedMs : (std::min)(parallelMs, elapsedMs);
+    }
+
+    const char* names[]   = {"sequential", "parallel"};
+    const double timeMs[] = {sequentialMs, parallelMs};
+    for (int i = 0; i < 2; ++i) {
+        double nsPerEntity = timeMs[i] * 1e6 / static_cast<double>(_entityCount);
+        if (_options.csv) {
+            std::printf("commands,%u,%s,%.4f,%.2f,%.2f,%d\n", _entityCount, names[i], timeMs[i], nsPerEntity, sequentialMs / timeMs[i], matched ? 1 : 0);
+        } else {
+            std::printf("%-8s %9u %-10s | %10.3f %10.2f %7.1fx | %s\n",
+                "commands", _entityCount, names[i], timeMs[i], nsPerEntity, sequentialMs / timeMs[i], matched ? "ok" : "MISMATCH");
+        }
+    }
+    return matched;
+}
+
+#pragma endregion
+
+#pragma region "Sleep"
+
+// 眠るまでに静止し続けるフレーム数 (sleep の間だけ設定する)
+constexpr int32_t kSleepFrameCount = 10;
+
+/// <summary>
+/// 重力を使わない止まった物体を生成し, 偶数番目は毎フレーム Transform を書き換えて動かしながら MoveSystemByRigidBody を更新する.
+/// 眠りが有効なら奇数番目だけが眠り, 無効なら誰も眠らなければ true を返す.
+/// </summary>
+/// <param name="_isSleepEnabled">眠りを有効にするか</param>
+/// <param name="_outMs">全員の判定が済んだ後の1フレームの最速の時間</param>
+bool RunSleepFrames(const BenchmarkOptions& _options, uint32_t _entityCount, bool _isSleepEnabled, double& _outMs) {
+    GlobalVariables::GetInstance()->SetValue<int32_t>("Settings", "Physics", "SleepFrameCount", _isSleepEnabled ? kSleepFrameCount : 0);
+
+    Scene scene("SleepBenchmark");
+    scene.InitializeECS();
+
+    MoveSystemByRigidBody moveSystem;
+    moveSystem.SetScene(&scene);
+    moveSystem.SetIsActive(true);
+    moveSystem.Initialize();
+
+    std::mt19937 random(_options.seed);
+    std::uniform_real_distribution<float> position(-100.f, 100.f);
+
+    std::vector<EntityHandle> handles;
+    handles.reserve(_entityCount);
+    for (uint32_t i = 0; i < _entityCount; ++i) {
+        EntityHandle handle = scene.CreateEntity("Body");
+        scene.AddComponent<Transform>(handle);
+        scene.AddComponent<Rigidbody>(handle);
+        scene.GetComponent<Transform>(handle)->translate = Vec3f(position(random), position(random), position(random));
+        scene.GetComponent<Rigidbody>(handle)->SetUseGravity(false);
+        moveSystem.AddEntity(handle);
+        handles.push_back(handle);
+    }
+
+    // 偶数番目は, 速度を持たせずに Transform だけを書き換えて動かす (アニメーションやゲームロジックから動かされる物体)
+    auto moveByTransform = [&scene, &handles]() {
+        for (size_t i = 0; i < handles.size(); i += 2) {
+            scene.GetComponent<Transform>(handles[i])->translate[X] += 0.1f;
+        }
+    };
+
+    // 眠るのに十分なフレームを回してから計測する
+    for (int32_t frame = 0; frame < kSleepFrameCount * 3; ++frame) {
+        moveSystem.Update();
+        moveByTransform();
+    }
+    // 計測する間も動かし続ける (Transform の書き換えは計測に含めない)
+    _outMs = 0.0;
+    for (uint32_t i = 0; i < _options.repeat; ++i) {
+        auto start     = std::chrono::steady_clock::now();
+        moveSystem.Update();
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        _outMs         = (i == 0) ? elapsed : (std::min)(_outMs, elapsed);
+        moveByTransform();
+    }
+    moveSystem.Update();
+
+    bool matched = true;
+    for (size_t i = 0; i < handles.size(); ++i) {
+        bool isMovedByTransform = i % 2 == 0;
+        bool expectedSleeping   = _isSleepEnabled && !isMovedByTransform;
+        matched &= scene.GetComponent<Rigidbody>(handles[i])->IsSleeping() == expectedSleeping;
+    }
+
+    moveSystem.Finalize();
+    scene.Finalize();
+    GlobalVariables::GetInstance()->SetValue<int32_t>("Settings", "Physics", "SleepFrameCount", 0);
+    return matched;
+}
+
+/// <returns>眠りの有無どちらでも, 眠った物体が期待通りなら true</returns>
+bool RunSleepBenchmark(const BenchmarkOptions& _options, uint32_t _entityCount) {
+    Engine::GetInstance()->GetDeltaTimer()->SetDeltaTime(_options.deltaTime);
+
+    double disabledMs = 0.0;
+    double enabledMs  = 0.0;
+    bool matched      = RunSleepFrames(_options, _entityCount, false, disabledMs);
+    matched &= RunSleepFrames(_options, _entityCount, true, enabledMs);
+
+    const char* names[]   = {"disabled", "enabled"};
+    const double timeMs[] = {disabledMs, enabledMs};
+    for (int i = 0; i < 2; ++i) {
+        double nsPerEntity = timeMs[i] * 1e6 / static_cast<double>(_entityCount);
+        if (_options.csv) {
+            std::printf("sleep,%u,%s,%.4f,%.2f,%.2f,%d\n", _entityCount, names[i], timeMs[i], nsPerEntity, disabledMs / timeMs[i], matched ? 1 : 0);
+        } else {
+            std::printf("%-8s %9u %-10s | %10.3f %10.2f %7.1fx | %s\n",
+                "sleep", _entityCount, names[i], timeMs[i], nsPerEntity, disabledMs / timeMs[i], matched ? "ok" : "MISMATCH");
+        }
+    }
+    return matched;
+}
+
+#pragma endregion
+
+void PrintHeader(const BenchmarkOptions& _options) {
+    if (_options.csv) {
+        std::printf("bench,entities,method,ms,ns_per_op,speedup,matched\n");
+        return;
+    }
+    std::printf("# repeat %u (fastest), seed %u, threads %u\n", _options.repeat, _options.seed, _options.threadCount);
+    std::printf("%-8s %9s %-10s | %10s %10s %8s | %s\n", "bench", "entities", "method", "ms", "ns/op", "speedup", "result");
+}
+
+} // namespace
+
+int main(int _argc, char** _argv) {
+    BenchmarkOptions options;
+    if (!ParseOptions(_argc, _argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+    RegisterComponents();
+    // Initialize(0) は論理コア数に合わせるので, 1スレッドなら起動しない (投入したジョブはその場で実行される)
+    if (options.threadCount > 1) {
+        JobSystem::GetInstance()->Initialize(options.threadCount - 1);
+    }
+
+    PrintHeader(options);
+    bool matched = true;
+    for (BenchmarkType benchmark : options.benchmarks) {
+        for (uint32_t entityCount : options.entityCounts) {
+            switch (benchmark) {
+            case BenchmarkType::Lookup:
+                matched &= RunLookupBenchmark(options, entityCount);
+                break;
+            case BenchmarkType::Update:
+                matched &= RunUpdateBenchmark(options, entityCount);
+                break;
+            case BenchmarkType::Commands:
+                matched &= RunCommandsBenchmark(options, entityCount);
+                break;
+            case BenchmarkType::Sleep:
+                matched &= RunSleepBenchmark(options, entityCount);
+                break;
+            default:
+                break;
+            }
+            std::fflush(stdout);
+        }
+    }
+    JobSystem::GetInstance()->Finalize();
+
+    // 比較した方法の結果が一致しなければ失敗として終了する
+    return matched ? 0 : 2;
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+/// stl
+#include <cmath>
+
+/// <summary>
+/// ヘッドレスビルド用の DirectXMath の代替.
+/// math/ が使う型と関数だけを, 本家と同じ行ベクトル (v * M) の規約でスカラー実装する.
+/// </summary>
+namespace DirectX {
+
+struct XMFLOAT3 {
+    float x, y, z;
+};
+
+struct XMFLOAT4 {
+    float x, y, z, w;
+};
+
+struct XMFLOAT4X4 {
+    float m[4][4];
+};
+
+struct XMVECTOR {
+    float v[4];
+};
+
+struct XMMATRIX {
+    XMVECTOR r[4];
+};
+
+inline XMVECTOR XMVectorSet(float _x, float _y, float _z, float _w) {
+    return XMVECTOR{{_x, _y, _z, _w}};
+}
+
+inline float XMVectorGetX(const XMVECTOR& _v) {
+    return _v.v[0];
+}
+
+inline XMMATRIX XMLoadFloat4x4(const XMFLOAT4X4* _src) {
+    XMMATRIX result;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            result.r[row].v[col] = _src->m[row][col];
+        }
+    }
+    return result;
+}
+
+inline void XMStoreFloat4x4(XMFLOAT4X4* _dst, const XMMATRIX& _m) {
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            _dst->m[row][col] = _m.r[row].v[col];
+        }
+    }
+}
+
+inline void XMStoreFloat3(XMFLOAT3* _dst, const XMVECTOR& _v) {
+    *_dst = XMFLOAT3{_v.v[0], _v.v[1], _v.v[2]};
+}
+
+inline void XMStoreFloat4(XMFLOAT4* _dst, const XMVECTOR& _v) {
+    *_dst = XMFLOAT4{_v.v[0], _v.v[1], _v.v[2], _v.v[3]};
+}
+
+inline XMMATRIX XMMatrixMultiply(const XMMATRIX& _a, const XMMATRIX& _b) {
+    XMMATRIX result;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            float sum = 0.f;
+            for (int k = 0; k < 4; ++k) {
+                sum += _a.r[row].v[k] * _b.r[k].v[col];
+            }
+            result.r[row].v[col] = sum;
+        }
+    }
+    return result;
+}
+
+inline XMMATRIX XMMatrixScaling(float _x, float _y, float _z) {
+    XMMATRIX result{};
+    result.r[0].v[0] = _x;
+    result.r[1].v[1] = _y;
+    result.r[2].v[2] = _z;
+    result.r[3].v[3] = 1.f;
+    return result;
+}
+
+inline XMVECTOR XMVector4Transform(const XMVECTOR& _v, const XMMATRIX& _m) {
+    XMVECTOR result;
+    for (int col = 0; col < 4; ++col) {
+        result.v[col] = _v.v[0] * _m.r[0].v[col] + _v.v[1] * _m.r[1].v[col] + _v.v[2] * _m.r[2].v[col] + _v.v[3] * _m.r[3].v[col];
+    }
+    return result;
+}
+
+/// <summary>
+/// 余因子行列 (転置済み) と行列式を求める
+/// </summary>
+inline float XMMatrixAdjugate(const XMMATRIX& _m, float _outAdj[4][4]) {
+    auto e = [&_m](int _row, int _col) { return _m.r[_row].v[_col]; };
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            // row, col を除いた 3x3 の行列式
+            int r[3], c[3];
+            for (int i = 0, n = 0; i < 4; ++i) {
+                if (i != row) {
+                    r[n++] = i;
+                }
+            }
+            for (int i = 0, n = 0; i < 4; ++i) {
+                if (i != col) {
+                    c[n++] = i;
+                }
+            }
+            float minor = e(r[0], c[0]) * (e(r[1], c[1]) * e(r[2], c[2]) - e(r[1], c[2]) * e(r[2], c[1]))
+                          - e(r[0], c[1]) * (e(r[1], c[0]) * e(r[2], c[2]) - e(r[1], c[2]) * e(r[2], c[0]))
+                          + e(r[0], c[2]) * (e(r[1], c[0]) * e(r[2], c[1]) - e(r[1], c[1]) * e(r[2], c[0]));
+            _outAdj[col][row] = ((row + col) % 2 == 0) ? minor : -minor;
+        }
+    }
+    return e(0, 0) * _outAdj[0][0] + e(0, 1) * _outAdj[1][0] + e(0, 2) * _outAdj[2][0] + e(0, 3) * _outAdj[3][0];
+}
+
+inline XMVECTOR XMMatrixDeterminant(const XMMATRIX& _m) {
+    float adj[4][4];
+    float det = XMMatrixAdjugate(_m, adj);
+    return XMVectorSet(det, det, det, det);
+}
+
+inline XMMATRIX XMMatrixInverse(XMVECTOR* _outDeterminant, const XMMATRIX& _m) {
+    float adj[4][4];
+    float det = XMMatrixAdjugate(_m, adj);
+    if (_outDeterminant) {
+        *_outDeterminant = XMVectorSet(det, det, det, det);
+    }
+    float invDet = det != 0.f ? 1.f / det : 0.f;
+    XMMATRIX result;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            result.r[row].v[col] = adj[row][col] * invDet;
+        }
+    }
+    return result;
+}
+
+inline XMVECTOR XMQuaternionRotationMatrix(const XMMATRIX& _m) {
+    float r00 = _m.r[0].v[0], r01 = _m.r[0].v[1], r02 = _m.r[0].v[2];
+    float r10 = _m.r[1].v[0], r11 = _m.r[1].v[1], r12 = _m.r[1].v[2];
+    float r20 = _m.r[2].v[0], r21 = _m.r[2].v[1], r22 = _m.r[2].v[2];
+    if (r22 <= 0.f) {
+        float dif10 = r11 - r00;
+        float omr22 = 1.f - r22;
+        if (dif10 <= 0.f) {
+            float fourXSqr = omr22 - dif10;
+            float inv4x    = 0.5f / std::sqrt(fourXSqr);
+            return XMVectorSet(fourXSqr * inv4x, (r01 + r10) * inv4x, (r02 + r20) * inv4x, (r12 - r21) * inv4x);
+        }
+        float fourYSqr = omr22 + dif10;
+        float inv4y    = 0.5f / std::sqrt(fourYSqr);
+        return XMVectorSet((r01 + r10) * inv4y, fourYSqr * inv4y, (r12 + r21) * inv4y, (r20 - r02) * inv4y);
+    }
+    float sum10 = r11 + r00;
+    float opr22 = 1.f + r22;
+    if (sum10 <= 0.f) {
+        float fourZSqr = opr22 - sum10;
+        float inv4z    = 0.5f / std::sqrt(fourZSqr);
+        return XMVectorSet((r02 + r20) * inv4z, (r12 + r21) * inv4z, fourZSqr * inv4z, (r01 - r10) * inv4z);
+    }
+    float fourWSqr = opr22 + sum10;
+    float inv4w    = 0.5f / std::sqrt(fourWSqr);
+    return XMVectorSet((r12 - r21) * inv4w, (r20 - r02) * inv4w, (r01 - r10) * inv4w, fourWSqr * inv4w);
+}
+
+inline bool XMMatrixDecompose(XMVECTOR* _outScale, XMVECTOR* _outRotQuat, XMVECTOR* _outTrans, const XMMATRIX& _m) {
+    XMMATRIX rotation = _m;
+    float scale[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        const float* row = _m.r[axis].v;
+        scale[axis]      = std::sqrt(row[0] * row[0] + row[1] * row[1] + row[2] * row[2]);
+        if (scale[axis] <= 1e-6f) {
+            return false;
+        }
+        for (int col = 0; col < 3; ++col) {
+            rotation.r[axis].v[col] = row[col] / scale[axis];
+        }
+    }
+    *_outScale   = XMVectorSet(scale[0], scale[1], scale[2], 0.f);
+    *_outRotQuat = XMQuaternionRotationMatrix(rotation);
+    *_outTrans   = XMVectorSet(_m.r[3].v[0], _m.r[3].v[1], _m.r[3].v[2], 1.f);
+    return true;
+}
+
+} // namespace DirectX
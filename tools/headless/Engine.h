@@ -0,0 +1,28 @@
+#pragma once
+
+/// util
+#include "deltaTime/DeltaTimer.h"
+
+namespace OriGine {
+
+/// <summary>
+/// ヘッドレスビルド用の Engine. ウィンドウや GPU を持たず, ECS が参照する DeltaTimer だけを提供する.
+/// </summary>
+class Engine {
+public:
+    static Engine* GetInstance() {
+        static Engine instance;
+        return &instance;
+    }
+
+    float GetDeltaTime() const { return deltaTimer_.GetDeltaTime(); }
+    DeltaTimer* GetDeltaTimer() { return &deltaTimer_; }
+
+private:
+    Engine()  = default;
+    ~Engine() = default;
+
+    DeltaTimer deltaTimer_;
+};
+
+} // namespace OriGine
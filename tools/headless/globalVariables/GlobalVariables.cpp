@@ -0,0 +1,25 @@
+#include "globalVariables/GlobalVariables.h"
+
+/// <summary>
+/// ヘッドレスビルド用の GlobalVariables の実装.
+/// ベンチマークは設定値をコードから与えるので, json の読み書きは行わずメモリ上だけで保持する.
+/// </summary>
+
+using namespace OriGine;
+
+GlobalVariables* GlobalVariables::GetInstance() {
+    static GlobalVariables instance;
+    return &instance;
+}
+
+GlobalVariables::GlobalVariables() {}
+
+GlobalVariables::~GlobalVariables() {}
+
+void GlobalVariables::LoadAllFile() {}
+
+void GlobalVariables::LoadFile(const std::string& /*scene*/, const std::string& /*groupName*/) {}
+
+void GlobalVariables::SaveScene(const std::string& /*scene*/) {}
+
+void GlobalVariables::SaveFile(const std::string& /*scene*/, const std::string& /*groupName*/) {}
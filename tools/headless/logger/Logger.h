@@ -0,0 +1,56 @@
+#pragma once
+
+/// stl
+#include <cstdio>
+#include <format>
+#include <string>
+#include <string_view>
+
+namespace OriGine {
+
+/// <summary>
+/// ヘッドレスビルド用の Logger. 本体と同じマクロで呼ばれ, WARN 以上だけを標準エラー出力に書く.
+/// (ベンチマークの出力を汚さないよう, INFO/DEBUG/TRACE は捨てる)
+/// </summary>
+class Logger {
+public:
+    static void Initialize() {}
+    static void Finalize() {}
+
+    template <typename... Args>
+    static void Trace(const char*, const char*, int, std::string_view, Args&&...) {}
+    template <typename... Args>
+    static void Info(const char*, const char*, int, std::string_view, Args&&...) {}
+    template <typename... Args>
+    static void Debug(const char*, const char*, int, std::string_view, Args&&...) {}
+
+    template <typename... Args>
+    static void Warn(const char* _file, const char* _function, int _line, std::string_view _fmt, Args&&... _args) {
+        Write("WARN", std::vformat(_fmt, std::make_format_args(_args...)), _file, _function, _line);
+    }
+    template <typename... Args>
+    static void Error(const char* _file, const char* _function, int _line, std::string_view _fmt, Args&&... _args) {
+        Write("ERROR", std::vformat(_fmt, std::make_format_args(_args...)), _file, _function, _line);
+    }
+    template <typename... Args>
+    static void Critical(const char* _file, const char* _function, int _line, std::string_view _fmt, Args&&... _args) {
+        Write("CRITICAL", std::vformat(_fmt, std::make_format_args(_args...)), _file, _function, _line);
+    }
+
+    static void DirectXLog(const char*, const char*, int) {}
+
+private:
+    static void Write(const char* _level, const std::string& _message, const char* _file, const char* _function, int _line) {
+        std::fprintf(stderr, "[%s] %s (%s:%d %s)\n", _level, _message.c_str(), _file, _line, _function);
+    }
+};
+
+} // namespace OriGine
+
+#define LOG_TRACE(fmt, ...) OriGine::Logger::Trace(__FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...) OriGine::Logger::Info(__FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...) OriGine::Logger::Debug(__FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...) OriGine::Logger::Warn(__FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...) OriGine::Logger::Error(__FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_CRITICAL(fmt, ...) OriGine::Logger::Critical(__FILE__, __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_DX12() OriGine::Logger::DirectXLog(__FILE__, __FUNCTION__, __LINE__)
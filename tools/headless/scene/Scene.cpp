@@ -0,0 +1,21 @@
+#include "Scene.h"
+
+/// ECS
+// system
+#include "system/SystemRunner.h"
+
+/// <summary>
+/// ヘッドレスビルド用の Scene の実装. 描画などを持たないので, 構築と破棄だけをここに置く.
+/// それ以外は本体と同じ code/scene/SceneEcs.cpp を使う.
+/// </summary>
+
+namespace OriGine {
+
+Scene::Scene(const ::std::string& _name) : name_(_name) {}
+Scene::~Scene() {}
+
+void Scene::Finalize() {
+    FinalizeECS();
+}
+
+} // namespace OriGine
@@ -0,0 +1,128 @@
+#pragma once
+
+/// stl
+#include <list>
+#include <memory>
+#include <string>
+
+/// ECS
+// entity
+#include "entity/EntityRepository.h"
+// component
+#include "component/ComponentArray.h"
+#include "component/ComponentRepository.h"
+
+/// engine
+#include <logger/Logger.h>
+
+namespace OriGine {
+
+/// ECS
+// system
+class SystemRunner;
+class ISystem;
+
+/// <summary>
+/// ヘッドレスビルド用の Scene.
+/// 描画・入力・レイトレーシングを持たず, ECS のリソース (エンティティ, コンポーネント, システム) だけを所有する.
+/// 公開している関数は本体の Scene と同じ宣言にしてあるので, これを使うコードは本体でもそのままビルドできる.
+/// ECS の関数の定義は本体と共有する (code/scene/SceneEcs.cpp, code/scene/Scene.inl).
+/// </summary>
+class Scene final {
+public:
+    Scene(const ::std::string& _name);
+    ~Scene();
+
+    /// <summary>
+    /// ECS のリソースを作成する
+    /// </summary>
+    void InitializeECS();
+
+    /// <summary>
+    /// ECS のリソースを破棄する
+    /// </summary>
+    void FinalizeECS();
+
+    /// <summary>
+    /// 全てのシステム・エンティティ・コンポーネントを破棄する
+    /// </summary>
+    void Finalize();
+
+    /// <summary>
+    /// 削除予約されたエンティティを削除する
+    /// </summary>
+    void ExecuteDeleteEntities();
+
+protected:
+    ::std::string name_ = "NULL";
+
+    ::std::unique_ptr<EntityRepository> entityRepository_;
+    ::std::unique_ptr<ComponentRepository> componentRepository_;
+    ::std::unique_ptr<SystemRunner> systemRunner_;
+
+    ::std::list<EntityHandle> deleteEntities_;
+
+public:
+    const ::std::string& GetName() const { return name_; }
+
+    const EntityRepository* GetEntityRepository() const;
+    EntityRepository* GetEntityRepositoryRef();
+
+    const ComponentRepository* GetComponentRepository() const;
+    ComponentRepository* GetComponentRepositoryRef();
+
+    const SystemRunner* GetSystemRunner() const;
+    SystemRunner* GetSystemRunnerRef();
+
+    void AddDeleteEntity(const EntityHandle& _entityId);
+
+    // --- Entity Operation Helpers ---
+
+    Entity* GetEntity(const EntityHandle& _handle) const;
+    EntityHandle GetUniqueEntity(const ::std::string& _dataType) const;
+    EntityHandle CreateEntity(const ::std::string& _dataType, bool _isUnique = false);
+    bool RegisterUniqueEntity(Entity* _entity);
+    bool UnregisterUniqueEntity(Entity* _entity);
+
+    // --- Component Operation Helpers ---
+
+    template <IsComponent ComponentType>
+    ComponentType* GetComponent(const EntityHandle& _handle, uint32_t _index = 0) const;
+    template <IsComponent ComponentType>
+    ComponentType* GetComponent(ComponentHandle _handle) const;
+
+    template <IsComponent ComponentType>
+    ComponentList<ComponentType>& GetComponents(const EntityHandle& _handle) {
+        return componentRepository_->GetComponents<ComponentType>(_handle);
+    }
+
+    template <IsComponent... ComponentTypes>
+    ComponentQuery<ComponentTypes...> Query() {
+        return componentRepository_->Query<ComponentTypes...>();
+    }
+
+    bool AddComponent(const ::std::string& _compTypeName, const EntityHandle& _handle);
+
+    template <IsComponent ComponentType>
+    bool AddComponent(const EntityHandle& _handle);
+
+    bool RemoveComponent(const ::std::string& _compTypeName, const EntityHandle& _handle, int32_t _componentIndex = 0);
+
+    IComponentArray* GetComponentArray(const ::std::string& _componentTypeName) const {
+        return componentRepository_->GetComponentArray(_componentTypeName);
+    }
+    template <IsComponent ComponentType>
+    ComponentArray<ComponentType>* GetComponentArray() const {
+        return componentRepository_->GetComponentArray<ComponentType>();
+    }
+
+    // --- System Operation Helpers ---
+
+    ::std::shared_ptr<ISystem> GetSystem(const ::std::string& _systemTypeName) const;
+    bool RegisterSystem(const ::std::string& _systemTypeName, int32_t _priority = 0, bool _activity = true);
+    bool UnregisterSystem(const ::std::string& _systemTypeName);
+};
+
+} // namespace OriGine
+
+#include "scene/Scene.inl"
@@ -0,0 +1,3 @@
+#pragma once
+
+// ヘッドレスビルド用の空ヘッダ. 衝突判定は COM / D3D12 の型を使わない.
@@ -0,0 +1,179 @@
+/// <summary>
+/// ヘッドレスの math の確認ツール.
+/// 環境によって実装が変わる関数 (三角関数などの std の float 版, 時刻の変換) を使う math と util の関数を, 手で求めた値と突き合わせる.
+/// 結果を1件ずつ ok / MISMATCH で出力し, 一致しないものがあれば終了コード 2 を返す.
+/// </summary>
+
+/// stl
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <string>
+
+/// math
+#include "math/Matrix4x4.h"
+#include "math/MyEasing.h"
+#include "math/Quaternion.h"
+#include "math/Vector3.h"
+
+/// util
+#include "StringUtil.h"
+
+using namespace OriGine;
+
+namespace {
+
+constexpr float kTolerance = 1e-5f;
+constexpr float kPi        = std::numbers::pi_v<float>;
+
+/// <summary>
+/// コマンドライン引数
+/// </summary>
+struct CheckOptions {
+    bool csv = false;
+};
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "usage: MathCheck [options]\n"
+        "  --csv              print results as CSV\n");
+}
+
+bool ParseOptions(int _argc, char** _argv, CheckOptions& _out) {
+    for (int i = 1; i < _argc; ++i) {
+        std::string arg = _argv[i];
+        if (arg == "--csv") {
+            _out.csv = true;
+            continue;
+        }
+        if (arg != "--help" && arg != "-h") {
+            std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+        }
+        return false;
+    }
+    return true;
+}
+
+bool NearlyEqual(float _a, float _b) {
+    return std::abs(_a - _b) <= kTolerance;
+}
+
+bool NearlyEqual(const Vec3f& _a, const Vec3f& _b) {
+    return NearlyEqual(_a[X], _b[X]) && NearlyEqual(_a[Y], _b[Y]) && NearlyEqual(_a[Z], _b[Z]);
+}
+
+/// <summary>
+/// 1件の結果を出力する
+/// </summary>
+bool PrintCheck(bool _csv, const char* _name, bool _matched) {
+    if (_csv) {
+        std::printf("check,%s,%d\n", _name, _matched ? 1 : 0);
+    } else {
+        std::printf("check  %-28s %s\n", _name, _matched ? "ok" : "MISMATCH");
+    }
+    return _matched;
+}
+
+/// <summary>
+/// イージングの値を途中の時刻で確かめる (std::sin / cos / pow の float 版を使う)
+/// </summary>
+bool CheckEasing(bool _csv) {
+    const float kInvSqrt2 = 1.0f / std::numbers::sqrt2_v<float>;
+
+    bool allMatched = true;
+    allMatched &= PrintCheck(_csv, "ease in sine", NearlyEqual(EaseInSine(0.5f), 1.0f - kInvSqrt2));
+    allMatched &= PrintCheck(_csv, "ease out sine", NearlyEqual(EaseOutSine(0.5f), kInvSqrt2));
+    allMatched &= PrintCheck(_csv, "ease in out sine", NearlyEqual(EaseInOutSine(0.25f), (1.0f - kInvSqrt2) * 0.5f));
+    allMatched &= PrintCheck(_csv, "ease in out quad", NearlyEqual(EaseInOutQuad(0.75f), 0.875f));
+    allMatched &= PrintCheck(_csv, "ease out cubic", NearlyEqual(EaseOutCubic(0.5f), 0.875f));
+    allMatched &= PrintCheck(_csv, "ease in out cubic", NearlyEqual(EaseInOutCubic(0.75f), 0.9375f));
+    allMatched &= PrintCheck(_csv, "ease out quart", NearlyEqual(EaseOutQuart(0.5f), 0.9375f));
+    allMatched &= PrintCheck(_csv, "ease out back end", NearlyEqual(EaseOutBack(1.0f), 1.0f));
+    // 2^-5 * sin(±π/6) になる時刻
+    allMatched &= PrintCheck(_csv, "ease in elastic", NearlyEqual(EaseInElastic(0.5f), -1.0f / 64.0f));
+    allMatched &= PrintCheck(_csv, "ease out elastic", NearlyEqual(EaseOutElastic(0.5f), 1.0f + 1.0f / 64.0f));
+    return allMatched;
+}
+
+/// <summary>
+/// 回転行列と透視投影行列を確かめる (行ベクトル v * M の規約)
+/// </summary>
+bool CheckMatrix(bool _csv) {
+    const float kHalfPi = kPi * 0.5f;
+
+    bool allMatched = true;
+    allMatched &= PrintCheck(_csv, "rotate x", NearlyEqual(Vec3f(0.f, 1.f, 0.f) * MakeMatrix4x4::RotateX(kHalfPi), Vec3f(0.f, 0.f, 1.f)));
+    allMatched &= PrintCheck(_csv, "rotate y", NearlyEqual(Vec3f(0.f, 0.f, 1.f) * MakeMatrix4x4::RotateY(kHalfPi), Vec3f(1.f, 0.f, 0.f)));
+    allMatched &= PrintCheck(_csv, "rotate z", NearlyEqual(Vec3f(1.f, 0.f, 0.f) * MakeMatrix4x4::RotateZ(kHalfPi), Vec3f(0.f, 1.f, 0.f)));
+
+    Matrix4x4 fromTo = MakeMatrix4x4::RotateAxisAngle(Vec3f(1.f, 0.f, 0.f), Vec3f(0.f, 1.f, 0.f));
+    allMatched &= PrintCheck(_csv, "rotate from to", NearlyEqual(Vec3f(1.f, 0.f, 0.f) * fromTo, Vec3f(0.f, 1.f, 0.f)));
+
+    // 画角 90 度なら cot(45°) = 1
+    Matrix4x4 perspective = MakeMatrix4x4::PerspectiveFov(kHalfPi, 2.0f, 0.1f, 100.0f);
+    allMatched &= PrintCheck(_csv, "perspective fov", NearlyEqual(perspective[0][0], 0.5f) && NearlyEqual(perspective[1][1], 1.0f));
+    return allMatched;
+}
+
+/// <summary>
+/// 2つのベクトルの間の回転を確かめる
+/// </summary>
+bool CheckQuaternion(bool _csv) {
+    const Vec3f from  = Vec3f(1.f, 0.f, 0.f);
+    const Vec3f to    = Vec3f(0.f, 0.f, 1.f);
+    Quaternion fromTo = Quaternion::RotateAxisVector(from, to);
+    return PrintCheck(_csv, "quaternion from to", NearlyEqual(fromTo.RotateVector(from), to));
+}
+
+/// <summary>
+/// 内積を確かめる
+/// </summary>
+bool CheckVector(bool _csv) {
+    bool allMatched = true;
+    allMatched &= PrintCheck(_csv, "vector dot self", NearlyEqual(Vec3f::Dot(Vec3f(1.f, 2.f, 2.f)), 9.0f));
+    allMatched &= PrintCheck(_csv, "vector dot pair", NearlyEqual(Vec3f::Dot(Vec3f(1.f, 2.f, 3.f), Vec3f(4.f, -5.f, 6.f)), 12.0f));
+    return allMatched;
+}
+
+/// <summary>
+/// 文字列の変換を確かめる (TimeToString はプラットフォームごとの localtime を使う)
+/// </summary>
+bool CheckString(bool _csv) {
+    bool allMatched = true;
+    allMatched &= PrintCheck(_csv, "normalize string", NormalizeString("a\\b\\c.json") == "a/b/c.json");
+    allMatched &= PrintCheck(_csv, "split", Split("x,,y", ',') == std::vector<std::string>{"x", "", "y"});
+    allMatched &= PrintCheck(_csv, "trim", Trim(" \t name \n") == "name");
+    allMatched &= PrintCheck(_csv, "trim after newline", TrimAfterNewline("a\r\nb", true) == "a\r\n" && TrimAfterNewline("a\r\nb") == "a");
+
+    // "YYYY-MM-DD_HH-MM-SS" で, 年は現在の年
+    std::string time = TimeToString();
+    bool isFormatted = time.size() == 19;
+    for (size_t i = 0; isFormatted && i < time.size(); ++i) {
+        char expected = (i == 4 || i == 7 || i == 13 || i == 16) ? '-' : (i == 10 ? '_' : '0');
+        isFormatted   = expected == '0' ? std::isdigit(static_cast<unsigned char>(time[i])) != 0 : time[i] == expected;
+    }
+    int year = static_cast<int>(std::chrono::year_month_day(std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now())).year());
+    allMatched &= PrintCheck(_csv, "time to string", isFormatted && std::abs(std::stoi(time.substr(0, 4)) - year) <= 1);
+    return allMatched;
+}
+
+} // namespace
+
+int main(int _argc, char** _argv) {
+    CheckOptions options;
+    if (!ParseOptions(_argc, _argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    bool allMatched = true;
+    allMatched &= CheckEasing(options.csv);
+    allMatched &= CheckMatrix(options.csv);
+    allMatched &= CheckQuaternion(options.csv);
+    allMatched &= CheckVector(options.csv);
+    allMatched &= CheckString(options.csv);
+
+    return allMatched ? 0 : 2;
+}
@@ -1,12 +1,17 @@
 #include "StringUtil.h"
 
 /// api
+#ifdef _WIN32
 #include <Windows.h>
+#endif // _WIN32
 
 /// stl
 #include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <iomanip>
 
+#ifdef _WIN32
 std::wstring ConvertString(const std::string& str) {
     if (str.empty()) {
         return std::wstring();
@@ -59,6 +64,7 @@ std::string HrToString(HRESULT hr) {
     }
     return result;
 }
+#endif // _WIN32
 
 std::string NormalizeString(const std::string& path) {
     std::string normalized = path;
@@ -73,7 +79,11 @@ std::string TimeToString() {
 
     // tm構造体を安全に取得
     struct tm time_info;
+#ifdef _WIN32
     localtime_s(&time_info, &time_t_now);
+#else
+    localtime_r(&time_t_now, &time_info);
+#endif // _WIN32
 
     // 時刻をフォーマット
     std::ostringstream oss;
@@ -0,0 +1,179 @@
+#include "JobSystem.h"
+
+using namespace OriGine;
+
+namespace {
+// 0 = ワーカー以外のスレッド, 1.. = ワーカー
+thread_local uint32_t tlsThreadIndex = 0;
+} // namespace
+
+JobSystem* JobSystem::GetInstance() {
+    static JobSystem instance;
+    return &instance;
+}
+
+JobSystem::~JobSystem() {
+    Finalize();
+}
+
+/// <summary>
+/// ワーカースレッドを起動する
+/// </summary>
+/// <param name="_workerCount">ワーカー数 (0 なら 論理コア数 - 1)</param>
+void JobSystem::Initialize(uint32_t _workerCount) {
+    if (IsRunning()) {
+        return;
+    }
+
+    if (_workerCount == 0) {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        _workerCount             = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    queues_.clear();
+    for (uint32_t i = 0; i < _workerCount + 1; ++i) {
+        queues_.emplace_back(std::make_unique<WorkQueue>());
+    }
+
+    isRunning_.store(true, std::memory_order_release);
+    workers_.reserve(_workerCount);
+    for (uint32_t i = 0; i < _workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+}
+
+/// <summary>
+/// 残っているジョブを実行し, ワーカースレッドを停止する
+/// </summary>
+void JobSystem::Finalize() {
+    if (!IsRunning()) {
+        return;
+    }
+
+    // 取り残されたジョブは呼び出し元で処理しきる
+    while (TryExecuteOne(tlsThreadIndex)) {}
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        isRunning_.store(false, std::memory_order_release);
+    }
+    sleepCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    queues_.clear();
+    queuedJobCount_.store(0, std::memory_order_release);
+}
+
+/// <summary>
+/// ジョブを投入する
+/// </summary>
+void JobSystem::Submit(JobCounter& _counter, std::function<void()> _job) {
+    if (!IsRunning()) {
+        _job();
+        return;
+    }
+
+    _counter.pendingCount_.fetch_add(1, std::memory_order_acq_rel);
+    // 取り出し側の減算より先に加算しておく (一時的に空のキューを覗くだけで済む)
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        queuedJobCount_.fetch_add(1, std::memory_order_acq_rel);
+    }
+    {
+        WorkQueue& queue = *queues_[tlsThreadIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(Job{std::move(_job), &_counter});
+    }
+    sleepCondition_.notify_one();
+}
+
+/// <summary>
+/// カウンタに紐づくジョブが全て完了するまで, ジョブを手伝いながら待つ.
+/// 手伝えるジョブが無ければ, カウンタが 0 になるか新しいジョブが積まれるまで眠る
+/// </summary>
+void JobSystem::Wait(JobCounter& _counter) {
+    while (!_counter.IsDone()) {
+        if (TryExecuteOne(tlsThreadIndex)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this, &_counter]() {
+            return _counter.IsDone() || queuedJobCount_.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+/// <summary>
+/// 自分のキューの末尾, なければ他のキューの先頭からジョブを1つ取り出して実行する
+/// </summary>
+bool JobSystem::TryExecuteOne(uint32_t _threadIndex) {
+    if (queuedJobCount_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    Job job;
+    bool found = false;
+
+    const uint32_t queueCount = static_cast<uint32_t>(queues_.size());
+    // 自分のキュー (LIFO)
+    {
+        WorkQueue& queue = *queues_[_threadIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            found = true;
+        }
+    }
+    // 他のキューから盗む (FIFO)
+    for (uint32_t offset = 1; !found && offset < queueCount; ++offset) {
+        WorkQueue& queue = *queues_[(_threadIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    queuedJobCount_.fetch_sub(1, std::memory_order_acq_rel);
+    job.func();
+    if (job.counter->pendingCount_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // Wait で眠っているスレッドを起こす. 判定と眠りの間に割り込まないよう, ロックを取ってから通知する
+        // (カウンタは Wait を抜けた直後に破棄されうるので, ここから先では触らない)
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        sleepCondition_.notify_all();
+    }
+    return true;
+}
+
+void JobSystem::WorkerLoop(uint32_t _threadIndex) {
+    tlsThreadIndex = _threadIndex;
+
+    while (true) {
+        if (TryExecuteOne(_threadIndex)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this]() {
+            return !isRunning_.load(std::memory_order_acquire) || queuedJobCount_.load(std::memory_order_acquire) > 0;
+        });
+        if (!isRunning_.load(std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+uint32_t JobSystem::GetCurrentThreadIndex() {
+    return tlsThreadIndex;
+}
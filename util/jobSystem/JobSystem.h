@@ -0,0 +1,154 @@
+#pragma once
+
+/// stl
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OriGine {
+
+/// <summary>
+/// JobSystem に投入したジョブの完了を待つためのカウンタ
+/// </summary>
+class JobCounter {
+    friend class JobSystem;
+
+public:
+    JobCounter()                             = default;
+    JobCounter(const JobCounter&)            = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    /// <summary>
+    /// 投入したジョブが全て完了したか
+    /// </summary>
+    bool IsDone() const { return pendingCount_.load(std::memory_order_acquire) == 0; }
+
+private:
+    std::atomic<uint32_t> pendingCount_{0};
+};
+
+/// <summary>
+/// ワークスティーリング方式のジョブプール.
+/// ワーカーごとにキューを持ち, 自分のキューは後ろから (LIFO), 他のキューは前から (FIFO) 取り出す.
+/// Initialize されていない場合, 投入されたジョブは呼び出したスレッドでその場で実行される.
+/// </summary>
+class JobSystem {
+public:
+    static JobSystem* GetInstance();
+
+    /// <summary>
+    /// ワーカースレッドを起動する
+    /// </summary>
+    /// <param name="_workerCount">ワーカー数 (0 なら 論理コア数 - 1)</param>
+    void Initialize(uint32_t _workerCount = 0);
+    /// <summary>
+    /// 残っているジョブを実行し, ワーカースレッドを停止する
+    /// </summary>
+    void Finalize();
+
+    /// <summary>
+    /// ジョブを投入する
+    /// </summary>
+    /// <param name="_counter">完了待ちに使うカウンタ</param>
+    /// <param name="_job">実行する処理</param>
+    void Submit(JobCounter& _counter, std::function<void()> _job);
+
+    /// <summary>
+    /// カウンタに紐づくジョブが全て完了するまで待つ.
+    /// 待っている間も呼び出したスレッドでジョブを実行するため, ジョブ内から呼び出してもデッドロックしない.
+    /// 実行できるジョブが無い間は, ワーカーと同じ条件変数で眠る (空回りしない).
+    /// </summary>
+    void Wait(JobCounter& _counter);
+
+    /// <summary>
+    /// [0, _count) を _grainSize ごとに分割して並列に実行する. 最初の区間は呼び出したスレッドで実行する.
+    /// </summary>
+    /// <param name="_count">要素数</param>
+    /// <param name="_grainSize">1ジョブあたりの要素数</param>
+    /// <param name="_func">void(uint32_t _begin, uint32_t _end)</param>
+    template <typename Func>
+    void ParallelFor(uint32_t _count, uint32_t _grainSize, Func&& _func);
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem&)            = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct Job {
+        std::function<void()> func;
+        JobCounter* counter = nullptr;
+    };
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    /// <summary>
+    /// 自分のキューの末尾, なければ他のキューの先頭からジョブを1つ取り出して実行する
+    /// </summary>
+    /// <returns>実行したら true</returns>
+    bool TryExecuteOne(uint32_t _threadIndex);
+    void WorkerLoop(uint32_t _threadIndex);
+
+private:
+    // [0] = ワーカー以外のスレッド (メインスレッド等) 用, [1..] = 各ワーカー用
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    // ワーカーの待機と Wait の待機で共用する (ジョブの投入とカウンタの完了で起こす)
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    std::atomic<uint32_t> queuedJobCount_{0};
+    std::atomic<bool> isRunning_{false};
+
+public:
+    /// <summary>
+    /// ワーカースレッド数 (呼び出し元スレッドは含まない)
+    /// </summary>
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+    /// <summary>
+    /// ジョブを実行しうるスレッド数 (ワーカー + 呼び出し元スレッド)
+    /// </summary>
+    uint32_t GetThreadCount() const { return GetWorkerCount() + 1; }
+    bool IsRunning() const { return isRunning_.load(std::memory_order_acquire); }
+
+    /// <summary>
+    /// 現在のスレッドの番号 (0 = ワーカー以外, 1.. = ワーカー)
+    /// </summary>
+    static uint32_t GetCurrentThreadIndex();
+};
+
+template <typename Func>
+inline void JobSystem::ParallelFor(uint32_t _count, uint32_t _grainSize, Func&& _func) {
+    if (_count == 0) {
+        return;
+    }
+    if (_grainSize == 0) {
+        _grainSize = 1;
+    }
+
+    const uint32_t chunkCount = (_count + _grainSize - 1) / _grainSize;
+    if (!IsRunning() || chunkCount <= 1) {
+        _func(0u, _count);
+        return;
+    }
+
+    JobCounter counter;
+    for (uint32_t chunk = 1; chunk < chunkCount; ++chunk) {
+        uint32_t begin = chunk * _grainSize;
+        uint32_t end   = (std::min)(begin + _grainSize, _count);
+        Submit(counter, [&_func, begin, end]() { _func(begin, end); });
+    }
+    _func(0u, (std::min)(_grainSize, _count));
+    Wait(counter);
+}
+
+} // namespace OriGine
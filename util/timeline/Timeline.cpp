@@ -71,7 +71,8 @@ bool EditKeyFrame(
     OriGine::AnimationCurve<float>& keyFrames,
     float duration,
     float defaultValue,
-    std::function<void(int)> howEditItem) {
+    std::function<void(int)> howEditItem,
+    std::function<void()> onEdited) {
     return EditKeyFrameImpl(
         label,
         keyFrames,
@@ -79,7 +80,8 @@ bool EditKeyFrame(
         defaultValue,
         TimelinePopup::DrawValueEditFloat,
         howEditItem,
-        true); // float版はコマンド付きAddNode
+        true, // float版はコマンド付きAddNode
+        onEdited);
 }
 
 bool EditKeyFrame(
@@ -87,7 +89,8 @@ bool EditKeyFrame(
     OriGine::AnimationCurve<OriGine::Vec2f>& keyFrames,
     float duration,
     const OriGine::Vec2f& defaultValue,
-    std::function<void(int)> howEditItem) {
+    std::function<void(int)> howEditItem,
+    std::function<void()> onEdited) {
     return EditKeyFrameImpl(
         label,
         keyFrames,
@@ -95,7 +98,8 @@ bool EditKeyFrame(
         defaultValue,
         TimelinePopup::DrawValueEditVec2,
         howEditItem,
-        false);
+        false,
+        onEdited);
 }
 
 bool EditKeyFrame(
@@ -103,7 +107,8 @@ bool EditKeyFrame(
     OriGine::AnimationCurve<OriGine::Vec3f>& keyFrames,
     float duration,
     const OriGine::Vec3f& defaultValue,
-    std::function<void(int)> howEditItem) {
+    std::function<void(int)> howEditItem,
+    std::function<void()> onEdited) {
     return EditKeyFrameImpl(
         label,
         keyFrames,
@@ -111,7 +116,8 @@ bool EditKeyFrame(
         defaultValue,
         TimelinePopup::DrawValueEditVec3,
         howEditItem,
-        false);
+        false,
+        onEdited);
 }
 
 bool EditKeyFrame(
@@ -119,7 +125,8 @@ bool EditKeyFrame(
     OriGine::AnimationCurve<OriGine::Vec4f>& keyFrames,
     float duration,
     const OriGine::Vec4f& defaultValue,
-    std::function<void(int)> howEditItem) {
+    std::function<void(int)> howEditItem,
+    std::function<void()> onEdited) {
     return EditKeyFrameImpl(
         label,
         keyFrames,
@@ -127,7 +134,8 @@ bool EditKeyFrame(
         defaultValue,
         TimelinePopup::DrawValueEditVec4,
         howEditItem,
-        false);
+        false,
+        onEdited);
 }
 
 bool EditKeyFrame(
@@ -135,7 +143,8 @@ bool EditKeyFrame(
     OriGine::AnimationCurve<OriGine::Quaternion>& keyFrames,
     float duration,
     const OriGine::Quaternion& defaultValue,
-    std::function<void(int)> howEditItem) {
+    std::function<void(int)> howEditItem,
+    std::function<void()> onEdited) {
     return EditKeyFrameImpl(
         label,
         keyFrames,
@@ -143,7 +152,8 @@ bool EditKeyFrame(
         defaultValue,
         TimelinePopup::DrawValueEditQuaternion,
         howEditItem,
-        false);
+        false,
+        onEdited);
 }
 
 bool EditColorKeyFrame(
@@ -151,13 +161,15 @@ bool EditColorKeyFrame(
     OriGine::AnimationCurve<OriGine::Vec4f>& keyFrames,
     float duration,
     const OriGine::Vec4f& defaultValue,
-    std::function<void(int)> howEditItem) {
+    std::function<void(int)> howEditItem,
+    std::function<void()> onEdited) {
     return EditColorKeyFrameImpl(
         label,
         keyFrames,
         duration,
         defaultValue,
-        howEditItem);
+        howEditItem,
+        onEdited);
 }
 
 } // namespace ImGui
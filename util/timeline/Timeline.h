@@ -45,13 +45,15 @@ bool TimeLineButtons(
 /// <param name="duration">アニメーションの全体時間</param>
 /// <param name="defaultValue">nodeを初期化する際に使用する値</param>
 /// <param name="howEditItem">値を編集するための関数</param>
+/// <param name="onEdited">キーフレームを編集するコマンドの Execute / Undo の後に呼ぶ関数</param>
 /// <returns></returns>
 bool EditKeyFrame(
     const std::string& label,
     ::OriGine::AnimationCurve<float>& keyFrames,
     float duration,
     float defaultValue                   = 0.0f,
-    std::function<void(int)> howEditItem = nullptr);
+    std::function<void(int)> howEditItem = nullptr,
+    std::function<void()> onEdited       = nullptr);
 
 /// <summary>
 /// animationCurveをKeyFrameエディタで編集する
@@ -61,12 +63,14 @@ bool EditKeyFrame(
 /// <param name="duration">アニメーションの全体時間</param>
 /// <param name="defaultValue">nodeを初期化する際に使用する値</param>
 /// <param name="howEditItem">値を編集するための関数</param>
+/// <param name="onEdited">キーフレームを編集するコマンドの Execute / Undo の後に呼ぶ関数</param>
 bool EditKeyFrame(
     const std::string& label,
     ::OriGine::AnimationCurve<::OriGine::Vec2f>& keyFrames,
     float duration,
     const ::OriGine::Vec2f& defaultValue            = ::OriGine::Vec2f(0.0f, 0.0f),
-    std::function<void(int)> howEditItem = nullptr);
+    std::function<void(int)> howEditItem = nullptr,
+    std::function<void()> onEdited       = nullptr);
 
 /// <summary>
 /// animationCurveをKeyFrameエディタで編集する
@@ -76,12 +80,14 @@ bool EditKeyFrame(
 /// <param name="duration">アニメーションの全体時間</param>
 /// <param name="defaultValue">nodeを初期化する際に使用する値</param>
 /// <param name="howEditItem">値を編集するための関数</param>
+/// <param name="onEdited">キーフレームを編集するコマンドの Execute / Undo の後に呼ぶ関数</param>
 bool EditKeyFrame(
     const std::string& label,
     ::OriGine::AnimationCurve<::OriGine::Vec3f>& keyFrames,
     float duration,
     const ::OriGine::Vec3f& defaultValue            = ::OriGine::Vec3f(0.0f, 0.0f, 0.0f),
-    std::function<void(int)> howEditItem = nullptr);
+    std::function<void(int)> howEditItem = nullptr,
+    std::function<void()> onEdited       = nullptr);
 
 /// <summary>
 /// animationCurveをKeyFrameエディタで編集する
@@ -91,12 +97,14 @@ bool EditKeyFrame(
 /// <param name="duration">アニメーションの全体時間</param>
 /// <param name="defaultValue">nodeを初期化する際に使用する値</param>
 /// <param name="howEditItem">値を編集するための関数</param>
+/// <param name="onEdited">キーフレームを編集するコマンドの Execute / Undo の後に呼ぶ関数</param>
 bool EditKeyFrame(
     const std::string& label,
     ::OriGine::AnimationCurve<::OriGine::Vec4f>& keyFrames,
     float duration,
     const ::OriGine::Vec4f& defaultValue            = ::OriGine::Vec4f(0.0f, 0.0f, 0.0f, 0.0f),
-    std::function<void(int)> howEditItem = nullptr);
+    std::function<void(int)> howEditItem = nullptr,
+    std::function<void()> onEdited       = nullptr);
 
 /// <summary>
 /// animationCurveをKeyFrameエディタで編集する
@@ -106,12 +114,14 @@ bool EditKeyFrame(
 /// <param name="duration">アニメーションの全体時間</param>
 /// <param name="defaultValue">nodeを初期化する際に使用する値</param>
 /// <param name="howEditItem">値を編集するための関数</param>
+/// <param name="onEdited">キーフレームを編集するコマンドの Execute / Undo の後に呼ぶ関数</param>
 bool EditKeyFrame(
     const std::string& label,
     ::OriGine::AnimationCurve<::OriGine::Quaternion>& keyFrames,
     float duration,
     const ::OriGine::Quaternion& defaultValue       = ::OriGine::Quaternion(0.0f, 0.0f, 0.0f, 1.0f),
-    std::function<void(int)> howEditItem = nullptr);
+    std::function<void(int)> howEditItem = nullptr,
+    std::function<void()> onEdited       = nullptr);
 
 /// <summary>
 /// animationCurve(Color)をKeyFrameエディタで編集する
@@ -121,11 +131,13 @@ bool EditKeyFrame(
 /// <param name="duration">アニメーションの全体時間</param>
 /// <param name="defaultValue">nodeを初期化する際に使用する値</param>
 /// <param name="howEditItem">値を編集するための関数</param>
+/// <param name="onEdited">キーフレームを編集するコマンドの Execute / Undo の後に呼ぶ関数</param>
 bool EditColorKeyFrame(
     const std::string& label,
     ::OriGine::AnimationCurve<::OriGine::Vec4f>& keyFrames,
     float duration,
     const ::OriGine::Vec4f& defaultValue            = ::OriGine::Vec4f(1.0f, 1.0f, 1.0f, 1.0f),
-    std::function<void(int)> howEditItem = nullptr);
+    std::function<void(int)> howEditItem = nullptr,
+    std::function<void()> onEdited       = nullptr);
 
 } // namespace ImGui
@@ -25,6 +25,7 @@ namespace ImGui {
 /// @param drawValueEdit 値編集UIを描画する関数
 /// @param howEditItem カスタム編集関数（nullptrの場合はデフォルト使用）
 /// @param useCommandForAddNode ノード追加時にコマンドを使用するか
+/// @param onEdited キーフレームを編集するコマンドの Execute / Undo の後に呼ぶ関数
 /// @return 更新されたか
 template <typename T, typename DrawValueEditFunc>
 bool EditKeyFrameImpl(
@@ -34,7 +35,8 @@ bool EditKeyFrameImpl(
     const T& defaultValue,
     DrawValueEditFunc drawValueEdit,
     std::function<void(int)> howEditItem = nullptr,
-    bool useCommandForAddNode            = false) {
+    bool useCommandForAddNode            = false,
+    std::function<void()> onEdited       = nullptr) {
     using namespace TimelineCore;
     using namespace ::TimelineConfig;
     using namespace ::TimelinePopup;
@@ -64,7 +66,8 @@ bool EditKeyFrameImpl(
                 keyFrames[state.draggedIndex].time = state.startDragValue;
                 auto command                       = std::make_unique<SetterCommand<float>>(
                     &keyFrames[state.draggedIndex].time,
-                    state.draggedValue);
+                    state.draggedValue,
+                    WithOnEdited<float>(nullptr, onEdited));
                 OriGine::EditorController::GetInstance()->PushCommand(std::move(command));
             }
 
@@ -112,19 +115,19 @@ bool EditKeyFrameImpl(
             ImGui::Text("NodeNumber : %d", state.popUpIndex);
 
             if (ImGui::Button("Delete")) {
-                HandleDeleteNode(keyFrames, state.popUpIndex, defaultValue);
+                HandleDeleteNode(keyFrames, state.popUpIndex, defaultValue, onEdited);
             }
             if (ImGui::Button("Copy")) {
-                HandleCopyNode(keyFrames, state.popUpIndex, keys.popUpIndexId);
+                HandleCopyNode(keyFrames, state.popUpIndex, keys.popUpIndexId, onEdited);
             }
 
-            DrawTimeEdit(label, keyFrames, state.popUpIndex);
+            DrawTimeEdit(label, keyFrames, state.popUpIndex, onEdited);
             ImGui::Spacing();
 
             if (howEditItem) {
                 howEditItem(state.popUpIndex);
             } else {
-                drawValueEdit(label, keyFrames, state.popUpIndex);
+                drawValueEdit(label, keyFrames, state.popUpIndex, onEdited);
             }
 
             EndPopup();
@@ -141,7 +144,7 @@ bool EditKeyFrameImpl(
             float currentTime = CalculateTimeFromMouse(widgetData.frameBB, duration);
 
             if (ImGui::Button("Add Node")) {
-                HandleAddNode(keyFrames, currentTime, keys.popUpIndexId, useCommandForAddNode);
+                HandleAddNode(keyFrames, currentTime, keys.popUpIndexId, useCommandForAddNode, onEdited);
             }
             if (ImGui::Button("Cancel")) {
                 ImGui::CloseCurrentPopup();
@@ -163,13 +166,15 @@ bool EditKeyFrameImpl(
 /// @param duration アニメーション全体時間
 /// @param defaultValue デフォルト値
 /// @param howEditItem カスタム編集関数
+/// @param onEdited キーフレームを編集するコマンドの Execute / Undo の後に呼ぶ関数
 /// @return 更新されたか
 inline bool EditColorKeyFrameImpl(
     const std::string& label,
     OriGine::AnimationCurve<OriGine::Vec4f>& keyFrames,
     float duration,
     const OriGine::Vec4f& defaultValue,
-    std::function<void(int)> howEditItem = nullptr) {
+    std::function<void(int)> howEditItem = nullptr,
+    std::function<void()> onEdited       = nullptr) {
     using namespace TimelineCore;
     using namespace ::TimelineConfig;
     using namespace ::TimelinePopup;
@@ -197,7 +202,8 @@ inline bool EditColorKeyFrameImpl(
                 keyFrames[state.draggedIndex].time = state.startDragValue;
                 auto command                       = std::make_unique<SetterCommand<float>>(
                     &keyFrames[state.draggedIndex].time,
-                    state.draggedValue);
+                    state.draggedValue,
+                    WithOnEdited<float>(nullptr, onEdited));
                 OriGine::EditorController::GetInstance()->PushCommand(std::move(command));
             }
 
@@ -251,19 +257,19 @@ inline bool EditColorKeyFrameImpl(
             ImGui::Text("NodeNumber : %d", state.popUpIndex);
 
             if (ImGui::Button("Delete")) {
-                HandleDeleteNode(keyFrames, state.popUpIndex, defaultValue);
+                HandleDeleteNode(keyFrames, state.popUpIndex, defaultValue, onEdited);
             }
             if (ImGui::Button("Copy")) {
-                HandleCopyNode(keyFrames, state.popUpIndex, keys.popUpIndexId);
+                HandleCopyNode(keyFrames, state.popUpIndex, keys.popUpIndexId, onEdited);
             }
 
-            DrawTimeEdit(label, keyFrames, state.popUpIndex);
+            DrawTimeEdit(label, keyFrames, state.popUpIndex, onEdited);
             ImGui::Spacing();
 
             if (howEditItem) {
                 howEditItem(state.popUpIndex);
             } else {
-                DrawValueEditColor(label, keyFrames, state.popUpIndex);
+                DrawValueEditColor(label, keyFrames, state.popUpIndex, onEdited);
             }
 
             EndPopup();
@@ -279,7 +285,7 @@ inline bool EditColorKeyFrameImpl(
             float currentTime = CalculateTimeFromMouse(widgetData.frameBB, duration);
 
             if (ImGui::Button("Add Node")) {
-                HandleAddNode(keyFrames, currentTime, keys.popUpIndexId, false);
+                HandleAddNode(keyFrames, currentTime, keys.popUpIndexId, false, onEdited);
             }
             if (ImGui::Button("Cancel")) {
                 ImGui::CloseCurrentPopup();
@@ -13,6 +13,7 @@
 #include "myGui/MyGui.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 
 namespace TimelinePopup {
@@ -28,23 +29,46 @@ inline void SortKeyFrames(OriGine::AnimationCurve<T>& keyFrames) {
         });
 }
 
+/// @brief SetterCommand の後処理に, キーフレームを編集したときの通知を足す
+/// @tparam T 値の型
+/// @param func 元の後処理 (nullptr 可)
+/// @param onEdited キーフレームを編集したときの通知 (nullptr 可)
+/// @return Execute / Undo の後に呼ぶ関数
+template <typename T>
+inline std::function<void(T*)> WithOnEdited(
+    std::function<void(T*)> func,
+    const std::function<void()>& onEdited) {
+    if (!onEdited) {
+        return func;
+    }
+    return [func, onEdited](T* value) {
+        if (func) {
+            func(value);
+        }
+        onEdited();
+    };
+}
+
 /// @brief ノード削除処理
 /// @tparam T 値の型
 /// @param keyFrames キーフレーム配列
 /// @param popUpIndex 削除対象のインデックス
 /// @param defaultValue デフォルト値
+/// @param onEdited コマンドの Execute / Undo の後に呼ぶ関数
 /// @return 成功時true
 template <typename T>
 inline bool HandleDeleteNode(
     OriGine::AnimationCurve<T>& keyFrames,
     int& popUpIndex,
-    const T& defaultValue) {
+    const T& defaultValue,
+    const std::function<void()>& onEdited = nullptr) {
     if (keyFrames.size() <= 1) {
         // 最後のキーフレームはデフォルト値にリセット
         OriGine::EditorController::GetInstance()->PushCommand(
             std::make_unique<SetterCommand<OriGine::KeyFrame<T>>>(
                 &keyFrames[popUpIndex],
-                OriGine::KeyFrame<T>(0.0f, defaultValue)));
+                OriGine::KeyFrame<T>(0.0f, defaultValue),
+                WithOnEdited<OriGine::KeyFrame<T>>(nullptr, onEdited)));
         popUpIndex = -1;
         return true;
     }
@@ -53,6 +77,9 @@ inline bool HandleDeleteNode(
     commandCombo->AddCommand(
         std::make_shared<EraseElementCommand<OriGine::AnimationCurve<T>>>(
             &keyFrames, keyFrames.begin() + popUpIndex));
+    if (onEdited) {
+        commandCombo->SetFuncOnAfterCommand(onEdited, true);
+    }
     OriGine::EditorController::GetInstance()->PushCommand(std::move(commandCombo));
     popUpIndex = -1;
     return true;
@@ -63,12 +90,14 @@ inline bool HandleDeleteNode(
 /// @param keyFrames キーフレーム配列
 /// @param popUpIndex コピー元のインデックス
 /// @param popUpIndexId ストレージID
+/// @param onEdited コマンドの Execute / Undo の後に呼ぶ関数
 /// @return 成功時true
 template <typename T>
 inline bool HandleCopyNode(
     OriGine::AnimationCurve<T>& keyFrames,
     int popUpIndex,
-    ImGuiID popUpIndexId) {
+    ImGuiID popUpIndexId,
+    const std::function<void()>& onEdited = nullptr) {
     using namespace TimelineConfig;
 
     auto commandCombo = std::make_unique<CommandCombo>();
@@ -80,18 +109,24 @@ inline bool HandleCopyNode(
             &keyFrames.back().time, keyFrames.back().time + COPY_TIME_OFFSET));
 
     commandCombo->SetFuncOnAfterCommand(
-        [popUpIndexId, &keyFrames]() {
+        [popUpIndexId, &keyFrames, onEdited]() {
             ImGuiStorage* storage = ImGui::GetStateStorage();
             storage->SetInt(popUpIndexId, (int)keyFrames.size() - 1);
             SortKeyFrames(keyFrames);
+            if (onEdited) {
+                onEdited();
+            }
         },
         false);
 
     commandCombo->SetFuncOnAfterUndoCommand(
-        [popUpIndexId, popUpIndex, &keyFrames]() {
+        [popUpIndexId, popUpIndex, &keyFrames, onEdited]() {
             ImGuiStorage* storage = ImGui::GetStateStorage();
             storage->SetInt(popUpIndexId, popUpIndex);
             SortKeyFrames(keyFrames);
+            if (onEdited) {
+                onEdited();
+            }
         });
 
     OriGine::EditorController::GetInstance()->PushCommand(std::move(commandCombo));
@@ -104,13 +139,15 @@ inline bool HandleCopyNode(
 /// @param currentTime 追加位置の時間
 /// @param popUpIndexId ストレージID
 /// @param useCommand Undo/Redo対応コマンドを使用するか
+/// @param onEdited 追加した後 (コマンドなら Execute / Undo の後) に呼ぶ関数
 /// @return 成功時true
 template <typename T>
 inline bool HandleAddNode(
     OriGine::AnimationCurve<T>& keyFrames,
     float currentTime,
     ImGuiID popUpIndexId,
-    bool useCommand = false) {
+    bool useCommand                       = false,
+    const std::function<void()>& onEdited = nullptr) {
     T newValue = OriGine::CalculateValue::Linear(keyFrames, currentTime);
 
     if (useCommand) {
@@ -124,15 +161,21 @@ inline bool HandleAddNode(
                     return a.time < b.time;
                 }));
         commandCombo->SetFuncOnAfterCommand(
-            [popUpIndexId, keyFrames]() {
+            [popUpIndexId, keyFrames, onEdited]() {
                 ImGuiStorage* storage = ImGui::GetStateStorage();
                 storage->SetInt(popUpIndexId, (int)keyFrames.size() - 1);
+                if (onEdited) {
+                    onEdited();
+                }
             },
             true);
         OriGine::EditorController::GetInstance()->PushCommand(std::move(commandCombo));
     } else {
         keyFrames.push_back({currentTime, newValue});
         SortKeyFrames(keyFrames);
+        if (onEdited) {
+            onEdited();
+        }
     }
 
     ImGui::CloseCurrentPopup();
@@ -144,11 +187,13 @@ inline bool HandleAddNode(
 /// @param label ラベル
 /// @param keyFrames キーフレーム配列
 /// @param popUpIndex 編集対象のインデックス
+/// @param onEdited コマンドの Execute / Undo の後に呼ぶ関数
 template <typename T>
 inline void DrawTimeEdit(
     const std::string& label,
     OriGine::AnimationCurve<T>& keyFrames,
-    int popUpIndex) {
+    int popUpIndex,
+    const std::function<void()>& onEdited = nullptr) {
     using namespace TimelineConfig;
 
     ImGui::Text("Time");
@@ -156,89 +201,96 @@ inline void DrawTimeEdit(
         "##Time" + label + std::to_string(popUpIndex),
         keyFrames[popUpIndex].time,
         DRAG_SPEED, {}, {}, "%.3f",
-        [&keyFrames](float* /*val*/) {
-            SortKeyFrames(keyFrames);
-        });
+        WithOnEdited<float>(
+            [&keyFrames](float* /*val*/) {
+                SortKeyFrames(keyFrames);
+            },
+            onEdited));
 }
 
 /// @brief float値編集UI
 inline void DrawValueEditFloat(
     const std::string& label,
     OriGine::AnimationCurve<float>& keyFrames,
-    int popUpIndex) {
+    int popUpIndex,
+    const std::function<void()>& onEdited) {
     using namespace TimelineConfig;
     ImGui::Text("Value");
-    DragGuiCommand("##Value" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value, DRAG_SPEED);
+    DragGuiCommand<float>("##Value" + label + std::to_string(popUpIndex),
+        keyFrames[popUpIndex].value, DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
 }
 
 /// @brief Vec2f値編集UI
 inline void DrawValueEditVec2(
     const std::string& label,
     OriGine::AnimationCurve<OriGine::Vec2f>& keyFrames,
-    int popUpIndex) {
+    int popUpIndex,
+    const std::function<void()>& onEdited) {
     using namespace TimelineConfig;
     ImGui::Text("Value");
     DragGuiVectorCommand<2, float>(
         "##Value" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value, DRAG_SPEED);
+        keyFrames[popUpIndex].value, DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<OriGine::Vector<2, float>>(nullptr, onEdited));
 }
 
 /// @brief Vec3f値編集UI
 inline void DrawValueEditVec3(
     const std::string& label,
     OriGine::AnimationCurve<OriGine::Vec3f>& keyFrames,
-    int popUpIndex) {
+    int popUpIndex,
+    const std::function<void()>& onEdited) {
     using namespace TimelineConfig;
     ImGui::Text("X:");
     DragGuiCommand<float>("##X" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value[OriGine::X], DRAG_SPEED);
+        keyFrames[popUpIndex].value[OriGine::X], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
     ImGui::Text("Y:");
     DragGuiCommand<float>("##Y" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value[OriGine::Y], DRAG_SPEED);
+        keyFrames[popUpIndex].value[OriGine::Y], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
     ImGui::Text("Z:");
     DragGuiCommand<float>("##Z" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value[OriGine::Z], DRAG_SPEED);
+        keyFrames[popUpIndex].value[OriGine::Z], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
 }
 
 /// @brief Vec4f値編集UI
 inline void DrawValueEditVec4(
     const std::string& label,
     OriGine::AnimationCurve<OriGine::Vec4f>& keyFrames,
-    int popUpIndex) {
+    int popUpIndex,
+    const std::function<void()>& onEdited) {
     using namespace TimelineConfig;
     ImGui::Text("X:");
     DragGuiCommand<float>("##X" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value[OriGine::X], DRAG_SPEED);
+        keyFrames[popUpIndex].value[OriGine::X], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
     ImGui::Text("Y:");
     DragGuiCommand<float>("##Y" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value[OriGine::Y], DRAG_SPEED);
+        keyFrames[popUpIndex].value[OriGine::Y], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
     ImGui::Text("Z:");
     DragGuiCommand<float>("##Z" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value[OriGine::Z], DRAG_SPEED);
+        keyFrames[popUpIndex].value[OriGine::Z], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
     ImGui::Text("W:");
     DragGuiCommand<float>("##W" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value[OriGine::W], DRAG_SPEED);
+        keyFrames[popUpIndex].value[OriGine::W], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
 }
 
 /// @brief Quaternion値編集UI
 inline void DrawValueEditQuaternion(
     const std::string& label,
     OriGine::AnimationCurve<OriGine::Quaternion>& keyFrames,
-    int popUpIndex) {
+    int popUpIndex,
+    const std::function<void()>& onEdited) {
     using namespace TimelineConfig;
     ImGui::Text("X:");
     DragGuiCommand<float>("##X" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value.v[OriGine::X], DRAG_SPEED);
+        keyFrames[popUpIndex].value.v[OriGine::X], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
     ImGui::Text("Y:");
     DragGuiCommand<float>("##Y" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value.v[OriGine::Y], DRAG_SPEED);
+        keyFrames[popUpIndex].value.v[OriGine::Y], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
     ImGui::Text("Z:");
     DragGuiCommand<float>("##Z" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value.v[OriGine::Z], DRAG_SPEED);
+        keyFrames[popUpIndex].value.v[OriGine::Z], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
     ImGui::Text("W:");
     DragGuiCommand<float>("##W" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value.v[OriGine::W], DRAG_SPEED);
+        keyFrames[popUpIndex].value.v[OriGine::W], DRAG_SPEED, {}, {}, "%.3f", WithOnEdited<float>(nullptr, onEdited));
     // Quaternionは正規化
     keyFrames[popUpIndex].value = keyFrames[popUpIndex].value.normalize();
 }
@@ -247,10 +299,11 @@ inline void DrawValueEditQuaternion(
 inline void DrawValueEditColor(
     const std::string& label,
     OriGine::AnimationCurve<OriGine::Vec4f>& keyFrames,
-    int popUpIndex) {
+    int popUpIndex,
+    const std::function<void()>& onEdited) {
     ColorEditGuiCommand<4>(
         "Color##" + label + std::to_string(popUpIndex),
-        keyFrames[popUpIndex].value);
+        keyFrames[popUpIndex].value, 0, WithOnEdited<OriGine::Vector<4, float>>(nullptr, onEdited));
 }
 
 } // namespace TimelinePopup
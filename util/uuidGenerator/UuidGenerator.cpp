@@ -1,7 +1,173 @@
 #include "UuidGenerator.h"
 
+/// stl
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <random>
+
+namespace {
+
+/// <summary>
+/// NameGenerate / Sequential の接頭辞に使う名前空間
+/// </summary>
+constexpr uuids::uuid kNamespaceUuid{{0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x45, 0x43, 0x83, 0x53, 0x55, 0x75, 0x69, 0x64, 0x4e, 0x73}};
+
+/// <summary>
+/// Sequential の連番のビット数. 下位64bitの先頭2bitは variant で上書きされるため, UUIDに残るのは62bit
+/// </summary>
+constexpr uint64_t kSequentialCounterMask = (uint64_t(1) << 62) - 1;
+
+/// <summary>
+/// 発行状態 (Seeded の乱数エンジンは mutex で保護し, Sequential は連番の atomic のみで発行する)
+/// </summary>
+struct GeneratorState {
+    std::mutex mutex;
+    std::atomic<UuidGenerateMode> mode{UuidGenerateMode::Random};
+
+    std::mt19937 seededEngine{0};
+    uuids::uuid_random_generator seededGenerator{seededEngine};
+
+    std::array<uint8_t, 8> sequentialPrefix{};
+    std::atomic<uint64_t> sequentialCounter{0};
+};
+
+GeneratorState& GetState() {
+    static GeneratorState state;
+    return state;
+}
+
+/// <summary>
+/// Random 用の乱数 (発行順を再現する必要が無いため, スレッドごとに持ってロックを避ける)
+/// </summary>
+uuids::uuid_random_generator& GetRandomGenerator() {
+    thread_local std::mt19937 engine{std::random_device{}()};
+    thread_local uuids::uuid_random_generator generator{engine};
+    return generator;
+}
+
+/// <summary>
+/// 上位64bit = 接頭辞, 下位62bit = 連番 のUUIDを作る (version = 8, variant = 10)
+/// </summary>
+uuids::uuid MakeSequentialUuid(const std::array<uint8_t, 8>& _prefix, uint64_t _counter) {
+    _counter &= kSequentialCounterMask;
+    std::array<uint8_t, 16> bytes{};
+    for (size_t i = 0; i < 8; ++i) {
+        bytes[i] = _prefix[i];
+    }
+    for (size_t i = 0; i < 8; ++i) {
+        bytes[15 - i] = static_cast<uint8_t>(_counter >> (i * 8));
+    }
+    bytes[6] = static_cast<uint8_t>((bytes[6] & 0x0F) | 0x80);
+    bytes[8] = static_cast<uint8_t>((bytes[8] & 0x3F) | 0x80);
+    return uuids::uuid(bytes);
+}
+
+} // namespace
+
 uuids::uuid UuidGenerator::RandomGenerate() {
-    static std::mt19937 rng{std::random_device{}()};
-    static uuids::uuid_random_generator gen{rng};
-    return gen();
+    return GetRandomGenerator()();
+}
+
+uuids::uuid UuidGenerator::Generate() {
+    GeneratorState& state = GetState();
+    UuidGenerateMode mode = state.mode.load(std::memory_order_relaxed);
+    if (mode == UuidGenerateMode::Sequential) {
+        return MakeSequentialUuid(state.sequentialPrefix, state.sequentialCounter.fetch_add(1, std::memory_order_relaxed));
+    }
+
+    if (mode == UuidGenerateMode::Random) {
+        return GetRandomGenerator()();
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.seededGenerator();
+}
+
+void UuidGenerator::GenerateRange(size_t _count, std::vector<uuids::uuid>& _outUuids) {
+    GeneratorState& state = GetState();
+    _outUuids.reserve(_outUuids.size() + _count);
+
+    UuidGenerateMode mode = state.mode.load(std::memory_order_relaxed);
+    if (mode == UuidGenerateMode::Sequential) {
+        uint64_t first = state.sequentialCounter.fetch_add(_count, std::memory_order_relaxed);
+        for (size_t i = 0; i < _count; ++i) {
+            _outUuids.push_back(MakeSequentialUuid(state.sequentialPrefix, first + i));
+        }
+        return;
+    }
+
+    if (mode == UuidGenerateMode::Random) {
+        auto& generator = GetRandomGenerator();
+        for (size_t i = 0; i < _count; ++i) {
+            _outUuids.push_back(generator());
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (size_t i = 0; i < _count; ++i) {
+        _outUuids.push_back(state.seededGenerator());
+    }
+}
+
+uuids::uuid UuidGenerator::NameGenerate(const std::string& _name) {
+    uuids::uuid_name_generator generator(kNamespaceUuid);
+    return generator(_name);
+}
+
+void UuidGenerator::SetMode(UuidGenerateMode _mode, uint64_t _seed) {
+    GeneratorState& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    switch (_mode) {
+    case UuidGenerateMode::Seeded:
+        state.seededEngine.seed(static_cast<std::mt19937::result_type>(_seed ^ (_seed >> 32)));
+        break;
+    case UuidGenerateMode::Sequential: {
+        // 接頭辞はシードから決める (シードが違えば別の列になる)
+        uuids::uuid prefixSource = NameGenerate("Sequential:" + std::to_string(_seed));
+        auto prefixBytes         = prefixSource.as_bytes();
+        for (size_t i = 0; i < state.sequentialPrefix.size(); ++i) {
+            state.sequentialPrefix[i] = static_cast<uint8_t>(prefixBytes[i]);
+        }
+        state.sequentialCounter.store(0, std::memory_order_relaxed);
+        break;
+    }
+    default:
+        break;
+    }
+    state.mode.store(_mode, std::memory_order_release);
+}
+
+void UuidGenerator::NotifyLoaded(const uuids::uuid& _uuid) {
+    GeneratorState& state = GetState();
+    if (state.mode.load(std::memory_order_acquire) != UuidGenerateMode::Sequential) {
+        return;
+    }
+
+    // 接頭辞 (version を含む) が現在の列と違えば, 新規発行分と衝突しない
+    auto bytes = _uuid.as_bytes();
+    for (size_t i = 0; i < state.sequentialPrefix.size(); ++i) {
+        uint8_t expected = (i == 6) ? static_cast<uint8_t>((state.sequentialPrefix[i] & 0x0F) | 0x80) : state.sequentialPrefix[i];
+        if (static_cast<uint8_t>(bytes[i]) != expected) {
+            return;
+        }
+    }
+
+    uint64_t loadedCounter = 0;
+    for (size_t i = 8; i < 16; ++i) {
+        loadedCounter = (loadedCounter << 8) | static_cast<uint8_t>(bytes[i]);
+    }
+    loadedCounter &= kSequentialCounterMask;
+
+    // 読み込んだ連番の次から発行する (既に後ろまで進んでいれば何もしない)
+    uint64_t current = state.sequentialCounter.load(std::memory_order_relaxed);
+    while (current <= loadedCounter
+           && !state.sequentialCounter.compare_exchange_weak(current, loadedCounter + 1, std::memory_order_relaxed)) {
+    }
+}
+
+UuidGenerateMode UuidGenerator::GetMode() {
+    return GetState().mode.load(std::memory_order_relaxed);
 }
@@ -1,16 +1,70 @@
 #pragma once
 
+/// stl
+#include <cstdint>
+#include <string>
+#include <vector>
+
 /// externals
 #include <uuid/uuid.h>
 
 /// <summary>
-/// Externalsにある uuidライブラリの生成ラッパー
+/// UuidGenerator::Generate の発行方式
+/// </summary>
+enum class UuidGenerateMode {
+    Random, // random_device で初期化した乱数 (UUID v4). 既定. セッションをまたいでも衝突しない
+    Seeded, // 指定したシードの乱数 (UUID v4). 同じシード/同じ発行順なら同じ列になる
+    Sequential, // シードから決まる上位64bit + 62bitの連番 (UUID v8). 最速で, 同じシード/同じ発行順なら同じ列になる
+};
+
+/// <summary>
+/// Externalsにある uuidライブラリの生成ラッパー.
+/// ECS のEntity/Componentの新規Handleは Generate で発行され, 発行方式は SetMode で切り替えられる.
 /// </summary>
+/// <remarks>
+/// Seeded / Sequential はリプレイや負荷計測など, 発行列の再現が必要な場面向け.
+/// Sequential では読み込んだUUIDを NotifyLoaded で知らせると, 同じ列のUUIDより後ろから発行を続ける
+/// (SetMode はシーンを読み込む前に呼ぶ). Seeded にはこの仕組みが無いため, 保存したシーンを同じシードで
+/// 読み込み直すと新規発行分と衝突し得る.
+/// </remarks>
 class UuidGenerator {
 public:
     /// <summary>
-    /// ランダムなUUIDを生成する
+    /// ランダムなUUIDを生成する (発行方式に関わらず常に乱数)
     /// </summary>
     /// <returns></returns>
     static uuids::uuid RandomGenerate();
+
+    /// <summary>
+    /// 現在の発行方式でUUIDを生成する
+    /// </summary>
+    static uuids::uuid Generate();
+
+    /// <summary>
+    /// 現在の発行方式でUUIDを _count 個生成し, _outUuids の末尾に追加する.
+    /// Sequential では連番の範囲を1回でまとめて予約する (大量生成向け).
+    /// </summary>
+    /// <param name="_count">生成する数</param>
+    /// <param name="_outUuids">出力先</param>
+    static void GenerateRange(size_t _count, std::vector<uuids::uuid>& _outUuids);
+
+    /// <summary>
+    /// 名前から決まるUUID (UUID v5) を生成する. 同じ名前からは常に同じUUIDが得られる.
+    /// </summary>
+    /// <param name="_name">名前</param>
+    static uuids::uuid NameGenerate(const std::string& _name);
+
+    /// <summary>
+    /// 発行方式を切り替える. Seeded / Sequential は _seed から発行列を最初からやり直す.
+    /// </summary>
+    /// <param name="_mode">発行方式</param>
+    /// <param name="_seed">Seeded / Sequential のシード</param>
+    static void SetMode(UuidGenerateMode _mode, uint64_t _seed = 0);
+
+    /// <summary>
+    /// 保存データから読み込んだUUIDを知らせる. Sequential の現在の列に属していれば, 連番をそれより後ろへ進める.
+    /// </summary>
+    /// <param name="_uuid">読み込んだUUID</param>
+    static void NotifyLoaded(const uuids::uuid& _uuid);
+    static UuidGenerateMode GetMode();
 };